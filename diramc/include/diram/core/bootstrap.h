@@ -29,7 +29,6 @@
     #include <pthread.h>
 #endif
 
-#define DIRAM_MAX_HEAP_EVENTS 3
 #define DIRAM_TRACE_LOG_PATH "logs/diram_trace.log"
 
 typedef struct {
@@ -43,6 +42,8 @@ typedef struct {
     uint64_t timestamp;
     uint32_t heap_events;
     pid_t binding_pid;
+    uint64_t receipt_ticket;       // nonzero while a deferred receipt is pending
+    void* receipt_slot;
     char sha256_receipt[65];
 } diram_allocation_t;
 
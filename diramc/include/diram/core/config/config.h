@@ -2,16 +2,183 @@
 #define DIRAM_CONFIG_H
 
 #include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+
+// Configuration files and environment
+#define DIRAM_DEFAULT_CONFIG_FILE      ".dramrc"
+#define DIRAM_SYSTEM_CONFIG_FILE       "/etc/diram/config.dram"
+#define DIRAM_CONFIG_ENV               "DIRAM_CONFIG"
+
+// Defaults (memory_limit in MB)
+#define DIRAM_DEFAULT_MEMORY_LIMIT     6144
+#define DIRAM_DEFAULT_MAX_HEAP_EVENTS  3
+#define DIRAM_DEFAULT_TELEMETRY_LEVEL  2
+
+// Configuration keys - section keys are "<section>.<key>"
+#define CFG_MEMORY_LIMIT               "memory_limit"
+#define CFG_MEMORY_SPACE               "memory_space"
+#define CFG_TRACE                      "trace"
+#define CFG_RECEIPT_MODE               "receipt_mode"
+#define CFG_LOG_DIR                    "log_dir"
+#define CFG_MAX_HEAP_EVENTS            "max_heap_events"
+#define CFG_DETACH_TIMEOUT             "detach_timeout"
+#define CFG_PID_BINDING                "pid_binding"
+#define CFG_GUARD_PAGES                "guard_pages"
+#define CFG_CANARY_VALUES              "canary_values"
+#define CFG_ASLR_ENABLED               "aslr_enabled"
+#define CFG_TELEMETRY_LEVEL            "telemetry_level"
+#define CFG_TELEMETRY_ENDPOINT         "telemetry_endpoint"
+#define CFG_ZERO_TRUST                 "zero_trust"
+#define CFG_MEMORY_AUDIT               "memory_audit"
+
+#define CFG_ASYNC_ENABLE_PROMISES      "async.enable_promises"
+#define CFG_ASYNC_DEFAULT_TIMEOUT_MS   "async.default_timeout_ms"
+#define CFG_ASYNC_MAX_PENDING_PROMISES "async.max_pending_promises"
+#define CFG_ASYNC_LOOKAHEAD_CACHE_SIZE "async.lookahead_cache_size"
+#define CFG_ASYNC_EXECUTOR_THREADS     "async.executor_threads"
+
+#define CFG_DETACH_ENABLE_MODE         "detach.enable_detach_mode"
+#define CFG_DETACH_LOG_ASYNC_OPS       "detach.log_async_operations"
+#define CFG_DETACH_PERSIST_RECEIPTS    "detach.persist_promise_receipts"
+
+#define CFG_GOV_THREAD_RATE            "governor.thread_rate"
+#define CFG_GOV_THREAD_BURST           "governor.thread_burst"
+#define CFG_GOV_SPACE_RATE             "governor.space_rate"
+#define CFG_GOV_SPACE_BURST            "governor.space_burst"
+
+#define CFG_RESIL_RETRY_TRANSIENT      "resilience.retry_on_transient_failure"
+#define CFG_RESIL_MAX_RETRY            "resilience.max_retry_attempts"
+#define CFG_RESIL_EXP_BACKOFF          "resilience.exponential_backoff"
+
+// Where a configuration file was found, lowest precedence first
+typedef enum {
+    CONFIG_SOURCE_DEFAULT = 0,
+    CONFIG_SOURCE_SYSTEM,
+    CONFIG_SOURCE_USER,
+    CONFIG_SOURCE_LOCAL,
+    CONFIG_SOURCE_ENV,
+    CONFIG_SOURCE_CMDLINE
+} config_source_t;
 
 typedef struct {
-    char config_file[256];
-    int detach_mode;
-    int trace_enabled;
-    int repl_mode;
+    char config_file[PATH_MAX];
+    bool detach_mode;
+    bool trace_enabled;
+    bool repl_mode;
     size_t memory_limit;
     char memory_space[64];
-    char log_dir[256];
-    int verbose;
+    char log_dir[PATH_MAX];
+    bool verbose;
+
+    // Receipts: 0 = sync, 1 = deferred (diram_receipt_mode_t)
+    int receipt_mode;
+
+    // Heap constraints and isolation
+    int max_heap_events;
+    int detach_timeout;
+    char pid_binding[32];
+
+    // Memory protection
+    bool guard_pages;
+    bool canary_values;
+    bool aslr_enabled;
+
+    // Telemetry
+    int telemetry_level;
+    char telemetry_endpoint[PATH_MAX];
+
+    // Zero-trust policy
+    bool zero_trust;
+    bool memory_audit;
+
+    // [async]
+    bool enable_promises;
+    int default_timeout_ms;
+    int max_pending_promises;       // queued async work before callers run it inline
+    int lookahead_cache_size;
+    int executor_threads;           // 0 = one worker per online CPU
+
+    // [detach]
+    bool enable_detach_mode;
+    bool log_async_operations;
+    bool persist_promise_receipts;
+
+    // [governor] - events/second and burst; rate 0 = unlimited
+    int gov_thread_rate;
+    int gov_thread_burst;
+    int gov_space_rate;
+    int gov_space_burst;
+
+    // [resilience]
+    bool retry_on_transient_failure;
+    int max_retry_attempts;
+    bool exponential_backoff;
 } diram_config_t;
 
+extern diram_config_t g_diram_config;
+
+// Every key maps to one typed field of diram_config_t
+typedef enum {
+    CONFIG_TYPE_BOOL,
+    CONFIG_TYPE_INT,
+    CONFIG_TYPE_SIZE,
+    CONFIG_TYPE_STRING,             // char[size], always terminated
+    CONFIG_TYPE_RECEIPT_MODE        // int holding a diram_receipt_mode_t
+} config_type_t;
+
+typedef struct {
+    const char* name;
+    config_type_t type;
+    size_t offset;
+    size_t size;
+} config_key_t;
+
+// Keys are found through a perfect hash: slot (hash(key, seed) & mask)
+// holds the key's index + 1, or 0. Built on first use unless a compiled
+// config cache supplied one.
+typedef struct {
+    uint32_t seed;
+    uint32_t mask;
+    const uint8_t* slots;           // mask + 1 entries
+} config_index_t;
+
+// Lifecycle
+int diram_config_init(void);
+void diram_config_cleanup(void);
+
+// Loading
+int diram_config_load_file(const char* filename, config_source_t source);
+int diram_config_load_env(void);
+int diram_config_load_hierarchy(void);
+
+// Push loaded settings into the running subsystems
+int diram_config_apply(void);
+
+// Access
+int diram_config_set_value(const char* key, const char* value);
+const char* diram_config_get_value(const char* key);
+size_t diram_config_parse_size(const char* size_str);
+bool diram_config_parse_bool(const char* bool_str);
+
+// Key table
+size_t diram_config_key_count(void);
+const config_key_t* diram_config_key(size_t index);
+int diram_config_key_index(const char* key);                // -1 if unknown
+uint32_t diram_config_key_hash(const char* key, uint32_t seed);
+const config_index_t* diram_config_get_index(void);
+bool diram_config_set_index(const config_index_t* index);   // false if not perfect for this table
+uint64_t diram_config_loaded_keys(void);                    // bit per key set by the last text load
+
+// Validation and output
+bool diram_config_validate(void);
+const char* diram_config_get_errors(void);
+void diram_config_print(void);
+int diram_config_save(const char* filename);
+
 #endif
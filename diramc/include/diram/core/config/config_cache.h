@@ -0,0 +1,58 @@
+// include/diram/core/config/config_cache.h
+// DIRAM Compiled Configuration Cache (.drcb)
+// The settings produced by diram_config_load_hierarchy, compiled once into
+// a binary file that later starts mmap instead of re-reading text configs:
+//   header   - magic, format version, key table layout stamp, checksum
+//   sources  - path, mtime, size and content hash of every source file,
+//              including ones that were missing
+//   slots    - the perfect hash over the key table (see config_index_t)
+//   values   - one typed record per key the sources set
+//   strings  - source paths and string values
+// A cache is used only if its layout matches this build and every source
+// still has the stamped mtime and size, or failing that the stamped
+// content hash. Files modified within a second of being stamped are always
+// hashed, since their mtime may not have ticked over yet.
+#ifndef DIRAM_CONFIG_CACHE_H
+#define DIRAM_CONFIG_CACHE_H
+
+#include "diram/core/config/config.h"
+#include <stdint.h>
+
+#define DIRAM_CONFIG_CACHE_ENV      "DIRAM_CONFIG_CACHE"    // cache path; empty disables
+#define DIRAM_CONFIG_CACHE_EXT      ".drcb"
+#define DIRAM_CONFIG_CACHE_VERSION  1
+#define DIRAM_CONFIG_MAX_SOURCES    4
+
+typedef struct {
+    char path[PATH_MAX];
+    bool present;
+    bool racy;                      // mtime too close to the stamp to trust
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint64_t size;
+    uint64_t hash;                  // FNV-1a 64 of the contents
+} diram_config_stamp_t;
+
+// Per-user cache file for the current directory and $DIRAM_CONFIG, or
+// $DIRAM_CONFIG_CACHE. False if caching is disabled or there is no home.
+bool diram_config_cache_path(char* path, size_t size);
+
+// Map the cache and, if it is valid for `sources`, apply its values to
+// g_diram_config and adopt its key index. Returns 0 and the error count
+// the hierarchy load had when compiled, or -1 if missing or stale.
+int diram_config_cache_load(const char* cache_path, const char* const* sources,
+                            size_t count, int* errors);
+
+// Stamp `sources` as they are now
+int diram_config_cache_stamp(diram_config_stamp_t* stamps, const char* const* sources,
+                             size_t count);
+
+// Compile the keys set since the last hierarchy load. Written to a
+// temporary file and renamed, so concurrent starts never see a partial file.
+int diram_config_cache_save(const char* cache_path, const diram_config_stamp_t* stamps,
+                            size_t count, int errors);
+
+// Unmap the cache; key lookups fall back to the built-in index
+void diram_config_cache_release(void);
+
+#endif
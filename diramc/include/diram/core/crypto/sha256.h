@@ -0,0 +1,39 @@
+// include/diram/core/crypto/sha256.h
+// OBINexus DIRAM SHA-256 Receipt Engine
+// Runtime dispatch: SHA-NI, AVX2 8-lane multi-buffer, portable scalar
+#ifndef DIRAM_SHA256_H
+#define DIRAM_SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_SHA256_DIGEST_LEN    32
+#define DIRAM_SHA256_BLOCK_LEN     64
+#define DIRAM_SHA256_LANES         8
+
+typedef enum {
+    DIRAM_SHA256_IMPL_AUTO = 0,
+    DIRAM_SHA256_IMPL_SCALAR,
+    DIRAM_SHA256_IMPL_SHANI,       // x86 SHA extensions, single buffer
+    DIRAM_SHA256_IMPL_AVX2         // 8 independent messages per pass
+} diram_sha256_impl_t;
+
+// Single message
+void diram_sha256(const void* data, size_t len, uint8_t digest[DIRAM_SHA256_DIGEST_LEN]);
+void diram_sha256_hex(const void* data, size_t len, char hex[65]);
+void diram_sha256_to_hex(const uint8_t digest[DIRAM_SHA256_DIGEST_LEN], char hex[65]);
+
+// Batch of independent messages (pending receipts); lengths may differ
+void diram_sha256_batch(const void* const* data,
+                        const size_t* lens,
+                        size_t count,
+                        uint8_t (*digests)[DIRAM_SHA256_DIGEST_LEN]);
+
+// Dispatch control - AUTO picks the fastest path the CPU supports
+int diram_sha256_supported(diram_sha256_impl_t impl);
+int diram_sha256_force_impl(diram_sha256_impl_t impl);
+diram_sha256_impl_t diram_sha256_active_impl(void);
+diram_sha256_impl_t diram_sha256_active_batch_impl(void);
+const char* diram_sha256_impl_name(diram_sha256_impl_t impl);
+
+#endif // DIRAM_SHA256_H
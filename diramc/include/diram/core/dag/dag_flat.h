@@ -0,0 +1,63 @@
+// include/diram/core/dag/dag_flat.h
+// OBINexus DIRAM Flat DAG
+// Compact alternative to the pointer-linked dag_node_t graph. Nodes are
+// 32-bit indices into parallel arrays; each node's out-edges occupy one
+// contiguous row of the edge arrays (CSR), and edge triggers have an array
+// of their own so the similarity scan reads packed 32-bit phenotypes only.
+#ifndef DIRAM_DAG_FLAT_H
+#define DIRAM_DAG_FLAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "diram/core/diram_phenomenological.h"
+
+#define DIRAM_FLAT_DAG_NONE        UINT32_MAX
+#define DIRAM_FLAT_DAG_ROW_MIN     4        // slots reserved for a node's first edge
+
+// Everything a navigation step reads about a node, in one 16-byte record
+typedef struct {
+    uint32_t begin;                 // first edge slot of the node's row
+    uint32_t count;                 // live edges in the row
+    uint32_t capacity;              // slots reserved for the row
+    uint32_t pheno;                 // phenotype_t.raw
+} diram_flat_row_t;
+
+typedef struct {
+    // Nodes
+    diram_flat_row_t* rows;
+    axial_state_t* node_axial;
+    float* node_stability;
+    uint32_t* node_observations;
+    uint32_t node_count;
+    uint32_t node_capacity;
+
+    // Edges - structure of arrays, rows contiguous per node
+    uint32_t* edge_trigger;         // phenotype_t.raw, the scanned array
+    float* edge_probability;
+    uint32_t* edge_target;
+    uint32_t* edge_traversals;
+    uint32_t edge_used;             // slots handed out to rows so far
+    uint32_t edge_capacity;
+    uint32_t edge_count;            // live edges
+    uint32_t edge_dead;             // slots abandoned by rows that moved
+} diram_flat_dag_t;
+
+diram_flat_dag_t* diram_flat_dag_create(uint32_t node_hint, uint32_t edge_hint);
+void diram_flat_dag_destroy(diram_flat_dag_t* dag);
+
+// Append paths - a row that fills up moves to the end of the edge arrays
+// with twice the room; DIRAM_FLAT_DAG_NONE / -1 on allocation failure
+uint32_t diram_flat_dag_add_node(diram_flat_dag_t* dag, phenotype_t pheno, axial_state_t axial);
+int diram_flat_dag_add_edge(diram_flat_dag_t* dag, uint32_t from, uint32_t to,
+                            phenotype_t trigger, float probability);
+
+// Rewrite every row contiguously in node order, dropping abandoned slots.
+// Runs on its own once abandoned slots outnumber live edges.
+int diram_flat_dag_compact(diram_flat_dag_t* dag);
+
+// Same walk as diram_navigate_dag: follow the best similarity * probability
+// edge above threshold, append a new state when none qualifies
+uint32_t diram_flat_dag_navigate(diram_flat_dag_t* dag, uint32_t start, phenotype_t target,
+                                 float threshold, uint32_t max_depth);
+
+#endif // DIRAM_DAG_FLAT_H
@@ -0,0 +1,29 @@
+// include/diram/core/dag/dag_internal.h
+// OBINexus DIRAM DAG internals shared by the dag/ translation units.
+// Everything here runs with the DAG's write_lock held.
+#ifndef DIRAM_DAG_INTERNAL_H
+#define DIRAM_DAG_INTERNAL_H
+
+#include "diram/core/diram_dag.h"
+
+#define DIRAM_DAG_NODE_DYING      0x80000000u   // in dag_node_t.holds: no new holds
+#define DIRAM_DAG_MARK_CONDEMNED  UINT32_MAX    // in dag_node_t.mark: out of the graph
+
+// Free `ptr` once no pinned reader can still reach it
+void diram_dag_retire(diram_dag_t* dag, void* ptr, void (*release)(void* ptr));
+
+// Advance the epoch if readers allow and free what has aged out
+void diram_dag_reclaim(diram_dag_t* dag);
+
+// Append an existing node to dag->nodes under a fresh id; -1 if the
+// index cannot grow
+int diram_dag_adopt_node(diram_dag_t* dag, dag_node_t* node);
+
+// Frees a node, its live edges and its edge array; no reader may reach it
+size_t diram_dag_free_node(dag_node_t* node);
+
+// Optimizer hooks (dag_optimize.c)
+void diram_dag_optimizer_shade(diram_dag_t* dag, dag_node_t* node);
+void diram_dag_optimizer_release(diram_dag_t* dag);
+
+#endif // DIRAM_DAG_INTERNAL_H
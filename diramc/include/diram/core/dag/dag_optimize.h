@@ -0,0 +1,64 @@
+// include/diram/core/dag/dag_optimize.h
+// OBINexus DIRAM DAG Optimizer
+// Keeps a long-running DAG bounded. A pass walks every node in slices,
+// each holding the writer lock for at most `slice_budget` units of work:
+//   prune   - drop edges that clear neither the probability nor the
+//             traversal threshold, fold sibling edges whose targets are
+//             near-identical into one, and re-weight the survivors
+//   mark    - incremental reachability from the root (appends made while
+//             marking are shaded by a write barrier)
+//   sweep   - unreachable nodes leave the graph and are condemned
+//   reclaim - after a reader grace period, condemned nodes nobody holds
+//             are marked dying; after a second grace period they are freed
+// Readers never wait on any of it.
+#ifndef DIRAM_DAG_OPTIMIZE_H
+#define DIRAM_DAG_OPTIMIZE_H
+
+#include <stdint.h>
+#include "diram/core/diram_dag.h"
+
+#define DIRAM_DAG_OPT_MIN_PROBABILITY   0.05f
+#define DIRAM_DAG_OPT_MIN_TRAVERSALS    1
+#define DIRAM_DAG_OPT_MERGE_SIMILARITY  0.96f    // at most one differing bit
+#define DIRAM_DAG_OPT_MERGE_MAX_ROW     256      // wider rows skip sibling merging
+#define DIRAM_DAG_OPT_RENORM_WEIGHT     0.5f
+#define DIRAM_DAG_OPT_RENORM_EVIDENCE   8        // traversals before re-weighting a row
+#define DIRAM_DAG_OPT_SLICE_BUDGET      4096     // edges or nodes per lock hold
+#define DIRAM_DAG_OPT_INTERVAL_MS       10
+
+typedef struct {
+    float min_probability;      // an edge survives if it clears this...
+    uint32_t min_traversals;    // ...or has been taken at least this often
+    float merge_similarity;     // sibling targets this similar become one edge
+    float renormalize_weight;   // pull towards the row's traversal shares, 0 disables
+    uint32_t slice_budget;
+    uint32_t interval_ms;       // background pause between slices
+} diram_dag_optimize_config_t;
+
+typedef struct {
+    uint64_t passes;
+    uint64_t slices;
+    uint64_t edges_pruned;
+    uint64_t edges_merged;
+    uint64_t edges_renormalized;
+    uint64_t nodes_condemned;
+    uint64_t nodes_reclaimed;
+    uint64_t nodes_rescued;     // condemned but still held, returned to the graph
+    uint64_t bytes_reclaimed;
+    uint64_t max_pause_ns;      // longest single writer-lock hold
+    uint64_t total_pause_ns;
+} diram_dag_optimize_stats_t;
+
+// NULL config means the defaults above; applies to the next slice
+int diram_dag_optimize_configure(diram_dag_t* dag, const diram_dag_optimize_config_t* config);
+
+// One bounded slice; 1 when it finished a pass, 0 otherwise, -1 on error
+int diram_dag_optimize_step(diram_dag_t* dag);
+
+// Background thread running slices every interval_ms
+int diram_dag_optimizer_start(diram_dag_t* dag);
+void diram_dag_optimizer_stop(diram_dag_t* dag);
+
+void diram_dag_optimize_get_stats(diram_dag_t* dag, diram_dag_optimize_stats_t* out);
+
+#endif // DIRAM_DAG_OPTIMIZE_H
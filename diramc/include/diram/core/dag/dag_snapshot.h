@@ -0,0 +1,82 @@
+// include/diram/core/dag/dag_snapshot.h
+// OBINexus DIRAM DAG Snapshot Files
+// A learned DAG written as one position-independent image: node records
+// and CSR edge arrays addressed by file offsets and 32-bit node indices,
+// never pointers. The image is mmap'ed read-only and navigated in place;
+// a process that needs to learn again upgrades it to a mutable diram_dag_t.
+//
+//   [header 256][nodes][edge triggers][probabilities][targets][traversals]
+//
+// Every section starts 64-byte aligned. The header carries a truncated
+// SHA-256 of itself, always checked, and a SHA-256 of everything after
+// it, checked when the map is opened with DIRAM_DAG_MAP_VERIFY.
+#ifndef DIRAM_DAG_SNAPSHOT_H
+#define DIRAM_DAG_SNAPSHOT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "diram/core/diram_dag.h"
+
+#define DIRAM_DAG_FILE_MAGIC        "DIRAMDAG"
+#define DIRAM_DAG_FILE_VERSION      1
+#define DIRAM_DAG_FILE_BYTE_ORDER   0x01020304u   // reads back swapped on a foreign-endian host
+#define DIRAM_DAG_FILE_HEADER_SIZE  256
+#define DIRAM_DAG_FILE_ALIGN        64
+#define DIRAM_DAG_MAP_NONE          UINT32_MAX
+
+// open flags
+#define DIRAM_DAG_MAP_VERIFY        0x1           // hash the payload and check every index
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint64_t file_size;
+    uint64_t generation;            // diram_dag_t generation when written
+    uint32_t node_count;
+    uint32_t edge_count;
+    uint64_t nodes_offset;
+    uint64_t trigger_offset;        // phenotype_t.raw per edge
+    uint64_t probability_offset;    // float per edge
+    uint64_t target_offset;         // node index per edge
+    uint64_t traversals_offset;     // traversal_count per edge
+    uint8_t payload_sha256[32];     // bytes [DIRAM_DAG_FILE_HEADER_SIZE, file_size)
+    uint8_t header_check[8];        // SHA-256 prefix over the bytes above
+} diram_dag_file_header_t;
+
+// Node 0 is the root; a node's edges are [edge_begin, edge_begin + edge_count)
+typedef struct {
+    uint32_t phenotype;
+    uint32_t edge_begin;
+    uint32_t edge_count;
+    uint32_t observation_count;
+    axial_state_t axial;
+    float observation_confidence;
+    float stability_score;
+} diram_dag_file_node_t;
+
+typedef struct {
+    const uint8_t* base;
+    size_t size;
+    const diram_dag_file_header_t* header;
+    const diram_dag_file_node_t* nodes;
+    const uint32_t* edge_trigger;
+    const float* edge_probability;
+    const uint32_t* edge_target;
+    const uint32_t* edge_traversals;
+} diram_dag_map_t;
+
+// NULL if the file is missing, truncated, from another version or byte
+// order, or fails a checksum
+diram_dag_map_t* diram_dag_map_open(const char* filepath, int flags);
+void diram_dag_map_close(diram_dag_map_t* map);
+
+// The diram_dag_navigate walk, read-only: traversal counters are not
+// bumped and a miss returns the node reached instead of appending
+uint32_t diram_dag_map_navigate(const diram_dag_map_t* map, uint32_t start, phenotype_t target,
+                                float threshold, uint32_t max_depth);
+
+// Copy the image into a fresh mutable DAG at the file's generation
+diram_dag_t* diram_dag_map_upgrade(const diram_dag_map_t* map);
+
+#endif // DIRAM_DAG_SNAPSHOT_H
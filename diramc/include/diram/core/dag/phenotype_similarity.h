@@ -0,0 +1,33 @@
+// include/diram/core/dag/phenotype_similarity.h
+// OBINexus DIRAM Batch Phenotype Similarity
+// Scores one target against N packed phenotype_t.raw values. Every
+// back-end returns exactly what compute_phenotype_similarity would:
+// 1 - popcount(a ^ b) / 32, computed in single precision.
+// Runtime dispatch: AVX-512 VPOPCNTDQ 16 lanes, AVX2 8 lanes, portable scalar
+#ifndef DIRAM_PHENOTYPE_SIMILARITY_H
+#define DIRAM_PHENOTYPE_SIMILARITY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Navigation scores a node's edges in one batch above this fan-out
+#define DIRAM_SIMILARITY_BATCH_MIN   8
+#define DIRAM_SIMILARITY_CHUNK       64       // stack buffer for gathered triggers
+
+typedef enum {
+    DIRAM_SIMILARITY_IMPL_AUTO = 0,
+    DIRAM_SIMILARITY_IMPL_SCALAR,
+    DIRAM_SIMILARITY_IMPL_AVX2,        // nibble-table popcount, 8 lanes
+    DIRAM_SIMILARITY_IMPL_AVX512       // VPOPCNTDQ, 16 lanes with masked tail
+} diram_similarity_impl_t;
+
+void diram_phenotype_similarity_batch(uint32_t target, const uint32_t* phenotypes,
+                                      size_t count, float* out);
+
+// Dispatch control - AUTO picks the widest path the CPU supports
+int diram_similarity_supported(diram_similarity_impl_t impl);
+int diram_similarity_force_impl(diram_similarity_impl_t impl);
+diram_similarity_impl_t diram_similarity_active_impl(void);
+const char* diram_similarity_impl_name(diram_similarity_impl_t impl);
+
+#endif // DIRAM_PHENOTYPE_SIMILARITY_H
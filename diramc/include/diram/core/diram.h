@@ -8,6 +8,8 @@
 #include <pthread.h>
 #include <unistd.h>
 #include <time.h>
+#include "diram/core/governor/governor.h"
+#include "diram/core/diram_phenomenological.h"
 
 // Error codes aligned with OBINexus governance
 #define DIRAM_ERR_NONE                 0x0000
@@ -22,7 +24,7 @@
 
 #define DIRAM_SHA256_HEX_LEN           65
 #define DIRAM_TRACE_LOG_PATH "/var/log/diram/trace.log"
-#define DIRAM_MAX_HEAP_EVENTS 1000
+#define DIRAM_TRACE_BIN_LOG_PATH "/var/log/diram/trace.bin"
 
 // Status structure
 typedef struct {
@@ -44,6 +46,8 @@ typedef struct {
     uint64_t timestamp;
     uint32_t heap_events;
     pid_t binding_pid;
+    uint64_t receipt_ticket;       // nonzero while a deferred receipt is pending
+    void* receipt_slot;
     char sha256_receipt[DIRAM_SHA256_HEX_LEN];
 } diram_allocation_t;
 
@@ -66,67 +70,37 @@ typedef struct {
 typedef struct diram_memory_space {
     char space_name[64];
     size_t limit_bytes;
-    size_t used_bytes;
+    struct diram_space_account* account;   // lock-free per-CPU quota
     pid_t owner_pid;
-    pthread_mutex_t lock;
     void* base;
     uint32_t flags;
+    diram_gov_bucket_t governor;   // allocation event rate for the space
 } diram_memory_space_t;
 
-// Phenomenological types for DIRAM memory observation
-typedef struct {
-    uint64_t signature;
-    uint32_t semantic_hash;
-    float confidence;
-    uint8_t dimensions[16];  // Dimensional attributes
-} phenotype_t;
-
-// DAG node for navigation
-typedef struct dag_node {
-    void* memory_ref;
-    phenotype_t phenotype;
-    struct dag_node* next;
-    struct dag_node* prev;
-    struct dag_node** children;
-    size_t child_count;
-    uint32_t depth;
-} dag_node_t;
-
-// Axial state representation
-typedef struct {
-    float vectors[3];     // x, y, z axes
-    float rotation[4];    // Quaternion
-    uint64_t timestamp;
-    uint32_t stability;
-} axial_state_t;
-
-// Main DIRAM context (different from heap context)
-typedef struct {
-    diram_heap_context_t* heap_ctx;
-    diram_memory_space_t* spaces[16];  // Multiple memory spaces
-    dag_node_t* dag_root;
-    pthread_mutex_t global_lock;
-    uint32_t flags;
-    char session_id[64];
-} diram_context_t;
-
 // Core allocation functions
 diram_allocation_t* diram_alloc_traced(size_t size, const char* tag);
 void diram_free_traced(diram_allocation_t* alloc);
 void diram_compute_receipt(diram_allocation_t* alloc, const char* tag);
 int diram_init_trace_log(void);
 void diram_close_trace_log(void);
+int diram_bootstrap_init(void);
 
 diram_enhanced_allocation_t* diram_alloc_enhanced(
     size_t size,
     const char* tag,
     diram_memory_space_t* space
 );
+void diram_free_enhanced(diram_enhanced_allocation_t* alloc, diram_memory_space_t* space);
 
 // Space management
 diram_memory_space_t* diram_space_create(const char* name, size_t limit);
 void diram_space_destroy(diram_memory_space_t* space);
 int diram_space_check_limit(diram_memory_space_t* space, size_t requested);
+int diram_space_charge(diram_memory_space_t* space, size_t bytes);
+void diram_space_release(diram_memory_space_t* space, size_t bytes);
+int diram_space_admit(diram_memory_space_t* space, size_t bytes, uint32_t events);
+size_t diram_space_used(const diram_memory_space_t* space);
+int diram_space_set_rate(diram_memory_space_t* space, uint32_t rate, uint32_t burst);
 void diram_error_index_init(void);
 void diram_error_index_shutdown(void);
 
@@ -1,11 +1,22 @@
 // include/diram/core/diram_dag.h
 // DAG (Directed Acyclic Graph) structures for OBINexus DIRAM phenomenological memory
+// Concurrency model: any number of lock-free readers, one writer at a time.
+// Readers pin an epoch and never take a lock; the writer appends edges
+// into slack at the end of a node's edge array and publishes them with a
+// release store of edge_count. A full array is copied, the copy published,
+// and the old one retired until every reader pinned before the swap has
+// left (epoch-based reclamation). Each edge records the generation that
+// published it, so a traversal sees the DAG exactly as of its snapshot.
 #ifndef DIRAM_DAG_H
 #define DIRAM_DAG_H
 
 #include <stdint.h>
+#include <pthread.h>
 #include "diram/core/diram_phenomenological.h"
 
+#define DIRAM_DAG_READER_SLOTS    128      // concurrently pinned readers
+#define DIRAM_DAG_DEFAULT_DEPTH   32
+
 // DAG navigation states for memory phenomena tracking
 typedef enum {
     DAG_STATE_IDLE,
@@ -15,6 +26,53 @@ typedef enum {
     DAG_STATE_COMPLETE
 } dag_state_t;
 
+// Something the writer unlinked, freed once no reader can still see it
+typedef struct diram_dag_retired {
+    void* ptr;
+    void (*release)(void* ptr);
+    uint64_t epoch;
+    struct diram_dag_retired* next;
+} diram_dag_retired_t;
+
+// One reader slot per cache line: 0 when free, else (epoch << 1) | 1
+typedef struct {
+    uint64_t state;
+    uint8_t pad[56];
+} diram_dag_reader_t;
+
+// DAG graph structure for phenomenological memory patterns
+typedef struct diram_dag {
+    dag_node_t* root;
+    uint32_t node_count;
+    uint32_t edge_count;
+    uint64_t generation;  // For versioning the DAG structure; bumped per published change
+    float threshold;      // minimum similarity * probability to follow an edge
+    uint32_t max_depth;
+
+    // Writer side - every mutation holds write_lock; readers never touch it
+    pthread_mutex_t write_lock;
+    dag_node_t** nodes;   // every node, for teardown and whole-graph passes
+    uint32_t node_capacity;
+    diram_dag_retired_t* retired;
+    uint32_t retired_count;
+
+    // Optimizer (dag/dag_optimize.h); appends shade their target while marking
+    struct diram_dag_optimizer* optimizer;
+    uint32_t mark_pass;
+    uint32_t marking;
+
+    // Epoch-based reclamation
+    uint64_t epoch;
+    diram_dag_reader_t readers[DIRAM_DAG_READER_SLOTS];
+} diram_dag_t;
+
+// A pinned view of the DAG as of one generation
+typedef struct {
+    diram_dag_t* dag;
+    uint64_t generation;
+    uint32_t slot;
+} diram_dag_snapshot_t;
+
 // DAG traversal context
 typedef struct {
     dag_node_t* current_node;
@@ -23,38 +81,50 @@ typedef struct {
     uint32_t max_depth;
     dag_state_t state;
     float cumulative_probability;
+    diram_dag_snapshot_t snapshot;
 } dag_traversal_context_t;
 
-// DAG graph structure for phenomenological memory patterns
-typedef struct {
-    dag_node_t* root;
-    uint32_t node_count;
-    uint32_t edge_count;
-    uint64_t generation;  // For versioning the DAG structure
-    pthread_rwlock_t lock;
-} diram_dag_t;
-
 // DAG operations
 diram_dag_t* diram_dag_create(void);
 void diram_dag_destroy(diram_dag_t* dag);
 
-// Node operations
+// Snapshots - pinning never waits on the writer. A snapshot can be ended
+// from any thread and holds back reclamation until it is
+void diram_dag_snapshot_begin(diram_dag_t* dag, diram_dag_snapshot_t* snap);
+void diram_dag_snapshot_end(diram_dag_snapshot_t* snap);
+
+// Node operations (writer path; serialised on write_lock). A node that is
+// neither reachable from the root nor held is reclaimed by the optimizer;
+// connecting to a node it has already taken out of the graph returns -1
 dag_node_t* diram_dag_add_node(diram_dag_t* dag, phenotype_t pheno);
-int diram_dag_connect_nodes(dag_node_t* from, dag_node_t* to, 
+int diram_dag_connect_nodes(diram_dag_t* dag, dag_node_t* from, dag_node_t* to,
                             phenotype_t trigger, float probability);
 
-// Traversal operations  
+// Holds keep a node alive outside a snapshot. Taking one fails (-1) on a
+// node that is already being reclaimed; the root can always be held
+int diram_dag_hold(diram_dag_t* dag, dag_node_t* node);
+void diram_dag_release(diram_dag_t* dag, dag_node_t* node);
+
+// Lock-free walk from `start` (root when NULL; caller holds it); appends a
+// new state through the writer path only when no edge qualifies. The node
+// returned is held for the caller
+dag_node_t* diram_dag_navigate(diram_dag_t* dag, dag_node_t* start, phenotype_t target,
+                               float threshold, uint32_t max_depth);
+
+// Traversal operations - read-only, pinned to the generation at begin;
+// the nodes returned stay valid until end
 dag_traversal_context_t* diram_dag_begin_traversal(diram_dag_t* dag);
 dag_node_t* diram_dag_traverse_next(dag_traversal_context_t* ctx, phenotype_t pheno);
 void diram_dag_end_traversal(dag_traversal_context_t* ctx);
 
 // Prediction operations
 phenotype_t diram_dag_predict_next(diram_dag_t* dag, dag_node_t* current);
-float diram_dag_get_transition_probability(dag_node_t* from, dag_node_t* to);
+float diram_dag_get_transition_probability(diram_dag_t* dag, dag_node_t* from, dag_node_t* to);
 
 // Utility operations
-void diram_dag_optimize(diram_dag_t* dag);  // Prune low-probability edges
-void diram_dag_serialize(diram_dag_t* dag, const char* filepath);
+void diram_dag_optimize(diram_dag_t* dag);  // One full pass, see dag/dag_optimize.h
+// Snapshot file, see dag/dag_snapshot.h; serialize returns 0 or -1
+int diram_dag_serialize(diram_dag_t* dag, const char* filepath);
 diram_dag_t* diram_dag_deserialize(const char* filepath);
 
 #endif // DIRAM_DAG_H
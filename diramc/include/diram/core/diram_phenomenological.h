@@ -50,6 +50,9 @@ typedef struct dag_node {
     uint32_t observation_count;
     float observation_confidence; 
     float stability_score;         
+    uint32_t id;                   // index in the owning diram_dag_t
+    uint32_t holds;                // long-lived references; see diram_dag_hold
+    uint32_t mark;                 // optimizer pass that last reached it
 } dag_node_t;
 
 
@@ -59,7 +62,8 @@ typedef struct dag_edge {
     dag_node_t* to;
     phenotype_t trigger;
     float probability;
-    uint32_t traversal_count;
+    uint32_t traversal_count;   // bumped atomically by concurrent walkers
+    uint64_t generation;        // diram_dag_t generation that published it
 } dag_edge_t;
 
 // Triple-stream processing result
@@ -82,12 +86,14 @@ typedef struct {
 typedef struct {
     dag_node_t* dag_root;
     dag_node_t* current_state;
-    phenotype_t* observation_buffer;
-    uint32_t observation_count;
-    uint32_t observation_capacity;
+    struct diram_obs_ring* observations;        // recent phenotypes and their running aggregates
+    struct diram_sampler* sampler;              // page-level phenomena of tracked allocations
     float phenomenon_threshold;
     uint32_t max_dag_depth;
     triple_stream_t* streams;
+    struct diram_dag* dag;                      // owns dag_root and every state below it
+    struct diram_prefetch_pool* prefetch_pool;  // speculative blocks awaiting a request
+    struct phenomenon_predictor* predictor;     // learns which request follows which
 } diram_context_t;
 
 // Function prototypes for phenomenological operations
@@ -95,6 +101,9 @@ dag_node_t* create_dag_node(phenotype_t pheno, axial_state_t axial);
 void add_dag_edge(dag_node_t* from, dag_node_t* to, phenotype_t trigger, float probability);
 triple_stream_t* init_triple_streams(void);
 triple_stream_result_t query_triple_streams(triple_stream_t* streams);
+void* diram_alloc(diram_context_t* ctx, size_t size, phenotype_t intent);
+// Returns a held state; give it back with diram_dag_release
+dag_node_t* diram_navigate_dag(diram_context_t* ctx, phenotype_t target);
 
 // Helper functions referenced in diram.c
 uint64_t get_memory_access_time(void* memory);
@@ -0,0 +1,47 @@
+// include/diram/core/feature-alloc/async_executor.h
+// OBINexus DIRAM Async Executor
+// Fixed pool of workers, each owning a Chase-Lev deque. Work submitted from
+// outside the pool lands on a shared injection list that idle workers pull
+// from in batches; workers that run dry steal from their peers. Replaces the
+// thread-per-promise model of diram_alloc_async.
+#ifndef DIRAM_ASYNC_EXECUTOR_H
+#define DIRAM_ASYNC_EXECUTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_EXECUTOR_MAX_WORKERS     64
+#define DIRAM_EXECUTOR_DEQUE_ENTRIES   1024     // per worker, power of two
+#define DIRAM_EXECUTOR_INJECT_BATCH    32       // tasks moved per injection pull
+
+// Intrusive task: embed it in the work item, the executor never allocates
+typedef struct diram_task {
+    void (*run)(struct diram_task* task);
+    struct diram_task* next;                    // injection list link
+} diram_task_t;
+
+typedef struct {
+    uint32_t workers;
+    uint64_t submitted;
+    uint64_t executed;
+    uint64_t inlined;         // ran on the submitter: pool full or not running
+    uint64_t steals;          // tasks taken from another worker's deque
+    uint64_t injected;        // tasks pulled from the injection list
+    uint64_t queue_depth;     // submitted but not yet finished
+    uint64_t peak_depth;
+} diram_executor_stats_t;
+
+// workers 0 = one per online CPU; max_pending 0 = bounded only by the deques.
+// The worker count takes effect at the next start.
+void diram_executor_configure(uint32_t workers, uint32_t max_pending);
+
+// Queue a task, starting the pool on first use. Past max_pending the task
+// runs on the calling thread instead, so submission never fails.
+void diram_executor_submit(diram_task_t* task);
+
+// Run everything queued, then stop and join the workers
+void diram_executor_shutdown(void);
+
+void diram_executor_get_stats(diram_executor_stats_t* out);
+
+#endif // DIRAM_ASYNC_EXECUTOR_H
@@ -8,6 +8,7 @@
 #include <time.h>
 #include <sys/types.h>
 #include <stdbool.h>
+#include "diram/core/feature-alloc/promise_futex.h"
 
 // Forward declarations for circular dependencies
 typedef struct diram_memory_space diram_memory_space_t;
@@ -116,6 +117,10 @@ typedef struct diram_promise_chain {
     void (*onRejected)(diram_reject_reason_t, const char*);
     diram_async_promise_t* next_promise;
     struct diram_promise_chain* next;
+    
+    // Internal settle hook (combinators); runs once, under the promise lock
+    void (*on_settle)(diram_async_promise_t* promise, void* context);
+    void* settle_context;
 } diram_promise_chain_t;
 
 // Main async promise structure - JavaScript Promise-inspired
@@ -143,6 +148,9 @@ typedef struct diram_async_promise {
     uint32_t cache_priority;
     bool is_chained;
     
+    // The caller and any queued worker each hold a reference
+    uint32_t refs;
+    
     // Lookahead computation parameters
     struct {
         uint64_t prediction_confidence;  // 0-100 percentage
@@ -166,11 +174,24 @@ typedef struct diram_async_promise {
     } result;
 } diram_async_promise_t;
 
+typedef struct diram_promise_combinator diram_promise_combinator_t;
+
 // Promise.all() implementation
 typedef struct {
     diram_async_promise_t** promises;
     size_t count;
     diram_async_promise_t* aggregate_promise;
+    
+    // Filled in order once the aggregate resolves
+    diram_enhanced_allocation_t** results;
+    
+    // Batch allocation: one block backs every buffer and tag
+    void* reservation;
+    diram_enhanced_allocation_t* allocations;
+    diram_memory_space_t* space;
+    size_t charged;                 // bytes charged to space, returned on release
+    
+    diram_promise_combinator_t* combinator;
 } diram_promise_all_t;
 
 // Promise.race() implementation  
@@ -178,6 +199,11 @@ typedef struct {
     diram_async_promise_t** promises;
     size_t count;
     diram_async_promise_t* winner_promise;
+    
+    // Valid once winner_promise settles
+    size_t winner_index;
+    
+    diram_promise_combinator_t* combinator;
 } diram_promise_race_t;
 
 // Core API functions
@@ -202,12 +228,48 @@ diram_async_promise_t* diram_alloc_with_lookahead(
     uint32_t access_pattern_hint
 );
 
+// Async allocation settled through a compact futex promise; the value
+// is the diram_enhanced_allocation_t*, release the promise after await
+diram_fpromise_t* diram_alloc_async_compact(
+    size_t size,
+    const char* tag,
+    diram_memory_space_t* space
+);
+
+// Allocations charge the space's quota and governor (one event each)
+// and are rejected with REJECT_REASON_GOVERNANCE_VIOLATION when either
+// refuses. Release a resolved allocation with diram_alloc_async_release
+// and the same space to return its quota.
+void diram_alloc_async_release(diram_enhanced_allocation_t* alloc, diram_memory_space_t* space);
+
+// Batch allocation - one aggregate promise whose results[] holds every
+// allocation. Buffers come from a single reservation and receipts are
+// hashed in one multi-buffer pass; tags may be NULL. The batch charges
+// its total size and one governor event per buffer up front. Release the
+// whole batch with diram_alloc_batch_release, never the individual buffers.
+diram_promise_all_t* diram_alloc_async_batch(
+    const size_t* sizes,
+    const char* const* tags,
+    size_t count,
+    diram_memory_space_t* space
+);
+void diram_alloc_batch_release(diram_promise_all_t* batch);
+
 // JavaScript-style static methods
 diram_async_promise_t* diram_promise_resolve(diram_enhanced_allocation_t* value);
 diram_async_promise_t* diram_promise_reject(diram_reject_reason_t reason, const char* msg);
 diram_promise_all_t* diram_promise_all(diram_async_promise_t** promises, size_t count);
 diram_promise_race_t* diram_promise_race(diram_async_promise_t** promises, size_t count);
 
+// Combinators settle from the children's settlement, never by polling.
+// all resolves once every child has (results[] in order) and rejects on
+// the first rejection; race settles with the first child and cancels the
+// rest so queued losers never allocate. Children must stay alive until
+// the aggregate settles. Destroying a pending combinator cancels its
+// children first.
+void diram_promise_all_destroy(diram_promise_all_t* all);
+void diram_promise_race_destroy(diram_promise_race_t* race);
+
 // Promise operations
 int diram_promise_await(diram_async_promise_t* promise, uint64_t timeout_ms);
 int diram_promise_resolve_internal(diram_async_promise_t* promise, diram_enhanced_allocation_t* alloc);
@@ -215,14 +277,15 @@ int diram_promise_reject_internal(diram_async_promise_t* promise, diram_reject_r
 void diram_promise_destroy(diram_async_promise_t* promise);
 diram_status_t diram_promise_get_status(diram_async_promise_t* promise);
 
-// Enhanced allocation function declaration
-diram_enhanced_allocation_t* diram_alloc_enhanced(
-    size_t size,
-    const char* tag,
-    diram_memory_space_t* space
-);
+// Space accounting, from diram.h; NULL space charges nothing
+diram_memory_space_t* diram_space_create(const char* name, size_t limit);
+void diram_space_destroy(diram_memory_space_t* space);
+int diram_space_admit(diram_memory_space_t* space, size_t bytes, uint32_t events);
+void diram_space_release(diram_memory_space_t* space, size_t bytes);
 
 // Constants
+#define DIRAM_ALLOC_FLAG_BATCH         0x1    // base.ptr is part of a batch reservation
+#define DIRAM_ALLOC_BATCH_ALIGN        64
 #define DIRAM_SHA256_HEX_LEN           65
 #define DIRAM_ERR_NONE                 0x0000
 #define DIRAM_ERR_MEMORY_EXHAUSTED     0x1001
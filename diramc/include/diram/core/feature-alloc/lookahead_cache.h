@@ -0,0 +1,48 @@
+// include/diram/core/feature-alloc/lookahead_cache.h
+// OBINexus DIRAM Lookahead Cache
+// Size predictions keyed by (tag hash, access pattern). Entries live in
+// sharded open-addressing tables: readers are lock-free under a per-shard
+// seqlock, writers lock only their shard, and a full probe window evicts
+// by CLOCK (second chance on the reference bit).
+#ifndef DIRAM_LOOKAHEAD_CACHE_H
+#define DIRAM_LOOKAHEAD_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_LOOKAHEAD_SHARDS            16       // power of two
+#define DIRAM_LOOKAHEAD_PROBE             8        // slots searched per key
+#define DIRAM_LOOKAHEAD_DEFAULT_CAPACITY  1024
+
+typedef struct {
+    size_t predicted_size;
+    double confidence;        // 0.0-1.0, grows while the same size recurs
+    uint64_t last_access;     // time() of the last recorded allocation
+} diram_lookahead_prediction_t;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;
+    uint64_t read_retries;    // seqlock reads repeated after a concurrent write
+    size_t capacity;
+    size_t entries;
+    double hit_ratio;
+} diram_lookahead_stats_t;
+
+// Capacity (lookahead_cache_size) applies when the cache is first used;
+// -1 once it has been built
+int diram_lookahead_cache_configure(size_t capacity);
+
+// 0 and *out filled on a hit, -1 on a miss
+int diram_lookahead_cache_lookup(const char* tag, uint32_t access_pattern,
+                                 diram_lookahead_prediction_t* out);
+
+// Learn from a completed allocation of `size` bytes
+void diram_lookahead_cache_record(const char* tag, uint32_t access_pattern, size_t size);
+
+void diram_lookahead_cache_get_stats(diram_lookahead_stats_t* out);
+void diram_lookahead_cache_clear(void);
+
+#endif // DIRAM_LOOKAHEAD_CACHE_H
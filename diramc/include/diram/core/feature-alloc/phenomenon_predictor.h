@@ -0,0 +1,75 @@
+// include/diram/core/feature-alloc/phenomenon_predictor.h
+// OBINexus DIRAM Phenomenon Predictor
+// Order-k Markov model with PPM-style fallback over observed phenotypes.
+// Each symbol is a (masked phenotype, allocation size) pair; a context is
+// the last 1..k symbols. Updates and predictions touch k+1 fixed-size
+// context slots, independent of how long the predictor has been running.
+#ifndef DIRAM_PHENOMENON_PREDICTOR_H
+#define DIRAM_PHENOMENON_PREDICTOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "diram/core/diram_phenomenological.h"
+
+#define DIRAM_PREDICTOR_HISTORY      32       // observed_sequence ring
+#define DIRAM_PREDICTOR_MAX_ORDER    4
+#define DIRAM_PREDICTOR_DEFAULT_ORDER 3
+#define DIRAM_PREDICTOR_CANDIDATES   4        // next symbols kept per context
+#define DIRAM_PREDICTOR_CONTEXTS     1024     // slots per order, power of two
+#define DIRAM_PREDICTOR_COUNT_LIMIT  255      // counts halve past this, so old habits fade
+
+// Field masks over phenotype_t.raw - the age bucket drifts with time and
+// says nothing about what comes next, so the default leaves it out
+#define DIRAM_PHENO_FIELDS_ALL       0xFFFFFFFFu
+#define DIRAM_PHENO_FIELD_AGE        0x00000007u
+#define DIRAM_PHENO_FIELDS_DEFAULT   (DIRAM_PHENO_FIELDS_ALL & ~DIRAM_PHENO_FIELD_AGE)
+
+typedef struct {
+    uint32_t phenotype;       // masked raw bits
+    uint32_t count;
+    uint64_t size;
+} diram_predictor_candidate_t;
+
+typedef struct {
+    uint64_t key;             // context hash, 0 while the slot is empty
+    uint32_t total;
+    uint32_t distinct;
+    diram_predictor_candidate_t next[DIRAM_PREDICTOR_CANDIDATES];
+} diram_predictor_context_t;
+
+typedef struct {
+    phenotype_t phenotype;
+    size_t size;              // 0 when no size has been learned
+    float confidence;         // 0.0-1.0
+    uint32_t order;           // context length used; 0 = overall frequency
+} phenomenon_prediction_t;
+
+// Phenomenon predictor structure
+typedef struct phenomenon_predictor {
+    phenotype_t observed_sequence[DIRAM_PREDICTOR_HISTORY];  // Recent phenomena observations
+    uint64_t observed_sizes[DIRAM_PREDICTOR_HISTORY];
+    uint32_t sequence_length;                                // total observed; ring index = length % HISTORY
+    float confidence_scores[DIRAM_PREDICTOR_HISTORY];        // probability the model gave each observation
+    uint32_t order;
+    uint32_t field_mask;
+    diram_predictor_context_t* contexts;                     // (order + 1) * CONTEXTS slots
+} phenomenon_predictor_t;
+
+// order 0 selects the default, field_mask 0 selects DIRAM_PHENO_FIELDS_DEFAULT
+int diram_predictor_init(phenomenon_predictor_t* predictor, uint32_t order, uint32_t field_mask);
+void diram_predictor_destroy(phenomenon_predictor_t* predictor);
+
+// Record what actually happened
+void diram_predictor_observe(phenomenon_predictor_t* predictor, phenotype_t pheno, size_t size);
+
+// Longest known context wins; -1 when nothing has been learned yet
+int diram_predictor_predict(const phenomenon_predictor_t* predictor, phenomenon_prediction_t* out);
+
+// cache_lookahead.c - blends the model with the current DAG state's edges;
+// the caller holds a DAG snapshot while the edges are read
+phenotype_t predict_next_phenomenon(phenomenon_predictor_t* predictor,
+                                    dag_node_t* current_state,
+                                    phenomenon_prediction_t* out);
+int prefetch_by_phenomenon(diram_context_t* ctx, const phenomenon_prediction_t* prediction);
+
+#endif // DIRAM_PHENOMENON_PREDICTOR_H
@@ -0,0 +1,78 @@
+// include/diram/core/feature-alloc/prefetch_pool.h
+// OBINexus DIRAM Speculative Prefetch Pool
+// Blocks allocated ahead of a predicted phenomenon park here until a
+// request of the same size class claims them. The pool is bounded in
+// blocks and bytes; unclaimed blocks leave oldest-first when they outlive
+// max_age, when a new block needs room, or when an allocation fails.
+#ifndef DIRAM_PREFETCH_POOL_H
+#define DIRAM_PREFETCH_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+
+#define DIRAM_PREFETCH_MAX_BLOCKS      64       // hard cap, index lists are 8-bit
+#define DIRAM_PREFETCH_DEFAULT_BYTES   (256 * 1024)
+#define DIRAM_PREFETCH_DEFAULT_AGE_MS  1000
+#define DIRAM_PREFETCH_CLASSES         64       // power-of-two size classes
+
+typedef struct {
+    uint64_t parked;            // blocks speculatively allocated
+    uint64_t hits;              // requests served from the pool
+    uint64_t misses;            // requests the pool could not serve
+    uint64_t aged_out;          // dropped after max_age unclaimed
+    uint64_t reclaimed;         // dropped for room or on allocation failure
+    uint64_t served_bytes;
+    uint64_t wasted_bytes;      // speculative bytes freed without use
+    uint64_t time_saved_ns;     // allocation time hits did not pay
+    uint32_t blocks;
+    size_t bytes;
+    double hit_ratio;           // hits / parked
+} diram_prefetch_stats_t;
+
+typedef struct {
+    void* ptr;
+    size_t size;
+    uint64_t parked_ns;
+    uint64_t alloc_ns;          // what the speculative allocation cost
+    uint32_t phenotype;
+    uint8_t cls;
+    uint8_t class_next;         // FIFO within the size class
+    uint8_t age_prev;           // pool-wide FIFO by park time
+    uint8_t age_next;
+} diram_prefetch_block_t;
+
+typedef struct diram_prefetch_pool {
+    pthread_mutex_t lock;
+    uint32_t max_blocks;
+    size_t max_bytes;
+    uint64_t max_age_ns;
+    diram_prefetch_block_t blocks[DIRAM_PREFETCH_MAX_BLOCKS];
+    uint8_t free_head;
+    uint8_t class_head[DIRAM_PREFETCH_CLASSES];
+    uint8_t class_tail[DIRAM_PREFETCH_CLASSES];
+    uint8_t age_head;           // oldest
+    uint8_t age_tail;           // newest
+    uint32_t count;
+    size_t bytes;
+    diram_prefetch_stats_t stats;
+} diram_prefetch_pool_t;
+
+// 0 for any limit selects its default
+diram_prefetch_pool_t* diram_prefetch_pool_create(uint32_t max_blocks, size_t max_bytes,
+                                                  uint32_t max_age_ms);
+void diram_prefetch_pool_destroy(diram_prefetch_pool_t* pool);
+
+// Allocate `size` bytes now and park them; 0 on success
+int diram_prefetch_pool_prefetch(diram_prefetch_pool_t* pool, size_t size, uint32_t phenotype);
+
+// Claim a parked zeroed block of at least `size` bytes, or NULL
+void* diram_prefetch_pool_take(diram_prefetch_pool_t* pool, size_t size);
+
+// Free unclaimed blocks, oldest first, until `bytes` are released
+// (SIZE_MAX empties the pool); returns the bytes freed
+size_t diram_prefetch_pool_reclaim(diram_prefetch_pool_t* pool, size_t bytes);
+
+void diram_prefetch_pool_get_stats(diram_prefetch_pool_t* pool, diram_prefetch_stats_t* out);
+
+#endif // DIRAM_PREFETCH_POOL_H
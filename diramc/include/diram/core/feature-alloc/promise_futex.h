@@ -0,0 +1,53 @@
+// include/diram/core/feature-alloc/promise_futex.h
+// OBINexus DIRAM Compact Promise
+// A 24-byte promise: one atomic state word that waiters futex-wait on, a
+// lock-free push list of continuations, and objects recycled through a
+// per-thread freelist. Creating, settling and awaiting a promise nobody
+// is blocked on makes no syscalls and, once the freelist is warm, no malloc.
+#ifndef DIRAM_PROMISE_FUTEX_H
+#define DIRAM_PROMISE_FUTEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef DIRAM_ERR_TIMEOUT
+#define DIRAM_ERR_TIMEOUT              0x100B
+#endif
+
+#define DIRAM_FPROMISE_FREELIST_MAX    256      // cached cells per thread
+
+typedef enum {
+    DIRAM_FPROMISE_PENDING = 0,
+    DIRAM_FPROMISE_RESOLVED = 1,
+    DIRAM_FPROMISE_REJECTED = 2
+} diram_fpromise_state_t;
+
+typedef struct diram_fpromise diram_fpromise_t;
+
+// Continuation: runs once on the settling thread, or inline if attached late
+typedef void (*diram_fpromise_fn)(diram_fpromise_t* promise, void* context);
+
+struct diram_fpromise {
+    uint32_t state;           // diram_fpromise_state_t plus settle/waiter bits
+    uint32_t reason;          // diram_reject_reason_t when rejected
+    void* value;              // allocation when resolved, static message when rejected
+    void* continuations;      // push list; closed once settled
+};
+
+// Lifecycle - release only once the promise has settled
+diram_fpromise_t* diram_fpromise_create(void);
+void diram_fpromise_release(diram_fpromise_t* promise);
+int diram_fpromise_reserve(size_t count);     // pre-warm the calling thread's freelist
+
+// Settlement - first caller wins; 0 settled, -1 already settled
+int diram_fpromise_resolve(diram_fpromise_t* promise, void* value);
+int diram_fpromise_reject(diram_fpromise_t* promise, uint32_t reason, const char* msg);
+
+// 0 resolved, -1 rejected, DIRAM_ERR_TIMEOUT
+int diram_fpromise_await(diram_fpromise_t* promise, uint64_t timeout_ms);
+diram_fpromise_state_t diram_fpromise_state(const diram_fpromise_t* promise);
+
+// 0 queued or already run, -1 no memory for the continuation
+int diram_fpromise_then(diram_fpromise_t* promise, diram_fpromise_fn fn, void* context);
+
+#endif // DIRAM_PROMISE_FUTEX_H
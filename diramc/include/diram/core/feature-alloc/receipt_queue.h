@@ -0,0 +1,58 @@
+// include/diram/core/feature-alloc/receipt_queue.h
+// OBINexus DIRAM Deferred Receipt Queue
+// receipt_mode=deferred moves SHA-256 receipts off the allocation path:
+// inputs go to a per-thread queue, a worker hashes them in batches and
+// back-fills sha256_receipt. diram_receipt_flush() is the audit barrier.
+#ifndef DIRAM_RECEIPT_QUEUE_H
+#define DIRAM_RECEIPT_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "diram/core/diram.h"
+
+#define DIRAM_RECEIPT_QUEUE_ENTRIES      1024     // per thread, power of two
+#define DIRAM_RECEIPT_BATCH              64       // digests per worker pass
+#define DIRAM_RECEIPT_WORKER_INTERVAL_US 500      // worker idle poll
+#define DIRAM_RECEIPT_TAG_LEN            64
+
+// Emit the ALLOC trace record once the receipt exists
+#define DIRAM_RECEIPT_FLAG_TRACE         0x1
+
+typedef enum {
+    DIRAM_RECEIPT_MODE_SYNC = 0,       // hash inline (default)
+    DIRAM_RECEIPT_MODE_DEFERRED        // queue, hash in batches
+} diram_receipt_mode_t;
+
+// Exact bytes hashed into a receipt; zero-filled so padding is stable
+typedef struct {
+    void* addr;
+    size_t size;
+    uint64_t timestamp;
+    char tag[DIRAM_RECEIPT_TAG_LEN];
+} diram_receipt_input_t;
+
+typedef struct {
+    uint64_t deferred;      // accepted into a queue
+    uint64_t queue_full;    // hashed inline because the queue was full
+    uint64_t batches;       // batch hash calls by the worker or a flush
+    uint64_t settled;       // claimed early by free/settle before the worker
+    uint32_t queues;
+} diram_receipt_stats_t;
+
+// Mode control - deferred starts the worker, sync flushes and stops it
+int diram_receipt_parse_mode(const char* value, diram_receipt_mode_t* mode);
+int diram_receipt_set_mode(diram_receipt_mode_t mode);
+diram_receipt_mode_t diram_receipt_get_mode(void);
+
+// Produce alloc->sha256_receipt now or later depending on the mode
+void diram_receipt_submit(diram_allocation_t* alloc, const char* tag, uint32_t flags);
+
+// Make this allocation's receipt final; required before reading or freeing it
+void diram_receipt_settle(diram_allocation_t* alloc);
+
+// Block until every receipt submitted before the call is back-filled
+void diram_receipt_flush(void);
+
+void diram_receipt_get_stats(diram_receipt_stats_t* out);
+
+#endif // DIRAM_RECEIPT_QUEUE_H
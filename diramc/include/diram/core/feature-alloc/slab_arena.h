@@ -0,0 +1,46 @@
+// include/diram/core/feature-alloc/slab_arena.h
+// OBINexus DIRAM Size-Class Slab Arena
+// Per-thread arenas serving header + payload from one cache-line-aligned block
+#ifndef DIRAM_SLAB_ARENA_H
+#define DIRAM_SLAB_ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_SLAB_CACHE_LINE      64
+#define DIRAM_SLAB_BLOCK_HEADER    128          // prefix + caller header, payload starts here
+#define DIRAM_SLAB_PREFIX_BYTES    8            // arena id / size class / magic
+#define DIRAM_SLAB_USER_HEADER     (DIRAM_SLAB_BLOCK_HEADER - DIRAM_SLAB_PREFIX_BYTES)
+#define DIRAM_SLAB_CLASS_COUNT     9            // 64 B .. 16 KiB payloads
+#define DIRAM_SLAB_MAX_PAYLOAD     (64u << (DIRAM_SLAB_CLASS_COUNT - 1))
+#define DIRAM_SLAB_CHUNK_BYTES     (1u << 20)   // mmap refill granularity
+#define DIRAM_SLAB_MAX_ARENAS      1024
+
+// Aggregated counters across every arena (live and orphaned)
+typedef struct {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t hits;              // served from a free list
+    uint64_t misses;            // free list empty, carved from a chunk
+    uint64_t large_allocs;      // above DIRAM_SLAB_MAX_PAYLOAD, one aligned heap call
+    uint64_t remote_frees;      // released by a thread other than the owner
+    uint64_t chunk_bytes;       // bytes mapped from the OS
+    uint64_t live_blocks;
+    uint64_t live_requested;    // payload bytes callers asked for
+    uint64_t live_reserved;     // block bytes backing them, header included
+    uint32_t arena_count;
+} diram_slab_stats_t;
+
+// Returns the caller header area (DIRAM_SLAB_USER_HEADER bytes, 8-byte aligned)
+// and stores the cache-line-aligned payload address in *payload. Payloads
+// above UINT32_MAX bytes are refused (NULL).
+void* diram_slab_alloc(size_t payload_size, void** payload);
+void diram_slab_free(void* header);
+size_t diram_slab_block_size(const void* header);
+
+// Statistics
+void diram_slab_get_stats(diram_slab_stats_t* out);
+double diram_slab_hit_rate(const diram_slab_stats_t* stats);
+double diram_slab_fragmentation(const diram_slab_stats_t* stats);
+
+#endif // DIRAM_SLAB_ARENA_H
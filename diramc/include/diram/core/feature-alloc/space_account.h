@@ -0,0 +1,41 @@
+// include/diram/core/feature-alloc/space_account.h
+// OBINexus DIRAM Memory Space Accounting
+// Per-CPU byte budgets reserved in chunks from one global counter.
+// Charging checks and takes quota in a single lock-free step; the limit
+// is never exceeded, while used-bytes reads are approximate within
+// diram_account_error_bound().
+#ifndef DIRAM_SPACE_ACCOUNT_H
+#define DIRAM_SPACE_ACCOUNT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_ACCOUNT_MAX_SLOTS   64               // per-CPU slots, power of two
+#define DIRAM_ACCOUNT_MIN_CHUNK   4096
+#define DIRAM_ACCOUNT_MAX_CHUNK   (4u << 20)
+
+typedef struct diram_space_account diram_space_account_t;
+
+typedef struct {
+    size_t limit;
+    size_t reserved;          // taken from the limit: charged + cached in slots
+    size_t used;              // approximate: reserved minus slot spare
+    size_t chunk;
+    uint64_t refills;         // slot budgets topped up from the global counter
+    uint64_t reclaims;        // spare pulled back from every slot near the limit
+    uint64_t failures;        // charges refused because the limit was reached
+    uint32_t slots;
+} diram_account_stats_t;
+
+diram_space_account_t* diram_account_create(size_t limit);
+void diram_account_destroy(diram_space_account_t* account);
+
+// 0 and charged, or -1 with nothing charged
+int diram_account_charge(diram_space_account_t* account, size_t bytes);
+void diram_account_release(diram_space_account_t* account, size_t bytes);
+
+size_t diram_account_used(const diram_space_account_t* account);
+size_t diram_account_error_bound(const diram_space_account_t* account);
+void diram_account_get_stats(const diram_space_account_t* account, diram_account_stats_t* out);
+
+#endif // DIRAM_SPACE_ACCOUNT_H
@@ -0,0 +1,78 @@
+// include/diram/core/feature-alloc/trace_log.h
+// OBINexus DIRAM Binary Trace Log
+// Per-thread lock-free rings of fixed-size records, drained by one writer thread
+#ifndef DIRAM_TRACE_LOG_H
+#define DIRAM_TRACE_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#define DIRAM_TRACE_BIN_MAGIC        "DIRAMTRC"
+#define DIRAM_TRACE_BIN_VERSION      1
+#define DIRAM_TRACE_RING_RECORDS     4096     // per thread, power of two
+#define DIRAM_TRACE_TAG_LEN          64
+#define DIRAM_TRACE_DRAIN_INTERVAL_US 1000    // writer idle poll
+
+typedef enum {
+    DIRAM_TRACE_EVENT_ALLOC = 1,
+    DIRAM_TRACE_EVENT_FREE  = 2
+} diram_trace_event_t;
+
+// On-disk record - 128 bytes, two cache lines
+typedef struct {
+    uint64_t timestamp;
+    uint64_t addr;
+    uint64_t size;
+    int32_t pid;
+    uint16_t event;
+    uint16_t flags;
+    uint8_t receipt[32];                // raw SHA-256, hex-encoded on decode
+    char tag[DIRAM_TRACE_TAG_LEN];      // NUL-terminated, truncated
+} diram_trace_record_t;
+
+// On-disk file header, followed by records until EOF
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t created;
+} diram_trace_file_header_t;
+
+typedef struct {
+    uint64_t records;       // accepted into a ring
+    uint64_t written;       // persisted by the writer
+    uint64_t batches;       // writev calls
+    uint64_t write_errors;  // failed batches, kept queued and retried
+    uint64_t dropped_bytes; // still queued when the log closed, never written
+    uint64_t full_waits;    // producer found its ring full and yielded
+    uint64_t refused;       // returned -1 because the log had closed
+    uint32_t rings;
+} diram_trace_stats_t;
+
+// Lifecycle - open starts the writer thread, close drains and joins it
+int diram_trace_open(const char* path);
+void diram_trace_close(void);
+int diram_trace_is_open(void);
+
+// Hot path - copies one record into the calling thread's ring, no syscalls.
+// Returns -1 once the log has closed; an accepted record is always written
+// or counted in dropped_bytes
+int diram_trace_record(diram_trace_event_t event,
+                       uint64_t timestamp,
+                       int32_t pid,
+                       const void* addr,
+                       size_t size,
+                       const char* receipt_hex,
+                       const char* tag);
+
+// Block until every record accepted before the call is on disk, or a
+// write fails (see write_errors)
+void diram_trace_flush(void);
+void diram_trace_get_stats(diram_trace_stats_t* out);
+
+// Decoding back to the ts|pid|EVENT|addr|size|receipt|tag text format
+int diram_trace_format_record(const diram_trace_record_t* record, char* buffer, size_t length);
+int diram_trace_decode_file(const char* path, FILE* out, int sort_by_time);
+
+#endif // DIRAM_TRACE_LOG_H
@@ -0,0 +1,58 @@
+// include/diram/core/governor/governor.h
+// OBINexus DIRAM Heap Event Governor
+// Continuous-refill token buckets (GCRA form: one theoretical-arrival-time
+// word per bucket) on a calibrated TSC clock. Replaces the per-second
+// heap event epoch, so there is no syscall per event and no cliff at
+// second boundaries.
+#ifndef DIRAM_GOVERNOR_H
+#define DIRAM_GOVERNOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_GOV_DEFAULT_THREAD_RATE   1000    // events per second
+#define DIRAM_GOV_DEFAULT_THREAD_BURST  1000    // events admitted back-to-back
+#define DIRAM_GOV_UNLIMITED             0       // rate 0 disables a bucket
+#define DIRAM_GOV_EPSILON_LIMIT         0.6     // Sinphasé ε ceiling, see over_limit
+
+typedef struct {
+    uint64_t tat_ns;          // theoretical arrival time of the next event
+    uint64_t interval_ns;     // 1e9 / rate; 0 = unlimited
+    uint64_t capacity_ns;     // burst * interval_ns
+    uint64_t admitted;
+    uint64_t throttled;
+} diram_gov_bucket_t;
+
+typedef struct {
+    uint64_t admitted;
+    uint64_t throttled;
+    uint32_t threads;
+    uint32_t over_limit;      // thread buckets above DIRAM_GOV_EPSILON_LIMIT
+    double max_epsilon;       // highest live thread bucket utilisation
+} diram_gov_stats_t;
+
+// Clock - TSC scaled to CLOCK_MONOTONIC nanoseconds, vDSO fallback
+uint64_t diram_gov_now_ns(void);
+const char* diram_gov_clock_source(void);
+
+// Buckets - admit is lock-free and safe on buckets shared between threads
+void diram_gov_bucket_init(diram_gov_bucket_t* bucket, uint32_t rate, uint32_t burst);
+int diram_gov_bucket_admit(diram_gov_bucket_t* bucket, uint64_t now_ns, uint32_t cost);
+double diram_gov_bucket_epsilon(const diram_gov_bucket_t* bucket, uint64_t now_ns);
+
+// Per-thread limits - configure sets the default every thread follows,
+// set_thread_limit overrides it for the calling thread only
+void diram_gov_configure_thread(uint32_t rate, uint32_t burst);
+void diram_gov_configure_space(uint32_t rate, uint32_t burst);
+void diram_gov_space_defaults(uint32_t* rate, uint32_t* burst);
+int diram_gov_set_thread_limit(uint32_t rate, uint32_t burst);
+
+// Hot path - charge one event to the calling thread; 0 admitted, -1 throttled
+int diram_gov_admit_thread(uint64_t now_ns);
+// Lifetime total of events admitted to the calling thread, not a rate;
+// a thread reusing an exited thread's state starts again from zero
+uint64_t diram_gov_thread_events(void);
+
+void diram_gov_get_stats(diram_gov_stats_t* out);
+
+#endif // DIRAM_GOVERNOR_H
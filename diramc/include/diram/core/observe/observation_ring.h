@@ -0,0 +1,102 @@
+// include/diram/core/observe/observation_ring.h
+// OBINexus DIRAM Observation Ring
+// Every phenotype diram_observe produces lands in a fixed ring that
+// overwrites its oldest entries, so recent history is never lost to a
+// full buffer. Each recording thread owns a shard of the ring, so
+// recording is two plain stores with no locked instruction. Per-field
+// EWMAs and histograms are folded from the shards in batches, by whichever
+// recorder crosses a half-shard boundary or by a reader asking for a
+// summary, so consumers read a constant-size summary instead of scanning
+// raw history. A recorder that finds another fold running folds its own
+// shard aside rather than letting it be lapped.
+#ifndef DIRAM_OBSERVATION_RING_H
+#define DIRAM_OBSERVATION_RING_H
+
+#include <stdint.h>
+#include <pthread.h>
+#include "diram/core/diram_phenomenological.h"
+
+#define DIRAM_OBS_RING_DEFAULT   1024       // slots per shard; rounded up to a power of two
+#define DIRAM_OBS_MAX_SHARDS     64         // later threads share one overflow shard
+#define DIRAM_OBS_FIELDS         12
+#define DIRAM_OBS_BUCKETS        8          // widest field is 3 bits
+#define DIRAM_OBS_EWMA_SHIFT     6          // alpha = 1/64
+
+// phenotype_t fields in declaration order
+typedef enum {
+    DIRAM_OBS_AGE, DIRAM_OBS_FREQUENCY, DIRAM_OBS_VOLATILITY,
+    DIRAM_OBS_LOCALITY, DIRAM_OBS_CLUSTERING, DIRAM_OBS_SPREAD,
+    DIRAM_OBS_INTENT, DIRAM_OBS_DEPENDENCY, DIRAM_OBS_NECESSITY,
+    DIRAM_OBS_AUTHORITY, DIRAM_OBS_COMPLIANCE, DIRAM_OBS_AUDIT
+} diram_obs_field_t;
+
+typedef struct {
+    uint64_t recorded;          // every observation ever made
+    uint64_t folded;            // reflected in the aggregates below
+    uint64_t dropped;           // overwritten before they could be folded
+    uint32_t shards;
+    phenotype_t last;           // last folded
+    float ewma[DIRAM_OBS_FIELDS];
+    uint64_t histogram[DIRAM_OBS_FIELDS][DIRAM_OBS_BUCKETS];
+} diram_obs_summary_t;
+
+// Slots hold (position + 1) << 32 | phenotype, one 64-bit store each
+typedef struct diram_obs_shard {
+    uint64_t head __attribute__((aligned(64)));     // written by the owner only
+    uint64_t fold_next __attribute__((aligned(64)));
+    struct diram_obs_shard* next;
+    pthread_t owner;
+    bool shared;                                    // overflow shard, claimed by fetch_add
+
+    // Behind fold_busy. A recorder that finds the ring's fold_lock taken
+    // folds its own shard here instead, and the next ring fold merges it
+    uint32_t fold_busy;
+    uint32_t spill_last;
+    uint64_t spilled;
+    uint64_t spill_dropped;
+    int32_t spill_ewma[DIRAM_OBS_FIELDS];           // EWMA of the spilled run, started at 0
+    uint64_t spill_histogram[4][256];
+    uint64_t slots[];
+} diram_obs_shard_t;
+
+typedef struct diram_obs_ring {
+    uint64_t id;                // distinguishes a ring reusing a freed address
+    uint64_t mask;
+    uint64_t fold_every;
+
+    pthread_mutex_t shard_lock;
+    diram_obs_shard_t* shards;  // push-only list
+    uint32_t shard_count;
+
+    // Fold state, behind fold_lock. Histograms are kept per phenotype byte
+    // (one increment per byte instead of one per field) and split into
+    // fields when a summary is taken
+    uint32_t fold_lock __attribute__((aligned(64)));
+    uint64_t folded;
+    uint64_t dropped;
+    uint32_t last;
+    int32_t ewma_fixed[DIRAM_OBS_FIELDS];           // value << 16
+    uint64_t byte_histogram[4][256];
+} diram_obs_ring_t;
+
+// 0 selects DIRAM_OBS_RING_DEFAULT
+diram_obs_ring_t* diram_obs_ring_create(uint32_t capacity);
+
+// No thread may still be recording
+void diram_obs_ring_destroy(diram_obs_ring_t* ring);
+
+// Any thread. No locked instruction except at a half-shard boundary, where
+// it yields only while a fold is inside its own shard
+void diram_obs_ring_record(diram_obs_ring_t* ring, phenotype_t observed);
+
+// Copy up to `max` of the most recent observations, oldest first within
+// each recording thread; returns how many were copied
+uint32_t diram_obs_ring_recent(diram_obs_ring_t* ring, phenotype_t* out, uint32_t max);
+
+// Fold whatever is pending and copy the aggregates; 0 or -1
+int diram_obs_ring_summary(diram_obs_ring_t* ring, diram_obs_summary_t* out);
+
+// Field value as stored in phenotype_t
+uint32_t diram_obs_field(phenotype_t p, diram_obs_field_t field);
+
+#endif // DIRAM_OBSERVATION_RING_H
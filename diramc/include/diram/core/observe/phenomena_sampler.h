@@ -0,0 +1,78 @@
+// include/diram/core/observe/phenomena_sampler.h
+// OBINexus DIRAM Phenomena Sampler
+// Derives the temporal and spatial phenotype fields of tracked regions
+// from what the kernel knows about their pages, instead of from
+// placeholders. A background thread walks every region once per interval:
+//   mincore     - which pages are resident
+//   pagemap     - present/swapped bits and, with CAP_SYS_ADMIN, PFNs
+//   soft-dirty  - which pages were written since the last pass
+//   idle pages  - which pages were touched since the last pass (needs PFNs)
+// and publishes one small sample per region. diram_observe only reads the
+// published sample; it never touches the kernel interfaces itself.
+//
+// Soft-dirty bits are cleared for the whole process after each pass,
+// which write-faults every page the process touches next, so the source
+// is opt-in and held by at most one sampler per process at a time; later
+// samplers asking for it go without.
+#ifndef DIRAM_PHENOMENA_SAMPLER_H
+#define DIRAM_PHENOMENA_SAMPLER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "diram/core/diram_phenomenological.h"
+
+#define DIRAM_SAMPLER_INTERVAL_MS   100
+#define DIRAM_SAMPLER_MAX_REGIONS   256
+#define DIRAM_SAMPLER_MIN_REGION    4096        // smaller allocations share pages
+
+// Signal sources; those the kernel or our privileges do not provide are
+// dropped at create and the rest fall back around them
+#define DIRAM_SAMPLE_MINCORE        0x1u
+#define DIRAM_SAMPLE_PAGEMAP        0x2u
+#define DIRAM_SAMPLE_SOFT_DIRTY     0x4u
+#define DIRAM_SAMPLE_IDLE_PAGE      0x8u
+#define DIRAM_SAMPLE_ALL            0xFu
+#define DIRAM_SAMPLE_DEFAULT        (DIRAM_SAMPLE_ALL & ~DIRAM_SAMPLE_SOFT_DIRTY)
+
+// Phenotype fields a sample fills in; the rest of phenomena.raw is zero
+#define DIRAM_SAMPLE_FIELD_MASK     0xFFFFu
+
+typedef struct {
+    uint32_t interval_ms;       // between passes
+    uint32_t sources;           // wanted DIRAM_SAMPLE_* bits
+} diram_sampler_config_t;
+
+typedef struct {
+    phenotype_t phenomena;      // age, frequency, volatility, locality, clustering, spread
+    uint32_t pages;
+    uint32_t resident;
+    uint32_t accessed;          // since the previous pass
+    uint32_t dirtied;           // since the previous pass
+    uint64_t pass;              // 0 until the region has been sampled
+} diram_region_sample_t;
+
+typedef struct diram_sampler diram_sampler_t;
+
+// NULL config means DIRAM_SAMPLER_INTERVAL_MS and DIRAM_SAMPLE_DEFAULT
+diram_sampler_t* diram_sampler_create(const diram_sampler_config_t* config);
+void diram_sampler_destroy(diram_sampler_t* sampler);
+
+// DIRAM_SAMPLE_* bits actually in use
+uint32_t diram_sampler_sources(diram_sampler_t* sampler);
+
+// Page-rounded; 0, or -1 when the table is full
+int diram_sampler_track(diram_sampler_t* sampler, const void* base, size_t size);
+void diram_sampler_untrack(diram_sampler_t* sampler, const void* base);
+
+// Latest sample of the region containing addr; 0, or -1 when untracked
+// or not yet sampled. Lock-free
+int diram_sampler_lookup(diram_sampler_t* sampler, const void* addr, diram_region_sample_t* out);
+
+// One pass on the calling thread
+void diram_sampler_sample(diram_sampler_t* sampler);
+
+// Background thread sampling every interval_ms
+int diram_sampler_start(diram_sampler_t* sampler);
+void diram_sampler_stop(diram_sampler_t* sampler);
+
+#endif // DIRAM_PHENOMENA_SAMPLER_H
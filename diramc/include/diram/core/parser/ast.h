@@ -139,6 +139,8 @@ struct diram_ast_visitor {
 };
 
 // AST Node Creation
+// Each node is its own allocation and owns every string it points to;
+// diram_ast_destroy_node releases the node, its strings and its subtree
 diram_ast_node_t* diram_ast_create_node(diram_ast_node_type_t type);
 void diram_ast_destroy_node(diram_ast_node_t* node);
 
@@ -165,4 +167,118 @@ void diram_ast_print(diram_ast_node_t* node, int depth);
 bool diram_ast_validate(diram_ast_node_t* node);
 size_t diram_ast_count_nodes(diram_ast_node_t* root);
 
+// ============================================================================
+// AST Arena - compact encoding for whole-manifest parses
+// ============================================================================
+// Nodes live in one array and refer to each other by index; a node's
+// children are the range [first_child, first_child + child_count) of the
+// arena's child list, filled in when the node is closed. Strings are
+// interned once in a shared table. Releasing a parse is one
+// diram_ast_arena_destroy (or _reset to reuse the storage).
+
+typedef uint32_t diram_ast_ref_t;       // Node index
+typedef uint32_t diram_ast_str_t;       // String table offset; 0 is ""
+
+#define DIRAM_AST_NONE          UINT32_MAX
+#define DIRAM_AST_PROTECTION    0x07    // Memory region r=4, w=2, x=1
+#define DIRAM_AST_ENABLED       0x08    // Feature enabled / policy enforced
+
+// 48 bytes. Field use by type:
+//   allocation     value=size  extent=address  text=tag  aux=sha256 receipt
+//   opcode         code
+//   constraint     value=epsilon (double bits)  extent=max heap events
+//   policy         text=type  value,extent=rule range in the string list
+//   feature        text=description  extra=policy
+//   memory region  value=base  extent=size
+//   operand        code=position  text=type  value=integer value
+//   build target   text=platform  extra=compiler  aux=flags
+typedef struct {
+    uint8_t type;               // diram_ast_node_type_t
+    uint8_t flags;              // DIRAM_AST_PROTECTION | DIRAM_AST_ENABLED
+    uint16_t code;
+    diram_ast_str_t name;
+    diram_ast_str_t text;
+    diram_ast_str_t extra;
+    diram_ast_str_t aux;
+    diram_ast_ref_t parent;
+    uint32_t first_child;
+    uint32_t child_count;
+    uint64_t value;
+    uint64_t extent;
+} diram_ast_compact_t;
+
+typedef struct {
+    diram_ast_ref_t node;
+    uint32_t pending_base;      // Its children start here in `pending`
+} diram_ast_open_t;
+
+typedef struct {
+    diram_ast_compact_t* nodes;
+    uint32_t node_count;
+    uint32_t node_capacity;
+
+    diram_ast_ref_t* children;  // Closed child ranges, back to back
+    uint32_t child_count;
+    uint32_t child_capacity;
+
+    diram_ast_str_t* lists;     // String lists (policy rules)
+    uint32_t list_count;
+    uint32_t list_capacity;
+
+    char* strings;              // NUL-terminated, interned
+    uint32_t string_length;
+    uint32_t string_capacity;
+    uint64_t* intern;           // Open addressing: hash << 32 | offset
+    uint32_t intern_count;
+    uint32_t intern_capacity;
+
+    // Builder state: open nodes, and the children collected for them
+    diram_ast_open_t* open;
+    uint32_t open_depth;
+    uint32_t open_capacity;
+    diram_ast_ref_t* pending;
+    uint32_t pending_count;
+    uint32_t pending_capacity;
+
+    const char** scratch;       // Rule pointers for diram_ast_arena_accept
+    uint32_t scratch_capacity;
+} diram_ast_arena_t;
+
+// Arena fill levels; rewinding to a mark drops everything added since
+typedef struct {
+    uint32_t nodes;
+    uint32_t children;
+    uint32_t lists;
+    uint32_t strings;
+    uint32_t pending;
+} diram_ast_mark_t;
+
+diram_ast_arena_t* diram_ast_arena_create(size_t node_hint);
+void diram_ast_arena_destroy(diram_ast_arena_t* arena);
+void diram_ast_arena_reset(diram_ast_arena_t* arena);
+diram_ast_mark_t diram_ast_arena_mark(const diram_ast_arena_t* arena);
+// Only valid once every node opened after the mark has been closed
+void diram_ast_arena_rewind(diram_ast_arena_t* arena, diram_ast_mark_t mark);
+
+// Strings
+diram_ast_str_t diram_ast_arena_intern(diram_ast_arena_t* arena, const char* text, size_t length);
+const char* diram_ast_arena_string(const diram_ast_arena_t* arena, diram_ast_str_t str);
+
+// Building: open a node as the next child of the innermost open node (the
+// first node opened is the root), fill it in, then close it. Node pointers
+// are only valid until the next open.
+diram_ast_ref_t diram_ast_arena_open(diram_ast_arena_t* arena, diram_ast_node_type_t type);
+bool diram_ast_arena_close(diram_ast_arena_t* arena);
+bool diram_ast_arena_add_rule(diram_ast_arena_t* arena, diram_ast_ref_t policy, diram_ast_str_t rule);
+diram_ast_compact_t* diram_ast_arena_node(const diram_ast_arena_t* arena, diram_ast_ref_t ref);
+
+// Traversal
+const diram_ast_ref_t* diram_ast_arena_children(const diram_ast_arena_t* arena,
+                                                diram_ast_ref_t ref, uint32_t* count);
+// Visit `ref` and its subtree in pre-order through the classic visitor; each
+// call sees a diram_ast_node_t view with data filled in and no child pointers
+void* diram_ast_arena_accept(diram_ast_arena_t* arena, diram_ast_ref_t ref,
+                             diram_ast_visitor_t* visitor);
+size_t diram_ast_arena_bytes(const diram_ast_arena_t* arena);
+
 #endif // DIRAM_AST_H
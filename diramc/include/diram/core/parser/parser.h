@@ -23,18 +23,56 @@ typedef enum {
     PARSER_STATE_COMPLETE
 } diram_parser_state_t;
 
+#define DIRAM_PARSER_MAX_DEPTH  32
+
+// What the text of the innermost element is for
+typedef enum {
+    PARSER_FIELD_NONE,
+    PARSER_FIELD_SKIP,              // Unknown subtree, ignored in lenient mode
+    PARSER_FIELD_DESCRIPTION,
+    PARSER_FIELD_POLICY,
+    PARSER_FIELD_CONSTRAINT,        // name=value
+    PARSER_FIELD_RULE,
+    PARSER_FIELD_COMPILER,
+    PARSER_FIELD_FLAGS
+} diram_parser_field_t;
+
+// One open element; names are kept as hashes because a streaming
+// tokenizer may have dropped the start tag by the time the end tag arrives
+typedef struct {
+    uint32_t name_hash;
+    uint16_t name_length;
+    uint16_t element;               // Manifest element id, 0 if unknown
+    diram_ast_ref_t node;           // Node this element opened, or DIRAM_AST_NONE
+    diram_parser_field_t field;
+    diram_parser_state_t resume;    // State to return to when it closes
+} diram_parser_frame_t;
+
 // Parser Context for Single-Pass Translation
 typedef struct {
     diram_tokenizer_t* tokenizer;      // Token source
     diram_parser_state_t state;        // Current state
-    diram_ast_node_t* root;           // AST root node
-    diram_ast_node_t* current_node;   // Current AST node being built
+    diram_ast_arena_t* arena;          // Nodes built so far
+    diram_ast_ref_t root;              // AST root node
+    diram_ast_ref_t current_node;      // Current AST node being built
     
     // Parser configuration
     bool strict_mode;                  // Enforce strict XML compliance
     bool validate_policies;            // Validate policy constraints
     bool emit_ast_immediately;         // Emit AST nodes without buffering
     
+    // Streaming: with emit_ast_immediately, each completed section item
+    // (toggle, opcode, policy, region, target) is visited and dropped
+    diram_ast_visitor_t* visitor;
+    diram_ast_mark_t stream_mark;      // Arena level with only the root
+    bool root_emitted;
+    uint64_t nodes_emitted;
+    
+    // Element nesting
+    diram_parser_frame_t frames[DIRAM_PARSER_MAX_DEPTH];
+    uint32_t depth;
+    uint32_t attribute;                // Id of the last attribute name
+    
     // Error tracking
     bool has_error;
     char error_message[512];
@@ -47,16 +85,22 @@ typedef struct {
 
 // Parser API - Single-Pass, Zero IR
 diram_parser_t* diram_parser_create(const char* xml_input, size_t length);
+diram_parser_t* diram_parser_open(const char* path);
+diram_parser_t* diram_parser_create_from_tokenizer(diram_tokenizer_t* tokenizer);   // takes ownership
 void diram_parser_destroy(diram_parser_t* parser);
+void diram_parser_set_visitor(diram_parser_t* parser, diram_ast_visitor_t* visitor);
 
-// Main parsing function - O(n) complexity, no backtracking
-diram_ast_node_t* diram_parser_parse(diram_parser_t* parser);
+// Main parsing function - O(n) complexity, no backtracking. Returns the
+// parser's arena with the root at parser->root, or NULL on error. When
+// streaming, the root is all that is left in it.
+diram_ast_arena_t* diram_parser_parse(diram_parser_t* parser);
 
 // State transitions (internal, but exposed for testing)
 bool diram_parser_transition(diram_parser_t* parser, diram_parser_state_t new_state);
 bool diram_parser_consume_token(diram_parser_t* parser, diram_token_t* token);
 
-// Direct AST emission - no intermediate representation
+// Direct AST emission - no intermediate representation; each adds a
+// finished leaf under the current node
 bool diram_parser_emit_feature_toggle(diram_parser_t* parser, const char* name, bool enabled);
 bool diram_parser_emit_opcode(diram_parser_t* parser, const char* name, uint8_t code);
 bool diram_parser_emit_policy(diram_parser_t* parser, const char* name, const char* type);
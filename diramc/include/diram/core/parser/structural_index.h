@@ -0,0 +1,45 @@
+// include/diram/core/parser/structural_index.h
+// DIRAM XML Structural Scanner
+// OBINexus Aegis Project
+// Stage one of tokenization: classify the input 64 bytes at a time into
+// one bitmask per character class, one bit per byte. The tokenizer walks
+// these masks with bit scans to find the next tag, quote, name delimiter
+// or newline instead of looping over bytes.
+// Runtime dispatch: AVX2 2x32 lanes, SSE4.2 4x16 lanes, portable scalar
+#ifndef DIRAM_STRUCTURAL_INDEX_H
+#define DIRAM_STRUCTURAL_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DIRAM_SCAN_BLOCK     64
+
+// Bit i describes byte i of the block
+typedef struct {
+    uint64_t lt;            // '<'
+    uint64_t quote;         // '"' and '\''
+    uint64_t delim;         // whitespace and < > = " ' / - everything that ends a name
+    uint64_t space;         // ' ' '\t' '\r' '\n'
+    uint64_t newline;       // '\n'
+} diram_scan_block_t;
+
+typedef enum {
+    DIRAM_SCAN_IMPL_AUTO = 0,
+    DIRAM_SCAN_IMPL_SCALAR,
+    DIRAM_SCAN_IMPL_SSE42,          // 4 x 16-byte compares per block
+    DIRAM_SCAN_IMPL_AVX2            // 2 x 32-byte compares per block
+} diram_scan_impl_t;
+
+// Classify `blocks` whole blocks of input into out[0..blocks)
+void diram_scan_blocks(const char* input, size_t blocks, diram_scan_block_t* out);
+
+// Classify a final block of fewer than 64 bytes; missing bytes match nothing
+void diram_scan_tail(const char* input, size_t length, diram_scan_block_t* out);
+
+// Dispatch control - AUTO picks the widest path the CPU supports
+int diram_scan_supported(diram_scan_impl_t impl);
+int diram_scan_force_impl(diram_scan_impl_t impl);
+diram_scan_impl_t diram_scan_active_impl(void);
+const char* diram_scan_impl_name(diram_scan_impl_t impl);
+
+#endif // DIRAM_STRUCTURAL_INDEX_H
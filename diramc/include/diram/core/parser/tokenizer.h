@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "structural_index.h"
 
 // Token Type Enumeration - Semantic role of token
 typedef enum {
@@ -56,6 +57,13 @@ typedef enum {
     MEMORY_VIRTUAL          // Virtual/unmapped memory
 } diram_token_memory_t;
 
+// Token text is never copied: it is a view of `length` bytes at stream
+// offset `offset`, resolved with diram_tokenizer_text
+typedef struct {
+    uint64_t offset;
+    uint32_t length;
+} diram_token_view_t;
+
 // Three-Layer Token Structure
 typedef struct {
     // Layer 1: Token Type - Semantic role
@@ -67,12 +75,8 @@ typedef struct {
     // Layer 3: Token Value - Actual content
     union {
         uint64_t integer_value;
-        void* pointer_value;
         bool boolean_value;
-        struct {
-            char* data;
-            size_t length;
-        } string_value;
+        diram_token_view_t text;        // names, attribute values, character data
         struct {
             uint64_t base;
             size_t size;
@@ -82,29 +86,58 @@ typedef struct {
     // Metadata
     uint32_t line;
     uint32_t column;
-    char* source_file;
 } diram_token_t;
 
 // Tokenizer State Machine
 typedef struct {
-    const char* input;          // Input XML buffer
-    size_t length;              // Input length
-    size_t position;            // Current position
-    uint32_t line;              // Current line number
-    uint32_t column;            // Current column number
+    const char* input;          // Mapping, caller buffer or stream window
+    size_t length;              // Bytes of input available
+    size_t position;            // Current position within input
+    uint64_t input_offset;      // Stream offset of input[0]
+    uint32_t line;              // Line containing stream offset lines_to
+    uint32_t column;            // Column of the last token
+    uint64_t line_start;        // Stream offset where that line starts
+    uint64_t lines_to;          // Newlines counted up to this stream offset
     
     // State tracking
-    bool in_element;
-    bool in_attribute;
-    bool in_text;
+    bool in_element;            // Inside a start tag
+    bool in_attribute;          // Attribute name returned, value next
+    diram_token_view_t element; // Name of the open start tag
+    
+    // Input source
+    int fd;                     // Streaming source, -1 when fully in memory
+    bool owns_fd;               // Opened by diram_tokenizer_open
+    char* window;               // Streaming buffer; holds the token being scanned
+    size_t window_capacity;
+    size_t chunk_size;
+    bool at_eof;
+    void* mapping;
+    size_t mapping_length;
+    
+    // Structural index: masks for the 64-byte blocks from index_offset on,
+    // classified a batch ahead of the scan and dropped once behind it
+    diram_scan_block_t* index;
+    size_t index_count;
+    size_t index_capacity;
+    uint64_t index_offset;      // Stream offset of index[0], block aligned
     
     // Error handling
     char error_buffer[256];
     bool has_error;
 } diram_tokenizer_t;
 
+#define DIRAM_TOKENIZER_CHUNK   (64 * 1024)
+#define DIRAM_TOKENIZER_BATCH   256             // blocks classified per index refill
+
 // Tokenizer API
+// Borrows `input`, which must outlive the tokenizer
 diram_tokenizer_t* diram_tokenizer_create(const char* input, size_t length);
+// Maps the file read-only; anything that cannot be mapped (pipes,
+// character devices) is read in chunks instead
+diram_tokenizer_t* diram_tokenizer_open(const char* path);
+// Reads `fd` in chunks of `chunk_size` (0 for DIRAM_TOKENIZER_CHUNK); the
+// caller keeps ownership of fd
+diram_tokenizer_t* diram_tokenizer_create_stream(int fd, size_t chunk_size);
 void diram_tokenizer_destroy(diram_tokenizer_t* tokenizer);
 
 // Single-pass tokenization
@@ -112,14 +145,19 @@ diram_token_t diram_tokenizer_next(diram_tokenizer_t* tokenizer);
 bool diram_tokenizer_has_error(const diram_tokenizer_t* tokenizer);
 const char* diram_tokenizer_get_error(const diram_tokenizer_t* tokenizer);
 
+// First byte of a token's text (value.text.length bytes, not terminated).
+// Valid until destroy for mapped and borrowed input, and until the next
+// diram_tokenizer_next for streams
+const char* diram_tokenizer_text(const diram_tokenizer_t* tokenizer, const diram_token_t* token);
+
 // Token utilities
 const char* diram_token_type_to_string(diram_token_type_t type);
 const char* diram_token_memory_to_string(diram_token_memory_t memory);
-void diram_token_free(diram_token_t* token);
+void diram_token_free(diram_token_t* token);    // tokens own nothing; kept for callers
 
-// XML-specific tokenization helpers
-bool diram_tokenizer_is_element_name(const char* name);
-bool diram_tokenizer_is_attribute_name(const char* name);
-diram_token_memory_t diram_tokenizer_classify_memory(const char* region_name);
+// XML-specific tokenization helpers; names are views, not terminated
+bool diram_tokenizer_is_element_name(const char* name, size_t length);
+bool diram_tokenizer_is_attribute_name(const char* name, size_t length);
+diram_token_memory_t diram_tokenizer_classify_memory(const char* region_name, size_t length);
 
 #endif // DIRAM_TOKENIZER_H
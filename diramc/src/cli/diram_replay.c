@@ -0,0 +1,217 @@
+// src/cli/diram_replay.c
+// diram-replay - replay a recorded trace log through the phenomenon predictor
+// and report how often the predicted (phenotype, size) matched the next allocation
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "diram/core/feature-alloc/trace_log.h"
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+
+#define REPLAY_CONFIDENCE_BUCKETS 5
+
+// diram.h owns the default path but clashes with the phenomenological types
+#ifndef DIRAM_TRACE_BIN_LOG_PATH
+#define DIRAM_TRACE_BIN_LOG_PATH "/var/log/diram/trace.bin"
+#endif
+
+static struct option long_options[] = {
+    {"order", required_argument, 0, 'k'},
+    {"threshold", required_argument, 0, 't'},
+    {"help", no_argument, 0, 'h'},
+    {0, 0, 0, 0}
+};
+
+typedef struct {
+    uint64_t allocations;
+    uint64_t predicted;         // a prediction was available
+    uint64_t confident;         // ... at or above the threshold
+    uint64_t confident_hits;
+    uint64_t hits;              // phenotype and size class matched
+    uint64_t phenotype_hits;
+    uint64_t size_covered;      // predicted size >= actual size
+    uint64_t baseline_hits;     // "same as last allocation"
+    uint64_t bucket_total[REPLAY_CONFIDENCE_BUCKETS];
+    uint64_t bucket_hits[REPLAY_CONFIDENCE_BUCKETS];
+    phenotype_t last_pheno;
+    uint64_t last_size;
+} replay_stats_t;
+
+static void print_usage(const char* progname) {
+    printf("diram-replay - phenomenon predictor accuracy on a DIRAM trace log\n\n");
+    printf("Usage: %s [OPTIONS] [TRACE_FILE]\n\n", progname);
+    printf("Options:\n");
+    printf("  -k, --order N           Markov context length (1-%d, default %d)\n",
+           DIRAM_PREDICTOR_MAX_ORDER, DIRAM_PREDICTOR_DEFAULT_ORDER);
+    printf("  -t, --threshold F       Confidence needed to prefetch (default 0.5)\n");
+    printf("  -h, --help              Show this help\n\n");
+    printf("Reads binary logs and the ts|pid|EVENT|addr|size|receipt|tag text format.\n");
+    printf("Default input: %s\n", DIRAM_TRACE_BIN_LOG_PATH);
+}
+
+// Traces carry no phenotype, so the tag stands in for the causal fields
+static phenotype_t phenotype_from_tag(const char* tag) {
+    uint32_t h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)tag; *p; p++) {
+        h = (h ^ *p) * 16777619u;
+    }
+    h ^= h >> 16;
+
+    phenotype_t pheno = {.raw = 0};
+    pheno.fields.intent = h & 0x7;
+    pheno.fields.dependency = (h >> 3) & 0x7;
+    pheno.fields.necessity = (h >> 6) & 0x3;
+    return pheno;
+}
+
+static uint32_t size_class(uint64_t size) {
+    return size > 1 ? 64 - (uint32_t)__builtin_clzll(size - 1) : 0;
+}
+
+static void replay_one(phenomenon_predictor_t* predictor, replay_stats_t* stats,
+                       float threshold, const char* tag, uint64_t size) {
+    phenotype_t pheno = phenotype_from_tag(tag);
+    uint32_t masked = pheno.raw & predictor->field_mask;
+    phenomenon_prediction_t prediction;
+
+    stats->allocations++;
+    if (stats->allocations > 1 && stats->last_pheno.raw == pheno.raw &&
+        size_class(stats->last_size) == size_class(size)) {
+        stats->baseline_hits++;
+    }
+
+    if (diram_predictor_predict(predictor, &prediction) == 0) {
+        int pheno_hit = prediction.phenotype.raw == masked;
+        int hit = pheno_hit && size_class(prediction.size) == size_class(size);
+        int bucket = (int)(prediction.confidence * REPLAY_CONFIDENCE_BUCKETS);
+        if (bucket >= REPLAY_CONFIDENCE_BUCKETS) bucket = REPLAY_CONFIDENCE_BUCKETS - 1;
+
+        stats->predicted++;
+        stats->phenotype_hits += pheno_hit;
+        stats->hits += hit;
+        stats->size_covered += pheno_hit && prediction.size >= size;
+        stats->bucket_total[bucket]++;
+        stats->bucket_hits[bucket] += hit;
+        if (prediction.confidence >= threshold) {
+            stats->confident++;
+            stats->confident_hits += hit;
+        }
+    }
+
+    diram_predictor_observe(predictor, pheno, size);
+    stats->last_pheno = pheno;
+    stats->last_size = size;
+}
+
+static int replay_binary(FILE* fp, phenomenon_predictor_t* predictor,
+                         replay_stats_t* stats, float threshold) {
+    diram_trace_file_header_t header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, DIRAM_TRACE_BIN_MAGIC, 8) != 0) {
+        return -1;
+    }
+    if (header.version != DIRAM_TRACE_BIN_VERSION ||
+        header.record_size != sizeof(diram_trace_record_t)) {
+        return -1;
+    }
+
+    diram_trace_record_t record;
+    while (fread(&record, sizeof(record), 1, fp) == 1) {
+        if (record.event != DIRAM_TRACE_EVENT_ALLOC) continue;
+        record.tag[DIRAM_TRACE_TAG_LEN - 1] = '\0';
+        replay_one(predictor, stats, threshold, record.tag, record.size);
+    }
+    return 0;
+}
+
+static int replay_text(FILE* fp, phenomenon_predictor_t* predictor,
+                       replay_stats_t* stats, float threshold) {
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        // ts|pid|EVENT|addr|size|receipt|tag
+        char* fields[7];
+        int n = 0;
+        char* save = NULL;
+        for (char* tok = strtok_r(line, "|", &save); tok && n < 7; tok = strtok_r(NULL, "|", &save)) {
+            fields[n++] = tok;
+        }
+        if (n < 7 || strcmp(fields[2], "ALLOC") != 0) continue;
+        replay_one(predictor, stats, threshold, fields[6], strtoull(fields[4], NULL, 10));
+    }
+    return 0;
+}
+
+static double percent(uint64_t part, uint64_t whole) {
+    return whole ? 100.0 * (double)part / (double)whole : 0.0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t order = DIRAM_PREDICTOR_DEFAULT_ORDER;
+    float threshold = 0.5f;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "k:t:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 'k':
+                order = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                threshold = strtof(optarg, NULL);
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (order < 1 || order > DIRAM_PREDICTOR_MAX_ORDER) {
+        fprintf(stderr, "Error: order must be between 1 and %d\n", DIRAM_PREDICTOR_MAX_ORDER);
+        return 1;
+    }
+
+    const char* input_path = optind < argc ? argv[optind] : DIRAM_TRACE_BIN_LOG_PATH;
+    FILE* fp = fopen(input_path, "rb");
+    if (!fp) {
+        perror(input_path);
+        return 1;
+    }
+
+    phenomenon_predictor_t predictor;
+    if (diram_predictor_init(&predictor, order, 0) != 0) {
+        fclose(fp);
+        return 1;
+    }
+
+    replay_stats_t stats = {0};
+    if (replay_binary(fp, &predictor, &stats, threshold) != 0) {
+        rewind(fp);
+        replay_text(fp, &predictor, &stats, threshold);
+    }
+    fclose(fp);
+    diram_predictor_destroy(&predictor);
+
+    printf("Replayed %llu allocations (order %u)\n",
+           (unsigned long long)stats.allocations, order);
+    printf("  predictions made:      %6.2f%%\n", percent(stats.predicted, stats.allocations));
+    printf("  exact (pheno + size):  %6.2f%%\n", percent(stats.hits, stats.predicted));
+    printf("  phenotype only:        %6.2f%%\n", percent(stats.phenotype_hits, stats.predicted));
+    printf("  prefetch size covered: %6.2f%%\n", percent(stats.size_covered, stats.predicted));
+    printf("  repeat-last baseline:  %6.2f%%\n", percent(stats.baseline_hits, stats.allocations));
+    printf("  at confidence >= %.2f: %6.2f%% of allocations, %6.2f%% correct\n", threshold,
+           percent(stats.confident, stats.allocations),
+           percent(stats.confident_hits, stats.confident));
+    printf("  calibration:\n");
+    for (int b = 0; b < REPLAY_CONFIDENCE_BUCKETS; b++) {
+        printf("    %.1f-%.1f  %8llu predictions  %6.2f%% correct\n",
+               (double)b / REPLAY_CONFIDENCE_BUCKETS, (double)(b + 1) / REPLAY_CONFIDENCE_BUCKETS,
+               (unsigned long long)stats.bucket_total[b],
+               percent(stats.bucket_hits[b], stats.bucket_total[b]));
+    }
+    return 0;
+}
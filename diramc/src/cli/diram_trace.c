@@ -0,0 +1,66 @@
+// src/cli/diram_trace.c
+// diram-trace - decode the binary DIRAM trace log to ts|pid|EVENT|addr|size|receipt|tag
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include "diram/core/diram.h"
+#include "diram/core/feature-alloc/trace_log.h"
+
+static struct option long_options[] = {
+    {"sort", no_argument, 0, 's'},
+    {"output", required_argument, 0, 'o'},
+    {"help", no_argument, 0, 'h'},
+    {0, 0, 0, 0}
+};
+
+static void print_usage(const char* progname) {
+    printf("diram-trace - DIRAM binary trace log decoder\n\n");
+    printf("Usage: %s [OPTIONS] [TRACE_FILE]\n\n", progname);
+    printf("Options:\n");
+    printf("  -s, --sort              Order records by timestamp across threads\n");
+    printf("  -o, --output PATH       Write text log to PATH instead of stdout\n");
+    printf("  -h, --help              Show this help\n\n");
+    printf("Default input: %s\n", DIRAM_TRACE_BIN_LOG_PATH);
+}
+
+int main(int argc, char** argv) {
+    int sort_by_time = 0;
+    const char* output_path = NULL;
+    int opt;
+
+    while ((opt = getopt_long(argc, argv, "so:h", long_options, NULL)) != -1) {
+        switch (opt) {
+            case 's':
+                sort_by_time = 1;
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    const char* input_path = optind < argc ? argv[optind] : DIRAM_TRACE_BIN_LOG_PATH;
+
+    FILE* out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "w");
+        if (!out) {
+            perror(output_path);
+            return 1;
+        }
+    }
+
+    int rc = diram_trace_decode_file(input_path, out, sort_by_time);
+    if (rc != 0) {
+        fprintf(stderr, "Error: %s is not a DIRAM binary trace log\n", input_path);
+    }
+
+    if (out != stdout) fclose(out);
+    return rc == 0 ? 0 : 1;
+}
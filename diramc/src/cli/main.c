@@ -240,6 +240,11 @@ int main(int argc, char** argv) {
         }
     }
     
+    // Load the config hierarchy and apply it before anything allocates
+    if (diram_bootstrap_init() != 0) {
+        fprintf(stderr, "[CONFIG] Some settings could not be applied\n");
+    }
+    
     // Start monitoring thread if in detach mode
     pthread_t monitor_thread;
     if (ctx.detach_mode) {
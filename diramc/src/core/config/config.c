@@ -3,8 +3,14 @@
 // OBINexus Project - Unified configuration management
 
 #include "diram/core/config/config.h"
+#include "diram/core/config/config_cache.h"
+#include "diram/core/feature-alloc/receipt_queue.h"
+#include "diram/core/feature-alloc/async_executor.h"
+#include "diram/core/feature-alloc/lookahead_cache.h"
+#include "diram/core/governor/governor.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <errno.h>
 #include <ctype.h>
@@ -16,6 +22,63 @@ diram_config_t g_diram_config = {0};
 // Error buffer for validation
 static char g_config_error_buffer[1024] = {0};
 
+#define CONFIG_KEY(name, type, field) \
+    { name, type, offsetof(diram_config_t, field), sizeof(((diram_config_t*)0)->field) }
+
+// Every settable key and the field it parses into
+static const config_key_t g_config_keys[] = {
+    CONFIG_KEY(CFG_MEMORY_LIMIT, CONFIG_TYPE_SIZE, memory_limit),
+    CONFIG_KEY(CFG_MEMORY_SPACE, CONFIG_TYPE_STRING, memory_space),
+    CONFIG_KEY(CFG_TRACE, CONFIG_TYPE_BOOL, trace_enabled),
+    CONFIG_KEY(CFG_RECEIPT_MODE, CONFIG_TYPE_RECEIPT_MODE, receipt_mode),
+    CONFIG_KEY(CFG_LOG_DIR, CONFIG_TYPE_STRING, log_dir),
+    CONFIG_KEY(CFG_MAX_HEAP_EVENTS, CONFIG_TYPE_INT, max_heap_events),
+    CONFIG_KEY(CFG_DETACH_TIMEOUT, CONFIG_TYPE_INT, detach_timeout),
+    CONFIG_KEY(CFG_PID_BINDING, CONFIG_TYPE_STRING, pid_binding),
+    CONFIG_KEY(CFG_GUARD_PAGES, CONFIG_TYPE_BOOL, guard_pages),
+    CONFIG_KEY(CFG_CANARY_VALUES, CONFIG_TYPE_BOOL, canary_values),
+    CONFIG_KEY(CFG_ASLR_ENABLED, CONFIG_TYPE_BOOL, aslr_enabled),
+    CONFIG_KEY(CFG_TELEMETRY_LEVEL, CONFIG_TYPE_INT, telemetry_level),
+    CONFIG_KEY(CFG_TELEMETRY_ENDPOINT, CONFIG_TYPE_STRING, telemetry_endpoint),
+    CONFIG_KEY(CFG_ZERO_TRUST, CONFIG_TYPE_BOOL, zero_trust),
+    CONFIG_KEY(CFG_MEMORY_AUDIT, CONFIG_TYPE_BOOL, memory_audit),
+    
+    CONFIG_KEY(CFG_ASYNC_ENABLE_PROMISES, CONFIG_TYPE_BOOL, enable_promises),
+    CONFIG_KEY(CFG_ASYNC_DEFAULT_TIMEOUT_MS, CONFIG_TYPE_INT, default_timeout_ms),
+    CONFIG_KEY(CFG_ASYNC_MAX_PENDING_PROMISES, CONFIG_TYPE_INT, max_pending_promises),
+    CONFIG_KEY(CFG_ASYNC_LOOKAHEAD_CACHE_SIZE, CONFIG_TYPE_INT, lookahead_cache_size),
+    CONFIG_KEY(CFG_ASYNC_EXECUTOR_THREADS, CONFIG_TYPE_INT, executor_threads),
+    
+    CONFIG_KEY(CFG_DETACH_ENABLE_MODE, CONFIG_TYPE_BOOL, enable_detach_mode),
+    CONFIG_KEY(CFG_DETACH_LOG_ASYNC_OPS, CONFIG_TYPE_BOOL, log_async_operations),
+    CONFIG_KEY(CFG_DETACH_PERSIST_RECEIPTS, CONFIG_TYPE_BOOL, persist_promise_receipts),
+    
+    CONFIG_KEY(CFG_GOV_THREAD_RATE, CONFIG_TYPE_INT, gov_thread_rate),
+    CONFIG_KEY(CFG_GOV_THREAD_BURST, CONFIG_TYPE_INT, gov_thread_burst),
+    CONFIG_KEY(CFG_GOV_SPACE_RATE, CONFIG_TYPE_INT, gov_space_rate),
+    CONFIG_KEY(CFG_GOV_SPACE_BURST, CONFIG_TYPE_INT, gov_space_burst),
+    
+    CONFIG_KEY(CFG_RESIL_RETRY_TRANSIENT, CONFIG_TYPE_BOOL, retry_on_transient_failure),
+    CONFIG_KEY(CFG_RESIL_MAX_RETRY, CONFIG_TYPE_INT, max_retry_attempts),
+    CONFIG_KEY(CFG_RESIL_EXP_BACKOFF, CONFIG_TYPE_BOOL, exponential_backoff),
+};
+
+#define CONFIG_KEY_COUNT    (sizeof(g_config_keys) / sizeof(g_config_keys[0]))
+#define CONFIG_INDEX_SLOTS  256     // 8x the keys: a perfect seed is found in a few tries
+
+_Static_assert(CONFIG_KEY_COUNT <= 64,
+               "g_config_loaded and the cache keep one bit per key in a uint64_t");
+_Static_assert(CONFIG_KEY_COUNT < CONFIG_INDEX_SLOTS &&
+               CONFIG_KEY_COUNT <= UINT8_MAX,
+               "index slots hold key index + 1 in a uint8_t, 0 = empty");
+
+// Perfect hash over g_config_keys; slots may point into a mapped cache
+static uint8_t g_config_slots[CONFIG_INDEX_SLOTS];
+static config_index_t g_config_index = {0};
+
+// Keys set since the last hierarchy load, compiled into the cache
+static uint64_t g_config_loaded = 0;
+
 // Internal helper to get home directory
 static const char* get_home_dir(void) {
     const char* home = getenv("HOME");
@@ -34,6 +97,7 @@ int diram_config_init(void) {
     g_diram_config.memory_limit = DIRAM_DEFAULT_MEMORY_LIMIT;
     strncpy(g_diram_config.memory_space, "default", 63);
     g_diram_config.trace_enabled = false;
+    g_diram_config.receipt_mode = DIRAM_RECEIPT_MODE_SYNC;
     strncpy(g_diram_config.log_dir, "logs", PATH_MAX - 1);
     g_diram_config.max_heap_events = DIRAM_DEFAULT_MAX_HEAP_EVENTS;
     g_diram_config.detach_timeout = 30;
@@ -50,6 +114,7 @@ int diram_config_init(void) {
     g_diram_config.enable_promises = true;
     g_diram_config.default_timeout_ms = 10000;
     g_diram_config.max_pending_promises = 100;
+    g_diram_config.executor_threads = 0;
     g_diram_config.lookahead_cache_size = 1024;
     
     // Detach defaults
@@ -57,6 +122,12 @@ int diram_config_init(void) {
     g_diram_config.log_async_operations = true;
     g_diram_config.persist_promise_receipts = true;
     
+    // Governor defaults
+    g_diram_config.gov_thread_rate = DIRAM_GOV_DEFAULT_THREAD_RATE;
+    g_diram_config.gov_thread_burst = DIRAM_GOV_DEFAULT_THREAD_BURST;
+    g_diram_config.gov_space_rate = DIRAM_GOV_UNLIMITED;
+    g_diram_config.gov_space_burst = 0;
+    
     // Resilience defaults
     g_diram_config.retry_on_transient_failure = true;
     g_diram_config.max_retry_attempts = 3;
@@ -105,6 +176,90 @@ bool diram_config_parse_bool(const char* bool_str) {
     return false;
 }
 
+// Key table access
+size_t diram_config_key_count(void) {
+    return CONFIG_KEY_COUNT;
+}
+
+const config_key_t* diram_config_key(size_t index) {
+    return index < CONFIG_KEY_COUNT ? &g_config_keys[index] : NULL;
+}
+
+// FNV-1a with a seeded basis and a final avalanche
+uint32_t diram_config_key_hash(const char* key, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    while (*key) {
+        hash = (hash ^ (uint8_t)*key++) * 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Try seeds until every key lands in its own slot
+static void build_index(void) {
+    for (uint32_t seed = 1; ; seed++) {
+        memset(g_config_slots, 0, sizeof(g_config_slots));
+        size_t i;
+        for (i = 0; i < CONFIG_KEY_COUNT; i++) {
+            uint32_t slot = diram_config_key_hash(g_config_keys[i].name, seed) & (CONFIG_INDEX_SLOTS - 1);
+            if (g_config_slots[slot]) break;
+            g_config_slots[slot] = (uint8_t)(i + 1);
+        }
+        if (i == CONFIG_KEY_COUNT) {
+            g_config_index.seed = seed;
+            g_config_index.mask = CONFIG_INDEX_SLOTS - 1;
+            g_config_index.slots = g_config_slots;
+            return;
+        }
+    }
+}
+
+const config_index_t* diram_config_get_index(void) {
+    if (!g_config_index.slots) build_index();
+    return &g_config_index;
+}
+
+// Adopt an index built elsewhere (a mapped cache), or NULL to go back to
+// the built-in one. The index must still be perfect for this key table.
+bool diram_config_set_index(const config_index_t* index) {
+    if (!index) {
+        g_config_index.slots = NULL;
+        return true;
+    }
+    if (!index->slots || (index->mask & (index->mask + 1)) != 0 || index->mask > UINT16_MAX) {
+        return false;
+    }
+    
+    size_t used = 0;
+    for (uint32_t slot = 0; slot <= index->mask; slot++) {
+        used += index->slots[slot] != 0;
+    }
+    if (used != CONFIG_KEY_COUNT) return false;
+    for (size_t i = 0; i < CONFIG_KEY_COUNT; i++) {
+        uint32_t slot = diram_config_key_hash(g_config_keys[i].name, index->seed) & index->mask;
+        if (index->slots[slot] != i + 1) return false;
+    }
+    
+    g_config_index = *index;
+    return true;
+}
+
+int diram_config_key_index(const char* key) {
+    if (!key) return -1;
+    const config_index_t* index = diram_config_get_index();
+    uint8_t slot = index->slots[diram_config_key_hash(key, index->seed) & index->mask];
+    if (slot == 0 || strcmp(g_config_keys[slot - 1].name, key) != 0) return -1;
+    return slot - 1;
+}
+
+uint64_t diram_config_loaded_keys(void) {
+    return g_config_loaded;
+}
+
 // Process a single configuration line
 static int process_config_line(const char* section, const char* key, const char* value) {
     char full_key[256];
@@ -186,6 +341,21 @@ int diram_config_load_file(const char* filename, config_source_t source) {
         
         // Trim whitespace from value
         while (*value == ' ' || *value == '\t') value++;
+
+        // Drop a trailing comment: '#' outside quotes, at the start of the
+        // value or after whitespace
+        char quote = 0;
+        for (char* c = value; *c; c++) {
+            if (quote) {
+                if (*c == quote) quote = 0;
+            } else if (*c == '"' || *c == '\'') {
+                quote = *c;
+            } else if (*c == '#' && (c == value || c[-1] == ' ' || c[-1] == '\t')) {
+                *c = '\0';
+                while (c > value && (c[-1] == ' ' || c[-1] == '\t')) *--c = '\0';
+                break;
+            }
+        }
         
         // Process the configuration line
         if (process_config_line(section, key, value) < 0) {
@@ -207,63 +377,8 @@ int diram_config_load_file(const char* filename, config_source_t source) {
 int diram_config_set_value(const char* key, const char* value) {
     if (!key || !value) return -1;
     
-    // Basic configuration
-    if (strcmp(key, CFG_MEMORY_LIMIT) == 0) {
-        g_diram_config.memory_limit = strtoul(value, NULL, 10);
-    } else if (strcmp(key, CFG_MEMORY_SPACE) == 0) {
-        strncpy(g_diram_config.memory_space, value, 63);
-    } else if (strcmp(key, CFG_TRACE) == 0) {
-        g_diram_config.trace_enabled = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_LOG_DIR) == 0) {
-        strncpy(g_diram_config.log_dir, value, PATH_MAX - 1);
-    } else if (strcmp(key, CFG_MAX_HEAP_EVENTS) == 0) {
-        g_diram_config.max_heap_events = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_DETACH_TIMEOUT) == 0) {
-        g_diram_config.detach_timeout = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_PID_BINDING) == 0) {
-        strncpy(g_diram_config.pid_binding, value, 31);
-    } else if (strcmp(key, CFG_GUARD_PAGES) == 0) {
-        g_diram_config.guard_pages = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_CANARY_VALUES) == 0) {
-        g_diram_config.canary_values = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_ASLR_ENABLED) == 0) {
-        g_diram_config.aslr_enabled = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_TELEMETRY_LEVEL) == 0) {
-        g_diram_config.telemetry_level = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_TELEMETRY_ENDPOINT) == 0) {
-        strncpy(g_diram_config.telemetry_endpoint, value, PATH_MAX - 1);
-    } else if (strcmp(key, CFG_ZERO_TRUST) == 0) {
-        g_diram_config.zero_trust = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_MEMORY_AUDIT) == 0) {
-        g_diram_config.memory_audit = diram_config_parse_bool(value);
-    }
-    // Async configuration
-    else if (strcmp(key, CFG_ASYNC_ENABLE_PROMISES) == 0) {
-        g_diram_config.enable_promises = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_ASYNC_DEFAULT_TIMEOUT_MS) == 0) {
-        g_diram_config.default_timeout_ms = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_ASYNC_MAX_PENDING_PROMISES) == 0) {
-        g_diram_config.max_pending_promises = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_ASYNC_LOOKAHEAD_CACHE_SIZE) == 0) {
-        g_diram_config.lookahead_cache_size = strtol(value, NULL, 10);
-    }
-    // Detach configuration
-    else if (strcmp(key, CFG_DETACH_ENABLE_MODE) == 0) {
-        g_diram_config.enable_detach_mode = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_DETACH_LOG_ASYNC_OPS) == 0) {
-        g_diram_config.log_async_operations = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_DETACH_PERSIST_RECEIPTS) == 0) {
-        g_diram_config.persist_promise_receipts = diram_config_parse_bool(value);
-    }
-    // Resilience configuration
-    else if (strcmp(key, CFG_RESIL_RETRY_TRANSIENT) == 0) {
-        g_diram_config.retry_on_transient_failure = diram_config_parse_bool(value);
-    } else if (strcmp(key, CFG_RESIL_MAX_RETRY) == 0) {
-        g_diram_config.max_retry_attempts = strtol(value, NULL, 10);
-    } else if (strcmp(key, CFG_RESIL_EXP_BACKOFF) == 0) {
-        g_diram_config.exponential_backoff = diram_config_parse_bool(value);
-    }
-    else {
+    int index = diram_config_key_index(key);
+    if (index < 0) {
         // Unknown key - log if verbose
         if (g_diram_config.verbose) {
             fprintf(stderr, "Warning: unknown config key '%s'\n", key);
@@ -271,6 +386,31 @@ int diram_config_set_value(const char* key, const char* value) {
         return -1;
     }
     
+    const config_key_t* entry = &g_config_keys[index];
+    char* field = (char*)&g_diram_config + entry->offset;
+    switch (entry->type) {
+        case CONFIG_TYPE_BOOL:
+            *(bool*)field = diram_config_parse_bool(value);
+            break;
+        case CONFIG_TYPE_INT:
+            *(int*)field = strtol(value, NULL, 10);
+            break;
+        case CONFIG_TYPE_SIZE:
+            *(size_t*)field = strtoul(value, NULL, 10);
+            break;
+        case CONFIG_TYPE_STRING:
+            strncpy(field, value, entry->size - 1);
+            field[entry->size - 1] = '\0';
+            break;
+        case CONFIG_TYPE_RECEIPT_MODE: {
+            diram_receipt_mode_t mode;
+            if (diram_receipt_parse_mode(value, &mode) != 0) return -1;
+            *(int*)field = mode;
+            break;
+        }
+    }
+    
+    g_config_loaded |= 1ull << index;
     return 0;
 }
 
@@ -278,16 +418,24 @@ int diram_config_set_value(const char* key, const char* value) {
 const char* diram_config_get_value(const char* key) {
     static char value_buffer[256];
     
-    if (strcmp(key, CFG_MEMORY_LIMIT) == 0) {
-        snprintf(value_buffer, sizeof(value_buffer), "%zu", g_diram_config.memory_limit);
-    } else if (strcmp(key, CFG_MEMORY_SPACE) == 0) {
-        return g_diram_config.memory_space;
-    } else if (strcmp(key, CFG_TRACE) == 0) {
-        return g_diram_config.trace_enabled ? "true" : "false";
-    } else if (strcmp(key, CFG_LOG_DIR) == 0) {
-        return g_diram_config.log_dir;
-    } else {
-        return NULL;
+    int index = diram_config_key_index(key);
+    if (index < 0) return NULL;
+    
+    const config_key_t* entry = &g_config_keys[index];
+    const char* field = (const char*)&g_diram_config + entry->offset;
+    switch (entry->type) {
+        case CONFIG_TYPE_BOOL:
+            return *(const bool*)field ? "true" : "false";
+        case CONFIG_TYPE_INT:
+            snprintf(value_buffer, sizeof(value_buffer), "%d", *(const int*)field);
+            break;
+        case CONFIG_TYPE_SIZE:
+            snprintf(value_buffer, sizeof(value_buffer), "%zu", *(const size_t*)field);
+            break;
+        case CONFIG_TYPE_STRING:
+            return field;
+        case CONFIG_TYPE_RECEIPT_MODE:
+            return *(const int*)field == DIRAM_RECEIPT_MODE_DEFERRED ? "deferred" : "sync";
     }
     
     return value_buffer;
@@ -302,36 +450,96 @@ int diram_config_load_env(void) {
     return 0;
 }
 
-// Load configuration hierarchy
+// Load configuration hierarchy. The result is compiled to a .drcb cache,
+// and later starts map that instead of re-reading the text files for as
+// long as every source is unchanged.
 int diram_config_load_hierarchy(void) {
-    int errors = 0;
-    char path[PATH_MAX];
+    char paths[DIRAM_CONFIG_MAX_SOURCES][PATH_MAX];
+    const char* sources[DIRAM_CONFIG_MAX_SOURCES];
+    config_source_t kinds[DIRAM_CONFIG_MAX_SOURCES];
+    size_t count = 0;
     
     // 1. System-wide configuration
-    if (diram_config_load_file(DIRAM_SYSTEM_CONFIG_FILE, CONFIG_SOURCE_SYSTEM) < 0) {
-        errors++;
-    }
+    snprintf(paths[count], PATH_MAX, "%s", DIRAM_SYSTEM_CONFIG_FILE);
+    kinds[count++] = CONFIG_SOURCE_SYSTEM;
     
     // 2. User home configuration
     const char* home = get_home_dir();
     if (home) {
-        snprintf(path, sizeof(path), "%s/.dramrc", home);
-        if (diram_config_load_file(path, CONFIG_SOURCE_USER) < 0) {
+        snprintf(paths[count], PATH_MAX, "%s/.dramrc", home);
+        kinds[count++] = CONFIG_SOURCE_USER;
+    }
+    
+    // 3. Local directory configuration
+    snprintf(paths[count], PATH_MAX, "%s", ".dramrc");
+    kinds[count++] = CONFIG_SOURCE_LOCAL;
+    
+    // 4. Environment variable override
+    const char* env_file = getenv(DIRAM_CONFIG_ENV);
+    if (env_file) {
+        snprintf(paths[count], PATH_MAX, "%s", env_file);
+        kinds[count++] = CONFIG_SOURCE_ENV;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        sources[i] = paths[i];
+    }
+    
+    char cache_path[PATH_MAX];
+    bool cached = diram_config_cache_path(cache_path, sizeof(cache_path));
+    int errors = 0;
+    if (cached && diram_config_cache_load(cache_path, sources, count, &errors) == 0) {
+        return errors;
+    }
+    
+    // Stamp before reading, so an edit racing the load leaves the cache
+    // stale rather than wrong
+    diram_config_stamp_t stamps[DIRAM_CONFIG_MAX_SOURCES];
+    if (cached && diram_config_cache_stamp(stamps, sources, count) != 0) {
+        cached = false;
+    }
+    
+    g_config_loaded = 0;
+    size_t missing = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (diram_config_load_file(sources[i], kinds[i]) < 0) {
             errors++;
         }
+        if (cached && !stamps[i].present) {
+            missing++;
+        }
     }
     
-    // 3. Local directory configuration
-    if (diram_config_load_file(".dramrc", CONFIG_SOURCE_LOCAL) < 0) {
-        errors++;
+    // Missing files count as errors but are part of the stamp; a file that
+    // failed to parse is not cached, so its diagnostics keep appearing
+    if (cached && (size_t)errors == missing) {
+        diram_config_cache_save(cache_path, stamps, count, errors);
     }
     
-    // 4. Environment variable override
-    if (diram_config_load_env() < 0) {
+    return errors;
+}
+
+// Apply runtime settings to the subsystems that own them
+int diram_config_apply(void) {
+    int errors = 0;
+    
+    if (diram_receipt_set_mode((diram_receipt_mode_t)g_diram_config.receipt_mode) != 0) {
+        fprintf(stderr, "Failed to apply receipt_mode\n");
         errors++;
     }
     
-    return errors;
+    diram_executor_configure((uint32_t)g_diram_config.executor_threads,
+                             (uint32_t)g_diram_config.max_pending_promises);
+    
+    // Sizes the cache only before its first lookup; later reloads keep it
+    diram_lookahead_cache_configure((size_t)g_diram_config.lookahead_cache_size);
+    
+    diram_gov_configure_thread((uint32_t)g_diram_config.gov_thread_rate,
+                               (uint32_t)g_diram_config.gov_thread_burst);
+    diram_gov_configure_space((uint32_t)g_diram_config.gov_space_rate,
+                              (uint32_t)g_diram_config.gov_space_burst);
+    
+    return errors > 0 ? -1 : 0;
 }
 
 // Validate configuration
@@ -355,6 +563,29 @@ bool diram_config_validate(void) {
         valid = false;
     }
     
+    // Validate lookahead cache capacity
+    if (g_diram_config.lookahead_cache_size < 1) {
+        snprintf(g_config_error_buffer, sizeof(g_config_error_buffer),
+                "Invalid lookahead_cache_size: %d (must be >= 1)",
+                g_diram_config.lookahead_cache_size);
+        valid = false;
+    }
+    
+    // Validate executor sizing
+    if (g_diram_config.executor_threads < 0 || g_diram_config.max_pending_promises < 0) {
+        snprintf(g_config_error_buffer, sizeof(g_config_error_buffer),
+                "Invalid async limits: executor_threads and max_pending_promises must be >= 0");
+        valid = false;
+    }
+    
+    // Validate governor limits
+    if (g_diram_config.gov_thread_rate < 0 || g_diram_config.gov_thread_burst < 0 ||
+        g_diram_config.gov_space_rate < 0 || g_diram_config.gov_space_burst < 0) {
+        snprintf(g_config_error_buffer, sizeof(g_config_error_buffer),
+                "Invalid governor limits: rates and bursts must be >= 0");
+        valid = false;
+    }
+    
     // Validate telemetry level
     if (g_diram_config.telemetry_level < 0 || g_diram_config.telemetry_level > 3) {
         snprintf(g_config_error_buffer, sizeof(g_config_error_buffer),
@@ -379,6 +610,7 @@ void diram_config_print(void) {
     printf("    memory_space: %s\n", g_diram_config.memory_space);
     printf("  Tracing:\n");
     printf("    trace_enabled: %s\n", g_diram_config.trace_enabled ? "yes" : "no");
+    printf("    receipt_mode: %s\n", diram_config_get_value(CFG_RECEIPT_MODE));
     printf("    log_dir: %s\n", g_diram_config.log_dir);
     printf("  Heap Constraints:\n");
     printf("    max_heap_events: %d\n", g_diram_config.max_heap_events);
@@ -403,11 +635,15 @@ void diram_config_print(void) {
         printf("    enable_promises: %s\n", g_diram_config.enable_promises ? "yes" : "no");
         printf("    default_timeout_ms: %d\n", g_diram_config.default_timeout_ms);
         printf("    max_pending_promises: %d\n", g_diram_config.max_pending_promises);
+        printf("    executor_threads: %d\n", g_diram_config.executor_threads);
         printf("    lookahead_cache_size: %d\n", g_diram_config.lookahead_cache_size);
         printf("  Detach Mode:\n");
         printf("    enable_detach_mode: %s\n", g_diram_config.enable_detach_mode ? "yes" : "no");
         printf("    log_async_operations: %s\n", g_diram_config.log_async_operations ? "yes" : "no");
         printf("    persist_promise_receipts: %s\n", g_diram_config.persist_promise_receipts ? "yes" : "no");
+        printf("  Governor:\n");
+        printf("    thread_rate: %d/s burst %d\n", g_diram_config.gov_thread_rate, g_diram_config.gov_thread_burst);
+        printf("    space_rate: %d/s burst %d\n", g_diram_config.gov_space_rate, g_diram_config.gov_space_burst);
         printf("  Resilience:\n");
         printf("    retry_on_transient_failure: %s\n", g_diram_config.retry_on_transient_failure ? "yes" : "no");
         printf("    max_retry_attempts: %d\n", g_diram_config.max_retry_attempts);
@@ -433,6 +669,7 @@ int diram_config_save(const char* filename) {
     
     fprintf(fp, "# Tracing Configuration\n");
     fprintf(fp, "%s=%s\n", CFG_TRACE, g_diram_config.trace_enabled ? "true" : "false");
+    fprintf(fp, "%s=%s\n", CFG_RECEIPT_MODE, diram_config_get_value(CFG_RECEIPT_MODE));
     fprintf(fp, "%s=%s\n", CFG_LOG_DIR, g_diram_config.log_dir);
     fprintf(fp, "\n");
     
@@ -465,6 +702,7 @@ int diram_config_save(const char* filename) {
     fprintf(fp, "enable_promises=%s\n", g_diram_config.enable_promises ? "true" : "false");
     fprintf(fp, "default_timeout_ms=%d\n", g_diram_config.default_timeout_ms);
     fprintf(fp, "max_pending_promises=%d\n", g_diram_config.max_pending_promises);
+    fprintf(fp, "executor_threads=%d\n", g_diram_config.executor_threads);
     fprintf(fp, "lookahead_cache_size=%d\n", g_diram_config.lookahead_cache_size);
     fprintf(fp, "\n");
     
@@ -474,6 +712,13 @@ int diram_config_save(const char* filename) {
     fprintf(fp, "persist_promise_receipts=%s\n", g_diram_config.persist_promise_receipts ? "true" : "false");
     fprintf(fp, "\n");
     
+    fprintf(fp, "[governor]\n");
+    fprintf(fp, "thread_rate=%d\n", g_diram_config.gov_thread_rate);
+    fprintf(fp, "thread_burst=%d\n", g_diram_config.gov_thread_burst);
+    fprintf(fp, "space_rate=%d\n", g_diram_config.gov_space_rate);
+    fprintf(fp, "space_burst=%d\n", g_diram_config.gov_space_burst);
+    fprintf(fp, "\n");
+    
     fprintf(fp, "[resilience]\n");
     fprintf(fp, "retry_on_transient_failure=%s\n", g_diram_config.retry_on_transient_failure ? "true" : "false");
     fprintf(fp, "max_retry_attempts=%d\n", g_diram_config.max_retry_attempts);
@@ -485,6 +730,5 @@ int diram_config_save(const char* filename) {
 
 // Cleanup configuration
 void diram_config_cleanup(void) {
-    // Currently nothing to cleanup, but placeholder for future
-    // dynamic allocations
+    diram_config_cache_release();
 }
\ No newline at end of file
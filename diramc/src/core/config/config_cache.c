@@ -0,0 +1,453 @@
+// src/core/config/config_cache.c
+// DIRAM Compiled Configuration Cache (.drcb)
+// OBINexus Project - typed settings mapped at startup instead of re-parsed
+
+#include "diram/core/config/config_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define DRCB_MAGIC      "DRCB"
+#define DRCB_MAX_SIZE   (1u << 20)
+
+// Host byte order; caches are per-user and per-machine
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t layout;            // key table and diram_config_t shape
+    uint64_t checksum;          // FNV-1a 64 of everything after the header
+    uint32_t size;              // whole file
+    int32_t errors;             // diram_config_load_hierarchy result
+    uint32_t seed;              // perfect hash seed
+    uint32_t slot_count;
+    uint32_t source_count;
+    uint32_t value_count;
+    uint32_t strings_length;
+    uint32_t reserved;
+} drcb_header_t;
+
+typedef struct {
+    uint32_t path;              // string offset
+    uint8_t present;
+    uint8_t racy;
+    uint16_t reserved;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint64_t size;
+    uint64_t hash;
+} drcb_source_t;
+
+typedef struct {
+    uint16_t key;               // index into the key table
+    uint16_t type;              // config_type_t, must match the key's
+    uint32_t length;            // string values
+    int64_t number;             // bool/int/size/receipt mode, or string offset
+} drcb_value_t;
+
+typedef struct {
+    const drcb_header_t* header;
+    const drcb_source_t* sources;
+    const uint8_t* slots;
+    const drcb_value_t* values;
+    const char* strings;
+} drcb_view_t;
+
+static void* g_cache_map = NULL;
+static size_t g_cache_size = 0;
+
+static uint64_t fnv64(uint64_t hash, const void* data, size_t length) {
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+#define FNV64_BASIS 14695981039346656037ull
+
+// Changes whenever a key, its type or the struct it lands in changes
+static uint64_t layout_stamp(void) {
+    uint64_t values[3] = { DIRAM_CONFIG_CACHE_VERSION, sizeof(diram_config_t), diram_config_key_count() };
+    uint64_t hash = fnv64(FNV64_BASIS, values, sizeof(values));
+    for (size_t i = 0; i < diram_config_key_count(); i++) {
+        const config_key_t* key = diram_config_key(i);
+        uint64_t shape[3] = { key->type, key->offset, key->size };
+        hash = fnv64(hash, key->name, strlen(key->name) + 1);
+        hash = fnv64(hash, shape, sizeof(shape));
+    }
+    return hash;
+}
+
+static size_t align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+static size_t values_offset(uint32_t source_count, uint32_t slot_count) {
+    return sizeof(drcb_header_t) + source_count * sizeof(drcb_source_t) + align8(slot_count);
+}
+
+static bool hash_file(const char* path, uint64_t* hash, uint64_t* size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    char buffer[4096];
+    uint64_t h = FNV64_BASIS, total = 0;
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        h = fnv64(h, buffer, (size_t)n);
+        total += (uint64_t)n;
+    }
+    close(fd);
+    if (n < 0) return false;
+    *hash = h;
+    *size = total;
+    return true;
+}
+
+// ============================================================================
+// Cache location
+// ============================================================================
+
+bool diram_config_cache_path(char* path, size_t size) {
+    const char* env = getenv(DIRAM_CONFIG_CACHE_ENV);
+    if (env) {
+        if (!*env) return false;
+        return snprintf(path, size, "%s", env) < (int)size;
+    }
+
+    char dir[PATH_MAX];
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (xdg && *xdg) {
+        snprintf(dir, sizeof(dir), "%s/diram", xdg);
+    } else if (home && *home) {
+        snprintf(dir, sizeof(dir), "%s/.cache/diram", home);
+    } else {
+        return false;
+    }
+
+    // The local .dramrc and $DIRAM_CONFIG pick the sources, so each
+    // combination gets its own file instead of evicting the others
+    char cwd[PATH_MAX];
+    if (!getcwd(cwd, sizeof(cwd))) return false;
+    const char* config = getenv(DIRAM_CONFIG_ENV);
+    uint64_t hash = fnv64(FNV64_BASIS, cwd, strlen(cwd) + 1);
+    if (config) hash = fnv64(hash, config, strlen(config));
+
+    return snprintf(path, size, "%s/config-%016llx%s", dir, (unsigned long long)hash,
+                    DIRAM_CONFIG_CACHE_EXT) < (int)size;
+}
+
+// ============================================================================
+// Stamps
+// ============================================================================
+
+int diram_config_cache_stamp(diram_config_stamp_t* stamps, const char* const* sources,
+                             size_t count) {
+    if (!stamps || count > DIRAM_CONFIG_MAX_SOURCES) return -1;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    for (size_t i = 0; i < count; i++) {
+        diram_config_stamp_t* stamp = &stamps[i];
+        memset(stamp, 0, sizeof(*stamp));
+        if (snprintf(stamp->path, sizeof(stamp->path), "%s", sources[i]) >= (int)sizeof(stamp->path)) {
+            return -1;
+        }
+
+        struct stat st;
+        if (stat(sources[i], &st) != 0) continue;
+        if (!hash_file(sources[i], &stamp->hash, &stamp->size)) continue;
+        stamp->present = true;
+        stamp->mtime_sec = st.st_mtim.tv_sec;
+        stamp->mtime_nsec = st.st_mtim.tv_nsec;
+        stamp->racy = st.st_mtim.tv_sec >= now.tv_sec - 1;
+        if (stamp->size != (uint64_t)st.st_size) stamp->racy = true;     // written while hashing
+    }
+    return 0;
+}
+
+static bool source_unchanged(const drcb_source_t* stamp, const char* path) {
+    struct stat st;
+    if (stat(path, &st) != 0) return !stamp->present;
+    if (!stamp->present || (uint64_t)st.st_size != stamp->size) return false;
+    if (!stamp->racy && st.st_mtim.tv_sec == stamp->mtime_sec &&
+        st.st_mtim.tv_nsec == stamp->mtime_nsec) {
+        return true;
+    }
+
+    // Touched, or too recent to trust: compare contents
+    uint64_t hash, size;
+    return hash_file(path, &hash, &size) && size == stamp->size && hash == stamp->hash;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+static bool valid_string(const drcb_view_t* view, uint64_t offset) {
+    uint32_t length = view->header->strings_length;
+    return offset < length && memchr(view->strings + offset, '\0', length - offset) != NULL;
+}
+
+// Structure, layout and checksum; says nothing about the sources
+static bool open_view(drcb_view_t* view, const void* map, size_t size) {
+    const drcb_header_t* header = map;
+    if (size < sizeof(drcb_header_t) || memcmp(header->magic, DRCB_MAGIC, 4) != 0 ||
+        header->version != DIRAM_CONFIG_CACHE_VERSION || header->size != size ||
+        header->layout != layout_stamp() ||
+        header->source_count > DIRAM_CONFIG_MAX_SOURCES ||
+        header->value_count > diram_config_key_count() ||
+        header->slot_count > UINT16_MAX + 1u) {
+        return false;
+    }
+
+    size_t values = values_offset(header->source_count, header->slot_count);
+    size_t strings = values + header->value_count * sizeof(drcb_value_t);
+    if (strings + header->strings_length != size) return false;
+    if (fnv64(FNV64_BASIS, (const char*)map + sizeof(drcb_header_t),
+              size - sizeof(drcb_header_t)) != header->checksum) {
+        return false;
+    }
+
+    view->header = header;
+    view->sources = (const drcb_source_t*)(header + 1);
+    view->slots = (const uint8_t*)(view->sources + header->source_count);
+    view->values = (const drcb_value_t*)((const char*)map + values);
+    view->strings = (const char*)map + strings;
+    return true;
+}
+
+static bool valid_values(const drcb_view_t* view) {
+    for (uint32_t i = 0; i < view->header->value_count; i++) {
+        const drcb_value_t* value = &view->values[i];
+        const config_key_t* key = diram_config_key(value->key);
+        if (!key || value->type != key->type) return false;
+        if (key->type == CONFIG_TYPE_STRING &&
+            (!valid_string(view, (uint64_t)value->number) || value->length >= key->size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void apply_values(const drcb_view_t* view) {
+    for (uint32_t i = 0; i < view->header->value_count; i++) {
+        const drcb_value_t* value = &view->values[i];
+        const config_key_t* key = diram_config_key(value->key);
+        char* field = (char*)&g_diram_config + key->offset;
+        switch (key->type) {
+            case CONFIG_TYPE_BOOL:
+                *(bool*)field = value->number != 0;
+                break;
+            case CONFIG_TYPE_INT:
+            case CONFIG_TYPE_RECEIPT_MODE:
+                *(int*)field = (int)value->number;
+                break;
+            case CONFIG_TYPE_SIZE:
+                *(size_t*)field = (size_t)value->number;
+                break;
+            case CONFIG_TYPE_STRING:
+                memcpy(field, view->strings + value->number, value->length);
+                memset(field + value->length, 0, key->size - value->length);
+                break;
+        }
+    }
+}
+
+int diram_config_cache_load(const char* cache_path, const char* const* sources,
+                            size_t count, int* errors) {
+    diram_config_cache_release();
+    if (!cache_path || !sources) return -1;
+
+    int fd = open(cache_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(drcb_header_t) ||
+        st.st_size > DRCB_MAX_SIZE) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)st.st_size;
+    void* map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    drcb_view_t view;
+    bool valid = open_view(&view, map, size) && view.header->source_count == count &&
+                 valid_values(&view);
+    for (size_t i = 0; valid && i < count; i++) {
+        valid = valid_string(&view, view.sources[i].path) &&
+                strcmp(view.strings + view.sources[i].path, sources[i]) == 0 &&
+                source_unchanged(&view.sources[i], sources[i]);
+    }
+
+    // The key index is used in place, so the mapping stays until release
+    if (valid) {
+        config_index_t index = { view.header->seed, view.header->slot_count - 1, view.slots };
+        valid = diram_config_set_index(&index);
+    }
+    if (!valid) {
+        munmap(map, size);
+        return -1;
+    }
+    apply_values(&view);
+    g_cache_map = map;
+    g_cache_size = size;
+    if (errors) *errors = view.header->errors;
+    return 0;
+}
+
+void diram_config_cache_release(void) {
+    if (!g_cache_map) return;
+
+    const uint8_t* slots = diram_config_get_index()->slots;
+    if (slots >= (const uint8_t*)g_cache_map && slots < (const uint8_t*)g_cache_map + g_cache_size) {
+        diram_config_set_index(NULL);
+    }
+    munmap(g_cache_map, g_cache_size);
+    g_cache_map = NULL;
+    g_cache_size = 0;
+}
+
+// ============================================================================
+// Compiling
+// ============================================================================
+
+static void make_parents(const char* path) {
+    char dir[PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s", path);
+    for (char* slash = strchr(dir + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        mkdir(dir, 0700);
+        *slash = '/';
+    }
+}
+
+static bool write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+int diram_config_cache_save(const char* cache_path, const diram_config_stamp_t* stamps,
+                            size_t count, int errors) {
+    if (!cache_path || !stamps || count > DIRAM_CONFIG_MAX_SOURCES) return -1;
+
+    const config_index_t* index = diram_config_get_index();
+    uint64_t loaded = diram_config_loaded_keys();
+    uint32_t slot_count = index->mask + 1;
+
+    // Size the string table: source paths, then string values
+    uint32_t value_count = 0;
+    size_t strings_length = 1;                      // offset 0 is ""
+    for (size_t i = 0; i < count; i++) {
+        strings_length += strlen(stamps[i].path) + 1;
+    }
+    for (size_t k = 0; k < diram_config_key_count(); k++) {
+        if (!(loaded & (1ull << k))) continue;
+        const config_key_t* key = diram_config_key(k);
+        if (key->type == CONFIG_TYPE_STRING) {
+            strings_length += strnlen((const char*)&g_diram_config + key->offset, key->size - 1) + 1;
+        }
+        value_count++;
+    }
+
+    size_t values = values_offset((uint32_t)count, slot_count);
+    size_t strings = values + value_count * sizeof(drcb_value_t);
+    size_t size = strings + strings_length;
+    char* file = calloc(1, size);
+    if (!file) return -1;
+
+    drcb_header_t* header = (drcb_header_t*)file;
+    memcpy(header->magic, DRCB_MAGIC, 4);
+    header->version = DIRAM_CONFIG_CACHE_VERSION;
+    header->layout = layout_stamp();
+    header->size = (uint32_t)size;
+    header->errors = errors;
+    header->seed = index->seed;
+    header->slot_count = slot_count;
+    header->source_count = (uint32_t)count;
+    header->value_count = value_count;
+    header->strings_length = (uint32_t)strings_length;
+
+    char* string = file + strings + 1;
+    drcb_source_t* source = (drcb_source_t*)(header + 1);
+    for (size_t i = 0; i < count; i++, source++) {
+        source->path = (uint32_t)(string - (file + strings));
+        source->present = stamps[i].present;
+        source->racy = stamps[i].racy;
+        source->mtime_sec = stamps[i].mtime_sec;
+        source->mtime_nsec = stamps[i].mtime_nsec;
+        source->size = stamps[i].size;
+        source->hash = stamps[i].hash;
+        size_t length = strlen(stamps[i].path) + 1;
+        memcpy(string, stamps[i].path, length);
+        string += length;
+    }
+    memcpy(source, index->slots, slot_count);
+
+    drcb_value_t* value = (drcb_value_t*)(file + values);
+    for (size_t k = 0; k < diram_config_key_count(); k++) {
+        if (!(loaded & (1ull << k))) continue;
+        const config_key_t* key = diram_config_key(k);
+        const char* field = (const char*)&g_diram_config + key->offset;
+        value->key = (uint16_t)k;
+        value->type = (uint16_t)key->type;
+        switch (key->type) {
+            case CONFIG_TYPE_BOOL:
+                value->number = *(const bool*)field;
+                break;
+            case CONFIG_TYPE_INT:
+            case CONFIG_TYPE_RECEIPT_MODE:
+                value->number = *(const int*)field;
+                break;
+            case CONFIG_TYPE_SIZE:
+                value->number = (int64_t)*(const size_t*)field;
+                break;
+            case CONFIG_TYPE_STRING:
+                value->length = (uint32_t)strnlen(field, key->size - 1);
+                value->number = string - (file + strings);
+                memcpy(string, field, value->length);
+                string += value->length + 1;
+                break;
+        }
+        value++;
+    }
+    header->checksum = fnv64(FNV64_BASIS, file + sizeof(drcb_header_t), size - sizeof(drcb_header_t));
+
+    char temp[PATH_MAX];
+    if (snprintf(temp, sizeof(temp), "%s.%d.tmp", cache_path, (int)getpid()) >= (int)sizeof(temp)) {
+        free(file);
+        return -1;
+    }
+    int fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0 && errno == ENOENT) {
+        make_parents(temp);
+        fd = open(temp, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    }
+    if (fd < 0) {
+        free(file);
+        return -1;
+    }
+    bool written = write_all(fd, file, size);
+    free(file);
+    if (close(fd) != 0 || !written || rename(temp, cache_path) != 0) {
+        unlink(temp);
+        return -1;
+    }
+    return 0;
+}
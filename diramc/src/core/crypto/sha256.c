@@ -0,0 +1,430 @@
+// src/core/crypto/sha256.c
+// OBINexus DIRAM SHA-256 Receipt Engine
+// FIPS 180-4 SHA-256 with three compression back-ends chosen at runtime:
+//   scalar - portable reference, always available
+//   SHA-NI - x86 SHA extensions, fastest single-message path
+//   AVX2   - eight messages hashed in parallel lanes for receipt batches
+#include "diram/core/crypto/sha256.h"
+#include <string.h>
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DIRAM_SHA256_X86 1
+#include <immintrin.h>
+#endif
+
+static const uint32_t K256[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t H256[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+typedef void (*sha256_compress_fn)(uint32_t state[8], const uint8_t* data, size_t nblocks);
+
+static inline uint32_t load_be32(const uint8_t* p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return __builtin_bswap32(v);
+}
+
+static inline void store_be32(uint8_t* p, uint32_t v) {
+    v = __builtin_bswap32(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline void store_be64(uint8_t* p, uint64_t v) {
+    v = __builtin_bswap64(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+// Builds the one or two padded tail blocks; returns how many were written
+static size_t sha256_pad_tail(const uint8_t* tail, size_t rem, uint64_t total_len,
+                              uint8_t out[2 * DIRAM_SHA256_BLOCK_LEN]) {
+    size_t blocks = rem < 56 ? 1 : 2;
+    memset(out, 0, blocks * DIRAM_SHA256_BLOCK_LEN);
+    if (rem) memcpy(out, tail, rem);
+    out[rem] = 0x80;
+    store_be64(out + blocks * DIRAM_SHA256_BLOCK_LEN - 8, total_len * 8);
+    return blocks;
+}
+
+// ============================================================================
+// Scalar back-end
+// ============================================================================
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void compress_scalar(uint32_t state[8], const uint8_t* data, size_t nblocks) {
+    uint32_t w[64];
+
+    while (nblocks--) {
+        for (int t = 0; t < 16; t++) {
+            w[t] = load_be32(data + t * 4);
+        }
+        for (int t = 16; t < 64; t++) {
+            uint32_t s0 = ROTR32(w[t - 15], 7) ^ ROTR32(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            uint32_t s1 = ROTR32(w[t - 2], 17) ^ ROTR32(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+        for (int t = 0; t < 64; t++) {
+            uint32_t S1 = ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + S1 + ch + K256[t] + w[t];
+            uint32_t S0 = ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = S0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+        data += DIRAM_SHA256_BLOCK_LEN;
+    }
+}
+
+// ============================================================================
+// SHA-NI back-end
+// ============================================================================
+
+#ifdef DIRAM_SHA256_X86
+__attribute__((target("sha,sse4.1,ssse3")))
+static void compress_shani(uint32_t state[8], const uint8_t* data, size_t nblocks) {
+    const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Repack A..H into the ABEF / CDGH register layout sha256rnds2 expects
+    __m128i tmp = _mm_loadu_si128((const __m128i*)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i*)&state[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while (nblocks--) {
+        __m128i abef_save = state0;
+        __m128i cdgh_save = state1;
+        __m128i msg[4];
+
+        // Sixteen groups of four rounds; the schedule runs three groups ahead
+        for (int g = 0; g < 16; g++) {
+            if (g < 4) {
+                msg[g] = _mm_shuffle_epi8(
+                    _mm_loadu_si128((const __m128i*)(data + g * 16)), byteswap);
+            }
+
+            __m128i wk = _mm_add_epi32(msg[g & 3],
+                                       _mm_loadu_si128((const __m128i*)&K256[g * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+
+            if (g >= 3 && g <= 14) {
+                __m128i carry = _mm_alignr_epi8(msg[g & 3], msg[(g - 1) & 3], 4);
+                msg[(g + 1) & 3] = _mm_add_epi32(msg[(g + 1) & 3], carry);
+                msg[(g + 1) & 3] = _mm_sha256msg2_epu32(msg[(g + 1) & 3], msg[g & 3]);
+            }
+
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, wk);
+
+            if (g >= 1 && g <= 12) {
+                msg[(g - 1) & 3] = _mm_sha256msg1_epu32(msg[(g - 1) & 3], msg[g & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        data += DIRAM_SHA256_BLOCK_LEN;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i*)&state[0], state0);
+    _mm_storeu_si128((__m128i*)&state[4], state1);
+}
+#endif
+
+// ============================================================================
+// AVX2 8-lane multi-buffer back-end
+// ============================================================================
+
+#ifdef DIRAM_SHA256_X86
+#define V_ROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+typedef struct {
+    const uint8_t* data;
+    size_t full_blocks;
+    size_t total_blocks;
+    uint8_t tail[2 * DIRAM_SHA256_BLOCK_LEN];
+} sha256_lane_t;
+
+static inline const uint8_t* lane_block(const sha256_lane_t* lane, size_t b) {
+    if (b < lane->full_blocks) return lane->data + b * DIRAM_SHA256_BLOCK_LEN;
+    return lane->tail + (b - lane->full_blocks) * DIRAM_SHA256_BLOCK_LEN;
+}
+
+// Hashes up to eight messages; lanes that run out of blocks keep their state
+__attribute__((target("avx2")))
+static void sha256_x8_avx2(const void* const* data, const size_t* lens, int lanes,
+                           uint8_t (*digests)[DIRAM_SHA256_DIGEST_LEN]) {
+    sha256_lane_t lane[DIRAM_SHA256_LANES];
+    size_t max_blocks = 0;
+
+    for (int j = 0; j < DIRAM_SHA256_LANES; j++) {
+        if (j < lanes) {
+            lane[j].data = (const uint8_t*)data[j];
+            lane[j].full_blocks = lens[j] / DIRAM_SHA256_BLOCK_LEN;
+            size_t rem = lens[j] % DIRAM_SHA256_BLOCK_LEN;
+            lane[j].total_blocks = lane[j].full_blocks +
+                sha256_pad_tail(lane[j].data + lane[j].full_blocks * DIRAM_SHA256_BLOCK_LEN,
+                                rem, lens[j], lane[j].tail);
+        } else {
+            // Idle lane: zero blocks, never selected by the active mask
+            lane[j].data = NULL;
+            lane[j].full_blocks = 0;
+            lane[j].total_blocks = 0;
+            memset(lane[j].tail, 0, sizeof(lane[j].tail));
+        }
+        if (lane[j].total_blocks > max_blocks) max_blocks = lane[j].total_blocks;
+    }
+
+    __m256i s[8];
+    for (int i = 0; i < 8; i++) s[i] = _mm256_set1_epi32((int)H256[i]);
+
+    __m256i w[64];
+    for (size_t b = 0; b < max_blocks; b++) {
+        const uint8_t* p[DIRAM_SHA256_LANES];
+        int32_t active[DIRAM_SHA256_LANES];
+        for (int j = 0; j < DIRAM_SHA256_LANES; j++) {
+            active[j] = b < lane[j].total_blocks ? -1 : 0;
+            p[j] = active[j] ? lane_block(&lane[j], b) : lane[j].tail;
+        }
+
+        // Transpose: word t of every lane into one vector
+        for (int t = 0; t < 16; t++) {
+            w[t] = _mm256_setr_epi32(
+                (int)load_be32(p[0] + t * 4), (int)load_be32(p[1] + t * 4),
+                (int)load_be32(p[2] + t * 4), (int)load_be32(p[3] + t * 4),
+                (int)load_be32(p[4] + t * 4), (int)load_be32(p[5] + t * 4),
+                (int)load_be32(p[6] + t * 4), (int)load_be32(p[7] + t * 4));
+        }
+        for (int t = 16; t < 64; t++) {
+            __m256i w15 = w[t - 15], w2 = w[t - 2];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(V_ROTR(w15, 7), V_ROTR(w15, 18)),
+                                          _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(V_ROTR(w2, 17), V_ROTR(w2, 19)),
+                                          _mm256_srli_epi32(w2, 10));
+            w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0),
+                                    _mm256_add_epi32(w[t - 7], s1));
+        }
+
+        __m256i a = s[0], bb = s[1], c = s[2], d = s[3];
+        __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 64; t++) {
+            __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(V_ROTR(e, 6), V_ROTR(e, 11)),
+                                          V_ROTR(e, 25));
+            __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1),
+                                          _mm256_add_epi32(_mm256_add_epi32(ch, w[t]),
+                                                           _mm256_set1_epi32((int)K256[t])));
+            __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(V_ROTR(a, 2), V_ROTR(a, 13)),
+                                          V_ROTR(a, 22));
+            __m256i maj = _mm256_xor_si256(_mm256_and_si256(a, bb),
+                                           _mm256_and_si256(c, _mm256_xor_si256(a, bb)));
+            __m256i t2 = _mm256_add_epi32(S0, maj);
+            h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+            d = c; c = bb; bb = a; a = _mm256_add_epi32(t1, t2);
+        }
+
+        __m256i mask = _mm256_setr_epi32(active[0], active[1], active[2], active[3],
+                                         active[4], active[5], active[6], active[7]);
+        __m256i next[8] = {a, bb, c, d, e, f, g, h};
+        for (int i = 0; i < 8; i++) {
+            s[i] = _mm256_blendv_epi8(s[i], _mm256_add_epi32(s[i], next[i]), mask);
+        }
+    }
+
+    uint32_t out[8][DIRAM_SHA256_LANES];
+    for (int i = 0; i < 8; i++) {
+        _mm256_storeu_si256((__m256i*)out[i], s[i]);
+    }
+    for (int j = 0; j < lanes; j++) {
+        for (int i = 0; i < 8; i++) {
+            store_be32(digests[j] + i * 4, out[i][j]);
+        }
+    }
+}
+#endif
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static atomic_int g_single_impl = DIRAM_SHA256_IMPL_AUTO;
+static atomic_int g_batch_impl = DIRAM_SHA256_IMPL_AUTO;
+
+int diram_sha256_supported(diram_sha256_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SHA256_IMPL_AUTO:
+        case DIRAM_SHA256_IMPL_SCALAR:
+            return 1;
+#ifdef DIRAM_SHA256_X86
+        case DIRAM_SHA256_IMPL_SHANI:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+        case DIRAM_SHA256_IMPL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return 0;
+    }
+}
+
+static void sha256_resolve_auto(void) {
+    if (atomic_load_explicit(&g_single_impl, memory_order_relaxed) != DIRAM_SHA256_IMPL_AUTO) {
+        return;
+    }
+
+    int single = diram_sha256_supported(DIRAM_SHA256_IMPL_SHANI)
+        ? DIRAM_SHA256_IMPL_SHANI : DIRAM_SHA256_IMPL_SCALAR;
+
+    // Receipt inputs are one block, where eight AVX2 lanes outrun SHA-NI
+    int batch = diram_sha256_supported(DIRAM_SHA256_IMPL_AVX2)
+        ? DIRAM_SHA256_IMPL_AVX2 : single;
+
+    int expected = DIRAM_SHA256_IMPL_AUTO;
+    if (atomic_compare_exchange_strong(&g_single_impl, &expected, single)) {
+        atomic_store(&g_batch_impl, batch);
+    }
+}
+
+int diram_sha256_force_impl(diram_sha256_impl_t impl) {
+    if (!diram_sha256_supported(impl)) return -1;
+
+    atomic_store(&g_single_impl, DIRAM_SHA256_IMPL_AUTO);
+    atomic_store(&g_batch_impl, DIRAM_SHA256_IMPL_AUTO);
+    if (impl == DIRAM_SHA256_IMPL_AUTO) {
+        sha256_resolve_auto();
+        return 0;
+    }
+
+    atomic_store(&g_batch_impl, impl);
+    atomic_store(&g_single_impl, impl);
+    return 0;
+}
+
+diram_sha256_impl_t diram_sha256_active_impl(void) {
+    sha256_resolve_auto();
+    return (diram_sha256_impl_t)atomic_load_explicit(&g_single_impl, memory_order_relaxed);
+}
+
+diram_sha256_impl_t diram_sha256_active_batch_impl(void) {
+    sha256_resolve_auto();
+    return (diram_sha256_impl_t)atomic_load_explicit(&g_batch_impl, memory_order_relaxed);
+}
+
+const char* diram_sha256_impl_name(diram_sha256_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SHA256_IMPL_AUTO:   return "auto";
+        case DIRAM_SHA256_IMPL_SCALAR: return "scalar";
+        case DIRAM_SHA256_IMPL_SHANI:  return "sha-ni";
+        case DIRAM_SHA256_IMPL_AVX2:   return "avx2-x8";
+        default:                       return "unknown";
+    }
+}
+
+static void sha256_one(sha256_compress_fn compress, const void* data, size_t len,
+                       uint8_t digest[DIRAM_SHA256_DIGEST_LEN]) {
+    uint32_t state[8];
+    memcpy(state, H256, sizeof(state));
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    size_t full = len / DIRAM_SHA256_BLOCK_LEN;
+    if (full) compress(state, bytes, full);
+
+    uint8_t tail[2 * DIRAM_SHA256_BLOCK_LEN];
+    size_t blocks = sha256_pad_tail(bytes + full * DIRAM_SHA256_BLOCK_LEN,
+                                    len % DIRAM_SHA256_BLOCK_LEN, len, tail);
+    compress(state, tail, blocks);
+
+    for (int i = 0; i < 8; i++) {
+        store_be32(digest + i * 4, state[i]);
+    }
+}
+
+static sha256_compress_fn single_compress(diram_sha256_impl_t impl) {
+#ifdef DIRAM_SHA256_X86
+    if (impl == DIRAM_SHA256_IMPL_SHANI) return compress_shani;
+#else
+    (void)impl;
+#endif
+    return compress_scalar;
+}
+
+void diram_sha256(const void* data, size_t len, uint8_t digest[DIRAM_SHA256_DIGEST_LEN]) {
+    diram_sha256_impl_t impl = diram_sha256_active_impl();
+#ifdef DIRAM_SHA256_X86
+    if (impl == DIRAM_SHA256_IMPL_AVX2) {
+        sha256_x8_avx2(&data, &len, 1, (uint8_t (*)[DIRAM_SHA256_DIGEST_LEN])digest);
+        return;
+    }
+#endif
+    sha256_one(single_compress(impl), data, len, digest);
+}
+
+void diram_sha256_to_hex(const uint8_t digest[DIRAM_SHA256_DIGEST_LEN], char hex[65]) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < DIRAM_SHA256_DIGEST_LEN; i++) {
+        hex[i * 2] = digits[digest[i] >> 4];
+        hex[i * 2 + 1] = digits[digest[i] & 0x0F];
+    }
+    hex[64] = '\0';
+}
+
+void diram_sha256_hex(const void* data, size_t len, char hex[65]) {
+    uint8_t digest[DIRAM_SHA256_DIGEST_LEN];
+    diram_sha256(data, len, digest);
+    diram_sha256_to_hex(digest, hex);
+}
+
+void diram_sha256_batch(const void* const* data,
+                        const size_t* lens,
+                        size_t count,
+                        uint8_t (*digests)[DIRAM_SHA256_DIGEST_LEN]) {
+    if (!data || !lens || !digests) return;
+
+    diram_sha256_impl_t impl = diram_sha256_active_batch_impl();
+    size_t i = 0;
+
+#ifdef DIRAM_SHA256_X86
+    if (impl == DIRAM_SHA256_IMPL_AVX2) {
+        for (; i < count; i += DIRAM_SHA256_LANES) {
+            size_t lanes = count - i < DIRAM_SHA256_LANES ? count - i : DIRAM_SHA256_LANES;
+            sha256_x8_avx2(data + i, lens + i, (int)lanes, digests + i);
+        }
+        return;
+    }
+#endif
+
+    sha256_compress_fn compress = single_compress(impl);
+    for (; i < count; i++) {
+        sha256_one(compress, data[i], lens[i], digests[i]);
+    }
+}
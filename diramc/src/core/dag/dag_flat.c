@@ -0,0 +1,240 @@
+// src/core/dag/dag_flat.c
+// OBINexus DIRAM Flat DAG
+// Rows keep slack so most appends write in place. A full row is copied
+// to the end of the edge arrays with double the room and its old slots
+// are abandoned; compaction reclaims them once they outnumber live
+// edges, which keeps appends amortised O(1) and the arrays within ~3x
+// of the live edge count.
+#include "diram/core/dag/dag_flat.h"
+#include "diram/core/dag/phenotype_similarity.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int grow_array(void** array, size_t elem, uint32_t capacity) {
+    void* grown = realloc(*array, (size_t)capacity * elem);
+    if (!grown) return -1;
+    *array = grown;
+    return 0;
+}
+
+static int grow_nodes(diram_flat_dag_t* dag, uint32_t capacity) {
+    if (grow_array((void**)&dag->rows, sizeof(diram_flat_row_t), capacity) ||
+        grow_array((void**)&dag->node_axial, sizeof(axial_state_t), capacity) ||
+        grow_array((void**)&dag->node_stability, sizeof(float), capacity) ||
+        grow_array((void**)&dag->node_observations, sizeof(uint32_t), capacity)) {
+        return -1;
+    }
+    dag->node_capacity = capacity;
+    return 0;
+}
+
+static int grow_edges(diram_flat_dag_t* dag, uint32_t capacity) {
+    if (grow_array((void**)&dag->edge_trigger, sizeof(uint32_t), capacity) ||
+        grow_array((void**)&dag->edge_probability, sizeof(float), capacity) ||
+        grow_array((void**)&dag->edge_target, sizeof(uint32_t), capacity) ||
+        grow_array((void**)&dag->edge_traversals, sizeof(uint32_t), capacity)) {
+        return -1;
+    }
+    dag->edge_capacity = capacity;
+    return 0;
+}
+
+diram_flat_dag_t* diram_flat_dag_create(uint32_t node_hint, uint32_t edge_hint) {
+    diram_flat_dag_t* dag = calloc(1, sizeof(diram_flat_dag_t));
+    if (!dag) return NULL;
+
+    if (grow_nodes(dag, node_hint ? node_hint : 64) != 0 ||
+        grow_edges(dag, edge_hint ? edge_hint : 256) != 0) {
+        diram_flat_dag_destroy(dag);
+        return NULL;
+    }
+    return dag;
+}
+
+void diram_flat_dag_destroy(diram_flat_dag_t* dag) {
+    if (!dag) return;
+    free(dag->rows);
+    free(dag->node_axial);
+    free(dag->node_stability);
+    free(dag->node_observations);
+    free(dag->edge_trigger);
+    free(dag->edge_probability);
+    free(dag->edge_target);
+    free(dag->edge_traversals);
+    free(dag);
+}
+
+uint32_t diram_flat_dag_add_node(diram_flat_dag_t* dag, phenotype_t pheno, axial_state_t axial) {
+    if (!dag || dag->node_count == DIRAM_FLAT_DAG_NONE) return DIRAM_FLAT_DAG_NONE;
+
+    if (dag->node_count == dag->node_capacity &&
+        grow_nodes(dag, dag->node_capacity * 2) != 0) {
+        return DIRAM_FLAT_DAG_NONE;
+    }
+
+    uint32_t id = dag->node_count++;
+    dag->rows[id] = (diram_flat_row_t){ .pheno = pheno.raw };
+    dag->node_axial[id] = axial;
+    dag->node_stability[id] = 1.0f;
+    dag->node_observations[id] = 0;
+    return id;
+}
+
+int diram_flat_dag_compact(diram_flat_dag_t* dag) {
+    if (!dag) return -1;
+
+    uint32_t capacity = dag->edge_capacity;
+    uint32_t* trigger = malloc((size_t)capacity * sizeof(uint32_t));
+    float* probability = malloc((size_t)capacity * sizeof(float));
+    uint32_t* target = malloc((size_t)capacity * sizeof(uint32_t));
+    uint32_t* traversals = malloc((size_t)capacity * sizeof(uint32_t));
+    if (!trigger || !probability || !target || !traversals) {
+        free(trigger);
+        free(probability);
+        free(target);
+        free(traversals);
+        return -1;
+    }
+
+    uint32_t used = 0;
+    for (uint32_t n = 0; n < dag->node_count; n++) {
+        uint32_t begin = dag->rows[n].begin;
+        uint32_t count = dag->rows[n].count;
+        memcpy(&trigger[used], &dag->edge_trigger[begin], count * sizeof(uint32_t));
+        memcpy(&probability[used], &dag->edge_probability[begin], count * sizeof(float));
+        memcpy(&target[used], &dag->edge_target[begin], count * sizeof(uint32_t));
+        memcpy(&traversals[used], &dag->edge_traversals[begin], count * sizeof(uint32_t));
+        dag->rows[n].begin = used;
+        used += dag->rows[n].capacity;
+    }
+
+    free(dag->edge_trigger);
+    free(dag->edge_probability);
+    free(dag->edge_target);
+    free(dag->edge_traversals);
+    dag->edge_trigger = trigger;
+    dag->edge_probability = probability;
+    dag->edge_target = target;
+    dag->edge_traversals = traversals;
+    dag->edge_used = used;
+    dag->edge_dead = 0;
+    return 0;
+}
+
+// Give `node` a row of `capacity` slots at the end of the edge arrays
+static int move_row(diram_flat_dag_t* dag, uint32_t node, uint32_t capacity) {
+    if ((uint64_t)dag->edge_used + capacity > dag->edge_capacity) {
+        if (dag->edge_dead > dag->edge_count) diram_flat_dag_compact(dag);
+        if ((uint64_t)dag->edge_used + capacity > dag->edge_capacity) {
+            uint64_t grown = (uint64_t)dag->edge_capacity * 2;
+            if (grown < (uint64_t)dag->edge_used + capacity) grown = (uint64_t)dag->edge_used + capacity;
+            if (grown > UINT32_MAX || grow_edges(dag, (uint32_t)grown) != 0) return -1;
+        }
+    }
+
+    diram_flat_row_t* row = &dag->rows[node];
+    uint32_t from = row->begin;
+    uint32_t to = dag->edge_used;
+    uint32_t count = row->count;
+    memcpy(&dag->edge_trigger[to], &dag->edge_trigger[from], count * sizeof(uint32_t));
+    memcpy(&dag->edge_probability[to], &dag->edge_probability[from], count * sizeof(float));
+    memcpy(&dag->edge_target[to], &dag->edge_target[from], count * sizeof(uint32_t));
+    memcpy(&dag->edge_traversals[to], &dag->edge_traversals[from], count * sizeof(uint32_t));
+
+    dag->edge_dead += row->capacity;
+    row->begin = to;
+    row->capacity = capacity;
+    dag->edge_used += capacity;
+    return 0;
+}
+
+int diram_flat_dag_add_edge(diram_flat_dag_t* dag, uint32_t from, uint32_t to,
+                            phenotype_t trigger, float probability) {
+    if (!dag || from >= dag->node_count || to >= dag->node_count) return -1;
+
+    if (dag->rows[from].count == dag->rows[from].capacity) {
+        uint32_t capacity = dag->rows[from].capacity ?
+                            dag->rows[from].capacity * 2 : DIRAM_FLAT_DAG_ROW_MIN;
+        if (move_row(dag, from, capacity) != 0) return -1;
+    }
+
+    uint32_t slot = dag->rows[from].begin + dag->rows[from].count++;
+    dag->edge_trigger[slot] = trigger.raw;
+    dag->edge_probability[slot] = probability;
+    dag->edge_target[slot] = to;
+    dag->edge_traversals[slot] = 0;
+    dag->edge_count++;
+    return 0;
+}
+
+// Matches compute_phenotype_similarity exactly
+static inline float similarity(uint32_t a, uint32_t b) {
+    return 1.0f - (float)__builtin_popcount(a ^ b) / 32.0f;
+}
+
+uint32_t diram_flat_dag_navigate(diram_flat_dag_t* dag, uint32_t start, phenotype_t target,
+                                 float threshold, uint32_t max_depth) {
+    if (!dag || start >= dag->node_count) return DIRAM_FLAT_DAG_NONE;
+
+    uint32_t current = start;
+    uint32_t depth = 0;
+
+    while (depth < max_depth) {
+        uint32_t begin = dag->rows[current].begin;
+        uint32_t count = dag->rows[current].count;
+        const uint32_t* triggers = &dag->edge_trigger[begin];
+        const float* probabilities = &dag->edge_probability[begin];
+
+        // Find best matching edge based on phenomenological distance
+        uint32_t best = DIRAM_FLAT_DAG_NONE;
+        float best_score = 0.0f;
+        if (count > DIRAM_SIMILARITY_BATCH_MIN) {
+            // Wide fan-out: score the trigger row in vector batches
+            float sims[DIRAM_SIMILARITY_CHUNK];
+            for (uint32_t base = 0; base < count; base += DIRAM_SIMILARITY_CHUNK) {
+                uint32_t n = count - base < DIRAM_SIMILARITY_CHUNK ? count - base : DIRAM_SIMILARITY_CHUNK;
+                diram_phenotype_similarity_batch(target.raw, &triggers[base], n, sims);
+                for (uint32_t i = 0; i < n; i++) {
+                    float score = sims[i] * probabilities[base + i];
+                    if (score > best_score && score > threshold) {
+                        best_score = score;
+                        best = base + i;
+                    }
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < count; i++) {
+                float score = similarity(triggers[i], target.raw) * probabilities[i];
+                if (score > best_score && score > threshold) {
+                    best_score = score;
+                    best = i;
+                }
+            }
+        }
+
+        if (best == DIRAM_FLAT_DAG_NONE) {
+            // No suitable transition found - create new state
+            uint32_t state = diram_flat_dag_add_node(dag, target,
+                compute_axial_state(target, dag->node_axial[current]));
+            if (state == DIRAM_FLAT_DAG_NONE) return current;
+            diram_flat_dag_add_edge(dag, current, state, target, 0.5f);
+            return state;
+        }
+
+        // Traverse edge; start pulling the next row in while we check arrival
+        current = dag->edge_target[begin + best];
+        dag->edge_traversals[begin + best]++;
+        depth++;
+
+        uint32_t next_begin = dag->rows[current].begin;
+        __builtin_prefetch(&dag->edge_trigger[next_begin]);
+        __builtin_prefetch(&dag->edge_probability[next_begin]);
+        __builtin_prefetch(&dag->edge_target[next_begin]);
+
+        if (similarity(dag->rows[current].pheno, target.raw) > 0.95f) {
+            return current;
+        }
+    }
+
+    return current;
+}
@@ -0,0 +1,553 @@
+// src/core/dag/dag_optimize.c
+// OBINexus DIRAM DAG Optimizer
+// A pass is a small state machine advanced one slice at a time under the
+// writer lock. Readers keep walking throughout: pruned rows are republished
+// as copies, and nothing is freed until the reader epoch has moved twice
+// past the point it became unreachable.
+#include "diram/core/dag/dag_optimize.h"
+#include "diram/core/dag/dag_internal.h"
+#include "diram/core/dag/phenotype_similarity.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+
+typedef enum {
+    OPT_PRUNE,
+    OPT_MARK_BEGIN,
+    OPT_MARK,
+    OPT_SWEEP,
+    OPT_CONDEMN_WAIT,
+    OPT_RECHECK,
+    OPT_DYING_WAIT,
+    OPT_FREE,
+    OPT_DONE
+} diram_dag_opt_phase_t;
+
+typedef struct {
+    dag_node_t** items;
+    uint32_t count;
+    uint32_t capacity;
+} diram_dag_node_stack_t;
+
+struct diram_dag_optimizer {
+    diram_dag_optimize_config_t config;
+    diram_dag_optimize_stats_t stats;
+
+    diram_dag_opt_phase_t phase;
+    uint32_t cursor;
+    uint64_t wait_epoch;
+    bool incomplete;                    // a push failed; this pass condemns nothing
+
+    diram_dag_node_stack_t gray;        // marked, edges not yet scanned
+    diram_dag_node_stack_t condemned;   // out of the graph, not yet freed
+
+    // Per-row scratch for pruning
+    uint8_t* keep;
+    uint32_t keep_capacity;
+
+    pthread_t thread;
+    bool running;
+    bool stop;
+};
+
+typedef struct {
+    uint32_t count;
+    dag_edge_t* edges[];
+} diram_dag_pruned_t;
+
+static const diram_dag_optimize_config_t default_config = {
+    .min_probability = DIRAM_DAG_OPT_MIN_PROBABILITY,
+    .min_traversals = DIRAM_DAG_OPT_MIN_TRAVERSALS,
+    .merge_similarity = DIRAM_DAG_OPT_MERGE_SIMILARITY,
+    .renormalize_weight = DIRAM_DAG_OPT_RENORM_WEIGHT,
+    .slice_budget = DIRAM_DAG_OPT_SLICE_BUDGET,
+    .interval_ms = DIRAM_DAG_OPT_INTERVAL_MS,
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int stack_push(diram_dag_node_stack_t* stack, dag_node_t* node) {
+    if (stack->count == stack->capacity) {
+        uint32_t capacity = stack->capacity ? stack->capacity * 2 : 256;
+        dag_node_t** grown = realloc(stack->items, capacity * sizeof(dag_node_t*));
+        if (!grown) return -1;
+        stack->items = grown;
+        stack->capacity = capacity;
+    }
+    stack->items[stack->count++] = node;
+    return 0;
+}
+
+// Caller holds write_lock
+static struct diram_dag_optimizer* optimizer_get(diram_dag_t* dag) {
+    if (!dag->optimizer) {
+        dag->optimizer = calloc(1, sizeof(struct diram_dag_optimizer));
+        if (dag->optimizer) dag->optimizer->config = default_config;
+    }
+    return dag->optimizer;
+}
+
+static void release_pruned(void* ptr) {
+    diram_dag_pruned_t* pruned = ptr;
+    for (uint32_t i = 0; i < pruned->count; i++) {
+        free(pruned->edges[i]);
+    }
+    free(pruned);
+}
+
+static void store_probability(dag_edge_t* edge, float probability) {
+    __atomic_store(&edge->probability, &probability, __ATOMIC_RELAXED);
+}
+
+// ============================================================================
+// Prune, merge, re-weight
+// ============================================================================
+
+// Returns the work done, in edges
+static uint32_t prune_row(diram_dag_t* dag, struct diram_dag_optimizer* opt, dag_node_t* node) {
+    const diram_dag_optimize_config_t* cfg = &opt->config;
+    uint32_t count = node->edge_count;
+    dag_edge_t** edges = node->edges;
+    if (count == 0) return 1;
+
+    if (count > opt->keep_capacity) {
+        uint8_t* grown = realloc(opt->keep, count);
+        if (!grown) return count;
+        opt->keep = grown;
+        opt->keep_capacity = count;
+    }
+    uint8_t* keep = opt->keep;
+    uint32_t work = count;
+    uint32_t removed = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t traversals = __atomic_load_n(&edges[i]->traversal_count, __ATOMIC_RELAXED);
+        keep[i] = edges[i]->probability >= cfg->min_probability ||
+                  traversals >= cfg->min_traversals;
+        if (!keep[i]) removed++;
+    }
+    opt->stats.edges_pruned += removed;
+
+    // Siblings leading to the same phenomenon compete for every target that
+    // matches one of them; fold them into the better-travelled edge
+    if (count <= DIRAM_DAG_OPT_MERGE_MAX_ROW && cfg->merge_similarity <= 1.0f) {
+        for (uint32_t i = 0; i < count; i++) {
+            if (!keep[i]) continue;
+            for (uint32_t j = i + 1; j < count; j++) {
+                if (!keep[j]) continue;
+                if (compute_phenotype_similarity(edges[i]->to->phenotype,
+                                                 edges[j]->to->phenotype) < cfg->merge_similarity) {
+                    continue;
+                }
+
+                uint32_t ti = __atomic_load_n(&edges[i]->traversal_count, __ATOMIC_RELAXED);
+                uint32_t tj = __atomic_load_n(&edges[j]->traversal_count, __ATOMIC_RELAXED);
+                uint32_t survivor = tj > ti ? j : i;
+                uint32_t loser = survivor == i ? j : i;
+
+                // Either transition firing now counts for the survivor
+                float p = 1.0f - (1.0f - edges[i]->probability) * (1.0f - edges[j]->probability);
+                store_probability(edges[survivor], p);
+                __atomic_fetch_add(&edges[survivor]->traversal_count, survivor == i ? tj : ti,
+                                   __ATOMIC_RELAXED);
+                keep[loser] = 0;
+                removed++;
+                opt->stats.edges_merged++;
+                if (loser == i) break;
+            }
+        }
+        work += count * count / 16;
+    }
+
+    // Pull probabilities towards each edge's share of the row's traffic,
+    // then age the counts so stale transitions eventually fall below the
+    // thresholds
+    uint32_t max_traversals = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t t = __atomic_load_n(&edges[i]->traversal_count, __ATOMIC_RELAXED);
+        if (keep[i] && t > max_traversals) max_traversals = t;
+    }
+    if (cfg->renormalize_weight > 0.0f && max_traversals >= DIRAM_DAG_OPT_RENORM_EVIDENCE) {
+        float w = cfg->renormalize_weight;
+        for (uint32_t i = 0; i < count; i++) {
+            if (!keep[i]) continue;
+            uint32_t t = __atomic_load_n(&edges[i]->traversal_count, __ATOMIC_RELAXED);
+            store_probability(edges[i], (1.0f - w) * edges[i]->probability +
+                                        w * (float)t / (float)max_traversals);
+            __atomic_fetch_sub(&edges[i]->traversal_count, t / 2, __ATOMIC_RELAXED);
+            opt->stats.edges_renormalized++;
+        }
+    }
+
+    if (removed == 0) return work;
+
+    // Same capacity, so a reader still holding an older, longer count stays
+    // in bounds: survivors first, the removed edges behind them, then the
+    // old tail untouched
+    dag_edge_t** row = malloc(node->edge_capacity * sizeof(dag_edge_t*));
+    diram_dag_pruned_t* pruned = malloc(sizeof(diram_dag_pruned_t) + removed * sizeof(dag_edge_t*));
+    if (!row || !pruned) {
+        free(row);
+        free(pruned);
+        return work;
+    }
+
+    uint32_t kept = 0;
+    pruned->count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (keep[i]) row[kept++] = edges[i];
+        else pruned->edges[pruned->count++] = edges[i];
+    }
+    memcpy(row + kept, pruned->edges, removed * sizeof(dag_edge_t*));
+    memcpy(row + count, edges + count, (node->edge_capacity - count) * sizeof(dag_edge_t*));
+
+    __atomic_store_n(&node->edges, row, __ATOMIC_RELEASE);
+    __atomic_store_n(&node->edge_count, kept, __ATOMIC_RELEASE);
+    __atomic_store_n(&dag->edge_count, dag->edge_count - removed, __ATOMIC_RELAXED);
+    diram_dag_retire(dag, edges, free);
+    diram_dag_retire(dag, pruned, release_pruned);
+    opt->stats.bytes_reclaimed += (uint64_t)removed * sizeof(dag_edge_t);
+    return work;
+}
+
+// ============================================================================
+// Mark and sweep
+// ============================================================================
+
+void diram_dag_optimizer_shade(diram_dag_t* dag, dag_node_t* node) {
+    struct diram_dag_optimizer* opt = dag->optimizer;
+    node->mark = dag->mark_pass;
+    if (stack_push(&opt->gray, node) != 0) opt->incomplete = true;
+}
+
+static uint32_t mark_slice(diram_dag_t* dag, struct diram_dag_optimizer* opt, uint32_t budget) {
+    uint32_t work = 0;
+    while (opt->gray.count && work < budget) {
+        dag_node_t* node = opt->gray.items[--opt->gray.count];
+        for (uint32_t i = 0; i < node->edge_count; i++) {
+            dag_node_t* to = node->edges[i]->to;
+            if (to->mark != dag->mark_pass) diram_dag_optimizer_shade(dag, to);
+        }
+        work += node->edge_count + 1;
+    }
+    return work;
+}
+
+static uint32_t sweep_slice(diram_dag_t* dag, struct diram_dag_optimizer* opt, uint32_t budget) {
+    uint32_t work = 0;
+    while (opt->cursor < dag->node_count && work < budget) {
+        dag_node_t* node = dag->nodes[opt->cursor];
+        work++;
+        if (node == dag->root || node->mark == dag->mark_pass) {
+            opt->cursor++;
+            continue;
+        }
+        if (stack_push(&opt->condemned, node) != 0) {
+            opt->cursor++;
+            continue;
+        }
+
+        // Swap-remove; readers never index dag->nodes
+        uint32_t last = dag->node_count - 1;
+        dag->nodes[opt->cursor] = dag->nodes[last];
+        dag->nodes[opt->cursor]->id = opt->cursor;
+        __atomic_store_n(&dag->node_count, last, __ATOMIC_RELAXED);
+        __atomic_store_n(&dag->edge_count, dag->edge_count - node->edge_count, __ATOMIC_RELAXED);
+        node->mark = DIRAM_DAG_MARK_CONDEMNED;
+        opt->stats.nodes_condemned++;
+    }
+    return work;
+}
+
+// ============================================================================
+// Reclaim
+// ============================================================================
+
+// A held condemned node, and everything condemned it leads to, rejoins
+// the graph
+static void rescue(diram_dag_t* dag, struct diram_dag_optimizer* opt, dag_node_t* node) {
+    __atomic_fetch_and(&node->holds, ~DIRAM_DAG_NODE_DYING, __ATOMIC_RELAXED);
+    node->mark = dag->mark_pass;
+    if (stack_push(&opt->gray, node) != 0) opt->incomplete = true;
+}
+
+static uint32_t recheck_slice(diram_dag_t* dag, struct diram_dag_optimizer* opt, uint32_t budget) {
+    uint32_t work = 0;
+    while (work < budget) {
+        if (opt->gray.count) {
+            dag_node_t* node = opt->gray.items[--opt->gray.count];
+            for (uint32_t i = 0; i < node->edge_count; i++) {
+                dag_node_t* to = node->edges[i]->to;
+                if (to->mark == DIRAM_DAG_MARK_CONDEMNED) rescue(dag, opt, to);
+            }
+            work += node->edge_count + 1;
+            continue;
+        }
+        if (opt->cursor == opt->condemned.count) return work;
+
+        dag_node_t* node = opt->condemned.items[opt->cursor++];
+        work++;
+        if (node->mark != DIRAM_DAG_MARK_CONDEMNED) continue;
+
+        uint32_t expected = 0;
+        if (!__atomic_compare_exchange_n(&node->holds, &expected, DIRAM_DAG_NODE_DYING, false,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            node->mark = dag->mark_pass;
+            if (stack_push(&opt->gray, node) != 0) opt->incomplete = true;
+        }
+    }
+    return work;
+}
+
+// Survivors go back into dag->nodes; only dying nodes stay condemned
+static void recheck_finish(diram_dag_t* dag, struct diram_dag_optimizer* opt) {
+    uint32_t dying = 0;
+    for (uint32_t i = 0; i < opt->condemned.count; i++) {
+        dag_node_t* node = opt->condemned.items[i];
+        if (node->mark == DIRAM_DAG_MARK_CONDEMNED && !opt->incomplete) {
+            opt->condemned.items[dying++] = node;
+            continue;
+        }
+
+        // A survivor - or, after a failed push, nothing here is provably dead
+        __atomic_fetch_and(&node->holds, ~DIRAM_DAG_NODE_DYING, __ATOMIC_RELAXED);
+        node->mark = dag->mark_pass;
+        if (diram_dag_adopt_node(dag, node) == 0) {
+            __atomic_store_n(&dag->edge_count, dag->edge_count + node->edge_count, __ATOMIC_RELAXED);
+            opt->stats.nodes_rescued++;
+        } else {
+            // Not dying, so never freed; adoption is retried next pass
+            opt->condemned.items[dying++] = node;
+        }
+    }
+    opt->condemned.count = dying;
+}
+
+static uint32_t free_slice(struct diram_dag_optimizer* opt, uint32_t budget) {
+    uint32_t work = 0;
+    uint32_t kept = 0;
+    while (opt->cursor < opt->condemned.count && work < budget) {
+        dag_node_t* node = opt->condemned.items[opt->cursor++];
+        if (!(node->holds & DIRAM_DAG_NODE_DYING)) {
+            opt->condemned.items[kept++] = node;
+            continue;
+        }
+        work += node->edge_count + 1;
+        opt->stats.bytes_reclaimed += diram_dag_free_node(node);
+        opt->stats.nodes_reclaimed++;
+    }
+    // Compact what is left so the next slice resumes at `kept`
+    uint32_t rest = opt->condemned.count - opt->cursor;
+    memmove(opt->condemned.items + kept, opt->condemned.items + opt->cursor,
+            rest * sizeof(dag_node_t*));
+    opt->condemned.count = kept + rest;
+    opt->cursor = kept;
+    return work;
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+static bool grace_elapsed(diram_dag_t* dag, struct diram_dag_optimizer* opt) {
+    diram_dag_reclaim(dag);
+    return __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST) >= opt->wait_epoch + 2;
+}
+
+static int step_locked(diram_dag_t* dag, struct diram_dag_optimizer* opt) {
+    uint32_t budget = opt->config.slice_budget ? opt->config.slice_budget : 1;
+    uint32_t work = 0;
+
+    switch (opt->phase) {
+    case OPT_PRUNE:
+        while (opt->cursor < dag->node_count && work < budget) {
+            work += prune_row(dag, opt, dag->nodes[opt->cursor++]);
+        }
+        if (opt->cursor >= dag->node_count) opt->phase = OPT_MARK_BEGIN;
+        return 0;
+
+    case OPT_MARK_BEGIN:
+        if (++dag->mark_pass == DIRAM_DAG_MARK_CONDEMNED) dag->mark_pass = 1;
+        opt->incomplete = false;
+        opt->gray.count = 0;
+        dag->marking = 1;
+        diram_dag_optimizer_shade(dag, dag->root);
+        // Survivors that could not rejoin dag->nodes last pass still count as live
+        for (uint32_t i = 0; i < opt->condemned.count; i++) {
+            diram_dag_optimizer_shade(dag, opt->condemned.items[i]);
+        }
+        opt->phase = OPT_MARK;
+        return 0;
+
+    case OPT_MARK:
+        mark_slice(dag, opt, budget);
+        if (opt->gray.count == 0) {
+            opt->phase = OPT_SWEEP;
+            opt->cursor = 0;
+        }
+        return 0;
+
+    case OPT_SWEEP:
+        if (!opt->incomplete) sweep_slice(dag, opt, budget);
+        if (opt->incomplete || opt->cursor >= dag->node_count) {
+            dag->marking = 0;
+            opt->wait_epoch = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST);
+            opt->phase = opt->condemned.count ? OPT_CONDEMN_WAIT : OPT_DONE;
+        }
+        return 0;
+
+    case OPT_CONDEMN_WAIT:
+        // Readers that entered before the sweep may still be inside
+        if (grace_elapsed(dag, opt)) {
+            opt->phase = OPT_RECHECK;
+            opt->cursor = 0;
+            opt->gray.count = 0;
+        }
+        return 0;
+
+    case OPT_RECHECK:
+        if (opt->cursor < opt->condemned.count || opt->gray.count) {
+            recheck_slice(dag, opt, budget);
+        }
+        if (opt->cursor == opt->condemned.count && opt->gray.count == 0) {
+            recheck_finish(dag, opt);
+            opt->wait_epoch = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST);
+            opt->phase = opt->condemned.count ? OPT_DYING_WAIT : OPT_DONE;
+        }
+        return 0;
+
+    case OPT_DYING_WAIT:
+        // ...and readers that walked onto a node before it was marked dying
+        if (grace_elapsed(dag, opt)) {
+            opt->phase = OPT_FREE;
+            opt->cursor = 0;
+        }
+        return 0;
+
+    case OPT_FREE:
+        free_slice(opt, budget);
+        if (opt->cursor >= opt->condemned.count) opt->phase = OPT_DONE;
+        return 0;
+
+    case OPT_DONE:
+    default:
+        opt->stats.passes++;
+        opt->phase = OPT_PRUNE;
+        opt->cursor = 0;
+        return 1;
+    }
+}
+
+int diram_dag_optimize_configure(diram_dag_t* dag, const diram_dag_optimize_config_t* config) {
+    if (!dag) return -1;
+
+    pthread_mutex_lock(&dag->write_lock);
+    struct diram_dag_optimizer* opt = optimizer_get(dag);
+    if (opt) opt->config = config ? *config : default_config;
+    pthread_mutex_unlock(&dag->write_lock);
+    return opt ? 0 : -1;
+}
+
+int diram_dag_optimize_step(diram_dag_t* dag) {
+    if (!dag) return -1;
+
+    pthread_mutex_lock(&dag->write_lock);
+    uint64_t start = now_ns();
+    struct diram_dag_optimizer* opt = optimizer_get(dag);
+    int rc = opt ? step_locked(dag, opt) : -1;
+    if (opt) {
+        uint64_t pause = now_ns() - start;
+        opt->stats.slices++;
+        opt->stats.total_pause_ns += pause;
+        if (pause > opt->stats.max_pause_ns) opt->stats.max_pause_ns = pause;
+    }
+    pthread_mutex_unlock(&dag->write_lock);
+    return rc;
+}
+
+void diram_dag_optimize(diram_dag_t* dag) {
+    if (!dag) return;
+
+    while (diram_dag_optimize_step(dag) == 0) {
+        // Grace periods need pinned readers to move on
+        sched_yield();
+    }
+}
+
+static void* optimizer_thread(void* arg) {
+    diram_dag_t* dag = arg;
+    struct diram_dag_optimizer* opt = dag->optimizer;
+
+    while (!__atomic_load_n(&opt->stop, __ATOMIC_ACQUIRE)) {
+        diram_dag_optimize_step(dag);
+
+        pthread_mutex_lock(&dag->write_lock);
+        uint32_t ms = opt->config.interval_ms;
+        pthread_mutex_unlock(&dag->write_lock);
+        if (ms == 0) {
+            // Still let writers at the lock between slices
+            sched_yield();
+            continue;
+        }
+        struct timespec pause = { .tv_sec = ms / 1000, .tv_nsec = (long)(ms % 1000) * 1000000L };
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+int diram_dag_optimizer_start(diram_dag_t* dag) {
+    if (!dag) return -1;
+
+    pthread_mutex_lock(&dag->write_lock);
+    struct diram_dag_optimizer* opt = optimizer_get(dag);
+    int rc = -1;
+    if (opt && !opt->running) {
+        opt->stop = false;
+        if (pthread_create(&opt->thread, NULL, optimizer_thread, dag) == 0) {
+            opt->running = true;
+            rc = 0;
+        }
+    }
+    pthread_mutex_unlock(&dag->write_lock);
+    return rc;
+}
+
+void diram_dag_optimizer_stop(diram_dag_t* dag) {
+    if (!dag || !dag->optimizer || !dag->optimizer->running) return;
+
+    struct diram_dag_optimizer* opt = dag->optimizer;
+    __atomic_store_n(&opt->stop, true, __ATOMIC_RELEASE);
+    pthread_join(opt->thread, NULL);
+    opt->running = false;
+}
+
+void diram_dag_optimize_get_stats(diram_dag_t* dag, diram_dag_optimize_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!dag) return;
+
+    pthread_mutex_lock(&dag->write_lock);
+    if (dag->optimizer) *out = dag->optimizer->stats;
+    pthread_mutex_unlock(&dag->write_lock);
+}
+
+// From diram_dag_destroy: no readers, so everything condemned can go
+void diram_dag_optimizer_release(diram_dag_t* dag) {
+    struct diram_dag_optimizer* opt = dag->optimizer;
+    if (!opt) return;
+
+    diram_dag_optimizer_stop(dag);
+    for (uint32_t i = 0; i < opt->condemned.count; i++) {
+        diram_dag_free_node(opt->condemned.items[i]);
+    }
+    free(opt->condemned.items);
+    free(opt->gray.items);
+    free(opt->keep);
+    free(opt);
+    dag->optimizer = NULL;
+}
@@ -0,0 +1,324 @@
+// src/core/dag/dag_snapshot.c
+// OBINexus DIRAM DAG Snapshot Files
+// The writer fills the image through a shared mapping of a temporary file
+// under the DAG's write lock (readers keep walking), hashes it, and
+// renames it over the target so a crash never leaves a half-written
+// snapshot behind. Opening maps the file read-only; nothing is copied
+// until a caller asks for a mutable DAG.
+#include "diram/core/dag/dag_snapshot.h"
+#include "diram/core/dag/phenotype_similarity.h"
+#include "diram/core/crypto/sha256.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+_Static_assert(sizeof(diram_dag_file_header_t) <= DIRAM_DAG_FILE_HEADER_SIZE,
+               "snapshot header outgrew its reserved block");
+
+static inline uint64_t align_up(uint64_t value) {
+    return (value + DIRAM_DAG_FILE_ALIGN - 1) & ~(uint64_t)(DIRAM_DAG_FILE_ALIGN - 1);
+}
+
+static void header_check(const diram_dag_file_header_t* h, uint8_t out[8]) {
+    uint8_t digest[DIRAM_SHA256_DIGEST_LEN];
+    diram_sha256(h, offsetof(diram_dag_file_header_t, header_check), digest);
+    memcpy(out, digest, 8);
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+int diram_dag_serialize(diram_dag_t* dag, const char* filepath) {
+    if (!dag || !filepath) return -1;
+
+    char tmp_path[4096];
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", filepath) >= (int)sizeof(tmp_path)) return -1;
+
+    int fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    pthread_mutex_lock(&dag->write_lock);
+
+    uint32_t node_count = dag->node_count;
+    uint32_t edge_count = dag->edge_count;
+
+    diram_dag_file_header_t h = {0};
+    memcpy(h.magic, DIRAM_DAG_FILE_MAGIC, sizeof(h.magic));
+    h.version = DIRAM_DAG_FILE_VERSION;
+    h.byte_order = DIRAM_DAG_FILE_BYTE_ORDER;
+    h.generation = dag->generation;
+    h.node_count = node_count;
+    h.edge_count = edge_count;
+    h.nodes_offset = DIRAM_DAG_FILE_HEADER_SIZE;
+    h.trigger_offset = align_up(h.nodes_offset + (uint64_t)node_count * sizeof(diram_dag_file_node_t));
+    h.probability_offset = align_up(h.trigger_offset + (uint64_t)edge_count * sizeof(uint32_t));
+    h.target_offset = align_up(h.probability_offset + (uint64_t)edge_count * sizeof(float));
+    h.traversals_offset = align_up(h.target_offset + (uint64_t)edge_count * sizeof(uint32_t));
+    h.file_size = h.traversals_offset + (uint64_t)edge_count * sizeof(uint32_t);
+
+    uint8_t* base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)h.file_size) == 0) {
+        base = mmap(NULL, h.file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (base == MAP_FAILED) {
+        pthread_mutex_unlock(&dag->write_lock);
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+
+    diram_dag_file_node_t* nodes = (diram_dag_file_node_t*)(base + h.nodes_offset);
+    uint32_t* trigger = (uint32_t*)(base + h.trigger_offset);
+    float* probability = (float*)(base + h.probability_offset);
+    uint32_t* target = (uint32_t*)(base + h.target_offset);
+    uint32_t* traversals = (uint32_t*)(base + h.traversals_offset);
+
+    uint32_t e = 0;
+    for (uint32_t i = 0; i < node_count; i++) {
+        dag_node_t* node = dag->nodes[i];
+        nodes[i] = (diram_dag_file_node_t){
+            .phenotype = node->phenotype.raw,
+            .edge_begin = e,
+            .edge_count = node->edge_count,
+            .observation_count = __atomic_load_n(&node->observation_count, __ATOMIC_RELAXED),
+            .axial = node->axial,
+            .observation_confidence = node->observation_confidence,
+            .stability_score = node->stability_score
+        };
+        for (uint32_t j = 0; j < node->edge_count; j++, e++) {
+            dag_edge_t* edge = node->edges[j];
+            trigger[e] = edge->trigger.raw;
+            probability[e] = edge->probability;
+            target[e] = edge->to->id;
+            traversals[e] = __atomic_load_n(&edge->traversal_count, __ATOMIC_RELAXED);
+        }
+    }
+
+    pthread_mutex_unlock(&dag->write_lock);
+
+    int rc = -1;
+    if (e == edge_count) {
+        diram_sha256(base + DIRAM_DAG_FILE_HEADER_SIZE, h.file_size - DIRAM_DAG_FILE_HEADER_SIZE,
+                     h.payload_sha256);
+        header_check(&h, h.header_check);
+        memset(base, 0, DIRAM_DAG_FILE_HEADER_SIZE);
+        memcpy(base, &h, sizeof(h));
+        rc = msync(base, h.file_size, MS_SYNC);
+    }
+
+    munmap(base, h.file_size);
+    if (rc == 0) rc = fsync(fd);
+    close(fd);
+    if (rc == 0) rc = rename(tmp_path, filepath);
+    if (rc != 0) unlink(tmp_path);
+    return rc == 0 ? 0 : -1;
+}
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+static int section_fits(uint64_t offset, uint64_t length, uint64_t size) {
+    return offset >= DIRAM_DAG_FILE_HEADER_SIZE &&
+           offset % DIRAM_DAG_FILE_ALIGN == 0 &&
+           offset <= size && length <= size - offset;
+}
+
+static int map_verify(const diram_dag_map_t* map) {
+    const diram_dag_file_header_t* h = map->header;
+
+    uint8_t digest[DIRAM_SHA256_DIGEST_LEN];
+    diram_sha256(map->base + DIRAM_DAG_FILE_HEADER_SIZE, map->size - DIRAM_DAG_FILE_HEADER_SIZE, digest);
+    if (memcmp(digest, h->payload_sha256, sizeof(digest)) != 0) return -1;
+
+    uint64_t next = 0;
+    for (uint32_t i = 0; i < h->node_count; i++) {
+        if (map->nodes[i].edge_begin != next) return -1;
+        next += map->nodes[i].edge_count;
+    }
+    if (next != h->edge_count) return -1;
+
+    for (uint32_t e = 0; e < h->edge_count; e++) {
+        if (map->edge_target[e] >= h->node_count) return -1;
+    }
+    return 0;
+}
+
+diram_dag_map_t* diram_dag_map_open(const char* filepath, int flags) {
+    if (!filepath) return NULL;
+
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < DIRAM_DAG_FILE_HEADER_SIZE) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    diram_dag_map_t* map = calloc(1, sizeof(diram_dag_map_t));
+    if (!map) {
+        munmap(base, size);
+        return NULL;
+    }
+    map->base = base;
+    map->size = size;
+    map->header = base;
+
+    const diram_dag_file_header_t* h = map->header;
+    uint8_t check[8];
+    header_check(h, check);
+
+    uint64_t edges = h->edge_count;
+    if (memcmp(h->magic, DIRAM_DAG_FILE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->byte_order != DIRAM_DAG_FILE_BYTE_ORDER ||
+        h->version != DIRAM_DAG_FILE_VERSION ||
+        memcmp(check, h->header_check, sizeof(check)) != 0 ||
+        h->file_size != size || h->node_count == 0 ||
+        !section_fits(h->nodes_offset, (uint64_t)h->node_count * sizeof(diram_dag_file_node_t), size) ||
+        !section_fits(h->trigger_offset, edges * sizeof(uint32_t), size) ||
+        !section_fits(h->probability_offset, edges * sizeof(float), size) ||
+        !section_fits(h->target_offset, edges * sizeof(uint32_t), size) ||
+        !section_fits(h->traversals_offset, edges * sizeof(uint32_t), size)) {
+        diram_dag_map_close(map);
+        return NULL;
+    }
+
+    map->nodes = (const diram_dag_file_node_t*)(map->base + h->nodes_offset);
+    map->edge_trigger = (const uint32_t*)(map->base + h->trigger_offset);
+    map->edge_probability = (const float*)(map->base + h->probability_offset);
+    map->edge_target = (const uint32_t*)(map->base + h->target_offset);
+    map->edge_traversals = (const uint32_t*)(map->base + h->traversals_offset);
+
+    if ((flags & DIRAM_DAG_MAP_VERIFY) && map_verify(map) != 0) {
+        diram_dag_map_close(map);
+        return NULL;
+    }
+    return map;
+}
+
+void diram_dag_map_close(diram_dag_map_t* map) {
+    if (!map) return;
+    munmap((void*)map->base, map->size);
+    free(map);
+}
+
+// Unverified maps are bounds-checked as they are walked; a bad index
+// ends the walk where it stands
+uint32_t diram_dag_map_navigate(const diram_dag_map_t* map, uint32_t start, phenotype_t target,
+                                float threshold, uint32_t max_depth) {
+    if (!map || start >= map->header->node_count) return DIRAM_DAG_MAP_NONE;
+
+    uint32_t node_count = map->header->node_count;
+    uint32_t edge_count = map->header->edge_count;
+    uint32_t current = start;
+    float sims[DIRAM_SIMILARITY_CHUNK];
+
+    for (uint32_t depth = 0; depth < max_depth; depth++) {
+        uint32_t begin = map->nodes[current].edge_begin;
+        uint32_t count = map->nodes[current].edge_count;
+        if ((uint64_t)begin + count > edge_count) return current;
+
+        uint32_t best = DIRAM_DAG_MAP_NONE;
+        float best_score = 0.0f;
+        for (uint32_t base = 0; base < count; base += DIRAM_SIMILARITY_CHUNK) {
+            uint32_t n = count - base < DIRAM_SIMILARITY_CHUNK ? count - base : DIRAM_SIMILARITY_CHUNK;
+            const uint32_t* triggers = &map->edge_trigger[begin + base];
+            if (n > DIRAM_SIMILARITY_BATCH_MIN) {
+                diram_phenotype_similarity_batch(target.raw, triggers, n, sims);
+            } else {
+                for (uint32_t i = 0; i < n; i++) {
+                    sims[i] = compute_phenotype_similarity((phenotype_t){ .raw = triggers[i] }, target);
+                }
+            }
+            for (uint32_t i = 0; i < n; i++) {
+                float score = sims[i] * map->edge_probability[begin + base + i];
+                if (score > best_score && score > threshold) {
+                    best_score = score;
+                    best = begin + base + i;
+                }
+            }
+        }
+
+        if (best == DIRAM_DAG_MAP_NONE || map->edge_target[best] >= node_count) return current;
+        current = map->edge_target[best];
+
+        phenotype_t reached = { .raw = map->nodes[current].phenotype };
+        if (compute_phenotype_similarity(reached, target) > 0.95f) return current;
+    }
+    return current;
+}
+
+// ============================================================================
+// Upgrade to a mutable DAG
+// ============================================================================
+
+static void restore_node(dag_node_t* node, const diram_dag_file_node_t* record) {
+    node->phenotype.raw = record->phenotype;
+    node->axial = record->axial;
+    node->observation_count = record->observation_count;
+    node->observation_confidence = record->observation_confidence;
+    node->stability_score = record->stability_score;
+}
+
+diram_dag_t* diram_dag_map_upgrade(const diram_dag_map_t* map) {
+    if (!map) return NULL;
+
+    const diram_dag_file_header_t* h = map->header;
+    diram_dag_t* dag = diram_dag_create();
+    if (!dag) return NULL;
+
+    // Node ids are assigned in insertion order, so file index == id
+    restore_node(dag->root, &map->nodes[0]);
+    for (uint32_t i = 1; i < h->node_count; i++) {
+        dag_node_t* node = diram_dag_add_node(dag, (phenotype_t){ .raw = map->nodes[i].phenotype });
+        if (!node) goto fail;
+        restore_node(node, &map->nodes[i]);
+    }
+
+    for (uint32_t i = 0; i < h->node_count; i++) {
+        uint32_t begin = map->nodes[i].edge_begin;
+        uint32_t count = map->nodes[i].edge_count;
+        if ((uint64_t)begin + count > h->edge_count) goto fail;
+
+        dag_node_t* from = dag->nodes[i];
+        for (uint32_t e = begin; e < begin + count; e++) {
+            if (map->edge_target[e] >= h->node_count ||
+                diram_dag_connect_nodes(dag, from, dag->nodes[map->edge_target[e]],
+                                        (phenotype_t){ .raw = map->edge_trigger[e] },
+                                        map->edge_probability[e]) != 0) {
+                goto fail;
+            }
+            // Everything restored predates the file's generation
+            dag_edge_t* edge = from->edges[from->edge_count - 1];
+            edge->traversal_count = map->edge_traversals[e];
+            edge->generation = 0;
+        }
+    }
+
+    dag->generation = h->generation;
+    return dag;
+
+fail:
+    diram_dag_destroy(dag);
+    return NULL;
+}
+
+diram_dag_t* diram_dag_deserialize(const char* filepath) {
+    diram_dag_map_t* map = diram_dag_map_open(filepath, DIRAM_DAG_MAP_VERIFY);
+    if (!map) return NULL;
+
+    diram_dag_t* dag = diram_dag_map_upgrade(map);
+    diram_dag_map_close(map);
+    return dag;
+}
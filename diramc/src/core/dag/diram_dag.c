@@ -0,0 +1,461 @@
+// src/core/dag/diram_dag.c
+// OBINexus DIRAM Concurrent DAG
+// Readers announce the epoch they entered in and then follow plain
+// acquire loads. The writer only ever appends in place or swaps in a
+// copied edge array; swapped-out arrays wait on the retired list until the
+// global epoch has moved twice past their retirement, which can only happen
+// once every reader that might have loaded them has unpinned.
+#include "diram/core/diram_dag.h"
+#include "diram/core/dag/phenotype_similarity.h"
+#include "diram/core/dag/dag_internal.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+// ============================================================================
+// Epoch-based reclamation
+// ============================================================================
+
+static uint32_t reader_pin(diram_dag_t* dag) {
+    uint32_t start = (uint32_t)((uintptr_t)pthread_self() >> 6) % DIRAM_DAG_READER_SLOTS;
+
+    for (;;) {
+        for (uint32_t n = 0; n < DIRAM_DAG_READER_SLOTS; n++) {
+            uint32_t i = (start + n) % DIRAM_DAG_READER_SLOTS;
+            uint64_t* state = &dag->readers[i].state;
+            if (__atomic_load_n(state, __ATOMIC_RELAXED) != 0) continue;
+
+            uint64_t epoch = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST);
+            uint64_t expected = 0;
+            if (!__atomic_compare_exchange_n(state, &expected, (epoch << 1) | 1, false,
+                                             __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+                continue;
+            }
+
+            // The epoch may have moved before the slot became visible
+            uint64_t now;
+            while ((now = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST)) != epoch) {
+                epoch = now;
+                __atomic_store_n(state, (epoch << 1) | 1, __ATOMIC_SEQ_CST);
+            }
+            return i;
+        }
+        // Every slot holds another reader, never the writer
+        sched_yield();
+    }
+}
+
+static inline void reader_unpin(diram_dag_t* dag, uint32_t slot) {
+    __atomic_store_n(&dag->readers[slot].state, 0, __ATOMIC_RELEASE);
+}
+
+// Free whatever is two epochs old, after advancing the epoch if every
+// pinned reader has caught up
+void diram_dag_reclaim(diram_dag_t* dag) {
+    uint64_t epoch = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST);
+    bool caught_up = true;
+    for (uint32_t i = 0; i < DIRAM_DAG_READER_SLOTS; i++) {
+        uint64_t state = __atomic_load_n(&dag->readers[i].state, __ATOMIC_SEQ_CST);
+        if ((state & 1) && (state >> 1) != epoch) {
+            caught_up = false;
+            break;
+        }
+    }
+    if (caught_up) {
+        __atomic_store_n(&dag->epoch, ++epoch, __ATOMIC_SEQ_CST);
+    }
+
+    diram_dag_retired_t** link = &dag->retired;
+    while (*link) {
+        diram_dag_retired_t* r = *link;
+        if (r->epoch + 2 <= epoch) {
+            *link = r->next;
+            r->release(r->ptr);
+            free(r);
+            dag->retired_count--;
+        } else {
+            link = &r->next;
+        }
+    }
+}
+
+// After `ptr` has been unlinked
+void diram_dag_retire(diram_dag_t* dag, void* ptr, void (*release)(void*)) {
+    diram_dag_retired_t* r = malloc(sizeof(diram_dag_retired_t));
+    if (!r) {
+        // Leaking beats freeing under a reader
+        return;
+    }
+    r->ptr = ptr;
+    r->release = release;
+    r->epoch = __atomic_load_n(&dag->epoch, __ATOMIC_SEQ_CST);
+    r->next = dag->retired;
+    dag->retired = r;
+    dag->retired_count++;
+    diram_dag_reclaim(dag);
+}
+
+void diram_dag_snapshot_begin(diram_dag_t* dag, diram_dag_snapshot_t* snap) {
+    snap->dag = dag;
+    snap->slot = reader_pin(dag);
+    snap->generation = __atomic_load_n(&dag->generation, __ATOMIC_ACQUIRE);
+}
+
+void diram_dag_snapshot_end(diram_dag_snapshot_t* snap) {
+    if (!snap || !snap->dag) return;
+    reader_unpin(snap->dag, snap->slot);
+    snap->dag = NULL;
+}
+
+// ============================================================================
+// Writer path
+// ============================================================================
+
+size_t diram_dag_free_node(dag_node_t* node) {
+    size_t bytes = sizeof(dag_node_t) + (size_t)node->edge_capacity * sizeof(dag_edge_t*) +
+                   (size_t)node->edge_count * sizeof(dag_edge_t);
+    for (uint32_t i = 0; i < node->edge_count; i++) {
+        free(node->edges[i]);
+    }
+    free(node->edges);
+    free(node);
+    return bytes;
+}
+
+int diram_dag_adopt_node(diram_dag_t* dag, dag_node_t* node) {
+    if (dag->node_count == dag->node_capacity) {
+        uint32_t capacity = dag->node_capacity ? dag->node_capacity * 2 : 64;
+        dag_node_t** grown = realloc(dag->nodes, capacity * sizeof(dag_node_t*));
+        if (!grown) return -1;
+        dag->nodes = grown;
+        dag->node_capacity = capacity;
+    }
+
+    node->id = dag->node_count;
+    node->mark = dag->mark_pass;     // born reachable for any pass in progress
+    dag->nodes[dag->node_count] = node;
+    __atomic_store_n(&dag->node_count, dag->node_count + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+static dag_node_t* add_node_locked(diram_dag_t* dag, phenotype_t pheno, axial_state_t axial) {
+    dag_node_t* node = create_dag_node(pheno, axial);
+    if (!node) return NULL;
+    if (!node->edges || diram_dag_adopt_node(dag, node) != 0) {
+        free(node->edges);
+        free(node);
+        return NULL;
+    }
+    return node;
+}
+
+static int connect_locked(diram_dag_t* dag, dag_node_t* from, dag_node_t* to,
+                          phenotype_t trigger, float probability) {
+    // The optimizer has already taken `to` out of the graph
+    if (to->mark == DIRAM_DAG_MARK_CONDEMNED) return -1;
+    if (dag->marking && to->mark != dag->mark_pass) diram_dag_optimizer_shade(dag, to);
+
+    uint32_t count = from->edge_count;
+    dag_edge_t** edges = from->edges;
+
+    dag_edge_t* edge = calloc(1, sizeof(dag_edge_t));
+    if (!edge) return -1;
+
+    if (count == from->edge_capacity) {
+        // Readers may be scanning the full array: publish a copy, retire the original
+        uint32_t capacity = from->edge_capacity ? from->edge_capacity * 2 : 16;
+        dag_edge_t** grown = malloc(capacity * sizeof(dag_edge_t*));
+        if (!grown) {
+            free(edge);
+            return -1;
+        }
+        memcpy(grown, edges, count * sizeof(dag_edge_t*));
+        __atomic_store_n(&from->edges, grown, __ATOMIC_RELEASE);
+        from->edge_capacity = capacity;
+        diram_dag_retire(dag, edges, free);
+        edges = grown;
+    }
+
+    uint64_t generation = dag->generation + 1;
+    edge->from = from;
+    edge->to = to;
+    edge->trigger = trigger;
+    edge->probability = probability;
+    edge->generation = generation;
+
+    // A reader still holding a longer count from before a prune may look here
+    __atomic_store_n(&edges[count], edge, __ATOMIC_RELEASE);
+    __atomic_store_n(&from->edge_count, count + 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&dag->edge_count, dag->edge_count + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&dag->generation, generation, __ATOMIC_RELEASE);
+    return 0;
+}
+
+diram_dag_t* diram_dag_create(void) {
+    diram_dag_t* dag = calloc(1, sizeof(diram_dag_t));
+    if (!dag) return NULL;
+
+    pthread_mutex_init(&dag->write_lock, NULL);
+    dag->threshold = 0.6f;
+    dag->max_depth = DIRAM_DAG_DEFAULT_DEPTH;
+
+    // Root phenomenon - the null state
+    dag->root = add_node_locked(dag, (phenotype_t){ .raw = 0 }, (axial_state_t){0, 0, 0, 0});
+    if (!dag->root) {
+        diram_dag_destroy(dag);
+        return NULL;
+    }
+    return dag;
+}
+
+// No reader may be pinned
+void diram_dag_destroy(diram_dag_t* dag) {
+    if (!dag) return;
+
+    diram_dag_optimizer_release(dag);
+
+    while (dag->retired) {
+        diram_dag_retired_t* r = dag->retired;
+        dag->retired = r->next;
+        r->release(r->ptr);
+        free(r);
+    }
+    for (uint32_t i = 0; i < dag->node_count; i++) {
+        diram_dag_free_node(dag->nodes[i]);
+    }
+    free(dag->nodes);
+    pthread_mutex_destroy(&dag->write_lock);
+    free(dag);
+}
+
+dag_node_t* diram_dag_add_node(diram_dag_t* dag, phenotype_t pheno) {
+    if (!dag) return NULL;
+
+    pthread_mutex_lock(&dag->write_lock);
+    dag_node_t* node = add_node_locked(dag, pheno, compute_axial_state(pheno, dag->root->axial));
+    pthread_mutex_unlock(&dag->write_lock);
+    return node;
+}
+
+int diram_dag_connect_nodes(diram_dag_t* dag, dag_node_t* from, dag_node_t* to,
+                            phenotype_t trigger, float probability) {
+    if (!dag || !from || !to) return -1;
+
+    pthread_mutex_lock(&dag->write_lock);
+    int rc = connect_locked(dag, from, to, trigger, probability);
+    pthread_mutex_unlock(&dag->write_lock);
+    return rc;
+}
+
+// ============================================================================
+// Holds
+// ============================================================================
+
+int diram_dag_hold(diram_dag_t* dag, dag_node_t* node) {
+    if (!dag || !node) return -1;
+
+    uint32_t holds = __atomic_load_n(&node->holds, __ATOMIC_RELAXED);
+    do {
+        if (holds & DIRAM_DAG_NODE_DYING) return -1;
+    } while (!__atomic_compare_exchange_n(&node->holds, &holds, holds + 1, true,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+    return 0;
+}
+
+void diram_dag_release(diram_dag_t* dag, dag_node_t* node) {
+    if (!dag || !node) return;
+    __atomic_fetch_sub(&node->holds, 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+// The optimizer re-weights edges in place
+static inline float edge_probability(const dag_edge_t* edge) {
+    float probability;
+    __atomic_load(&edge->probability, &probability, __ATOMIC_RELAXED);
+    return probability;
+}
+
+static inline dag_edge_t* edge_at(dag_edge_t** edges, uint32_t i) {
+    return __atomic_load_n(&edges[i], __ATOMIC_ACQUIRE);
+}
+
+// Best similarity * probability edge above threshold among those published
+// by `generation`; rows are in publication order so the scan stops early
+static dag_edge_t* select_edge(dag_node_t* node, phenotype_t target, float threshold,
+                               uint64_t generation) {
+    uint32_t count = __atomic_load_n(&node->edge_count, __ATOMIC_ACQUIRE);
+    dag_edge_t** edges = __atomic_load_n(&node->edges, __ATOMIC_ACQUIRE);
+
+    dag_edge_t* best_edge = NULL;
+    float best_score = 0.0f;
+    dag_edge_t* chunk[DIRAM_SIMILARITY_CHUNK];
+    uint32_t triggers[DIRAM_SIMILARITY_CHUNK];
+    float sims[DIRAM_SIMILARITY_CHUNK];
+
+    for (uint32_t base = 0; base < count; base += DIRAM_SIMILARITY_CHUNK) {
+        uint32_t n = count - base;
+        if (n > DIRAM_SIMILARITY_CHUNK) n = DIRAM_SIMILARITY_CHUNK;
+
+        uint32_t visible = 0;
+        while (visible < n) {
+            dag_edge_t* edge = edge_at(edges, base + visible);
+            if (edge->generation > generation) break;
+            chunk[visible] = edge;
+            triggers[visible] = edge->trigger.raw;
+            visible++;
+        }
+
+        if (visible > DIRAM_SIMILARITY_BATCH_MIN) {
+            diram_phenotype_similarity_batch(target.raw, triggers, visible, sims);
+        } else {
+            for (uint32_t i = 0; i < visible; i++) {
+                sims[i] = compute_phenotype_similarity((phenotype_t){ .raw = triggers[i] }, target);
+            }
+        }
+
+        for (uint32_t i = 0; i < visible; i++) {
+            float score = sims[i] * edge_probability(chunk[i]);
+            if (score > best_score && score > threshold) {
+                best_score = score;
+                best_edge = chunk[i];
+            }
+        }
+        if (visible < n) break;
+    }
+    return best_edge;
+}
+
+dag_node_t* diram_dag_navigate(diram_dag_t* dag, dag_node_t* start, phenotype_t target,
+                               float threshold, uint32_t max_depth) {
+    if (!dag) return NULL;
+
+    diram_dag_snapshot_t snap;
+    diram_dag_snapshot_begin(dag, &snap);
+
+    dag_node_t* current = start ? start : dag->root;
+    uint32_t depth = 0;
+
+    while (depth < max_depth) {
+        dag_edge_t* best_edge = select_edge(current, target, threshold, snap.generation);
+
+        if (!best_edge) {
+            // No suitable transition found - create new state
+            pthread_mutex_lock(&dag->write_lock);
+            dag_node_t* state = add_node_locked(dag, target,
+                compute_axial_state(target, current->axial));
+            if (state && connect_locked(dag, current, state, target, 0.5f) == 0) {
+                current = state;
+            }
+            pthread_mutex_unlock(&dag->write_lock);
+            break;
+        }
+
+        // Traverse edge
+        __atomic_fetch_add(&best_edge->traversal_count, 1, __ATOMIC_RELAXED);
+        current = best_edge->to;
+        depth++;
+
+        // Check if we've reached target phenomena
+        if (compute_phenotype_similarity(current->phenotype, target) > 0.95f) {
+            break;
+        }
+    }
+
+    // Hold before unpinning; a state already being reclaimed hands back the root
+    if (diram_dag_hold(dag, current) != 0) {
+        current = dag->root;
+        diram_dag_hold(dag, current);
+    }
+    diram_dag_snapshot_end(&snap);
+    return current;
+}
+
+dag_traversal_context_t* diram_dag_begin_traversal(diram_dag_t* dag) {
+    if (!dag) return NULL;
+
+    dag_traversal_context_t* ctx = calloc(1, sizeof(dag_traversal_context_t));
+    if (!ctx) return NULL;
+
+    diram_dag_snapshot_begin(dag, &ctx->snapshot);
+    ctx->root_node = dag->root;
+    ctx->current_node = dag->root;
+    ctx->max_depth = dag->max_depth;
+    ctx->state = DAG_STATE_IDLE;
+    ctx->cumulative_probability = 1.0f;
+    return ctx;
+}
+
+dag_node_t* diram_dag_traverse_next(dag_traversal_context_t* ctx, phenotype_t pheno) {
+    if (!ctx || ctx->state == DAG_STATE_COMPLETE) return NULL;
+
+    dag_edge_t* edge = select_edge(ctx->current_node, pheno, ctx->snapshot.dag->threshold,
+                                   ctx->snapshot.generation);
+    if (!edge) {
+        ctx->state = DAG_STATE_COMPLETE;
+        return NULL;
+    }
+
+    __atomic_fetch_add(&edge->traversal_count, 1, __ATOMIC_RELAXED);
+    ctx->current_node = edge->to;
+    ctx->cumulative_probability *= edge_probability(edge);
+    ctx->depth++;
+    ctx->state = DAG_STATE_TRAVERSING;
+
+    if (ctx->depth >= ctx->max_depth ||
+        compute_phenotype_similarity(edge->to->phenotype, pheno) > 0.95f) {
+        ctx->state = DAG_STATE_COMPLETE;
+    }
+    return ctx->current_node;
+}
+
+void diram_dag_end_traversal(dag_traversal_context_t* ctx) {
+    if (!ctx) return;
+    diram_dag_snapshot_end(&ctx->snapshot);
+    free(ctx);
+}
+
+phenotype_t diram_dag_predict_next(diram_dag_t* dag, dag_node_t* current) {
+    phenotype_t predicted = { .raw = 0 };
+    if (!dag || !current) return predicted;
+
+    diram_dag_snapshot_t snap;
+    diram_dag_snapshot_begin(dag, &snap);
+
+    uint32_t count = __atomic_load_n(&current->edge_count, __ATOMIC_ACQUIRE);
+    dag_edge_t** edges = __atomic_load_n(&current->edges, __ATOMIC_ACQUIRE);
+    float best = -1.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        // Learned probability, weighted by how often the edge is actually taken
+        dag_edge_t* edge = edge_at(edges, i);
+        uint32_t taken = __atomic_load_n(&edge->traversal_count, __ATOMIC_RELAXED);
+        float weight = edge_probability(edge) * (float)(taken + 1);
+        if (weight > best) {
+            best = weight;
+            predicted = edge->trigger;
+        }
+    }
+
+    diram_dag_snapshot_end(&snap);
+    return predicted;
+}
+
+float diram_dag_get_transition_probability(diram_dag_t* dag, dag_node_t* from, dag_node_t* to) {
+    if (!dag || !from || !to) return 0.0f;
+
+    diram_dag_snapshot_t snap;
+    diram_dag_snapshot_begin(dag, &snap);
+
+    uint32_t count = __atomic_load_n(&from->edge_count, __ATOMIC_ACQUIRE);
+    dag_edge_t** edges = __atomic_load_n(&from->edges, __ATOMIC_ACQUIRE);
+    float probability = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        dag_edge_t* edge = edge_at(edges, i);
+        if (edge->to == to) probability += edge_probability(edge);
+    }
+
+    diram_dag_snapshot_end(&snap);
+    return probability > 1.0f ? 1.0f : probability;
+}
@@ -0,0 +1,148 @@
+// src/core/dag/phenotype_similarity.c
+// OBINexus DIRAM Batch Phenotype Similarity
+// The field layout never matters here: similarity is the Hamming distance
+// over the whole 32-bit word, so each lane is XOR, popcount, convert.
+// Integer-to-float conversion of 0..32 is exact and /32 is a power-of-two
+// scale, so multiplying by 1/32 in a vector lane rounds exactly like the
+// scalar division, and 1 - x is the same single IEEE subtraction.
+//   scalar - portable reference, always available
+//   AVX2   - nibble lookup popcount, 8 lanes, scalar tail
+//   AVX512 - VPOPCNTDQ, 16 lanes, masked tail
+#include "diram/core/dag/phenotype_similarity.h"
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DIRAM_SIMILARITY_X86 1
+#include <immintrin.h>
+#endif
+
+static inline float similarity_scalar(uint32_t a, uint32_t b) {
+    return 1.0f - (float)__builtin_popcount(a ^ b) / 32.0f;
+}
+
+static void batch_scalar(uint32_t target, const uint32_t* phenotypes, size_t count, float* out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = similarity_scalar(phenotypes[i], target);
+    }
+}
+
+#ifdef DIRAM_SIMILARITY_X86
+__attribute__((target("avx2")))
+static void batch_avx2(uint32_t target, const uint32_t* phenotypes, size_t count, float* out) {
+    const __m256i nibbles = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                             0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0F);
+    const __m256i ones8 = _mm256_set1_epi8(1);
+    const __m256i ones16 = _mm256_set1_epi16(1);
+    const __m256i t = _mm256_set1_epi32((int)target);
+    const __m256 scale = _mm256_set1_ps(1.0f / 32.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i diff = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(phenotypes + i)), t);
+        __m256i lo = _mm256_and_si256(diff, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(diff, 4), low_mask);
+        __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(nibbles, lo),
+                                        _mm256_shuffle_epi8(nibbles, hi));
+        __m256i bits = _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, ones8), ones16);
+        __m256 distance = _mm256_mul_ps(_mm256_cvtepi32_ps(bits), scale);
+        _mm256_storeu_ps(out + i, _mm256_sub_ps(one, distance));
+    }
+    batch_scalar(target, phenotypes + i, count - i, out + i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static void batch_avx512(uint32_t target, const uint32_t* phenotypes, size_t count, float* out) {
+    const __m512i t = _mm512_set1_epi32((int)target);
+    const __m512 scale = _mm512_set1_ps(1.0f / 32.0f);
+    const __m512 one = _mm512_set1_ps(1.0f);
+
+    for (size_t i = 0; i < count; i += 16) {
+        __mmask16 lanes = count - i >= 16 ? (__mmask16)0xFFFF
+                                          : (__mmask16)((1u << (count - i)) - 1);
+        __m512i diff = _mm512_xor_si512(_mm512_maskz_loadu_epi32(lanes, phenotypes + i), t);
+        __m512 distance = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_popcnt_epi32(diff)), scale);
+        _mm512_mask_storeu_ps(out + i, lanes, _mm512_sub_ps(one, distance));
+    }
+}
+#endif
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static atomic_int g_impl = DIRAM_SIMILARITY_IMPL_AUTO;
+
+int diram_similarity_supported(diram_similarity_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SIMILARITY_IMPL_AUTO:
+        case DIRAM_SIMILARITY_IMPL_SCALAR:
+            return 1;
+#ifdef DIRAM_SIMILARITY_X86
+        case DIRAM_SIMILARITY_IMPL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case DIRAM_SIMILARITY_IMPL_AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq");
+#endif
+        default:
+            return 0;
+    }
+}
+
+static diram_similarity_impl_t similarity_resolve(void) {
+    int impl = atomic_load_explicit(&g_impl, memory_order_relaxed);
+    if (impl != DIRAM_SIMILARITY_IMPL_AUTO) return (diram_similarity_impl_t)impl;
+
+    int best = diram_similarity_supported(DIRAM_SIMILARITY_IMPL_AVX512) ? DIRAM_SIMILARITY_IMPL_AVX512
+             : diram_similarity_supported(DIRAM_SIMILARITY_IMPL_AVX2) ? DIRAM_SIMILARITY_IMPL_AVX2
+             : DIRAM_SIMILARITY_IMPL_SCALAR;
+
+    int expected = DIRAM_SIMILARITY_IMPL_AUTO;
+    atomic_compare_exchange_strong(&g_impl, &expected, best);
+    return (diram_similarity_impl_t)atomic_load_explicit(&g_impl, memory_order_relaxed);
+}
+
+int diram_similarity_force_impl(diram_similarity_impl_t impl) {
+    if (!diram_similarity_supported(impl)) return -1;
+
+    atomic_store(&g_impl, DIRAM_SIMILARITY_IMPL_AUTO);
+    if (impl != DIRAM_SIMILARITY_IMPL_AUTO) atomic_store(&g_impl, impl);
+    similarity_resolve();
+    return 0;
+}
+
+diram_similarity_impl_t diram_similarity_active_impl(void) {
+    return similarity_resolve();
+}
+
+const char* diram_similarity_impl_name(diram_similarity_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SIMILARITY_IMPL_AUTO:   return "auto";
+        case DIRAM_SIMILARITY_IMPL_SCALAR: return "scalar";
+        case DIRAM_SIMILARITY_IMPL_AVX2:   return "avx2-x8";
+        case DIRAM_SIMILARITY_IMPL_AVX512: return "avx512-x16";
+        default:                           return "unknown";
+    }
+}
+
+void diram_phenotype_similarity_batch(uint32_t target, const uint32_t* phenotypes,
+                                      size_t count, float* out) {
+    if (!phenotypes || !out) return;
+
+    switch (similarity_resolve()) {
+#ifdef DIRAM_SIMILARITY_X86
+        case DIRAM_SIMILARITY_IMPL_AVX512:
+            batch_avx512(target, phenotypes, count, out);
+            return;
+        case DIRAM_SIMILARITY_IMPL_AVX2:
+            batch_avx2(target, phenotypes, count, out);
+            return;
+#endif
+        default:
+            batch_scalar(target, phenotypes, count, out);
+            return;
+    }
+}
@@ -4,8 +4,11 @@
 // ============================================================================
 
 #include "diram/core/diram.h"
-#include "diram/core/diram_phenomenological.h"  // Add this first
-#include "diram/core/diram.h"
+#include "diram/core/feature-alloc/prefetch_pool.h"
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+#include "diram/core/diram_dag.h"
+#include "diram/core/observe/observation_ring.h"
+#include "diram/core/observe/phenomena_sampler.h"
 #include <math.h>
 #include <string.h>
 #include <stdlib.h>
@@ -14,16 +17,20 @@
 // Initialize phenomenological observer
 diram_context_t* diram_init(void) {
     diram_context_t* ctx = calloc(1, sizeof(diram_context_t));
+    if (!ctx) return NULL;
     
-    // Create root phenomenon - the null state
-    ctx->dag_root = create_dag_node((phenotype_t){.raw = 0}, 
-                                    (axial_state_t){0, 0, 0, 0});
+    // Phenomenological DAG; its root is the null state
+    ctx->dag = diram_dag_create();
+    ctx->dag_root = ctx->dag->root;
     ctx->current_state = ctx->dag_root;
+    diram_dag_hold(ctx->dag, ctx->current_state);
     
     // Initialize observation apparatus
-    ctx->observation_capacity = 1024;
-    ctx->observation_buffer = calloc(ctx->observation_capacity, 
-                                     sizeof(phenotype_t));
+    ctx->observations = diram_obs_ring_create(DIRAM_OBS_RING_DEFAULT);
+    
+    // Sample page residency, access and writes in the background
+    ctx->sampler = diram_sampler_create(NULL);
+    diram_sampler_start(ctx->sampler);
     
     // Set phenomenological thresholds
     ctx->phenomenon_threshold = 0.6f;  // 60% confidence required
@@ -32,6 +39,16 @@ diram_context_t* diram_init(void) {
     // Initialize triple-stream processor
     ctx->streams = init_triple_streams();
     
+    // Speculative blocks parked by prefetch_by_phenomenon
+    ctx->prefetch_pool = diram_prefetch_pool_create(0, 0, 0);
+    
+    // Request model that decides what to park there
+    ctx->predictor = malloc(sizeof(phenomenon_predictor_t));
+    if (ctx->predictor && diram_predictor_init(ctx->predictor, 0, 0) != 0) {
+        free(ctx->predictor);
+        ctx->predictor = NULL;
+    }
+    
     return ctx;
 }
 
@@ -39,16 +56,21 @@ diram_context_t* diram_init(void) {
 phenotype_t diram_observe(diram_context_t* ctx, void* memory, size_t size) {
     phenotype_t observed = {.raw = 0};
     
-    // Extract temporal phenomena
-    uint64_t access_time = get_memory_access_time(memory);
-    observed.fields.age = compute_age_bucket(access_time);
-    observed.fields.frequency = compute_access_frequency(memory);
-    observed.fields.volatility = measure_change_rate(memory, size);
-    
-    // Extract spatial phenomena
-    observed.fields.locality = compute_spatial_locality(memory);
-    observed.fields.clustering = measure_cluster_density(memory, size);
-    observed.fields.spread = analyze_distribution_pattern(memory, size);
+    // Extract temporal and spatial phenomena: sampled from the page tables
+    // for tracked regions, estimated otherwise
+    diram_region_sample_t sample;
+    if (diram_sampler_lookup(ctx->sampler, memory, &sample) == 0) {
+        observed.raw = sample.phenomena.raw & DIRAM_SAMPLE_FIELD_MASK;
+    } else {
+        uint64_t access_time = get_memory_access_time(memory);
+        observed.fields.age = compute_age_bucket(access_time);
+        observed.fields.frequency = compute_access_frequency(memory);
+        observed.fields.volatility = measure_change_rate(memory, size);
+        
+        observed.fields.locality = compute_spatial_locality(memory);
+        observed.fields.clustering = measure_cluster_density(memory, size);
+        observed.fields.spread = analyze_distribution_pattern(memory, size);
+    }
     
     // Extract causal phenomena (from triple-stream)
     triple_stream_result_t stream_result = query_triple_streams(ctx->streams);
@@ -61,71 +83,63 @@ phenotype_t diram_observe(diram_context_t* ctx, void* memory, size_t size) {
     observed.fields.compliance = verify_governance_state(ctx, memory);
     observed.fields.audit = get_audit_trail_depth(memory);
     
-    // Record observation
-    if (ctx->observation_count < ctx->observation_capacity) {
-        ctx->observation_buffer[ctx->observation_count++] = observed;
-    }
+    // Record observation; the ring keeps the newest and folds the rest
+    // into its running aggregates
+    diram_obs_ring_record(ctx->observations, observed);
     
     return observed;
 }
 
-// Navigate DAG based on observed phenomena
+// Navigate DAG based on observed phenomena - readers walk lock-free and
+// only a missing transition goes through the DAG's single-writer path
 dag_node_t* diram_navigate_dag(diram_context_t* ctx, phenotype_t target) {
-    dag_node_t* current = ctx->current_state;
-    uint32_t depth = 0;
-    
-    while (depth < ctx->max_dag_depth) {
-        // Find best matching edge based on phenomenological distance
-        dag_edge_t* best_edge = NULL;
-        float best_score = 0.0f;
-        
-        for (uint32_t i = 0; i < current->edge_count; i++) {
-            dag_edge_t* edge = current->edges[i];
-            
-            // Calculate phenomenological similarity
-            float similarity = compute_phenotype_similarity(edge->trigger, target);
-            float score = similarity * edge->probability;
-            
-            if (score > best_score && score > ctx->phenomenon_threshold) {
-                best_score = score;
-                best_edge = edge;
-            }
-        }
-        
-        if (!best_edge) {
-            // No suitable transition found - create new state
-            dag_node_t* new_state = create_dag_node(target, 
-                compute_axial_state(target, current->axial));
-            add_dag_edge(current, new_state, target, 0.5f);
-            return new_state;
-        }
-        
-        // Traverse edge
-        current = best_edge->to;
-        best_edge->traversal_count++;
-        depth++;
-        
-        // Check if we've reached target phenomena
-        if (compute_phenotype_similarity(current->phenotype, target) > 0.95f) {
-            return current;
-        }
+    return diram_dag_navigate(ctx->dag, ctx->current_state, target,
+                              ctx->phenomenon_threshold, ctx->max_dag_depth);
+}
+
+// Learn the request just made and, once the model is confident enough in
+// the next one, park a block for it. Only a learned size is worth parking,
+// so a guess from the DAG edges alone parks nothing
+static void anticipate_next(diram_context_t* ctx, phenotype_t intent, size_t size) {
+    if (!ctx->predictor || !ctx->prefetch_pool) return;
+    diram_predictor_observe(ctx->predictor, intent, size);
+    
+    phenomenon_prediction_t prediction;
+    diram_dag_snapshot_t snap;
+    diram_dag_snapshot_begin(ctx->dag, &snap);
+    predict_next_phenomenon(ctx->predictor, ctx->current_state, &prediction);
+    diram_dag_snapshot_end(&snap);
+    
+    if (prediction.size > 0 && prediction.confidence >= ctx->phenomenon_threshold) {
+        prefetch_by_phenomenon(ctx, &prediction);
     }
-    
-    return current;  // Return best state found within depth limit
 }
 
 // Allocate memory based on phenomena
 void* diram_alloc(diram_context_t* ctx, size_t size, phenotype_t intent) {
-    // 1. Observe current phenomena
-    phenotype_t current = diram_observe(ctx, NULL, 0);
-    
-    // 2. Navigate DAG to find/create target state
+    // 1. Navigate DAG to find/create target state
     dag_node_t* target_state = diram_navigate_dag(ctx, intent);
     
-    // 3. Compute axial intent vector
+    // 2. Claim a prefetched block, else allocate; unclaimed speculation
+    //    is the first thing given back when memory runs short
+    void* memory = diram_prefetch_pool_take(ctx->prefetch_pool, size);
+    if (!memory) memory = perform_raw_allocation(size);
+    if (!memory && diram_prefetch_pool_reclaim(ctx->prefetch_pool, SIZE_MAX) > 0) {
+        memory = perform_raw_allocation(size);
+    }
+    if (!memory) {
+        diram_dag_release(ctx->dag, target_state);
+        return NULL;
+    }
+    
+    // 3. Observe the block itself: sampled if its pages are already
+    //    tracked, estimated from its address otherwise
+    phenotype_t current = diram_observe(ctx, memory, size);
+    
+    // 4. Compute axial intent vector
     axial_state_t axial = compute_axial_intent(current, intent, target_state);
     
-    // 4. Query triple-stream for verification
+    // 5. Query triple-stream for verification
     triple_stream_result_t verification = {
         .stream_a = encode_primary_intent(axial.x_intent),
         .stream_b = encode_verification(axial.y_verify),
@@ -133,55 +147,44 @@ void* diram_alloc(diram_context_t* ctx, size_t size, phenotype_t intent) {
     };
     
     if (!verify_triple_stream(ctx->streams, &verification)) {
+        free(memory);
+        diram_dag_release(ctx->dag, target_state);
+        anticipate_next(ctx, intent, size);
         return NULL;  // Triple-stream verification failed
     }
     
-    // 5. Perform actual allocation with phenomena tracking
-    void* memory = perform_raw_allocation(size);
-    if (!memory) return NULL;
-    
-    // 6. Tag memory with phenomena
+    // 6. Tag memory with phenomena; whole pages are worth sampling
     tag_memory_with_phenotype(memory, size, intent);
+    if (size >= DIRAM_SAMPLER_MIN_REGION) diram_sampler_track(ctx->sampler, memory, size);
     
-    // 7. Update DAG with observation
+    // 7. Update DAG with observation; the held state keeps the optimizer off it
+    diram_dag_release(ctx->dag, ctx->current_state);
     ctx->current_state = target_state;
-    target_state->observation_count++;
+    __atomic_fetch_add(&target_state->observation_count, 1, __ATOMIC_RELAXED);
+    
+    // 8. Learn the request and park a block for the likely next one
+    anticipate_next(ctx, intent, size);
     
     return memory;
 }
 
-// Compute phenomenological similarity (0.0 to 1.0)
-float compute_phenotype_similarity(phenotype_t a, phenotype_t b) {
-    uint32_t diff = a.raw ^ b.raw;  // XOR to find differences
-    uint32_t bit_distance = __builtin_popcount(diff);  // Count differing bits
-    return 1.0f - (float)bit_distance / 32.0f;
+// Free memory from diram_alloc; sampled regions stop being tracked first
+void diram_free(diram_context_t* ctx, void* memory) {
+    if (!memory) return;
+    if (ctx) diram_sampler_untrack(ctx->sampler, memory);
+    free(memory);
 }
 
-// Compute axial state from phenomena
-axial_state_t compute_axial_state(phenotype_t pheno, axial_state_t previous) {
-    axial_state_t state;
-    
-    // Map phenomena to 3D intent space
-    state.x_intent = (pheno.fields.intent << 8) | 
-                     (pheno.fields.frequency << 4) | 
-                     pheno.fields.age;
-    
-    state.y_verify = (pheno.fields.locality << 8) | 
-                     (pheno.fields.clustering << 6) | 
-                     (pheno.fields.dependency << 2) | 
-                     pheno.fields.necessity;
-    
-    state.z_govern = (pheno.fields.authority << 8) | 
-                     (pheno.fields.compliance << 6) | 
-                     (pheno.fields.audit << 3) | 
-                     pheno.fields.volatility;
-    
-    // Compute magnitude as distance from previous state
-    uint32_t dx = abs((int)state.x_intent - (int)previous.x_intent);
-    uint32_t dy = abs((int)state.y_verify - (int)previous.y_verify);
-    uint32_t dz = abs((int)state.z_govern - (int)previous.z_govern);
-    
-    state.magnitude = (uint32_t)sqrt(dx*dx + dy*dy + dz*dz);
-    
-    return state;
+// Tear down the observer: the sampler thread stops before anything it
+// reads is released, and parked speculative blocks are freed with the pool
+void diram_destroy(diram_context_t* ctx) {
+    if (!ctx) return;
+    diram_sampler_destroy(ctx->sampler);
+    diram_prefetch_pool_destroy(ctx->prefetch_pool);
+    diram_predictor_destroy(ctx->predictor);
+    free(ctx->predictor);
+    diram_obs_ring_destroy(ctx->observations);
+    diram_dag_destroy(ctx->dag);
+    free(ctx->streams);
+    free(ctx);
 }
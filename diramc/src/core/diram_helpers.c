@@ -1,6 +1,7 @@
 // src/core/diram_helpers.c - Helper function implementations
 // OBINexus DIRAM Phenomenological Memory Allocator
 #include "diram/core/diram_phenomenological.h"
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -37,6 +38,42 @@ void add_dag_edge(dag_node_t* from, dag_node_t* to, phenotype_t trigger, float p
     from->edges[from->edge_count++] = edge;
 }
 
+// Compute phenomenological similarity (0.0 to 1.0)
+float compute_phenotype_similarity(phenotype_t a, phenotype_t b) {
+    uint32_t diff = a.raw ^ b.raw;  // XOR to find differences
+    uint32_t bit_distance = __builtin_popcount(diff);  // Count differing bits
+    return 1.0f - (float)bit_distance / 32.0f;
+}
+
+// Compute axial state from phenomena
+axial_state_t compute_axial_state(phenotype_t pheno, axial_state_t previous) {
+    axial_state_t state;
+    
+    // Map phenomena to 3D intent space
+    state.x_intent = (pheno.fields.intent << 8) | 
+                     (pheno.fields.frequency << 4) | 
+                     pheno.fields.age;
+    
+    state.y_verify = (pheno.fields.locality << 8) | 
+                     (pheno.fields.clustering << 6) | 
+                     (pheno.fields.dependency << 2) | 
+                     pheno.fields.necessity;
+    
+    state.z_govern = (pheno.fields.authority << 8) | 
+                     (pheno.fields.compliance << 6) | 
+                     (pheno.fields.audit << 3) | 
+                     pheno.fields.volatility;
+    
+    // Compute magnitude as distance from previous state
+    uint32_t dx = abs((int)state.x_intent - (int)previous.x_intent);
+    uint32_t dy = abs((int)state.y_verify - (int)previous.y_verify);
+    uint32_t dz = abs((int)state.z_govern - (int)previous.z_govern);
+    
+    state.magnitude = (uint32_t)sqrt(dx*dx + dy*dy + dz*dz);
+    
+    return state;
+}
+
 // Triple-stream operations aligned with OBINexus architecture
 triple_stream_t* init_triple_streams(void) {
     triple_stream_t* streams = calloc(1, sizeof(triple_stream_t));
@@ -186,12 +223,6 @@ void tag_memory_with_phenotype(void* memory, size_t size, phenotype_t pheno) {
     (void)pheno;
 }
 
-void mark_memory_speculative(void* memory, size_t size) {
-    // Mark for speculative execution
-    (void)memory;
-    (void)size;
-}
-
 // Compute axial intent with OBINexus alignment
 axial_state_t compute_axial_intent(phenotype_t current, phenotype_t intent, dag_node_t* target) {
     axial_state_t result = {0};
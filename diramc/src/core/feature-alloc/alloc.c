@@ -1,141 +1,103 @@
 #include "diram/core/diram.h"
+#include "diram/core/feature-alloc/slab_arena.h"
+#include "diram/core/feature-alloc/trace_log.h"
+#include "diram/core/feature-alloc/receipt_queue.h"
+#include "diram/core/crypto/sha256.h"
+#include "diram/core/governor/governor.h"
+#include "diram/core/config/config.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
+
+static pid_t cached_pid = 0;
+static pthread_once_t pid_once = PTHREAD_ONCE_INIT;
+
+// Traced allocations keep their header in the slab block ahead of the payload
+_Static_assert(sizeof(diram_allocation_t) <= DIRAM_SLAB_USER_HEADER,
+               "diram_allocation_t must fit the slab block header");
 
-#ifdef _WIN32
-#include <windows.h>
-static int clock_gettime(int clk_id, struct timespec* ts) {
-    LARGE_INTEGER freq, count;
-    QueryPerformanceFrequency(&freq);
-    QueryPerformanceCounter(&count);
-    ts->tv_sec = (time_t)(count.QuadPart / freq.QuadPart);
-    ts->tv_nsec = (long)(((count.QuadPart % freq.QuadPart) * 1000000000ULL) / freq.QuadPart);
-    return 0;
+// getpid() is a real syscall on current glibc; cache it and refresh after fork
+static void refresh_cached_pid(void) {
+    cached_pid = getpid();
 }
-#else
-#include <time.h>
-#endif
 
-static __thread diram_heap_context_t heap_ctx = {0, 0};
-static FILE* trace_log = NULL;
-static pthread_mutex_t trace_mutex = PTHREAD_MUTEX_INITIALIZER;
+static void register_pid_cache(void) {
+    refresh_cached_pid();
+    pthread_atfork(NULL, NULL, refresh_cached_pid);
+}
 
-static void sha256_hex(const void* data, size_t len, char* output) {
-    const uint8_t* bytes = (const uint8_t*)data;
-    for (size_t i = 0; i < 32; i++) {
-        sprintf(output + (i * 2), "%02x", bytes[i % len]);
-    }
-    output[64] = '\0';
+static inline pid_t current_pid(void) {
+    pthread_once(&pid_once, register_pid_cache);
+    return cached_pid;
 }
 
+// Inline or queued for the batch worker, per receipt_mode
 void diram_compute_receipt(diram_allocation_t* alloc, const char* tag) {
-    struct {
-        void* addr;
-        size_t size;
-        uint64_t timestamp;
-        char tag[64];
-    } input;
-    
-    input.addr = alloc->base_addr;
-    input.size = alloc->size;
-    input.timestamp = alloc->timestamp;
-    strncpy(input.tag, tag ? tag : "untagged", 63);
-    sha256_hex(&input, sizeof(input), alloc->sha256_receipt);
+    diram_receipt_submit(alloc, tag, 0);
 }
 
+// The trace log is binary; diram-trace renders it back to text
 int diram_init_trace_log(void) {
-    pthread_mutex_lock(&trace_mutex);
-    if (trace_log != NULL) {
-        pthread_mutex_unlock(&trace_mutex);
-        return 0;
-    }
-    
-    trace_log = fopen(DIRAM_TRACE_LOG_PATH, "a");
-    if (trace_log == NULL) {
-        pthread_mutex_unlock(&trace_mutex);
-        return -1;
-    }
-    
-    setvbuf(trace_log, NULL, _IOLBF, 0);
-    fprintf(trace_log, "# DIRAM Trace Log\n");
-    fflush(trace_log);
-    
-    pthread_mutex_unlock(&trace_mutex);
-    return 0;
+    return diram_trace_open(DIRAM_TRACE_BIN_LOG_PATH);
+}
+
+// Entry point of the standalone bootstrap.h API: load the config
+// hierarchy and push it into the receipt queue, executor, lookahead cache
+// and governor. Missing config files are not an error; tracing starts
+// only if the log directory is writable
+int diram_bootstrap_init(void) {
+    diram_config_init();
+    diram_config_load_hierarchy();
+    int applied = diram_config_apply();
+    diram_init_trace_log();
+    return applied;
 }
 
 void diram_close_trace_log(void) {
-    pthread_mutex_lock(&trace_mutex);
-    if (trace_log != NULL) {
-        fclose(trace_log);
-        trace_log = NULL;
-    }
-    pthread_mutex_unlock(&trace_mutex);
+    // Deferred ALLOC records are emitted with their receipts
+    diram_receipt_flush();
+    diram_trace_close();
 }
 
 diram_allocation_t* diram_alloc_traced(size_t size, const char* tag) {
-    struct timespec ts = {0};
-    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t now = diram_gov_now_ns();
     
-    if (heap_ctx.command_epoch != (uint64_t)ts.tv_sec) {
-        heap_ctx.event_count = 0;
-        heap_ctx.command_epoch = ts.tv_sec;
-    }
-    
-    if (heap_ctx.event_count >= DIRAM_MAX_HEAP_EVENTS) {
+    // Continuous token bucket per thread; no epoch reset, no syscall
+    if (diram_gov_admit_thread(now) != 0) {
         return NULL;
     }
     
-    diram_allocation_t* alloc = calloc(1, sizeof(diram_allocation_t));
+    // One slab block holds both the header and the payload
+    void* payload = NULL;
+    diram_allocation_t* alloc = diram_slab_alloc(size, &payload);
     if (!alloc) return NULL;
     
-    alloc->base_addr = malloc(size);
-    if (!alloc->base_addr) {
-        free(alloc);
-        return NULL;
-    }
+    memset(alloc, 0, sizeof(diram_allocation_t));
+    alloc->base_addr = payload;
     
-    heap_ctx.event_count++;
     alloc->size = size;
-    alloc->timestamp = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
-    alloc->heap_events = heap_ctx.event_count;
-    alloc->binding_pid = getpid();
-    
-    diram_compute_receipt(alloc, tag);
-    
-    pthread_mutex_lock(&trace_mutex);
-    if (trace_log != NULL) {
-        fprintf(trace_log, "%lu|%d|ALLOC|%p|%zu|%s|%s\n",
-                alloc->timestamp, alloc->binding_pid,
-                alloc->base_addr, alloc->size,
-                alloc->sha256_receipt, tag ? tag : "untagged");
-        fflush(trace_log);
-    }
-    pthread_mutex_unlock(&trace_mutex);
+    alloc->timestamp = now;
+    alloc->heap_events = (uint32_t)diram_gov_thread_events();
+    alloc->binding_pid = current_pid();
+    
+    // The ALLOC record is written once its receipt exists
+    diram_receipt_submit(alloc, tag, DIRAM_RECEIPT_FLAG_TRACE);
     
     return alloc;
 }
 
 void diram_free_traced(diram_allocation_t* alloc) {
     if (!alloc) return;
-    if (alloc->binding_pid != getpid()) return;
-    
-    struct timespec ts = {0};
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    
-    pthread_mutex_lock(&trace_mutex);
-    if (trace_log != NULL) {
-        fprintf(trace_log, "%llu|%d|FREE|%p|%zu|%s|traced\n",
-                (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec,
-                getpid(), alloc->base_addr, alloc->size,
-                alloc->sha256_receipt);
-        fflush(trace_log);
-    }
-    pthread_mutex_unlock(&trace_mutex);
+    if (alloc->binding_pid != current_pid()) return;
     
-    free(alloc->base_addr);
-    free(alloc);
+    diram_receipt_settle(alloc);
+    
+    diram_trace_record(DIRAM_TRACE_EVENT_FREE, diram_gov_now_ns(),
+                       alloc->binding_pid, alloc->base_addr, alloc->size,
+                       alloc->sha256_receipt, NULL);
+    
+    diram_slab_free(alloc);
 }
 
 // Add to alloc.c after the existing functions
@@ -147,14 +109,15 @@ diram_enhanced_allocation_t* diram_alloc_enhanced(
     diram_enhanced_allocation_t* alloc = calloc(1, sizeof(diram_enhanced_allocation_t));
     if (!alloc) return NULL;
     
-    // Check space limits if provided
-    if (space && diram_space_check_limit(space, size) != 0) {
+    // One governor event, then check and charge the quota in one step
+    if (diram_space_admit(space, size, 1) != 0) {
         free(alloc);
         return NULL;
     }
     
     alloc->base.ptr = malloc(size);
     if (!alloc->base.ptr) {
+        diram_space_release(space, size);
         free(alloc);
         return NULL;
     }
@@ -173,24 +136,22 @@ diram_enhanced_allocation_t* diram_alloc_enhanced(
         char tag[128];
     } input;
     
+    memset(&input, 0, sizeof(input));
     input.addr = alloc->base.ptr;
     input.size = size;
     input.timestamp = alloc->timestamp;
     strncpy(input.tag, alloc->tag, 127);
     
-    // Simple hash generation (placeholder)
-    for (int i = 0; i < 32; i++) {
-        sprintf(alloc->base.sha256_receipt + (i * 2), "%02x", 
-                ((uint8_t*)&input)[i % sizeof(input)]);
-    }
-    alloc->base.sha256_receipt[64] = '\0';
-    
-    // Update space usage
-    if (space) {
-        pthread_mutex_lock(&space->lock);
-        space->used_bytes += size;
-        pthread_mutex_unlock(&space->lock);
-    }
+    diram_sha256_hex(&input, sizeof(input), alloc->base.sha256_receipt);
     
     return alloc;
 }
+
+// Returns the payload's quota to the space it was charged against
+void diram_free_enhanced(diram_enhanced_allocation_t* alloc, diram_memory_space_t* space) {
+    if (!alloc) return;
+    
+    diram_space_release(space, alloc->base.size);
+    free(alloc->base.ptr);
+    free(alloc);
+}
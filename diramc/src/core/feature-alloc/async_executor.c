@@ -0,0 +1,433 @@
+// src/core/feature-alloc/async_executor.c
+// OBINexus DIRAM Async Executor
+// Owners push and pop at the bottom of their deque without locks; thieves
+// take from the top with a single CAS. The injection list and idle parking
+// share one mutex, which only external submitters and idle workers touch.
+#include "diram/core/feature-alloc/async_executor.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define EXECUTOR_DEQUE_MASK  (DIRAM_EXECUTOR_DEQUE_ENTRIES - 1)
+
+_Static_assert((DIRAM_EXECUTOR_DEQUE_ENTRIES & EXECUTOR_DEQUE_MASK) == 0,
+               "executor deque size must be a power of two");
+_Static_assert(DIRAM_EXECUTOR_INJECT_BATCH < DIRAM_EXECUTOR_DEQUE_ENTRIES,
+               "an injection batch must fit an empty deque");
+
+enum {
+    EXECUTOR_STOPPED = 0,
+    EXECUTOR_RUNNING,
+    EXECUTOR_STOPPING
+};
+
+typedef struct {
+    _Alignas(64) atomic_int_fast64_t top;       // advanced by thieves
+    _Alignas(64) atomic_int_fast64_t bottom;    // written by the owner
+    _Atomic(diram_task_t*) slots[DIRAM_EXECUTOR_DEQUE_ENTRIES];
+} diram_deque_t;
+
+typedef struct {
+    diram_deque_t deque;
+    pthread_t thread;
+    uint32_t index;
+    uint32_t steal_seed;
+    int started;
+    _Alignas(64) uint64_t executed;             // owner-only writes
+    uint64_t steals;
+    uint64_t injected;
+} diram_executor_worker_t;
+
+static struct {
+    pthread_mutex_t lock;           // injection list, parking, start and stop
+    pthread_cond_t wake;
+    diram_task_t* inject_head;
+    diram_task_t* inject_tail;
+    atomic_size_t inject_len;
+    atomic_int idle;
+    atomic_int state;
+    uint32_t configured_workers;
+    atomic_uint max_pending;
+    uint32_t worker_count;
+    diram_executor_worker_t* workers;
+    _Alignas(64) atomic_uint_fast64_t pending;
+    atomic_uint_fast64_t peak;
+    atomic_uint_fast64_t submitted;
+    atomic_uint_fast64_t inlined;
+    // Counters of pools already shut down
+    uint64_t retired_executed;
+    uint64_t retired_steals;
+    uint64_t retired_injected;
+} g_exec = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+};
+
+static __thread diram_executor_worker_t* tls_worker = NULL;
+
+// ============================================================================
+// Chase-Lev deque
+// ============================================================================
+
+static int deque_push(diram_deque_t* d, diram_task_t* task) {
+    int_fast64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int_fast64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= DIRAM_EXECUTOR_DEQUE_ENTRIES) return -1;
+
+    atomic_store_explicit(&d->slots[b & EXECUTOR_DEQUE_MASK], task, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return 0;
+}
+
+static diram_task_t* deque_pop(diram_deque_t* d) {
+    int_fast64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int_fast64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    diram_task_t* task = atomic_load_explicit(&d->slots[b & EXECUTOR_DEQUE_MASK],
+                                              memory_order_acquire);
+    if (t == b) {
+        // Last entry: race any thief for it
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst,
+                                                     memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+static diram_task_t* deque_steal(diram_deque_t* d) {
+    int_fast64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int_fast64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+
+    diram_task_t* task = atomic_load_explicit(&d->slots[t & EXECUTOR_DEQUE_MASK],
+                                              memory_order_acquire);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+static int deque_empty(diram_deque_t* d) {
+    int_fast64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    int_fast64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    return t >= b;
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+static int work_visible(void) {
+    if (atomic_load_explicit(&g_exec.inject_len, memory_order_acquire) > 0) return 1;
+    for (uint32_t i = 0; i < g_exec.worker_count; i++) {
+        if (!deque_empty(&g_exec.workers[i].deque)) return 1;
+    }
+    return 0;
+}
+
+// Idle workers are only woken under the lock, so a park cannot miss one
+static void wake_one_idle(void) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&g_exec.idle, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&g_exec.lock);
+        pthread_cond_signal(&g_exec.wake);
+        pthread_mutex_unlock(&g_exec.lock);
+    }
+}
+
+// Move a batch from the injection list into the caller's empty deque
+static diram_task_t* inject_pull(diram_executor_worker_t* w) {
+    if (atomic_load_explicit(&g_exec.inject_len, memory_order_acquire) == 0) return NULL;
+
+    pthread_mutex_lock(&g_exec.lock);
+    diram_task_t* first = g_exec.inject_head;
+    size_t taken = 0;
+
+    if (first) {
+        diram_task_t* task = first->next;
+        taken = 1;
+        while (task && taken < DIRAM_EXECUTOR_INJECT_BATCH) {
+            diram_task_t* next = task->next;
+            deque_push(&w->deque, task);
+            task = next;
+            taken++;
+        }
+        g_exec.inject_head = task;
+        if (!task) g_exec.inject_tail = NULL;
+        atomic_fetch_sub_explicit(&g_exec.inject_len, taken, memory_order_release);
+
+        // Leave the rest of the batch for an idle peer to steal
+        if (taken > 1 && atomic_load_explicit(&g_exec.idle, memory_order_relaxed) > 0) {
+            pthread_cond_signal(&g_exec.wake);
+        }
+    }
+
+    pthread_mutex_unlock(&g_exec.lock);
+    __atomic_store_n(&w->injected, w->injected + taken, __ATOMIC_RELAXED);
+    return first;
+}
+
+static diram_task_t* steal_any(diram_executor_worker_t* w) {
+    uint32_t n = g_exec.worker_count;
+    if (n < 2) return NULL;
+
+    // Cheap xorshift so thieves do not all start at the same victim
+    uint32_t s = w->steal_seed;
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    w->steal_seed = s;
+
+    for (uint32_t i = 0; i < n; i++) {
+        diram_executor_worker_t* victim = &g_exec.workers[(s + i) % n];
+        if (victim == w) continue;
+        diram_task_t* task = deque_steal(&victim->deque);
+        if (task) {
+            __atomic_store_n(&w->steals, w->steals + 1, __ATOMIC_RELAXED);
+            return task;
+        }
+    }
+    return NULL;
+}
+
+// 0 = parked and woken, -1 = pool is stopping and nothing is left
+static int worker_park(void) {
+    pthread_mutex_lock(&g_exec.lock);
+    atomic_fetch_add_explicit(&g_exec.idle, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    int rc = 0;
+    if (!work_visible()) {
+        if (atomic_load_explicit(&g_exec.state, memory_order_acquire) == EXECUTOR_STOPPING) {
+            rc = -1;
+        } else {
+            pthread_cond_wait(&g_exec.wake, &g_exec.lock);
+        }
+    }
+
+    atomic_fetch_sub_explicit(&g_exec.idle, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&g_exec.lock);
+    return rc;
+}
+
+static void* executor_worker_thread(void* arg) {
+    diram_executor_worker_t* w = (diram_executor_worker_t*)arg;
+    tls_worker = w;
+
+    for (;;) {
+        diram_task_t* task = deque_pop(&w->deque);
+        if (!task) task = inject_pull(w);
+        if (!task) task = steal_any(w);
+        if (!task) {
+            if (worker_park() != 0) break;
+            continue;
+        }
+
+        task->run(task);
+        __atomic_store_n(&w->executed, w->executed + 1, __ATOMIC_RELAXED);
+        atomic_fetch_sub_explicit(&g_exec.pending, 1, memory_order_relaxed);
+    }
+
+    tls_worker = NULL;
+    return NULL;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+static uint32_t resolve_worker_count(uint32_t configured) {
+    if (configured == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        configured = cpus > 0 ? (uint32_t)cpus : 1;
+    }
+    if (configured > DIRAM_EXECUTOR_MAX_WORKERS) configured = DIRAM_EXECUTOR_MAX_WORKERS;
+    return configured;
+}
+
+// Called with g_exec.lock held
+static int executor_start_locked(void) {
+    uint32_t n = resolve_worker_count(g_exec.configured_workers);
+
+    void* mem = NULL;
+    if (posix_memalign(&mem, 64, n * sizeof(diram_executor_worker_t)) != 0) return -1;
+    memset(mem, 0, n * sizeof(diram_executor_worker_t));
+
+    g_exec.workers = (diram_executor_worker_t*)mem;
+    g_exec.worker_count = n;
+    atomic_store_explicit(&g_exec.state, EXECUTOR_RUNNING, memory_order_release);
+
+    // Workers that fail to start keep an empty deque nobody pushes to
+    uint32_t started = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        diram_executor_worker_t* w = &g_exec.workers[i];
+        w->index = i;
+        w->steal_seed = 0x9E3779B9u * (i + 1);
+        if (pthread_create(&w->thread, NULL, executor_worker_thread, w) == 0) {
+            w->started = 1;
+            started++;
+        }
+    }
+
+    if (started == 0) {
+        atomic_store(&g_exec.state, EXECUTOR_STOPPED);
+        g_exec.workers = NULL;
+        g_exec.worker_count = 0;
+        free(mem);
+        return -1;
+    }
+    return 0;
+}
+
+static int executor_ensure_running(void) {
+    if (atomic_load_explicit(&g_exec.state, memory_order_acquire) == EXECUTOR_RUNNING) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&g_exec.lock);
+    int rc = 0;
+    int state = atomic_load(&g_exec.state);
+    if (state == EXECUTOR_STOPPED) {
+        rc = executor_start_locked();
+    } else if (state == EXECUTOR_STOPPING) {
+        rc = -1;
+    }
+    pthread_mutex_unlock(&g_exec.lock);
+    return rc;
+}
+
+void diram_executor_configure(uint32_t workers, uint32_t max_pending) {
+    pthread_mutex_lock(&g_exec.lock);
+    g_exec.configured_workers = workers;
+    pthread_mutex_unlock(&g_exec.lock);
+    atomic_store_explicit(&g_exec.max_pending, max_pending, memory_order_relaxed);
+}
+
+void diram_executor_shutdown(void) {
+    pthread_mutex_lock(&g_exec.lock);
+    if (atomic_load(&g_exec.state) != EXECUTOR_RUNNING) {
+        pthread_mutex_unlock(&g_exec.lock);
+        return;
+    }
+    atomic_store_explicit(&g_exec.state, EXECUTOR_STOPPING, memory_order_release);
+    pthread_cond_broadcast(&g_exec.wake);
+    pthread_mutex_unlock(&g_exec.lock);
+
+    // Workers leave only once every queue is empty
+    for (uint32_t i = 0; i < g_exec.worker_count; i++) {
+        if (g_exec.workers[i].started) pthread_join(g_exec.workers[i].thread, NULL);
+    }
+
+    pthread_mutex_lock(&g_exec.lock);
+    for (uint32_t i = 0; i < g_exec.worker_count; i++) {
+        g_exec.retired_executed += g_exec.workers[i].executed;
+        g_exec.retired_steals += g_exec.workers[i].steals;
+        g_exec.retired_injected += g_exec.workers[i].injected;
+    }
+    free(g_exec.workers);
+    g_exec.workers = NULL;
+    g_exec.worker_count = 0;
+    atomic_store_explicit(&g_exec.state, EXECUTOR_STOPPED, memory_order_release);
+    pthread_mutex_unlock(&g_exec.lock);
+}
+
+// ============================================================================
+// Submission
+// ============================================================================
+
+static void run_inline(diram_task_t* task) {
+    atomic_fetch_sub_explicit(&g_exec.pending, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&g_exec.inlined, 1, memory_order_relaxed);
+    task->run(task);
+}
+
+static void note_depth(uint64_t depth) {
+    uint64_t peak = atomic_load_explicit(&g_exec.peak, memory_order_relaxed);
+    while (depth > peak &&
+           !atomic_compare_exchange_weak_explicit(&g_exec.peak, &peak, depth,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+void diram_executor_submit(diram_task_t* task) {
+    if (!task || !task->run) return;
+
+    uint32_t max_pending = atomic_load_explicit(&g_exec.max_pending, memory_order_relaxed);
+    uint64_t depth = atomic_fetch_add_explicit(&g_exec.pending, 1, memory_order_relaxed) + 1;
+
+    if ((max_pending && depth > max_pending) || executor_ensure_running() != 0) {
+        // Back-pressure: the submitter does the work itself
+        run_inline(task);
+        return;
+    }
+
+    diram_executor_worker_t* w = tls_worker;
+    if (w && deque_push(&w->deque, task) == 0) {
+        note_depth(depth);
+        atomic_fetch_add_explicit(&g_exec.submitted, 1, memory_order_relaxed);
+        wake_one_idle();
+        return;
+    }
+
+    task->next = NULL;
+    pthread_mutex_lock(&g_exec.lock);
+    // Workers only exit after seeing an empty list under this lock
+    if (atomic_load_explicit(&g_exec.state, memory_order_relaxed) != EXECUTOR_RUNNING) {
+        pthread_mutex_unlock(&g_exec.lock);
+        run_inline(task);
+        return;
+    }
+    note_depth(depth);
+    atomic_fetch_add_explicit(&g_exec.submitted, 1, memory_order_relaxed);
+    if (g_exec.inject_tail) {
+        g_exec.inject_tail->next = task;
+    } else {
+        g_exec.inject_head = task;
+    }
+    g_exec.inject_tail = task;
+    atomic_fetch_add_explicit(&g_exec.inject_len, 1, memory_order_release);
+    if (atomic_load_explicit(&g_exec.idle, memory_order_relaxed) > 0) {
+        pthread_cond_signal(&g_exec.wake);
+    }
+    pthread_mutex_unlock(&g_exec.lock);
+}
+
+void diram_executor_get_stats(diram_executor_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    pthread_mutex_lock(&g_exec.lock);
+    out->workers = g_exec.worker_count;
+    out->executed = g_exec.retired_executed;
+    out->steals = g_exec.retired_steals;
+    out->injected = g_exec.retired_injected;
+    for (uint32_t i = 0; i < g_exec.worker_count; i++) {
+        diram_executor_worker_t* w = &g_exec.workers[i];
+        out->executed += __atomic_load_n(&w->executed, __ATOMIC_RELAXED);
+        out->steals += __atomic_load_n(&w->steals, __ATOMIC_RELAXED);
+        out->injected += __atomic_load_n(&w->injected, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&g_exec.lock);
+
+    out->submitted = atomic_load_explicit(&g_exec.submitted, memory_order_relaxed);
+    out->inlined = atomic_load_explicit(&g_exec.inlined, memory_order_relaxed);
+    out->queue_depth = atomic_load_explicit(&g_exec.pending, memory_order_relaxed);
+    out->peak_depth = atomic_load_explicit(&g_exec.peak, memory_order_relaxed);
+}
@@ -2,6 +2,9 @@
 // JavaScript-inspired Promise implementation for DIRAM lookahead allocation
 // OBINexus phenomenological memory architecture
 #include "diram/core/feature-alloc/async_promise.h"
+#include "diram/core/feature-alloc/async_executor.h"
+#include "diram/core/feature-alloc/lookahead_cache.h"
+#include "diram/core/crypto/sha256.h"
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
@@ -63,7 +66,7 @@
 #endif
 
 // Forward declarations
-static void* async_allocation_worker(void* arg);
+static void async_allocation_worker(diram_task_t* task);
 static diram_async_promise_t* promise_then(diram_async_promise_t* self,
     void (*onFulfilled)(diram_enhanced_allocation_t*),
     void (*onRejected)(diram_reject_reason_t, const char*));
@@ -71,56 +74,91 @@ static diram_async_promise_t* promise_catch(diram_async_promise_t* self,
     void (*onRejected)(diram_reject_reason_t, const char*));
 static void promise_finally(diram_async_promise_t* self, void (*callback)(void));
 
-// Lookahead cache entry for predictive allocation
-typedef struct {
-    size_t predicted_size;
-    uint32_t access_pattern;
-    uint64_t last_access;
-    double confidence_score;
-} diram_lookahead_entry_t;
-
-// Global lookahead cache with lock
-static struct {
-    diram_lookahead_entry_t* entries;
-    size_t capacity;
-    pthread_rwlock_t lock;
-    bool initialized;
-} g_lookahead_cache = {0};
-
-// Worker context structure - FIXED: removed invalid (void) from struct
+// Worker context structure - the executor task must stay first
 typedef struct {
+    diram_task_t task;
     diram_async_promise_t* promise;
     char* tag;
     diram_memory_space_t* space;
+    size_t requested_size;  // what the caller asked for, before prediction
     bool use_lookahead;  // Added missing field
 } diram_worker_context_t;
 
-// Initialize lookahead cache
-static void init_lookahead_cache() {
-    if (g_lookahead_cache.initialized) return;
-    
-    pthread_rwlock_init(&g_lookahead_cache.lock, NULL);
-    g_lookahead_cache.capacity = 1024;
-    g_lookahead_cache.entries = calloc(g_lookahead_cache.capacity, 
-                                      sizeof(diram_lookahead_entry_t));
-    g_lookahead_cache.initialized = true;
+// Compact promise context - the tag is copied inline after the header
+typedef struct {
+    diram_task_t task;
+    diram_fpromise_t* promise;
+    diram_memory_space_t* space;
+    size_t size;
+    bool tagged;
+    char tag[];
+} diram_compact_context_t;
+
+// Batch context - sizes and packed NUL-terminated tags follow the header
+typedef struct {
+    diram_task_t task;
+    diram_promise_all_t* batch;
+    diram_memory_space_t* space;
+    size_t count;
+    size_t tag_bytes;
+    size_t* sizes;
+    char* tags;
+    size_t data[];
+} diram_batch_context_t;
+
+// Exact bytes hashed into a receipt; zero-filled so padding is stable
+typedef struct {
+    void* addr;
+    size_t size;
+    time_t timestamp;
+    char tag[64];
+} diram_async_receipt_input_t;
+
+static void receipt_input_init(diram_async_receipt_input_t* input,
+                               const diram_allocation_t* base,
+                               const char* tag) {
+    memset(input, 0, sizeof(*input));
+    input->addr = base->ptr;
+    input->size = base->size;
+    input->timestamp = (time_t)base->timestamp;
+    strncpy(input->tag, tag ? tag : "untagged", sizeof(input->tag) - 1);
+}
+
+static bool promise_is_settled(diram_async_promise_t* promise) {
+    pthread_mutex_lock(&promise->state_mutex);
+    bool settled = promise->receipt.state != PROMISE_STATE_PENDING;
+    pthread_mutex_unlock(&promise->state_mutex);
+    return settled;
+}
+
+void diram_alloc_async_release(diram_enhanced_allocation_t* alloc, diram_memory_space_t* space) {
+    if (!alloc) return;
+    diram_space_release(space, alloc->base.size);
+    free(alloc->base.ptr);
+    free(alloc->base.tag);
+    free(alloc);
 }
 
-// Enhanced allocation implementation (stub for now)
-diram_enhanced_allocation_t* diram_alloc_enhanced(
+// Async-side allocation, charged to the space like diram_alloc_enhanced;
+// NULL with errno EDQUOT when the space's governor or quota refuses
+static diram_enhanced_allocation_t* async_alloc_enhanced(
     size_t size,
     const char* tag,
     diram_memory_space_t* space
 ) {
-    // FIXED: Moved (void) statements inside function body
-    (void)space;  // Suppress unused parameter warning
-    
     diram_enhanced_allocation_t* alloc = calloc(1, sizeof(diram_enhanced_allocation_t));
     if (!alloc) return NULL;
     
+    if (diram_space_admit(space, size, 1) != 0) {
+        free(alloc);
+        errno = EDQUOT;
+        return NULL;
+    }
+    
     // Basic allocation
     alloc->base.ptr = malloc(size);
     if (!alloc->base.ptr) {
+        diram_space_release(space, size);
         free(alloc);
         return NULL;
     }
@@ -136,14 +174,188 @@ diram_enhanced_allocation_t* diram_alloc_enhanced(
         alloc->base.tag = strdup(tag);
     }
     
-    // Generate SHA256 receipt (simplified)
-    #define DIRAM_SHA256_HEX_LEN 65
-    snprintf(alloc->base.sha256_receipt, DIRAM_SHA256_HEX_LEN, 
-            "SHA256_%lx_%zu_%ld", (uintptr_t)alloc->base.ptr, size, alloc->base.timestamp);
+    // Generate SHA256 receipt
+    diram_async_receipt_input_t input;
+    receipt_input_init(&input, &alloc->base, tag);
+    diram_sha256_hex(&input, sizeof(input), alloc->base.sha256_receipt);
     
     return alloc;
 }
 
+static size_t batch_round_up(size_t size) {
+    return (size + DIRAM_ALLOC_BATCH_ALIGN - 1) & ~(size_t)(DIRAM_ALLOC_BATCH_ALIGN - 1);
+}
+
+// Executor task for batch allocation: one reservation, one hash pass
+static void async_batch_worker(diram_task_t* task) {
+    diram_batch_context_t* ctx = (diram_batch_context_t*)task;
+    diram_promise_all_t* batch = ctx->batch;
+    size_t count = ctx->count;
+    
+    // Layout: every buffer on its own alignment boundary, then the tags
+    size_t offset = 0;
+    size_t requested = 0;
+    bool overflow = false;
+    for (size_t i = 0; i < count && !overflow; i++) {
+        size_t rounded = batch_round_up(ctx->sizes[i]);
+        if (rounded < ctx->sizes[i] || offset + rounded < offset) overflow = true;
+        offset += rounded;
+        requested += ctx->sizes[i];
+    }
+    size_t total = offset + ctx->tag_bytes;
+    if (total < offset) overflow = true;
+    
+    // The whole batch is charged up front: its requested bytes against the
+    // quota and one governor event per buffer
+    uint32_t events = count > UINT32_MAX ? UINT32_MAX : (uint32_t)count;
+    if (!overflow && diram_space_admit(ctx->space, requested, events) != 0) {
+        diram_promise_reject_internal(batch->aggregate_promise, REJECT_REASON_GOVERNANCE_VIOLATION,
+                                      "batch refused by the space quota or governor");
+        free(ctx);
+        return;
+    }
+    
+    void* block = NULL;
+    diram_enhanced_allocation_t* allocs = NULL;
+    diram_enhanced_allocation_t** results = NULL;
+    void* scratch = NULL;
+    
+    if (!overflow && posix_memalign(&block, DIRAM_ALLOC_BATCH_ALIGN, total) == 0) {
+        allocs = calloc(count, sizeof(diram_enhanced_allocation_t));
+        results = malloc(count * sizeof(*results));
+        scratch = malloc(count * (sizeof(diram_async_receipt_input_t) + sizeof(void*) +
+                                  sizeof(size_t) + DIRAM_SHA256_DIGEST_LEN));
+    }
+    
+    if (!block || !allocs || !results || !scratch) {
+        free(block);
+        free(allocs);
+        free(results);
+        free(scratch);
+        if (!overflow) diram_space_release(ctx->space, requested);
+        diram_promise_reject_internal(batch->aggregate_promise, REJECT_REASON_MEMORY_EXHAUSTED,
+                                      overflow ? "batch size overflow" : strerror(ENOMEM));
+        free(ctx);
+        return;
+    }
+    
+    diram_async_receipt_input_t* inputs = scratch;
+    const void** data = (const void**)(inputs + count);
+    size_t* lens = (size_t*)(data + count);
+    uint8_t (*digests)[DIRAM_SHA256_DIGEST_LEN] = (uint8_t (*)[DIRAM_SHA256_DIGEST_LEN])(lens + count);
+    
+    char* tags = (char*)block + offset;
+    memcpy(tags, ctx->tags, ctx->tag_bytes);
+    
+    uint64_t now = (uint64_t)time(NULL);
+    char* cursor = block;
+    for (size_t i = 0; i < count; i++) {
+        diram_enhanced_allocation_t* alloc = &allocs[i];
+        alloc->base.ptr = cursor;
+        alloc->base.size = ctx->sizes[i];
+        alloc->base.timestamp = now;
+        alloc->base.flags = DIRAM_ALLOC_FLAG_BATCH;
+        alloc->base.tag = *tags ? tags : NULL;
+        alloc->phenotype.priority = getpid() & 0xFF;
+        
+        receipt_input_init(&inputs[i], &alloc->base, alloc->base.tag);
+        data[i] = &inputs[i];
+        lens[i] = sizeof(inputs[i]);
+        
+        cursor += batch_round_up(ctx->sizes[i]);
+        tags += strlen(tags) + 1;
+    }
+    
+    diram_sha256_batch(data, lens, count, digests);
+    for (size_t i = 0; i < count; i++) {
+        diram_sha256_to_hex(digests[i], allocs[i].base.sha256_receipt);
+        results[i] = &allocs[i];
+    }
+    batch->space = ctx->space;
+    batch->charged = requested;
+    free(scratch);
+    free(ctx);
+    
+    batch->reservation = block;
+    batch->allocations = allocs;
+    batch->results = results;
+    
+    diram_async_promise_t* aggregate = batch->aggregate_promise;
+    memcpy(aggregate->receipt.allocation_receipt, allocs[0].base.sha256_receipt,
+           DIRAM_SHA256_HEX_LEN);
+    diram_promise_resolve_internal(aggregate, allocs);
+}
+
+diram_promise_all_t* diram_alloc_async_batch(
+    const size_t* sizes,
+    const char* const* tags,
+    size_t count,
+    diram_memory_space_t* space
+) {
+    if (!sizes || count == 0) return NULL;
+    
+    size_t tag_bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        tag_bytes += (tags && tags[i] ? strlen(tags[i]) : 0) + 1;
+    }
+    
+    diram_batch_context_t* ctx = malloc(sizeof(diram_batch_context_t) +
+                                        count * sizeof(size_t) + tag_bytes);
+    diram_promise_all_t* batch = calloc(1, sizeof(diram_promise_all_t));
+    diram_async_promise_t* aggregate = diram_promise_create(NULL);
+    if (!ctx || !batch || !aggregate) {
+        free(ctx);
+        free(batch);
+        diram_promise_destroy(aggregate);
+        return NULL;
+    }
+    
+    batch->count = count;
+    batch->aggregate_promise = aggregate;
+    
+    ctx->task.run = async_batch_worker;
+    ctx->batch = batch;
+    ctx->space = space;
+    ctx->count = count;
+    ctx->tag_bytes = tag_bytes;
+    ctx->sizes = ctx->data;
+    ctx->tags = (char*)(ctx->sizes + count);
+    memcpy(ctx->sizes, sizes, count * sizeof(size_t));
+    
+    // Missing tags pack as empty strings and come back as NULL
+    char* packed = ctx->tags;
+    for (size_t i = 0; i < count; i++) {
+        const char* tag = tags && tags[i] ? tags[i] : "";
+        size_t len = strlen(tag) + 1;
+        memcpy(packed, tag, len);
+        packed += len;
+    }
+    
+    diram_executor_submit(&ctx->task);
+    return batch;
+}
+
+void diram_alloc_batch_release(diram_promise_all_t* batch) {
+    if (!batch) return;
+    
+    // The worker still owns everything until the aggregate settles
+    diram_async_promise_t* aggregate = batch->aggregate_promise;
+    if (aggregate) {
+        pthread_mutex_lock(&aggregate->state_mutex);
+        while (aggregate->receipt.state == PROMISE_STATE_PENDING) {
+            pthread_cond_wait(&aggregate->state_cond, &aggregate->state_mutex);
+        }
+        pthread_mutex_unlock(&aggregate->state_mutex);
+    }
+    
+    diram_space_release(batch->space, batch->charged);
+    free(batch->reservation);
+    free(batch->allocations);
+    free(batch->results);
+    diram_promise_destroy(aggregate);
+    free(batch);
+}
+
 // JavaScript-style Promise constructor pattern
 diram_async_promise_t* diram_promise_create(
     void (*executor)(
@@ -166,6 +378,7 @@ diram_async_promise_t* diram_promise_create(
     
     pthread_mutex_init(&promise->state_mutex, NULL);
     pthread_cond_init(&promise->state_cond, NULL);
+    promise->refs = 1;
     
     // Setup thenable interface
     promise->thenable.then = promise_then;
@@ -179,6 +392,90 @@ diram_async_promise_t* diram_promise_create(
     return promise;
 }
 
+// Hand the allocation to the executor; the worker owns ctx from here on
+static int submit_allocation(
+    diram_async_promise_t* promise,
+    const char* tag,
+    diram_memory_space_t* space,
+    size_t requested_size,
+    bool use_lookahead
+) {
+    diram_worker_context_t* ctx = calloc(1, sizeof(diram_worker_context_t));
+    if (!ctx) return -1;
+    
+    ctx->task.run = async_allocation_worker;
+    ctx->promise = promise;
+    ctx->tag = tag ? strdup(tag) : NULL;
+    ctx->space = space;
+    ctx->requested_size = requested_size;
+    ctx->use_lookahead = use_lookahead;
+    
+    // The worker may outlive the caller's reference
+    __atomic_fetch_add(&promise->refs, 1, __ATOMIC_RELAXED);
+    diram_executor_submit(&ctx->task);
+    return 0;
+}
+
+// Plain async allocation - the hint only seeds the lookahead record
+diram_async_promise_t* diram_alloc_async(
+    size_t size,
+    const char* tag,
+    diram_memory_space_t* space,
+    size_t lookahead_hint
+) {
+    diram_async_promise_t* promise = diram_promise_create(NULL);
+    if (!promise) return NULL;
+    
+    promise->lookahead_size = size;
+    promise->lookahead.predicted_next_size = lookahead_hint;
+    
+    if (submit_allocation(promise, tag, space, size, false) != 0) {
+        diram_promise_reject_internal(promise, REJECT_REASON_FATAL_ERROR,
+                                      "failed to queue async allocation");
+    }
+    
+    return promise;
+}
+
+static void async_compact_worker(diram_task_t* task) {
+    diram_compact_context_t* ctx = (diram_compact_context_t*)task;
+    diram_enhanced_allocation_t* alloc = async_alloc_enhanced(
+        ctx->size, ctx->tagged ? ctx->tag : NULL, ctx->space);
+    
+    if (alloc) {
+        diram_fpromise_resolve(ctx->promise, alloc);
+    } else {
+        diram_fpromise_reject(ctx->promise, REJECT_REASON_MEMORY_EXHAUSTED,
+                              "async allocation failed");
+    }
+    free(ctx);
+}
+
+diram_fpromise_t* diram_alloc_async_compact(
+    size_t size,
+    const char* tag,
+    diram_memory_space_t* space
+) {
+    size_t tag_len = tag ? strlen(tag) + 1 : 0;
+    diram_compact_context_t* ctx = malloc(sizeof(diram_compact_context_t) + tag_len);
+    diram_fpromise_t* promise = diram_fpromise_create();
+    if (!ctx || !promise) {
+        free(ctx);
+        diram_fpromise_release(promise);
+        return NULL;
+    }
+    
+    ctx->task.run = async_compact_worker;
+    ctx->promise = promise;
+    ctx->space = space;
+    ctx->size = size;
+    ctx->tagged = tag != NULL;
+    if (tag) memcpy(ctx->tag, tag, tag_len);
+    
+    diram_executor_submit(&ctx->task);
+    return promise;
+}
+
 // Async allocation with lookahead - FIXED: proper parameter list
 diram_async_promise_t* diram_alloc_with_lookahead(
     size_t size,
@@ -186,30 +483,21 @@ diram_async_promise_t* diram_alloc_with_lookahead(
     diram_memory_space_t* space,
     uint32_t access_pattern_hint
 ) {
-    // FIXED: Suppress unused parameter inside function body
-    (void)space;
-    
-    init_lookahead_cache();
-    
     diram_async_promise_t* promise = diram_promise_create(NULL);
     if (!promise) return NULL;
     
-    // Check lookahead cache for predictions
-    pthread_rwlock_rdlock(&g_lookahead_cache.lock);
+    // Check lookahead cache for predictions; never shrink below the request
     size_t predicted_size = size;
     double confidence = 0.0;
+    diram_lookahead_prediction_t prediction;
     
-    for (size_t i = 0; i < g_lookahead_cache.capacity; i++) {
-        if (g_lookahead_cache.entries[i].access_pattern == access_pattern_hint) {
-            confidence = g_lookahead_cache.entries[i].confidence_score;
-            if (confidence > 0.7) {
-                predicted_size = g_lookahead_cache.entries[i].predicted_size;
-                promise->lookahead.prefetch_enabled = true;
-            }
-            break;
+    if (diram_lookahead_cache_lookup(tag, access_pattern_hint, &prediction) == 0) {
+        confidence = prediction.confidence;
+        if (confidence > 0.7 && prediction.predicted_size >= size) {
+            predicted_size = prediction.predicted_size;
+            promise->lookahead.prefetch_enabled = true;
         }
     }
-    pthread_rwlock_unlock(&g_lookahead_cache.lock);
     
     // Store lookahead parameters
     promise->lookahead_size = predicted_size;
@@ -218,66 +506,51 @@ diram_async_promise_t* diram_alloc_with_lookahead(
     promise->lookahead.predicted_next_size = predicted_size;
     promise->lookahead.access_pattern_hint = access_pattern_hint;
     
-    // Create worker context
-    diram_worker_context_t* ctx = calloc(1, sizeof(diram_worker_context_t));
-    if (ctx) {
-        ctx->promise = promise;
-        ctx->tag = tag ? strdup(tag) : NULL;
-        ctx->space = space;
-        ctx->use_lookahead = true;
-        promise->callback_context = ctx;
+    if (submit_allocation(promise, tag, space, size, true) != 0) {
+        diram_promise_reject_internal(promise, REJECT_REASON_FATAL_ERROR,
+                                      "failed to queue async allocation");
     }
     
-    // Spawn async worker thread
-    pthread_t worker_thread;
-    pthread_create(&worker_thread, NULL, async_allocation_worker, ctx);
-    pthread_detach(worker_thread);
-    
     return promise;
 }
 
-// Worker thread for async allocation
-static void* async_allocation_worker(void* arg) {
-    diram_worker_context_t* ctx = (diram_worker_context_t*)arg;
-    if (!ctx || !ctx->promise) return NULL;
-    
+// Executor task for async allocation
+static void async_allocation_worker(diram_task_t* task) {
+    diram_worker_context_t* ctx = (diram_worker_context_t*)task;
     diram_async_promise_t* promise = ctx->promise;
     
-    // Simulate async work with lookahead
-    if (ctx->use_lookahead && promise->lookahead.prefetch_enabled) {
-        // Perform predictive allocation
-        usleep(1000); // Simulate lookahead computation
+    // Cancelled while queued (a lost race): never reserve anything
+    if (promise_is_settled(promise)) {
+        if (ctx->tag) free(ctx->tag);
+        free(ctx);
+        diram_promise_destroy(promise);
+        return;
     }
     
     // Perform actual allocation
-    diram_enhanced_allocation_t* alloc = diram_alloc_enhanced(
+    diram_enhanced_allocation_t* alloc = async_alloc_enhanced(
         promise->lookahead_size,
         ctx->tag,
         ctx->space
     );
     
     if (alloc) {
-        // Copy receipt
-        memcpy(promise->receipt.allocation_receipt,
-               alloc->base.sha256_receipt,
-               DIRAM_SHA256_HEX_LEN);
-        
-        // Resolve promise
-        diram_promise_resolve_internal(promise, alloc);
-        
         // Update lookahead cache
-        pthread_rwlock_wrlock(&g_lookahead_cache.lock);
-        size_t cache_idx = promise->cache_priority % g_lookahead_cache.capacity;
-        g_lookahead_cache.entries[cache_idx].predicted_size = promise->lookahead_size;
-        g_lookahead_cache.entries[cache_idx].access_pattern = promise->cache_priority;
-        g_lookahead_cache.entries[cache_idx].last_access = time(NULL);
-        g_lookahead_cache.entries[cache_idx].confidence_score = 
-            (promise->lookahead.prediction_confidence / 100.0);
-        pthread_rwlock_unlock(&g_lookahead_cache.lock);
+        if (ctx->use_lookahead) {
+            diram_lookahead_cache_record(ctx->tag, promise->cache_priority,
+                                         ctx->requested_size);
+        }
+        
+        // Cancelled mid-allocation: hand the memory straight back
+        if (diram_promise_resolve_internal(promise, alloc) != 0) {
+            diram_alloc_async_release(alloc, ctx->space);
+        }
     } else {
         // Determine rejection reason
         diram_reject_reason_t reason = REJECT_REASON_MEMORY_EXHAUSTED;
-        if (errno == ENOMEM) {
+        if (errno == EDQUOT) {
+            reason = REJECT_REASON_GOVERNANCE_VIOLATION;
+        } else if (errno == ENOMEM) {
             reason = REJECT_REASON_FATAL_ERROR;
         } else if (ctx->use_lookahead && !promise->lookahead.prefetch_enabled) {
             reason = REJECT_REASON_LOOKAHEAD_MISS;
@@ -289,8 +562,7 @@ static void* async_allocation_worker(void* arg) {
     // Cleanup
     if (ctx->tag) free(ctx->tag);
     free(ctx);
-    
-    return NULL;
+    diram_promise_destroy(promise);
 }
 
 // Promise.then() implementation
@@ -387,6 +659,10 @@ int diram_promise_resolve_internal(
     
     promise->receipt.state = PROMISE_STATE_RESOLVED;
     promise->result.resolved_allocation = alloc;
+    if (alloc) {
+        memcpy(promise->receipt.allocation_receipt, alloc->base.sha256_receipt,
+               DIRAM_SHA256_HEX_LEN);
+    }
     
     // Execute chain
     diram_promise_chain_t* node = promise->chain_head;
@@ -394,6 +670,9 @@ int diram_promise_resolve_internal(
         if (node->onFulfilled) {
             node->onFulfilled(alloc);
         }
+        if (node->on_settle) {
+            node->on_settle(promise, node->settle_context);
+        }
         node = node->next;
     }
     
@@ -439,6 +718,9 @@ int diram_promise_reject_internal(
         if (node->onRejected) {
             node->onRejected(reason, msg);
         }
+        if (node->on_settle) {
+            node->on_settle(promise, node->settle_context);
+        }
         node = node->next;
     }
     
@@ -453,6 +735,188 @@ int diram_promise_reject_internal(
     return 0;
 }
 
+// Static constructors: promises born settled
+diram_async_promise_t* diram_promise_resolve(diram_enhanced_allocation_t* value) {
+    diram_async_promise_t* promise = diram_promise_create(NULL);
+    if (promise) diram_promise_resolve_internal(promise, value);
+    return promise;
+}
+
+diram_async_promise_t* diram_promise_reject(diram_reject_reason_t reason, const char* msg) {
+    diram_async_promise_t* promise = diram_promise_create(NULL);
+    if (promise) diram_promise_reject_internal(promise, reason, msg);
+    return promise;
+}
+
+// Combinator state - outlives the all/race struct until every child settled
+typedef struct {
+    diram_promise_combinator_t* combinator;
+    size_t index;
+} diram_combinator_entry_t;
+
+struct diram_promise_combinator {
+    size_t remaining;                       // all: children yet to resolve
+    size_t refs;                            // one per hooked child + the owner
+    int settled;                            // aggregate claimed by one CAS
+    diram_async_promise_t* aggregate;
+    diram_async_promise_t** children;
+    size_t count;
+    size_t* winner_index;                   // race only
+    diram_enhanced_allocation_t** results;
+    diram_combinator_entry_t entries[];
+};
+
+static diram_promise_combinator_t* combinator_create(
+    diram_async_promise_t** children,
+    size_t count,
+    bool with_results
+) {
+    size_t size = sizeof(diram_promise_combinator_t) + count * sizeof(diram_combinator_entry_t);
+    size_t results_offset = size;
+    if (with_results) size += count * sizeof(diram_enhanced_allocation_t*);
+    
+    diram_promise_combinator_t* c = calloc(1, size);
+    if (!c) return NULL;
+    
+    c->aggregate = diram_promise_create(NULL);
+    if (!c->aggregate) {
+        free(c);
+        return NULL;
+    }
+    c->children = children;
+    c->count = count;
+    c->remaining = count;
+    c->refs = count + 1;
+    if (with_results) c->results = (diram_enhanced_allocation_t**)((char*)c + results_offset);
+    for (size_t i = 0; i < count; i++) {
+        c->entries[i].combinator = c;
+        c->entries[i].index = i;
+    }
+    return c;
+}
+
+static void combinator_unref(diram_promise_combinator_t* c) {
+    if (__atomic_sub_fetch(&c->refs, 1, __ATOMIC_ACQ_REL) == 0) free(c);
+}
+
+static bool combinator_claim(diram_promise_combinator_t* c) {
+    int expected = 0;
+    return __atomic_compare_exchange_n(&c->settled, &expected, 1, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+// Child settled: runs once per child with the child's lock held
+static void all_on_settle(diram_async_promise_t* child, void* context) {
+    diram_combinator_entry_t* entry = (diram_combinator_entry_t*)context;
+    diram_promise_combinator_t* c = entry->combinator;
+    
+    if (child->receipt.state == PROMISE_STATE_RESOLVED) {
+        c->results[entry->index] = child->result.resolved_allocation;
+        if (__atomic_sub_fetch(&c->remaining, 1, __ATOMIC_ACQ_REL) == 0 &&
+            combinator_claim(c)) {
+            diram_promise_resolve_internal(c->aggregate, c->results[0]);
+        }
+    } else if (combinator_claim(c)) {
+        diram_promise_reject_internal(c->aggregate, child->receipt.reject_reason,
+                                      child->result.rejection_context.context);
+    }
+    combinator_unref(c);
+}
+
+static void race_on_settle(diram_async_promise_t* child, void* context) {
+    diram_combinator_entry_t* entry = (diram_combinator_entry_t*)context;
+    diram_promise_combinator_t* c = entry->combinator;
+    
+    if (combinator_claim(c)) {
+        *c->winner_index = entry->index;
+        
+        // Losers settle now; queued workers see it and never allocate.
+        // Their own hooks lose the claim and take no further locks.
+        for (size_t i = 0; i < c->count; i++) {
+            if (i == entry->index || c->children[i] == child) continue;
+            diram_promise_reject_internal(c->children[i], REJECT_REASON_CANCELLED,
+                                          "lost promise race");
+        }
+        
+        if (child->receipt.state == PROMISE_STATE_RESOLVED) {
+            diram_promise_resolve_internal(c->aggregate, child->result.resolved_allocation);
+        } else {
+            diram_promise_reject_internal(c->aggregate, child->receipt.reject_reason,
+                                          child->result.rejection_context.context);
+        }
+    }
+    combinator_unref(c);
+}
+
+static int attach_settle_hook(
+    diram_async_promise_t* promise,
+    void (*on_settle)(diram_async_promise_t*, void*),
+    void* context
+) {
+    diram_promise_chain_t* node = calloc(1, sizeof(diram_promise_chain_t));
+    if (!node) return -1;
+    node->on_settle = on_settle;
+    node->settle_context = context;
+    
+    pthread_mutex_lock(&promise->state_mutex);
+    if (promise->receipt.state == PROMISE_STATE_PENDING) {
+        if (!promise->chain_head) {
+            promise->chain_head = node;
+        } else {
+            promise->chain_tail->next = node;
+        }
+        promise->chain_tail = node;
+        node = NULL;
+    } else {
+        on_settle(promise, context);
+    }
+    pthread_mutex_unlock(&promise->state_mutex);
+    
+    free(node);
+    return 0;
+}
+
+static void combinator_attach(
+    diram_promise_combinator_t* c,
+    void (*on_settle)(diram_async_promise_t*, void*)
+) {
+    for (size_t i = 0; i < c->count; i++) {
+        if (attach_settle_hook(c->children[i], on_settle, &c->entries[i]) == 0) continue;
+        
+        // A child we cannot watch would leave the aggregate pending forever
+        if (combinator_claim(c)) {
+            diram_promise_reject_internal(c->aggregate, REJECT_REASON_FATAL_ERROR,
+                                          "failed to attach to child promise");
+        }
+        combinator_unref(c);
+    }
+}
+
+static void combinator_abandon(diram_promise_combinator_t* c) {
+    diram_async_promise_t* aggregate = c->aggregate;
+    
+    pthread_mutex_lock(&aggregate->state_mutex);
+    bool pending = aggregate->receipt.state == PROMISE_STATE_PENDING;
+    pthread_mutex_unlock(&aggregate->state_mutex);
+    
+    if (pending) {
+        for (size_t i = 0; i < c->count; i++) {
+            diram_promise_reject_internal(c->children[i], REJECT_REASON_CANCELLED,
+                                          "combinator destroyed");
+        }
+    }
+    
+    // The winning hook may still be settling the aggregate
+    pthread_mutex_lock(&aggregate->state_mutex);
+    while (aggregate->receipt.state == PROMISE_STATE_PENDING) {
+        pthread_cond_wait(&aggregate->state_cond, &aggregate->state_mutex);
+    }
+    pthread_mutex_unlock(&aggregate->state_mutex);
+    
+    diram_promise_destroy(aggregate);
+    combinator_unref(c);
+}
+
 // Promise.all() implementation
 diram_promise_all_t* diram_promise_all(
     diram_async_promise_t** promises,
@@ -463,13 +927,19 @@ diram_promise_all_t* diram_promise_all(
     diram_promise_all_t* all = calloc(1, sizeof(diram_promise_all_t));
     if (!all) return NULL;
     
+    diram_promise_combinator_t* c = combinator_create(promises, count, true);
+    if (!c) {
+        free(all);
+        return NULL;
+    }
+    
     all->promises = promises;
     all->count = count;
-    all->aggregate_promise = diram_promise_create(NULL);
-    
-    // TODO: Implement Promise.all logic
-    // Wait for all promises to resolve, or reject on first rejection
+    all->aggregate_promise = c->aggregate;
+    all->results = c->results;
+    all->combinator = c;
     
+    combinator_attach(c, all_on_settle);
     return all;
 }
 
@@ -483,16 +953,34 @@ diram_promise_race_t* diram_promise_race(
     diram_promise_race_t* race = calloc(1, sizeof(diram_promise_race_t));
     if (!race) return NULL;
     
+    diram_promise_combinator_t* c = combinator_create(promises, count, false);
+    if (!c) {
+        free(race);
+        return NULL;
+    }
+    
     race->promises = promises;
     race->count = count;
-    race->winner_promise = diram_promise_create(NULL);
-    
-    // TODO: Implement Promise.race logic
-    // Resolve/reject with first settled promise
+    race->winner_promise = c->aggregate;
+    race->combinator = c;
+    c->winner_index = &race->winner_index;
     
+    combinator_attach(c, race_on_settle);
     return race;
 }
 
+void diram_promise_all_destroy(diram_promise_all_t* all) {
+    if (!all) return;
+    if (all->combinator) combinator_abandon(all->combinator);
+    free(all);
+}
+
+void diram_promise_race_destroy(diram_promise_race_t* race) {
+    if (!race) return;
+    if (race->combinator) combinator_abandon(race->combinator);
+    free(race);
+}
+
 // Await promise with timeout
 int diram_promise_await(
     diram_async_promise_t* promise,
@@ -555,9 +1043,10 @@ diram_status_t diram_promise_get_status(diram_async_promise_t* promise) {
     return status;
 }
 
-// Cleanup promise
+// Cleanup promise - drops one reference; the last one frees it
 void diram_promise_destroy(diram_async_promise_t* promise) {
     if (!promise) return;
+    if (__atomic_sub_fetch(&promise->refs, 1, __ATOMIC_ACQ_REL) != 0) return;
     
     pthread_mutex_destroy(&promise->state_mutex);
     pthread_cond_destroy(&promise->state_cond);
@@ -5,91 +5,76 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include "diram/core/diram.h"
 #include "diram/core/diram_phenomenological.h"
-#include "diram/core/feature-alloc/alloc.h"
+#include "diram/core/diram_dag.h"
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+#include "diram/core/feature-alloc/prefetch_pool.h"
 
-// Remove the duplicate typedefs - they're already in diram_phenomenological.h
-// Only define helper functions that aren't in the headers
-
-// Helper functions
-static uint32_t detect_pattern_length(phenotype_t* seq, uint32_t len) {
-    // Simple pattern detection stub
-    (void)seq; // Suppress unused warning
-    return len > 4 ? 2 : 0;
-}
-
-static dag_node_t* diram_navigate_dag(diram_context_t* ctx, phenotype_t pheno) {
-    // Navigation stub
-    (void)ctx;   // Suppress unused warning
-    (void)pheno; // Suppress unused warning
-    return NULL;
-}
-
-static void mark_memory_speculative(void* ptr, size_t size) {
-    // Speculation marker stub
-    (void)ptr; 
-    (void)size;
-}
-
-// Phenomenon predictor structure
-typedef struct {
-    phenotype_t observed_sequence[32];  // Recent phenomena observations
-    uint32_t sequence_length;
-    float confidence_scores[32];        // Confidence in each observation
-} phenomenon_predictor_t;
+// Below this the model is guessing; fall back to the DAG-stability heuristic
+#define PREFETCH_MIN_CONFIDENCE 0.5f
 
 // Predict next memory phenomenon based on observed patterns
 phenotype_t predict_next_phenomenon(phenomenon_predictor_t* predictor, 
-                                   dag_node_t* current_state) {
-    phenotype_t predicted = {.raw = 0};
+                                   dag_node_t* current_state,
+                                   phenomenon_prediction_t* out) {
+    phenomenon_prediction_t prediction = {0};
+    bool modelled = diram_predictor_predict(predictor, &prediction) == 0;
     
-    // Analyze observed sequence for patterns
-    if (predictor->sequence_length >= 3) {
-        // Look for repeating patterns (simple markov chain)
-        uint32_t pattern_length = detect_pattern_length(predictor->observed_sequence,
-                                                       predictor->sequence_length);
+    // Weight prediction by DAG edge probabilities. Triggers are bitfields,
+    // so edges vote for whole phenotypes instead of being averaged.
+    if (current_state && current_state->edge_count > 0) {
+        uint32_t mask = predictor ? predictor->field_mask : DIRAM_PHENO_FIELDS_ALL;
+        float total_probability = 0.0f;
+        float agreeing = 0.0f;
+        dag_edge_t* likeliest = NULL;
         
-        if (pattern_length > 0) {
-            // Predict based on pattern
-            uint32_t next_index = predictor->sequence_length % pattern_length;
-            predicted = predictor->observed_sequence[next_index];
+        for (uint32_t i = 0; i < current_state->edge_count; i++) {
+            dag_edge_t* edge = current_state->edges[i];
+            total_probability += edge->probability;
+            if (!likeliest || edge->probability > likeliest->probability) {
+                likeliest = edge;
+            }
+            if (modelled && ((edge->trigger.raw ^ prediction.phenotype.raw) & mask) == 0) {
+                agreeing += edge->probability;
+            }
         }
-    }
-    
-    // Weight prediction by DAG edge probabilities
-    float total_probability = 0.0f;
-    phenotype_t weighted_sum = {.raw = 0};
-    
-    for (uint32_t i = 0; i < current_state->edge_count; i++) {
-        dag_edge_t* edge = current_state->edges[i];
         
-        // Weight each possible next state by its probability
-        uint32_t weighted_pheno = (uint32_t)(edge->trigger.raw * edge->probability);
-        weighted_sum.raw += weighted_pheno;
-        total_probability += edge->probability;
-    }
-    
-    if (total_probability > 0.0f) {
-        // Combine pattern prediction with DAG probabilities
-        predicted.raw = (predicted.raw / 2) + 
-                       (weighted_sum.raw / (uint32_t)(total_probability * 2));
+        if (total_probability > 0.0f) {
+            if (modelled) {
+                // Independent evidence for the same phenotype
+                float support = agreeing / total_probability;
+                prediction.confidence = 1.0f - (1.0f - prediction.confidence) * (1.0f - support);
+            } else {
+                prediction.phenotype = likeliest->trigger;
+                prediction.size = 0;
+                prediction.confidence = likeliest->probability / total_probability;
+                prediction.order = 0;
+            }
+        }
     }
     
-    return predicted;
+    if (out) *out = prediction;
+    return prediction.phenotype;
 }
 
 // Prefetch based on predicted phenomena
-int prefetch_by_phenomenon(diram_context_t* ctx, phenotype_t predicted) {
+int prefetch_by_phenomenon(diram_context_t* ctx, const phenomenon_prediction_t* prediction) {
+    if (!ctx || !prediction) return -1;
+    phenotype_t predicted = prediction->phenotype;
+    
     // Navigate DAG to predicted state
     dag_node_t* predicted_state = diram_navigate_dag(ctx, predicted);
     
     // Use predicted_state for enhanced prefetch decisions
     size_t prefetch_size = 0;
+    float stability = predicted_state ? predicted_state->stability_score : 0.0f;
+    diram_dag_release(ctx->dag, predicted_state);
     
-    if (predicted_state != NULL) {
+    if (prediction->size > 0 && prediction->confidence >= PREFETCH_MIN_CONFIDENCE) {
+        // The model has seen this phenomenon lead to this size
+        prefetch_size = prediction->size;
+    } else if (predicted_state != NULL) {
         // Adjust prefetch based on DAG node stability
-        float stability = predicted_state->stability_score;
         if (stability > 0.8f && predicted.fields.frequency >= 5) {
             prefetch_size = 4096;  // High frequency + stable - prefetch more
         } else if (predicted.fields.locality >= 10) {
@@ -102,14 +87,7 @@ int prefetch_by_phenomenon(diram_context_t* ctx, phenotype_t predicted) {
         prefetch_size = 1024;
     }
     
-    // Perform speculative allocation
-    void* prefetched = diram_alloc(ctx, prefetch_size, predicted);
-    
-    if (prefetched) {
-        // Mark as speculative
-        mark_memory_speculative(prefetched, prefetch_size);
-        return 0;
-    }
-    
-    return -1;
+    // Park the speculative block; diram_alloc claims it if the prediction holds
+    if (!ctx->prefetch_pool) return -1;
+    return diram_prefetch_pool_prefetch(ctx->prefetch_pool, prefetch_size, predicted.raw);
 }
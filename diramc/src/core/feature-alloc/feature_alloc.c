@@ -1,4 +1,5 @@
 #include "diram/core/diram.h"
+#include "diram/core/feature-alloc/space_account.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -9,22 +10,58 @@ diram_memory_space_t* diram_space_create(const char* name, size_t limit) {
     strncpy(space->space_name, name, 63);
     space->limit_bytes = limit;
     space->owner_pid = getpid();
-    pthread_mutex_init(&space->lock, NULL);
+    space->account = diram_account_create(limit);
+    if (!space->account) {
+        free(space);
+        return NULL;
+    }
+    
+    uint32_t rate, burst;
+    diram_gov_space_defaults(&rate, &burst);
+    diram_gov_bucket_init(&space->governor, rate, burst);
     return space;
 }
 
 void diram_space_destroy(diram_memory_space_t* space) {
     if (!space) return;
-    pthread_mutex_destroy(&space->lock);
+    diram_account_destroy(space->account);
     free(space);
 }
 
+// Advisory only - use diram_space_charge to check and take quota atomically
 int diram_space_check_limit(diram_memory_space_t* space, size_t requested) {
     if (!space) return 0;
-    pthread_mutex_lock(&space->lock);
-    int ok = (space->used_bytes + requested <= space->limit_bytes) ? 0 : -1;
-    pthread_mutex_unlock(&space->lock);
-    return ok;
+    size_t used = diram_account_used(space->account);
+    return (requested <= space->limit_bytes && used <= space->limit_bytes - requested) ? 0 : -1;
+}
+
+int diram_space_charge(diram_memory_space_t* space, size_t bytes) {
+    if (!space) return 0;
+    return diram_account_charge(space->account, bytes);
+}
+
+void diram_space_release(diram_memory_space_t* space, size_t bytes) {
+    if (!space) return;
+    diram_account_release(space->account, bytes);
+}
+
+// Governor events, then the quota; -1 if either refuses. A refused
+// charge still spends the events, as a refused allocation would
+int diram_space_admit(diram_memory_space_t* space, size_t bytes, uint32_t events) {
+    if (!space) return 0;
+    if (diram_gov_bucket_admit(&space->governor, diram_gov_now_ns(), events) != 0) return -1;
+    return diram_account_charge(space->account, bytes);
+}
+
+size_t diram_space_used(const diram_memory_space_t* space) {
+    if (!space) return 0;
+    return diram_account_used(space->account);
+}
+
+int diram_space_set_rate(diram_memory_space_t* space, uint32_t rate, uint32_t burst) {
+    if (!space) return -1;
+    diram_gov_bucket_init(&space->governor, rate, burst);
+    return 0;
 }
 
 void diram_error_index_init(void) {
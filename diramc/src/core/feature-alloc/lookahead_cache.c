@@ -0,0 +1,350 @@
+// src/core/feature-alloc/lookahead_cache.c
+// OBINexus DIRAM Lookahead Cache
+// A key maps to a shard by its top bits and to a window of PROBE slots by
+// its low bits; it lives anywhere in that window, so there are no
+// tombstones. Readers copy the window under the shard sequence counter and
+// retry if a writer overlapped; hits set the slot's reference bit outside
+// the seqlock, which at worst grants a fresh entry one extra CLOCK pass.
+#include "diram/core/feature-alloc/lookahead_cache.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#define SLOT_USED        0x1u
+#define SLOT_REFERENCED  0x2u
+
+#define CONFIDENCE_NEW      0.5
+#define CONFIDENCE_REPLACE  0.3     // below this a different size takes over
+
+_Static_assert((DIRAM_LOOKAHEAD_SHARDS & (DIRAM_LOOKAHEAD_SHARDS - 1)) == 0,
+               "lookahead shard count must be a power of two");
+
+// Every field is read racily by seqlock readers, so all access is atomic
+typedef struct {
+    uint64_t tag_hash;
+    uint32_t pattern;
+    uint32_t flags;
+    uint64_t predicted_size;
+    uint64_t confidence;          // IEEE-754 bits of a double
+    uint64_t last_access;
+} diram_lookahead_slot_t;
+
+typedef struct {
+    _Alignas(64) uint32_t seq;    // odd while a writer is inside
+    pthread_mutex_t lock;         // writers only
+    uint32_t hand;                // CLOCK position within a probe window
+    uint32_t mask;
+    diram_lookahead_slot_t* slots;
+    size_t entries;
+    uint64_t inserts;
+    uint64_t evictions;
+    _Alignas(64) uint64_t hits;   // bumped by readers
+    uint64_t misses;
+    uint64_t retries;
+} diram_lookahead_shard_t;
+
+typedef struct {
+    diram_lookahead_shard_t shards[DIRAM_LOOKAHEAD_SHARDS];
+    size_t capacity;
+} diram_lookahead_table_t;
+
+static struct {
+    pthread_mutex_t lock;         // build and configure only
+    diram_lookahead_table_t* table;
+    size_t capacity;
+} g_lookahead = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .capacity = DIRAM_LOOKAHEAD_DEFAULT_CAPACITY,
+};
+
+static inline uint64_t tag_hash(const char* tag) {
+    // FNV-1a; untagged allocations share one key per pattern
+    const unsigned char* p = (const unsigned char*)(tag ? tag : "untagged");
+    uint64_t h = 0xcbf29ce484222325ULL;
+    while (*p) {
+        h ^= *p++;
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+static inline uint64_t key_mix(uint64_t th, uint32_t pattern) {
+    uint64_t x = th ^ ((uint64_t)pattern * 0x9E3779B97F4A7C15ULL);
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static inline uint64_t double_bits(double d) {
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+static inline double bits_double(uint64_t bits) {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+static diram_lookahead_table_t* table_build(size_t capacity) {
+    diram_lookahead_table_t* table = NULL;
+    if (posix_memalign((void**)&table, 64, sizeof(*table)) != 0) return NULL;
+    memset(table, 0, sizeof(*table));
+
+    size_t per_shard = DIRAM_LOOKAHEAD_PROBE;
+    while (per_shard * DIRAM_LOOKAHEAD_SHARDS < capacity) per_shard <<= 1;
+
+    for (int i = 0; i < DIRAM_LOOKAHEAD_SHARDS; i++) {
+        diram_lookahead_shard_t* shard = &table->shards[i];
+        shard->slots = calloc(per_shard, sizeof(diram_lookahead_slot_t));
+        if (!shard->slots) {
+            while (--i >= 0) free(table->shards[i].slots);
+            free(table);
+            return NULL;
+        }
+        shard->mask = (uint32_t)(per_shard - 1);
+        pthread_mutex_init(&shard->lock, NULL);
+    }
+    table->capacity = per_shard * DIRAM_LOOKAHEAD_SHARDS;
+    return table;
+}
+
+static diram_lookahead_table_t* table_get(void) {
+    diram_lookahead_table_t* table = __atomic_load_n(&g_lookahead.table, __ATOMIC_ACQUIRE);
+    if (table) return table;
+
+    pthread_mutex_lock(&g_lookahead.lock);
+    table = g_lookahead.table;
+    if (!table) {
+        table = table_build(g_lookahead.capacity);
+        __atomic_store_n(&g_lookahead.table, table, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&g_lookahead.lock);
+    return table;
+}
+
+int diram_lookahead_cache_configure(size_t capacity) {
+    pthread_mutex_lock(&g_lookahead.lock);
+    int rc = -1;
+    if (!g_lookahead.table) {
+        g_lookahead.capacity = capacity ? capacity : DIRAM_LOOKAHEAD_DEFAULT_CAPACITY;
+        rc = 0;
+    }
+    pthread_mutex_unlock(&g_lookahead.lock);
+    return rc;
+}
+
+static inline diram_lookahead_shard_t* shard_for(diram_lookahead_table_t* table, uint64_t key) {
+    return &table->shards[key >> (64 - __builtin_ctz(DIRAM_LOOKAHEAD_SHARDS))];
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+int diram_lookahead_cache_lookup(const char* tag, uint32_t access_pattern,
+                                 diram_lookahead_prediction_t* out) {
+    diram_lookahead_table_t* table = table_get();
+    if (!table) return -1;
+
+    uint64_t th = tag_hash(tag);
+    uint64_t key = key_mix(th, access_pattern);
+    diram_lookahead_shard_t* shard = shard_for(table, key);
+
+    diram_lookahead_slot_t* hit;
+    diram_lookahead_prediction_t found;
+
+    for (;;) {
+        uint32_t seq = __atomic_load_n(&shard->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            cpu_relax();
+            continue;
+        }
+
+        hit = NULL;
+        for (uint32_t p = 0; p < DIRAM_LOOKAHEAD_PROBE; p++) {
+            diram_lookahead_slot_t* slot = &shard->slots[(key + p) & shard->mask];
+            if (!(__atomic_load_n(&slot->flags, __ATOMIC_RELAXED) & SLOT_USED)) continue;
+            if (__atomic_load_n(&slot->tag_hash, __ATOMIC_RELAXED) != th ||
+                __atomic_load_n(&slot->pattern, __ATOMIC_RELAXED) != access_pattern) {
+                continue;
+            }
+            found.predicted_size = __atomic_load_n(&slot->predicted_size, __ATOMIC_RELAXED);
+            found.confidence = bits_double(__atomic_load_n(&slot->confidence, __ATOMIC_RELAXED));
+            found.last_access = __atomic_load_n(&slot->last_access, __ATOMIC_RELAXED);
+            hit = slot;
+            break;
+        }
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&shard->seq, __ATOMIC_RELAXED) == seq) break;
+        __atomic_fetch_add(&shard->retries, 1, __ATOMIC_RELAXED);
+    }
+
+    if (!hit) {
+        __atomic_fetch_add(&shard->misses, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    __atomic_fetch_or(&hit->flags, SLOT_REFERENCED, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&shard->hits, 1, __ATOMIC_RELAXED);
+    if (out) *out = found;
+    return 0;
+}
+
+// ============================================================================
+// Writers
+// ============================================================================
+
+static inline void write_begin(diram_lookahead_shard_t* shard) {
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void write_end(diram_lookahead_shard_t* shard) {
+    __atomic_store_n(&shard->seq, shard->seq + 1, __ATOMIC_RELEASE);
+}
+
+// Second chance within the window: clear reference bits until one is clear
+static diram_lookahead_slot_t* clock_victim(diram_lookahead_shard_t* shard, uint64_t key) {
+    for (uint32_t step = 0; step < 2 * DIRAM_LOOKAHEAD_PROBE; step++) {
+        uint32_t p = (shard->hand + step) % DIRAM_LOOKAHEAD_PROBE;
+        diram_lookahead_slot_t* slot = &shard->slots[(key + p) & shard->mask];
+        uint32_t flags = __atomic_load_n(&slot->flags, __ATOMIC_RELAXED);
+        if (flags & SLOT_REFERENCED) {
+            __atomic_fetch_and(&slot->flags, ~SLOT_REFERENCED, __ATOMIC_RELAXED);
+            continue;
+        }
+        shard->hand = (p + 1) % DIRAM_LOOKAHEAD_PROBE;
+        return slot;
+    }
+    // Every slot was re-referenced while we swept; take the one under the hand
+    return &shard->slots[(key + shard->hand) & shard->mask];
+}
+
+void diram_lookahead_cache_record(const char* tag, uint32_t access_pattern, size_t size) {
+    diram_lookahead_table_t* table = table_get();
+    if (!table) return;
+
+    uint64_t th = tag_hash(tag);
+    uint64_t key = key_mix(th, access_pattern);
+    diram_lookahead_shard_t* shard = shard_for(table, key);
+    uint64_t now = (uint64_t)time(NULL);
+
+    pthread_mutex_lock(&shard->lock);
+
+    diram_lookahead_slot_t* match = NULL;
+    diram_lookahead_slot_t* empty = NULL;
+    for (uint32_t p = 0; p < DIRAM_LOOKAHEAD_PROBE && !match; p++) {
+        diram_lookahead_slot_t* slot = &shard->slots[(key + p) & shard->mask];
+        // Readers may be setting the reference bit concurrently
+        if (!(__atomic_load_n(&slot->flags, __ATOMIC_RELAXED) & SLOT_USED)) {
+            if (!empty) empty = slot;
+        } else if (slot->tag_hash == th && slot->pattern == access_pattern) {
+            match = slot;
+        }
+    }
+
+    if (match) {
+        // Confidence climbs while the size recurs and halves when it does not
+        double confidence = bits_double(match->confidence);
+        uint64_t predicted = match->predicted_size;
+        if (predicted == size) {
+            confidence += (1.0 - confidence) * 0.25;
+        } else {
+            confidence *= 0.5;
+            if (confidence < CONFIDENCE_REPLACE) {
+                predicted = size;
+                confidence = CONFIDENCE_NEW;
+            }
+        }
+
+        write_begin(shard);
+        __atomic_store_n(&match->predicted_size, predicted, __ATOMIC_RELAXED);
+        __atomic_store_n(&match->confidence, double_bits(confidence), __ATOMIC_RELAXED);
+        __atomic_store_n(&match->last_access, now, __ATOMIC_RELAXED);
+        write_end(shard);
+    } else {
+        diram_lookahead_slot_t* slot = empty;
+        if (slot) {
+            shard->entries++;
+        } else {
+            slot = clock_victim(shard, key);
+            shard->evictions++;
+        }
+        shard->inserts++;
+
+        write_begin(shard);
+        __atomic_store_n(&slot->tag_hash, th, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->pattern, access_pattern, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->predicted_size, (uint64_t)size, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->confidence, double_bits(CONFIDENCE_NEW), __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->last_access, now, __ATOMIC_RELAXED);
+        __atomic_store_n(&slot->flags, SLOT_USED, __ATOMIC_RELAXED);
+        write_end(shard);
+    }
+
+    pthread_mutex_unlock(&shard->lock);
+}
+
+void diram_lookahead_cache_clear(void) {
+    diram_lookahead_table_t* table = __atomic_load_n(&g_lookahead.table, __ATOMIC_ACQUIRE);
+    if (!table) return;
+
+    for (int i = 0; i < DIRAM_LOOKAHEAD_SHARDS; i++) {
+        diram_lookahead_shard_t* shard = &table->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        write_begin(shard);
+        for (uint32_t s = 0; s <= shard->mask; s++) {
+            __atomic_store_n(&shard->slots[s].flags, 0, __ATOMIC_RELAXED);
+        }
+        write_end(shard);
+        shard->entries = 0;
+        shard->inserts = 0;
+        shard->evictions = 0;
+        __atomic_store_n(&shard->hits, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&shard->misses, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&shard->retries, 0, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+void diram_lookahead_cache_get_stats(diram_lookahead_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    diram_lookahead_table_t* table = __atomic_load_n(&g_lookahead.table, __ATOMIC_ACQUIRE);
+    if (!table) {
+        pthread_mutex_lock(&g_lookahead.lock);
+        out->capacity = g_lookahead.capacity;
+        pthread_mutex_unlock(&g_lookahead.lock);
+        return;
+    }
+
+    out->capacity = table->capacity;
+    for (int i = 0; i < DIRAM_LOOKAHEAD_SHARDS; i++) {
+        diram_lookahead_shard_t* shard = &table->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        out->entries += shard->entries;
+        out->inserts += shard->inserts;
+        out->evictions += shard->evictions;
+        pthread_mutex_unlock(&shard->lock);
+        out->hits += __atomic_load_n(&shard->hits, __ATOMIC_RELAXED);
+        out->misses += __atomic_load_n(&shard->misses, __ATOMIC_RELAXED);
+        out->read_retries += __atomic_load_n(&shard->retries, __ATOMIC_RELAXED);
+    }
+
+    uint64_t lookups = out->hits + out->misses;
+    out->hit_ratio = lookups ? (double)out->hits / (double)lookups : 0.0;
+}
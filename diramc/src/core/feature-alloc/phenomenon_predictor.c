@@ -0,0 +1,161 @@
+// src/core/feature-alloc/phenomenon_predictor.c
+// OBINexus DIRAM Phenomenon Predictor
+// Symbols compare on the masked phenotype and the power-of-two size class,
+// so 1000- and 1020-byte requests count as the same event; each candidate
+// remembers the largest size seen in its class, which is what a prefetch
+// has to cover. Contexts are direct-mapped: a colliding context simply
+// restarts the slot, which keeps every update a fixed amount of work.
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+#include <stdlib.h>
+#include <string.h>
+
+static inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static inline uint32_t size_class(uint64_t size) {
+    return size > 1 ? 64 - (uint32_t)__builtin_clzll(size - 1) : 0;
+}
+
+static inline uint32_t history_available(const phenomenon_predictor_t* p) {
+    return p->sequence_length < DIRAM_PREDICTOR_HISTORY ?
+           p->sequence_length : DIRAM_PREDICTOR_HISTORY;
+}
+
+// Hash of the last `order` symbols, most recent first
+static uint64_t context_key(const phenomenon_predictor_t* p, uint32_t order) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL * (order + 1);
+    for (uint32_t j = 0; j < order; j++) {
+        uint32_t idx = (p->sequence_length - 1 - j) % DIRAM_PREDICTOR_HISTORY;
+        uint64_t symbol = ((uint64_t)(p->observed_sequence[idx].raw & p->field_mask) << 8) |
+                          size_class(p->observed_sizes[idx]);
+        h = mix64(h ^ symbol);
+    }
+    return h | 1;
+}
+
+static inline diram_predictor_context_t* context_slot(const phenomenon_predictor_t* p,
+                                                      uint32_t order, uint64_t key) {
+    return &p->contexts[(size_t)order * DIRAM_PREDICTOR_CONTEXTS +
+                        (key & (DIRAM_PREDICTOR_CONTEXTS - 1))];
+}
+
+static diram_predictor_candidate_t* find_candidate(diram_predictor_context_t* ctx,
+                                                   uint32_t pheno, uint32_t cls) {
+    for (uint32_t i = 0; i < ctx->distinct; i++) {
+        if (ctx->next[i].phenotype == pheno && size_class(ctx->next[i].size) == cls) {
+            return &ctx->next[i];
+        }
+    }
+    return NULL;
+}
+
+static void context_update(diram_predictor_context_t* ctx, uint32_t pheno, uint64_t size) {
+    diram_predictor_candidate_t* c = find_candidate(ctx, pheno, size_class(size));
+
+    if (c) {
+        c->count++;
+        if (size > c->size) c->size = size;
+    } else {
+        if (ctx->distinct < DIRAM_PREDICTOR_CANDIDATES) {
+            c = &ctx->next[ctx->distinct++];
+        } else {
+            // Full: the least frequent follower makes room
+            c = &ctx->next[0];
+            for (uint32_t i = 1; i < DIRAM_PREDICTOR_CANDIDATES; i++) {
+                if (ctx->next[i].count < c->count) c = &ctx->next[i];
+            }
+            ctx->total -= c->count;
+        }
+        c->phenotype = pheno;
+        c->size = size;
+        c->count = 1;
+    }
+    ctx->total++;
+
+    if (c->count > DIRAM_PREDICTOR_COUNT_LIMIT) {
+        ctx->total = 0;
+        for (uint32_t i = 0; i < ctx->distinct; i++) {
+            ctx->next[i].count = (ctx->next[i].count + 1) / 2;
+            ctx->total += ctx->next[i].count;
+        }
+    }
+}
+
+int diram_predictor_init(phenomenon_predictor_t* predictor, uint32_t order, uint32_t field_mask) {
+    if (!predictor || order > DIRAM_PREDICTOR_MAX_ORDER) return -1;
+
+    memset(predictor, 0, sizeof(*predictor));
+    predictor->order = order ? order : DIRAM_PREDICTOR_DEFAULT_ORDER;
+    predictor->field_mask = field_mask ? field_mask : DIRAM_PHENO_FIELDS_DEFAULT;
+    predictor->contexts = calloc((size_t)(predictor->order + 1) * DIRAM_PREDICTOR_CONTEXTS,
+                                 sizeof(diram_predictor_context_t));
+    return predictor->contexts ? 0 : -1;
+}
+
+void diram_predictor_destroy(phenomenon_predictor_t* predictor) {
+    if (!predictor) return;
+    free(predictor->contexts);
+    predictor->contexts = NULL;
+}
+
+void diram_predictor_observe(phenomenon_predictor_t* predictor, phenotype_t pheno, size_t size) {
+    if (!predictor || !predictor->contexts) return;
+
+    uint32_t symbol = pheno.raw & predictor->field_mask;
+    uint32_t top = history_available(predictor);
+    if (top > predictor->order) top = predictor->order;
+
+    // Longest context that already existed scores the observation
+    float scored = -1.0f;
+    for (int32_t o = (int32_t)top; o >= 0; o--) {
+        uint64_t key = context_key(predictor, (uint32_t)o);
+        diram_predictor_context_t* ctx = context_slot(predictor, (uint32_t)o, key);
+
+        if (ctx->key != key) {
+            memset(ctx, 0, sizeof(*ctx));
+            ctx->key = key;
+        } else if (scored < 0.0f && ctx->total > 0) {
+            diram_predictor_candidate_t* c = find_candidate(ctx, symbol, size_class(size));
+            scored = c ? (float)c->count / (float)(ctx->total + ctx->distinct) : 0.0f;
+        }
+        context_update(ctx, symbol, size);
+    }
+
+    uint32_t idx = predictor->sequence_length % DIRAM_PREDICTOR_HISTORY;
+    predictor->observed_sequence[idx] = pheno;
+    predictor->observed_sizes[idx] = size;
+    predictor->confidence_scores[idx] = scored < 0.0f ? 0.0f : scored;
+    predictor->sequence_length++;
+}
+
+int diram_predictor_predict(const phenomenon_predictor_t* predictor, phenomenon_prediction_t* out) {
+    if (!predictor || !predictor->contexts || !out) return -1;
+
+    uint32_t top = history_available(predictor);
+    if (top > predictor->order) top = predictor->order;
+
+    for (int32_t o = (int32_t)top; o >= 0; o--) {
+        uint64_t key = context_key(predictor, (uint32_t)o);
+        diram_predictor_context_t* ctx = context_slot(predictor, (uint32_t)o, key);
+        if (ctx->key != key || ctx->total == 0) continue;
+
+        const diram_predictor_candidate_t* best = &ctx->next[0];
+        for (uint32_t i = 1; i < ctx->distinct; i++) {
+            if (ctx->next[i].count > best->count) best = &ctx->next[i];
+        }
+
+        // PPM method C: each distinct follower reserves one escape count
+        out->phenotype.raw = best->phenotype;
+        out->size = (size_t)best->size;
+        out->confidence = (float)best->count / (float)(ctx->total + ctx->distinct);
+        out->order = (uint32_t)o;
+        return 0;
+    }
+    return -1;
+}
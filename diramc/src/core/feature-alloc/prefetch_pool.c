@@ -0,0 +1,200 @@
+// src/core/feature-alloc/prefetch_pool.c
+// OBINexus DIRAM Speculative Prefetch Pool
+// Blocks sit on two intrusive index lists: a FIFO per power-of-two size
+// class for claiming, and one pool-wide FIFO by park time for ageing and
+// reclaim. A request checks the head of its own class and then the next
+// class up, so claiming never scans.
+#include "diram/core/feature-alloc/prefetch_pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BLOCK_NONE 0xFF
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// Sizes past 2^63 would round up to class 64; they share the top class,
+// where the size check on the head still decides
+static inline uint8_t size_class(size_t size) {
+    if (size > 1ULL << (DIRAM_PREFETCH_CLASSES - 1)) return DIRAM_PREFETCH_CLASSES - 1;
+    return size > 1 ? (uint8_t)(64 - __builtin_clzll((unsigned long long)size - 1)) : 0;
+}
+
+diram_prefetch_pool_t* diram_prefetch_pool_create(uint32_t max_blocks, size_t max_bytes,
+                                                  uint32_t max_age_ms) {
+    if (max_blocks > DIRAM_PREFETCH_MAX_BLOCKS) return NULL;
+
+    diram_prefetch_pool_t* pool = calloc(1, sizeof(diram_prefetch_pool_t));
+    if (!pool) return NULL;
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pool->max_blocks = max_blocks ? max_blocks : DIRAM_PREFETCH_MAX_BLOCKS;
+    pool->max_bytes = max_bytes ? max_bytes : DIRAM_PREFETCH_DEFAULT_BYTES;
+    pool->max_age_ns = (uint64_t)(max_age_ms ? max_age_ms : DIRAM_PREFETCH_DEFAULT_AGE_MS) * 1000000ULL;
+
+    for (uint32_t i = 0; i < DIRAM_PREFETCH_MAX_BLOCKS; i++) {
+        pool->blocks[i].class_next = i + 1 < DIRAM_PREFETCH_MAX_BLOCKS ? (uint8_t)(i + 1) : BLOCK_NONE;
+    }
+    pool->free_head = 0;
+    memset(pool->class_head, BLOCK_NONE, sizeof(pool->class_head));
+    memset(pool->class_tail, BLOCK_NONE, sizeof(pool->class_tail));
+    pool->age_head = BLOCK_NONE;
+    pool->age_tail = BLOCK_NONE;
+    return pool;
+}
+
+// Unlink a class head from both lists and return its slot to the freelist
+static void unlink_class_head(diram_prefetch_pool_t* pool, uint8_t cls) {
+    uint8_t i = pool->class_head[cls];
+    diram_prefetch_block_t* b = &pool->blocks[i];
+
+    pool->class_head[cls] = b->class_next;
+    if (pool->class_head[cls] == BLOCK_NONE) pool->class_tail[cls] = BLOCK_NONE;
+
+    if (b->age_prev != BLOCK_NONE) pool->blocks[b->age_prev].age_next = b->age_next;
+    else pool->age_head = b->age_next;
+    if (b->age_next != BLOCK_NONE) pool->blocks[b->age_next].age_prev = b->age_prev;
+    else pool->age_tail = b->age_prev;
+
+    pool->count--;
+    pool->bytes -= b->size;
+    b->ptr = NULL;
+    b->class_next = pool->free_head;
+    pool->free_head = i;
+}
+
+// The oldest block overall is also the head of its class FIFO
+static void drop_oldest(diram_prefetch_pool_t* pool, uint64_t* counter) {
+    diram_prefetch_block_t* b = &pool->blocks[pool->age_head];
+    void* ptr = b->ptr;
+    size_t size = b->size;
+
+    unlink_class_head(pool, b->cls);
+    free(ptr);
+    (*counter)++;
+    pool->stats.wasted_bytes += size;
+}
+
+static void age_out(diram_prefetch_pool_t* pool, uint64_t now) {
+    while (pool->age_head != BLOCK_NONE &&
+           now - pool->blocks[pool->age_head].parked_ns > pool->max_age_ns) {
+        drop_oldest(pool, &pool->stats.aged_out);
+    }
+}
+
+void diram_prefetch_pool_destroy(diram_prefetch_pool_t* pool) {
+    if (!pool) return;
+    while (pool->age_head != BLOCK_NONE) {
+        drop_oldest(pool, &pool->stats.reclaimed);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+int diram_prefetch_pool_prefetch(diram_prefetch_pool_t* pool, size_t size, uint32_t phenotype) {
+    if (!pool || size == 0 || size > pool->max_bytes) return -1;
+
+    // Allocate outside the lock; the cost is what a later hit saves
+    uint64_t start = now_ns();
+    void* ptr = calloc(1, size);
+    uint64_t parked = now_ns();
+    if (!ptr) return -1;
+
+    pthread_mutex_lock(&pool->lock);
+    age_out(pool, parked);
+    while (pool->count >= pool->max_blocks || pool->bytes + size > pool->max_bytes) {
+        drop_oldest(pool, &pool->stats.reclaimed);
+    }
+
+    uint8_t i = pool->free_head;
+    diram_prefetch_block_t* b = &pool->blocks[i];
+    pool->free_head = b->class_next;
+
+    b->ptr = ptr;
+    b->size = size;
+    b->parked_ns = parked;
+    b->alloc_ns = parked - start;
+    b->phenotype = phenotype;
+    b->cls = size_class(size);
+
+    b->class_next = BLOCK_NONE;
+    if (pool->class_tail[b->cls] != BLOCK_NONE) pool->blocks[pool->class_tail[b->cls]].class_next = i;
+    else pool->class_head[b->cls] = i;
+    pool->class_tail[b->cls] = i;
+
+    b->age_next = BLOCK_NONE;
+    b->age_prev = pool->age_tail;
+    if (pool->age_tail != BLOCK_NONE) pool->blocks[pool->age_tail].age_next = i;
+    else pool->age_head = i;
+    pool->age_tail = i;
+
+    pool->count++;
+    pool->bytes += size;
+    pool->stats.parked++;
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+void* diram_prefetch_pool_take(diram_prefetch_pool_t* pool, size_t size) {
+    if (!pool || size == 0) return NULL;
+
+    uint8_t cls = size_class(size);
+    void* ptr = NULL;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->count > 0) {
+        age_out(pool, now_ns());
+
+        // Own class if the head is large enough, else anything one class up
+        uint8_t found = BLOCK_NONE;
+        if (pool->class_head[cls] != BLOCK_NONE &&
+            pool->blocks[pool->class_head[cls]].size >= size) {
+            found = cls;
+        } else if (cls + 1 < DIRAM_PREFETCH_CLASSES && pool->class_head[cls + 1] != BLOCK_NONE) {
+            found = cls + 1;
+        }
+
+        if (found != BLOCK_NONE) {
+            diram_prefetch_block_t* b = &pool->blocks[pool->class_head[found]];
+            ptr = b->ptr;
+            pool->stats.hits++;
+            pool->stats.served_bytes += b->size;
+            pool->stats.time_saved_ns += b->alloc_ns;
+            unlink_class_head(pool, found);
+        }
+    }
+    if (!ptr) pool->stats.misses++;
+    pthread_mutex_unlock(&pool->lock);
+    return ptr;
+}
+
+size_t diram_prefetch_pool_reclaim(diram_prefetch_pool_t* pool, size_t bytes) {
+    if (!pool) return 0;
+
+    pthread_mutex_lock(&pool->lock);
+    size_t before = pool->bytes;
+    while (pool->age_head != BLOCK_NONE && before - pool->bytes < bytes) {
+        drop_oldest(pool, &pool->stats.reclaimed);
+    }
+    size_t freed = before - pool->bytes;
+    pthread_mutex_unlock(&pool->lock);
+    return freed;
+}
+
+void diram_prefetch_pool_get_stats(diram_prefetch_pool_t* pool, diram_prefetch_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    *out = pool->stats;
+    out->blocks = pool->count;
+    out->bytes = pool->bytes;
+    pthread_mutex_unlock(&pool->lock);
+
+    out->hit_ratio = out->parked ? (double)out->hits / (double)out->parked : 0.0;
+}
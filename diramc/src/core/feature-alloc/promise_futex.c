@@ -0,0 +1,244 @@
+// src/core/feature-alloc/promise_futex.c
+// OBINexus DIRAM Compact Promise
+// Settling claims the state word, closes the continuation list, runs it,
+// and only then publishes the final state. Waiters set a bit before they
+// sleep, so the settler issues FUTEX_WAKE only when someone is blocked.
+#include "diram/core/feature-alloc/promise_futex.h"
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#define FPROMISE_STATE_MASK   0x3u
+#define FPROMISE_SETTLING     0x4u
+#define FPROMISE_WAITERS      0x80000000u
+#define FPROMISE_CLOSED       ((void*)1)
+
+typedef struct diram_fpromise_cont {
+    diram_fpromise_fn fn;
+    void* context;
+    struct diram_fpromise_cont* next;
+} diram_fpromise_cont_t;
+
+// Promises and continuations share one cell size and one freelist
+typedef union diram_fpromise_cell {
+    union diram_fpromise_cell* next_free;
+    diram_fpromise_t promise;
+    diram_fpromise_cont_t cont;
+} diram_fpromise_cell_t;
+
+_Static_assert(sizeof(diram_fpromise_t) == 24, "compact promise grew");
+
+static __thread struct {
+    diram_fpromise_cell_t* head;
+    size_t count;
+    int registered;
+} tls_cells;
+
+static pthread_key_t g_cells_key;
+static pthread_once_t g_cells_once = PTHREAD_ONCE_INIT;
+
+// Key destructors run on the exiting thread, so its list is still reachable
+static void cells_release(void* arg) {
+    (void)arg;
+    diram_fpromise_cell_t* cell = tls_cells.head;
+    tls_cells.head = NULL;
+    tls_cells.count = 0;
+    while (cell) {
+        diram_fpromise_cell_t* next = cell->next_free;
+        free(cell);
+        cell = next;
+    }
+}
+
+static void cells_key_init(void) {
+    pthread_key_create(&g_cells_key, cells_release);
+}
+
+static diram_fpromise_cell_t* cell_alloc(void) {
+    diram_fpromise_cell_t* cell = tls_cells.head;
+    if (cell) {
+        tls_cells.head = cell->next_free;
+        tls_cells.count--;
+        return cell;
+    }
+    return malloc(sizeof(diram_fpromise_cell_t));
+}
+
+// Cells go to the releasing thread's list, whoever allocated them
+static void cell_free(diram_fpromise_cell_t* cell) {
+    if (tls_cells.count >= DIRAM_FPROMISE_FREELIST_MAX) {
+        free(cell);
+        return;
+    }
+    if (!tls_cells.registered) {
+        pthread_once(&g_cells_once, cells_key_init);
+        pthread_setspecific(g_cells_key, &tls_cells);
+        tls_cells.registered = 1;
+    }
+    cell->next_free = tls_cells.head;
+    tls_cells.head = cell;
+    tls_cells.count++;
+}
+
+static long futex(uint32_t* addr, int op, uint32_t val, const struct timespec* timeout) {
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+diram_fpromise_t* diram_fpromise_create(void) {
+    diram_fpromise_cell_t* cell = cell_alloc();
+    if (!cell) return NULL;
+
+    diram_fpromise_t* promise = &cell->promise;
+    promise->state = DIRAM_FPROMISE_PENDING;
+    promise->reason = 0;
+    promise->value = NULL;
+    promise->continuations = NULL;
+    return promise;
+}
+
+void diram_fpromise_release(diram_fpromise_t* promise) {
+    if (!promise) return;
+    cell_free((diram_fpromise_cell_t*)promise);
+}
+
+int diram_fpromise_reserve(size_t count) {
+    while (tls_cells.count < count && tls_cells.count < DIRAM_FPROMISE_FREELIST_MAX) {
+        diram_fpromise_cell_t* cell = malloc(sizeof(diram_fpromise_cell_t));
+        if (!cell) return -1;
+        cell_free(cell);
+    }
+    return 0;
+}
+
+// ============================================================================
+// Settlement
+// ============================================================================
+
+static int fpromise_settle(diram_fpromise_t* promise, uint32_t final,
+                           void* value, uint32_t reason) {
+    if (!promise) return -1;
+
+    uint32_t old = __atomic_fetch_or(&promise->state, FPROMISE_SETTLING, __ATOMIC_ACQ_REL);
+    if (old & (FPROMISE_SETTLING | FPROMISE_STATE_MASK)) return -1;
+
+    promise->value = value;
+    promise->reason = reason;
+
+    // Late then() calls see the closed list and run inline
+    diram_fpromise_cont_t* list = __atomic_exchange_n(
+        (diram_fpromise_cont_t**)&promise->continuations,
+        (diram_fpromise_cont_t*)FPROMISE_CLOSED, __ATOMIC_ACQ_REL);
+
+    // Pushed LIFO; run in attachment order
+    diram_fpromise_cont_t* ordered = NULL;
+    while (list) {
+        diram_fpromise_cont_t* next = list->next;
+        list->next = ordered;
+        ordered = list;
+        list = next;
+    }
+    while (ordered) {
+        diram_fpromise_cont_t* next = ordered->next;
+        ordered->fn(promise, ordered->context);
+        cell_free((diram_fpromise_cell_t*)ordered);
+        ordered = next;
+    }
+
+    // Awaiters return only after every continuation has run
+    old = __atomic_exchange_n(&promise->state, final, __ATOMIC_RELEASE);
+    if (old & FPROMISE_WAITERS) {
+        futex(&promise->state, FUTEX_WAKE_PRIVATE, INT_MAX, NULL);
+    }
+    return 0;
+}
+
+int diram_fpromise_resolve(diram_fpromise_t* promise, void* value) {
+    return fpromise_settle(promise, DIRAM_FPROMISE_RESOLVED, value, 0);
+}
+
+int diram_fpromise_reject(diram_fpromise_t* promise, uint32_t reason, const char* msg) {
+    return fpromise_settle(promise, DIRAM_FPROMISE_REJECTED, (void*)msg, reason);
+}
+
+diram_fpromise_state_t diram_fpromise_state(const diram_fpromise_t* promise) {
+    if (!promise) return DIRAM_FPROMISE_PENDING;
+    uint32_t state = __atomic_load_n(&promise->state, __ATOMIC_ACQUIRE);
+    return (diram_fpromise_state_t)(state & FPROMISE_STATE_MASK);
+}
+
+static inline int settled_result(uint32_t state) {
+    return (state & FPROMISE_STATE_MASK) == DIRAM_FPROMISE_RESOLVED ? 0 : -1;
+}
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int diram_fpromise_await(diram_fpromise_t* promise, uint64_t timeout_ms) {
+    if (!promise) return -1;
+
+    uint32_t state = __atomic_load_n(&promise->state, __ATOMIC_ACQUIRE);
+    if (state & FPROMISE_STATE_MASK) return settled_result(state);
+
+    uint64_t deadline = monotonic_ns() + timeout_ms * 1000000ULL;
+    for (;;) {
+        state = __atomic_load_n(&promise->state, __ATOMIC_ACQUIRE);
+        if (state & FPROMISE_STATE_MASK) return settled_result(state);
+
+        if (!(state & FPROMISE_WAITERS)) {
+            if (!__atomic_compare_exchange_n(&promise->state, &state, state | FPROMISE_WAITERS,
+                                             0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                continue;
+            }
+            state |= FPROMISE_WAITERS;
+        }
+
+        uint64_t now = monotonic_ns();
+        if (now >= deadline) return DIRAM_ERR_TIMEOUT;
+        uint64_t remaining = deadline - now;
+        struct timespec ts = {
+            .tv_sec = (time_t)(remaining / 1000000000ULL),
+            .tv_nsec = (long)(remaining % 1000000000ULL),
+        };
+        // EAGAIN means the word already moved on; either way re-check it
+        futex(&promise->state, FUTEX_WAIT_PRIVATE, state, &ts);
+    }
+}
+
+int diram_fpromise_then(diram_fpromise_t* promise, diram_fpromise_fn fn, void* context) {
+    if (!promise || !fn) return -1;
+
+    diram_fpromise_cont_t** slot = (diram_fpromise_cont_t**)&promise->continuations;
+    diram_fpromise_cont_t* head = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+    if (head == FPROMISE_CLOSED) {
+        fn(promise, context);
+        return 0;
+    }
+
+    diram_fpromise_cell_t* cell = cell_alloc();
+    if (!cell) return -1;
+    diram_fpromise_cont_t* node = &cell->cont;
+    node->fn = fn;
+    node->context = context;
+
+    do {
+        if (head == FPROMISE_CLOSED) {
+            cell_free((diram_fpromise_cell_t*)node);
+            fn(promise, context);
+            return 0;
+        }
+        node->next = head;
+    } while (!__atomic_compare_exchange_n(slot, &head, node, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+    return 0;
+}
@@ -0,0 +1,375 @@
+// src/core/feature-alloc/receipt_queue.c
+// OBINexus DIRAM Deferred Receipt Queue
+// Each allocating thread owns an SPSC queue of receipt inputs. Entries are
+// claimed by ticket CAS, so the worker, a flush, or the owner's free path may
+// hash any pending entry; only the worker advances the queue tail.
+#include "diram/core/feature-alloc/receipt_queue.h"
+#include "diram/core/feature-alloc/trace_log.h"
+#include "diram/core/crypto/sha256.h"
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#define RECEIPT_QUEUE_MASK   (DIRAM_RECEIPT_QUEUE_ENTRIES - 1)
+#define RECEIPT_TICKET_BUSY  (1ULL << 63)
+
+_Static_assert((DIRAM_RECEIPT_QUEUE_ENTRIES & RECEIPT_QUEUE_MASK) == 0,
+               "receipt queue size must be a power of two");
+_Static_assert(sizeof(diram_receipt_input_t) == 88, "receipt input layout is hashed as-is");
+
+// ticket: 0 = settled, T = pending, T|BUSY = being hashed by its claimer
+typedef struct {
+    _Alignas(64) atomic_uint_fast64_t ticket;
+    diram_allocation_t* alloc;
+    uint32_t flags;
+    diram_receipt_input_t input;
+} diram_receipt_entry_t;
+
+typedef struct diram_receipt_queue {
+    _Alignas(64) atomic_uint_fast64_t head;    // written by the owner thread
+    _Alignas(64) atomic_uint_fast64_t tail;    // written by the worker
+    _Alignas(64) uint64_t deferred;
+    uint64_t queue_full;
+    atomic_int orphaned;
+    struct diram_receipt_queue* next;
+    diram_receipt_entry_t entries[DIRAM_RECEIPT_QUEUE_ENTRIES];
+} diram_receipt_queue_t;
+
+static struct {
+    atomic_int mode;
+    atomic_int running;
+    pthread_t worker;
+    pthread_mutex_t lock;           // queue registration and mode changes only
+    _Atomic(diram_receipt_queue_t*) queues;
+    atomic_uint_fast64_t batches;
+    atomic_uint_fast64_t settled;
+} g_receipts = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static pthread_key_t g_queue_key;
+static pthread_once_t g_queue_once = PTHREAD_ONCE_INIT;
+static __thread diram_receipt_queue_t* tls_queue = NULL;
+
+static void queue_release(void* arg) {
+    diram_receipt_queue_t* queue = (diram_receipt_queue_t*)arg;
+    atomic_store_explicit(&queue->orphaned, 1, memory_order_release);
+}
+
+static void queue_key_init(void) {
+    pthread_key_create(&g_queue_key, queue_release);
+}
+
+// Queues are never freed; one left by an exited thread is adopted
+static diram_receipt_queue_t* queue_acquire(void) {
+    if (tls_queue) return tls_queue;
+
+    pthread_once(&g_queue_once, queue_key_init);
+
+    diram_receipt_queue_t* queue = NULL;
+    pthread_mutex_lock(&g_receipts.lock);
+
+    for (diram_receipt_queue_t* q = atomic_load(&g_receipts.queues); q && !queue; q = q->next) {
+        int expected = 1;
+        if (atomic_compare_exchange_strong(&q->orphaned, &expected, 0)) {
+            queue = q;
+        }
+    }
+
+    if (!queue) {
+        void* mem = NULL;
+        if (posix_memalign(&mem, 64, sizeof(diram_receipt_queue_t)) == 0) {
+            queue = (diram_receipt_queue_t*)mem;
+            memset(queue, 0, sizeof(*queue));
+            queue->next = atomic_load(&g_receipts.queues);
+            atomic_store_explicit(&g_receipts.queues, queue, memory_order_release);
+        }
+    }
+
+    pthread_mutex_unlock(&g_receipts.lock);
+
+    if (queue) {
+        tls_queue = queue;
+        pthread_setspecific(g_queue_key, queue);
+    }
+    return queue;
+}
+
+static void receipt_input_init(diram_receipt_input_t* input,
+                               const diram_allocation_t* alloc,
+                               const char* tag) {
+    memset(input, 0, sizeof(*input));
+    input->addr = alloc->base_addr;
+    input->size = alloc->size;
+    input->timestamp = alloc->timestamp;
+    strncpy(input->tag, tag ? tag : "untagged", DIRAM_RECEIPT_TAG_LEN - 1);
+}
+
+static void receipt_publish(diram_allocation_t* alloc, const char* hex,
+                            const char* tag, uint32_t flags) {
+    memcpy(alloc->sha256_receipt, hex, DIRAM_SHA256_HEX_LEN);
+    if (flags & DIRAM_RECEIPT_FLAG_TRACE) {
+        diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, alloc->timestamp,
+                           alloc->binding_pid, alloc->base_addr, alloc->size,
+                           hex, tag);
+    }
+}
+
+// Publish one claimed entry's receipt, then hand the allocation back
+static void receipt_finish(diram_receipt_entry_t* entry,
+                           const uint8_t digest[DIRAM_SHA256_DIGEST_LEN]) {
+    diram_allocation_t* alloc = entry->alloc;
+    char hex[DIRAM_SHA256_HEX_LEN];
+
+    diram_sha256_to_hex(digest, hex);
+    receipt_publish(alloc, hex, entry->input.tag, entry->flags);
+
+    // The owner may free the allocation as soon as its ticket clears
+    __atomic_store_n(&alloc->receipt_ticket, 0, __ATOMIC_RELEASE);
+    atomic_store_explicit(&entry->ticket, 0, memory_order_release);
+}
+
+// Hash a batch of entries this thread holds BUSY
+static void receipt_complete(diram_receipt_entry_t** claimed, size_t count) {
+    const void* data[DIRAM_RECEIPT_BATCH];
+    size_t lens[DIRAM_RECEIPT_BATCH];
+    uint8_t digests[DIRAM_RECEIPT_BATCH][DIRAM_SHA256_DIGEST_LEN];
+
+    for (size_t i = 0; i < count; i++) {
+        data[i] = &claimed[i]->input;
+        lens[i] = sizeof(diram_receipt_input_t);
+    }
+    diram_sha256_batch(data, lens, count, digests);
+
+    for (size_t i = 0; i < count; i++) {
+        receipt_finish(claimed[i], digests[i]);
+    }
+    atomic_fetch_add_explicit(&g_receipts.batches, 1, memory_order_relaxed);
+}
+
+static inline int receipt_claim(diram_receipt_entry_t* entry, uint64_t ticket) {
+    uint_fast64_t expected = ticket;
+    return atomic_compare_exchange_strong_explicit(&entry->ticket, &expected,
+                                                   ticket | RECEIPT_TICKET_BUSY,
+                                                   memory_order_acquire,
+                                                   memory_order_relaxed);
+}
+
+// Claim and hash every pending entry in [tail, limit); returns the count
+static uint64_t queue_process(diram_receipt_queue_t* queue, uint64_t limit) {
+    diram_receipt_entry_t* claimed[DIRAM_RECEIPT_BATCH];
+    size_t count = 0;
+    uint64_t total = 0;
+
+    for (uint64_t pos = atomic_load_explicit(&queue->tail, memory_order_acquire);
+         pos < limit; pos++) {
+        diram_receipt_entry_t* entry = &queue->entries[pos & RECEIPT_QUEUE_MASK];
+        uint64_t ticket = atomic_load_explicit(&entry->ticket, memory_order_acquire);
+        if (ticket == 0 || (ticket & RECEIPT_TICKET_BUSY)) continue;
+        if (!receipt_claim(entry, ticket)) continue;
+
+        claimed[count++] = entry;
+        if (count == DIRAM_RECEIPT_BATCH) {
+            receipt_complete(claimed, count);
+            total += count;
+            count = 0;
+        }
+    }
+
+    if (count > 0) {
+        receipt_complete(claimed, count);
+        total += count;
+    }
+    return total;
+}
+
+// Worker only: release settled slots back to the owner
+static void queue_retire(diram_receipt_queue_t* queue) {
+    uint64_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    uint64_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+
+    while (tail < head &&
+           atomic_load_explicit(&queue->entries[tail & RECEIPT_QUEUE_MASK].ticket,
+                                memory_order_acquire) == 0) {
+        tail++;
+    }
+    atomic_store_explicit(&queue->tail, tail, memory_order_release);
+}
+
+static void* receipt_worker_thread(void* arg) {
+    (void)arg;
+    struct timespec idle = {0, DIRAM_RECEIPT_WORKER_INTERVAL_US * 1000L};
+
+    for (;;) {
+        int running = atomic_load_explicit(&g_receipts.running, memory_order_acquire);
+        uint64_t hashed = 0;
+
+        for (diram_receipt_queue_t* q = atomic_load_explicit(&g_receipts.queues,
+                                                             memory_order_acquire);
+             q; q = q->next) {
+            hashed += queue_process(q, atomic_load_explicit(&q->head, memory_order_acquire));
+            queue_retire(q);
+        }
+
+        // Stop only after a pass that found nothing left to hash
+        if (!running && hashed == 0) break;
+        if (hashed == 0) nanosleep(&idle, NULL);
+    }
+    return NULL;
+}
+
+int diram_receipt_parse_mode(const char* value, diram_receipt_mode_t* mode) {
+    if (!value || !mode) return -1;
+
+    if (strcasecmp(value, "deferred") == 0 || strcasecmp(value, "batched") == 0) {
+        *mode = DIRAM_RECEIPT_MODE_DEFERRED;
+    } else if (strcasecmp(value, "sync") == 0 || strcasecmp(value, "inline") == 0) {
+        *mode = DIRAM_RECEIPT_MODE_SYNC;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+int diram_receipt_set_mode(diram_receipt_mode_t mode) {
+    pthread_mutex_lock(&g_receipts.lock);
+
+    int current = atomic_load(&g_receipts.mode);
+    if ((int)mode == current) {
+        pthread_mutex_unlock(&g_receipts.lock);
+        return 0;
+    }
+
+    if (mode == DIRAM_RECEIPT_MODE_DEFERRED) {
+        atomic_store_explicit(&g_receipts.running, 1, memory_order_release);
+        if (pthread_create(&g_receipts.worker, NULL, receipt_worker_thread, NULL) != 0) {
+            atomic_store(&g_receipts.running, 0);
+            pthread_mutex_unlock(&g_receipts.lock);
+            return -1;
+        }
+        atomic_store_explicit(&g_receipts.mode, DIRAM_RECEIPT_MODE_DEFERRED,
+                              memory_order_release);
+    } else {
+        // New submissions go inline; the worker drains what is queued and exits
+        atomic_store_explicit(&g_receipts.mode, DIRAM_RECEIPT_MODE_SYNC,
+                              memory_order_release);
+        atomic_store_explicit(&g_receipts.running, 0, memory_order_release);
+        pthread_join(g_receipts.worker, NULL);
+        for (diram_receipt_queue_t* q = atomic_load(&g_receipts.queues); q; q = q->next) {
+            queue_retire(q);
+        }
+    }
+
+    pthread_mutex_unlock(&g_receipts.lock);
+    return 0;
+}
+
+diram_receipt_mode_t diram_receipt_get_mode(void) {
+    return (diram_receipt_mode_t)atomic_load_explicit(&g_receipts.mode, memory_order_acquire);
+}
+
+static void receipt_compute_inline(diram_allocation_t* alloc, const char* tag, uint32_t flags) {
+    diram_receipt_input_t input;
+    char hex[DIRAM_SHA256_HEX_LEN];
+
+    receipt_input_init(&input, alloc, tag);
+    diram_sha256_hex(&input, sizeof(input), hex);
+    receipt_publish(alloc, hex, input.tag, flags);
+}
+
+void diram_receipt_submit(diram_allocation_t* alloc, const char* tag, uint32_t flags) {
+    if (!alloc) return;
+
+    diram_receipt_queue_t* queue = NULL;
+    if (diram_receipt_get_mode() == DIRAM_RECEIPT_MODE_DEFERRED) {
+        queue = queue_acquire();
+    }
+
+    if (!queue) {
+        receipt_compute_inline(alloc, tag, flags);
+        return;
+    }
+
+    uint64_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&queue->tail, memory_order_acquire) >=
+        DIRAM_RECEIPT_QUEUE_ENTRIES) {
+        // Never stall the allocator on the worker; hash this one here
+        __atomic_store_n(&queue->queue_full, queue->queue_full + 1, __ATOMIC_RELAXED);
+        receipt_compute_inline(alloc, tag, flags);
+        return;
+    }
+
+    diram_receipt_entry_t* entry = &queue->entries[head & RECEIPT_QUEUE_MASK];
+    uint64_t ticket = head + 1;
+
+    entry->alloc = alloc;
+    entry->flags = flags;
+    receipt_input_init(&entry->input, alloc, tag);
+    alloc->sha256_receipt[0] = '\0';
+    alloc->receipt_slot = entry;
+    __atomic_store_n(&alloc->receipt_ticket, ticket, __ATOMIC_RELAXED);
+
+    atomic_store_explicit(&entry->ticket, ticket, memory_order_release);
+    __atomic_store_n(&queue->deferred, queue->deferred + 1, __ATOMIC_RELAXED);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+}
+
+void diram_receipt_settle(diram_allocation_t* alloc) {
+    if (!alloc) return;
+
+    uint64_t ticket = __atomic_load_n(&alloc->receipt_ticket, __ATOMIC_ACQUIRE);
+    if (ticket == 0) return;
+
+    diram_receipt_entry_t* entry = (diram_receipt_entry_t*)alloc->receipt_slot;
+    if (receipt_claim(entry, ticket)) {
+        uint8_t digest[DIRAM_SHA256_DIGEST_LEN];
+        diram_sha256(&entry->input, sizeof(diram_receipt_input_t), digest);
+        receipt_finish(entry, digest);
+        atomic_fetch_add_explicit(&g_receipts.settled, 1, memory_order_relaxed);
+        return;
+    }
+
+    // Someone else holds it; tickets are unique so this cannot be a reused slot
+    while (__atomic_load_n(&alloc->receipt_ticket, __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
+    }
+}
+
+void diram_receipt_flush(void) {
+    for (diram_receipt_queue_t* q = atomic_load_explicit(&g_receipts.queues,
+                                                         memory_order_acquire);
+         q; q = q->next) {
+        uint64_t target = atomic_load_explicit(&q->head, memory_order_acquire);
+
+        // Hash what nobody has claimed yet rather than waiting for the worker
+        queue_process(q, target);
+
+        for (uint64_t pos = atomic_load_explicit(&q->tail, memory_order_acquire);
+             pos < target; pos++) {
+            diram_receipt_entry_t* entry = &q->entries[pos & RECEIPT_QUEUE_MASK];
+            while (atomic_load_explicit(&entry->ticket, memory_order_acquire) &
+                   RECEIPT_TICKET_BUSY) {
+                sched_yield();
+            }
+        }
+    }
+}
+
+void diram_receipt_get_stats(diram_receipt_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    for (diram_receipt_queue_t* q = atomic_load_explicit(&g_receipts.queues,
+                                                         memory_order_acquire);
+         q; q = q->next) {
+        out->deferred += __atomic_load_n(&q->deferred, __ATOMIC_RELAXED);
+        out->queue_full += __atomic_load_n(&q->queue_full, __ATOMIC_RELAXED);
+        out->queues++;
+    }
+    out->batches = atomic_load_explicit(&g_receipts.batches, memory_order_relaxed);
+    out->settled = atomic_load_explicit(&g_receipts.settled, memory_order_relaxed);
+}
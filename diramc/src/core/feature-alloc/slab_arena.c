@@ -0,0 +1,327 @@
+// src/core/feature-alloc/slab_arena.c
+// OBINexus DIRAM Size-Class Slab Arena
+// Header and payload share one cache-line-aligned block; per-thread free lists
+// are refilled in bulk from mmap'd chunks so the traced path makes no heap calls.
+#include "diram/core/feature-alloc/slab_arena.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+
+#define SLAB_MAGIC          0xD1
+#define SLAB_CLASS_LARGE    0xFF
+#define SLAB_REFILL_BYTES   (64u * 1024u)   // blocks carved per refill, at least one
+
+// Owner-only counter update; readers aggregate with relaxed loads
+#define SLAB_STAT_ADD(field, v) \
+    __atomic_store_n(&(field), (field) + (uint64_t)(v), __ATOMIC_RELAXED)
+#define SLAB_STAT_LOAD(field) __atomic_load_n(&(field), __ATOMIC_RELAXED)
+
+// Block prefix, immediately before the caller header
+typedef struct {
+    uint32_t requested;     // payload bytes asked for
+    uint8_t size_class;
+    uint8_t magic;
+    uint16_t arena_id;
+} diram_slab_prefix_t;
+
+_Static_assert(sizeof(diram_slab_prefix_t) == DIRAM_SLAB_PREFIX_BYTES,
+               "slab prefix must stay 8 bytes");
+
+// Free blocks are linked through the caller header area
+typedef struct diram_slab_free {
+    struct diram_slab_free* next;
+} diram_slab_free_t;
+
+typedef struct {
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t large_allocs;
+    uint64_t remote_frees;
+    uint64_t chunk_bytes;
+    uint64_t requested_in;
+    uint64_t requested_out;
+    uint64_t reserved_in;
+    uint64_t reserved_out;
+} diram_slab_counters_t;
+
+typedef struct diram_slab_arena {
+    diram_slab_free_t* free_list[DIRAM_SLAB_CLASS_COUNT];
+    _Atomic(diram_slab_free_t*) remote_free[DIRAM_SLAB_CLASS_COUNT];
+    char* bump;
+    char* bump_end;
+    diram_slab_counters_t counters;
+    atomic_int orphaned;    // owning thread exited, arena may be adopted
+    uint16_t id;
+} diram_slab_arena_t;
+
+// Arena registry - arenas live for the process, blocks may outlive threads
+static diram_slab_arena_t* g_arenas[DIRAM_SLAB_MAX_ARENAS];
+static atomic_uint g_arena_count = 0;
+static pthread_mutex_t g_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t g_arena_key;
+static pthread_once_t g_arena_once = PTHREAD_ONCE_INIT;
+static __thread diram_slab_arena_t* tls_arena = NULL;
+
+static inline diram_slab_prefix_t* prefix_of(const void* header) {
+    return (diram_slab_prefix_t*)((char*)header - DIRAM_SLAB_PREFIX_BYTES);
+}
+
+static inline size_t class_payload(uint8_t size_class) {
+    return (size_t)64 << size_class;
+}
+
+static inline uint8_t size_to_class(size_t size) {
+    if (size <= 64) return 0;
+    return (uint8_t)(64 - __builtin_clzll((unsigned long long)(size - 1)) - 6);
+}
+
+static void arena_release(void* arg) {
+    diram_slab_arena_t* arena = (diram_slab_arena_t*)arg;
+    atomic_store_explicit(&arena->orphaned, 1, memory_order_release);
+}
+
+static void arena_key_init(void) {
+    pthread_key_create(&g_arena_key, arena_release);
+}
+
+// Bind the calling thread to an arena, adopting an orphan before creating one
+static diram_slab_arena_t* arena_acquire(void) {
+    if (tls_arena) return tls_arena;
+
+    pthread_once(&g_arena_once, arena_key_init);
+
+    diram_slab_arena_t* arena = NULL;
+    pthread_mutex_lock(&g_arena_lock);
+
+    unsigned count = atomic_load_explicit(&g_arena_count, memory_order_relaxed);
+    for (unsigned i = 0; i < count && !arena; i++) {
+        int expected = 1;
+        if (atomic_compare_exchange_strong(&g_arenas[i]->orphaned, &expected, 0)) {
+            arena = g_arenas[i];
+        }
+    }
+
+    if (!arena && count < DIRAM_SLAB_MAX_ARENAS) {
+        void* mem = NULL;
+        if (posix_memalign(&mem, DIRAM_SLAB_CACHE_LINE, sizeof(diram_slab_arena_t)) == 0) {
+            arena = (diram_slab_arena_t*)mem;
+            memset(arena, 0, sizeof(*arena));
+            arena->id = (uint16_t)count;
+            g_arenas[count] = arena;
+            atomic_store_explicit(&g_arena_count, count + 1, memory_order_release);
+        }
+    }
+
+    pthread_mutex_unlock(&g_arena_lock);
+
+    if (arena) {
+        tls_arena = arena;
+        pthread_setspecific(g_arena_key, arena);
+    }
+    return arena;
+}
+
+// Carve a batch of blocks for one size class, mapping a new chunk if needed
+static int arena_refill(diram_slab_arena_t* arena, uint8_t size_class) {
+    size_t block = DIRAM_SLAB_BLOCK_HEADER + class_payload(size_class);
+
+    if ((size_t)(arena->bump_end - arena->bump) < block) {
+        void* chunk = mmap(NULL, DIRAM_SLAB_CHUNK_BYTES, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (chunk == MAP_FAILED) return -1;
+
+        // The unused tail of the previous chunk is abandoned (counted as fragmentation)
+        arena->bump = (char*)chunk;
+        arena->bump_end = (char*)chunk + DIRAM_SLAB_CHUNK_BYTES;
+        SLAB_STAT_ADD(arena->counters.chunk_bytes, DIRAM_SLAB_CHUNK_BYTES);
+    }
+
+    size_t available = (size_t)(arena->bump_end - arena->bump) / block;
+    size_t batch = SLAB_REFILL_BYTES / block;
+    if (batch == 0) batch = 1;
+    if (batch > available) batch = available;
+
+    // Push in reverse so consecutive allocations walk ascending addresses
+    char* base = arena->bump;
+    for (size_t i = batch; i-- > 0; ) {
+        diram_slab_free_t* node = (diram_slab_free_t*)
+            (base + i * block + DIRAM_SLAB_PREFIX_BYTES);
+        node->next = arena->free_list[size_class];
+        arena->free_list[size_class] = node;
+    }
+    arena->bump += batch * block;
+
+    return 0;
+}
+
+// The prefix records a large block's exact size, so one past 4 GiB is refused
+// rather than freed and accounted under a truncated size
+static void* slab_alloc_large(diram_slab_arena_t* arena, size_t payload_size, void** payload) {
+    if (payload_size > UINT32_MAX) return NULL;
+
+    void* block = NULL;
+    if (posix_memalign(&block, DIRAM_SLAB_CACHE_LINE,
+                       DIRAM_SLAB_BLOCK_HEADER + payload_size) != 0) {
+        return NULL;
+    }
+
+    void* header = (char*)block + DIRAM_SLAB_PREFIX_BYTES;
+    diram_slab_prefix_t* prefix = prefix_of(header);
+    prefix->requested = (uint32_t)payload_size;
+    prefix->size_class = SLAB_CLASS_LARGE;
+    prefix->magic = SLAB_MAGIC;
+    prefix->arena_id = arena ? arena->id : 0;
+
+    if (arena) {
+        SLAB_STAT_ADD(arena->counters.allocs, 1);
+        SLAB_STAT_ADD(arena->counters.large_allocs, 1);
+        SLAB_STAT_ADD(arena->counters.requested_in, prefix->requested);
+        SLAB_STAT_ADD(arena->counters.reserved_in, DIRAM_SLAB_BLOCK_HEADER + payload_size);
+    }
+
+    *payload = (char*)block + DIRAM_SLAB_BLOCK_HEADER;
+    return header;
+}
+
+void* diram_slab_alloc(size_t payload_size, void** payload) {
+    if (!payload) return NULL;
+
+    diram_slab_arena_t* arena = arena_acquire();
+    if (!arena || payload_size > DIRAM_SLAB_MAX_PAYLOAD) {
+        return slab_alloc_large(arena, payload_size, payload);
+    }
+
+    uint8_t size_class = size_to_class(payload_size);
+    diram_slab_free_t* node = arena->free_list[size_class];
+
+    if (!node) {
+        // Blocks released by other threads come back before touching a chunk
+        node = atomic_exchange_explicit(&arena->remote_free[size_class], NULL,
+                                        memory_order_acquire);
+        if (!node) {
+            if (arena_refill(arena, size_class) != 0) return NULL;
+            node = arena->free_list[size_class];
+            SLAB_STAT_ADD(arena->counters.misses, 1);
+        } else {
+            SLAB_STAT_ADD(arena->counters.hits, 1);
+        }
+    } else {
+        SLAB_STAT_ADD(arena->counters.hits, 1);
+    }
+
+    arena->free_list[size_class] = node->next;
+
+    diram_slab_prefix_t* prefix = prefix_of(node);
+    prefix->requested = (uint32_t)payload_size;
+    prefix->size_class = size_class;
+    prefix->magic = SLAB_MAGIC;
+    prefix->arena_id = arena->id;
+
+    SLAB_STAT_ADD(arena->counters.allocs, 1);
+    SLAB_STAT_ADD(arena->counters.requested_in, payload_size);
+    SLAB_STAT_ADD(arena->counters.reserved_in,
+                  DIRAM_SLAB_BLOCK_HEADER + class_payload(size_class));
+
+    *payload = (char*)prefix + DIRAM_SLAB_BLOCK_HEADER;
+    return node;
+}
+
+void diram_slab_free(void* header) {
+    if (!header) return;
+
+    diram_slab_prefix_t* prefix = prefix_of(header);
+    if (prefix->magic != SLAB_MAGIC) return;
+
+    diram_slab_arena_t* arena = arena_acquire();
+    size_t reserved = diram_slab_block_size(header);
+
+    if (arena) {
+        SLAB_STAT_ADD(arena->counters.frees, 1);
+        SLAB_STAT_ADD(arena->counters.requested_out, prefix->requested);
+        SLAB_STAT_ADD(arena->counters.reserved_out, reserved);
+    }
+
+    if (prefix->size_class == SLAB_CLASS_LARGE) {
+        prefix->magic = 0;
+        free(prefix);
+        return;
+    }
+
+    uint8_t size_class = prefix->size_class;
+    diram_slab_free_t* node = (diram_slab_free_t*)header;
+    diram_slab_arena_t* owner = g_arenas[prefix->arena_id];
+
+    if (owner == arena) {
+        node->next = arena->free_list[size_class];
+        arena->free_list[size_class] = node;
+        return;
+    }
+
+    // Cross-thread release: lock-free push, the owner drains with one exchange
+    diram_slab_free_t* head = atomic_load_explicit(&owner->remote_free[size_class],
+                                                   memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&owner->remote_free[size_class],
+                                                    &head, node,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+    if (arena) {
+        SLAB_STAT_ADD(arena->counters.remote_frees, 1);
+    }
+}
+
+size_t diram_slab_block_size(const void* header) {
+    if (!header) return 0;
+    const diram_slab_prefix_t* prefix = prefix_of(header);
+    if (prefix->size_class == SLAB_CLASS_LARGE) {
+        return DIRAM_SLAB_BLOCK_HEADER + prefix->requested;
+    }
+    return DIRAM_SLAB_BLOCK_HEADER + class_payload(prefix->size_class);
+}
+
+void diram_slab_get_stats(diram_slab_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    uint64_t requested_in = 0, requested_out = 0;
+    uint64_t reserved_in = 0, reserved_out = 0;
+    unsigned count = atomic_load_explicit(&g_arena_count, memory_order_acquire);
+
+    for (unsigned i = 0; i < count; i++) {
+        diram_slab_counters_t* c = &g_arenas[i]->counters;
+        out->allocs += SLAB_STAT_LOAD(c->allocs);
+        out->frees += SLAB_STAT_LOAD(c->frees);
+        out->hits += SLAB_STAT_LOAD(c->hits);
+        out->misses += SLAB_STAT_LOAD(c->misses);
+        out->large_allocs += SLAB_STAT_LOAD(c->large_allocs);
+        out->remote_frees += SLAB_STAT_LOAD(c->remote_frees);
+        out->chunk_bytes += SLAB_STAT_LOAD(c->chunk_bytes);
+        requested_in += SLAB_STAT_LOAD(c->requested_in);
+        requested_out += SLAB_STAT_LOAD(c->requested_out);
+        reserved_in += SLAB_STAT_LOAD(c->reserved_in);
+        reserved_out += SLAB_STAT_LOAD(c->reserved_out);
+    }
+
+    // Frees are charged to the releasing thread, so fold before subtracting
+    out->live_blocks = out->allocs > out->frees ? out->allocs - out->frees : 0;
+    out->live_requested = requested_in > requested_out ? requested_in - requested_out : 0;
+    out->live_reserved = reserved_in > reserved_out ? reserved_in - reserved_out : 0;
+    out->arena_count = count;
+}
+
+double diram_slab_hit_rate(const diram_slab_stats_t* stats) {
+    if (!stats) return 0.0;
+    uint64_t total = stats->hits + stats->misses;
+    return total ? (double)stats->hits / (double)total : 0.0;
+}
+
+// Share of reserved block bytes not holding requested payload
+double diram_slab_fragmentation(const diram_slab_stats_t* stats) {
+    if (!stats || stats->live_reserved == 0) return 0.0;
+    return 1.0 - (double)stats->live_requested / (double)stats->live_reserved;
+}
@@ -0,0 +1,187 @@
+// src/core/feature-alloc/space_account.c
+// OBINexus DIRAM Memory Space Accounting
+// reserved <= limit is the only invariant that needs a global atomic, and
+// it is touched once per chunk rather than once per allocation. Threads on
+// the same CPU share a slot; threads on different CPUs never contend.
+#include "diram/core/feature-alloc/space_account.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <stdatomic.h>
+
+typedef struct {
+    _Alignas(64) atomic_size_t avail;     // spare bytes already reserved
+} diram_account_slot_t;
+
+struct diram_space_account {
+    size_t limit;
+    size_t chunk;
+    uint32_t slot_mask;
+    _Alignas(64) atomic_size_t reserved;
+    _Alignas(64) atomic_uint_fast64_t refills;
+    atomic_uint_fast64_t reclaims;
+    atomic_uint_fast64_t failures;
+    diram_account_slot_t slots[DIRAM_ACCOUNT_MAX_SLOTS];
+};
+
+static __thread int tls_fallback_slot = -1;
+static atomic_int g_fallback_next = 0;
+
+static inline uint32_t current_slot(const diram_space_account_t* account) {
+    int cpu = sched_getcpu();
+    if (cpu < 0) {
+        // No CPU id available: spread threads round-robin instead
+        if (tls_fallback_slot < 0) {
+            tls_fallback_slot = atomic_fetch_add(&g_fallback_next, 1);
+        }
+        cpu = tls_fallback_slot;
+    }
+    return (uint32_t)cpu & account->slot_mask;
+}
+
+diram_space_account_t* diram_account_create(size_t limit) {
+    void* mem = NULL;
+    if (posix_memalign(&mem, 64, sizeof(diram_space_account_t)) != 0) return NULL;
+
+    diram_space_account_t* account = (diram_space_account_t*)mem;
+    memset(account, 0, sizeof(*account));
+    account->limit = limit;
+
+    long cpus = sysconf(_SC_NPROCESSORS_CONF);
+    uint32_t slots = 1;
+    while (slots < (uint32_t)(cpus > 0 ? cpus : 1) && slots < DIRAM_ACCOUNT_MAX_SLOTS) {
+        slots <<= 1;
+    }
+    account->slot_mask = slots - 1;
+
+    // Spare held per slot stays a small fraction of the limit
+    size_t chunk = limit / (8 * (size_t)slots);
+    if (chunk < DIRAM_ACCOUNT_MIN_CHUNK) chunk = DIRAM_ACCOUNT_MIN_CHUNK;
+    if (chunk > DIRAM_ACCOUNT_MAX_CHUNK) chunk = DIRAM_ACCOUNT_MAX_CHUNK;
+    account->chunk = chunk;
+
+    return account;
+}
+
+void diram_account_destroy(diram_space_account_t* account) {
+    free(account);
+}
+
+static int reserve_global(diram_space_account_t* account, size_t bytes) {
+    size_t reserved = atomic_load_explicit(&account->reserved, memory_order_relaxed);
+    do {
+        if (bytes > account->limit || reserved > account->limit - bytes) return -1;
+    } while (!atomic_compare_exchange_weak_explicit(&account->reserved, &reserved,
+                                                    reserved + bytes,
+                                                    memory_order_relaxed,
+                                                    memory_order_relaxed));
+    return 0;
+}
+
+// Near the limit, spare parked on other CPUs goes back to the global pool
+static void reclaim_spare(diram_space_account_t* account) {
+    for (uint32_t i = 0; i <= account->slot_mask; i++) {
+        size_t spare = atomic_exchange_explicit(&account->slots[i].avail, 0,
+                                                memory_order_relaxed);
+        if (spare) {
+            atomic_fetch_sub_explicit(&account->reserved, spare, memory_order_relaxed);
+        }
+    }
+    atomic_fetch_add_explicit(&account->reclaims, 1, memory_order_relaxed);
+}
+
+int diram_account_charge(diram_space_account_t* account, size_t bytes) {
+    if (!account) return 0;
+    if (bytes == 0) return 0;
+
+    // Large charges bypass the slots entirely
+    if (bytes > account->chunk) {
+        if (reserve_global(account, bytes) == 0) return 0;
+        reclaim_spare(account);
+        if (reserve_global(account, bytes) == 0) return 0;
+        atomic_fetch_add_explicit(&account->failures, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    diram_account_slot_t* slot = &account->slots[current_slot(account)];
+    size_t avail = atomic_load_explicit(&slot->avail, memory_order_relaxed);
+    while (avail >= bytes) {
+        if (atomic_compare_exchange_weak_explicit(&slot->avail, &avail, avail - bytes,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            return 0;
+        }
+    }
+
+    // Take this charge plus a chunk of spare in one global step
+    if (reserve_global(account, bytes + account->chunk) == 0) {
+        atomic_fetch_add_explicit(&slot->avail, account->chunk, memory_order_relaxed);
+        atomic_fetch_add_explicit(&account->refills, 1, memory_order_relaxed);
+        return 0;
+    }
+    if (reserve_global(account, bytes) == 0) return 0;
+
+    reclaim_spare(account);
+    if (reserve_global(account, bytes) == 0) return 0;
+
+    atomic_fetch_add_explicit(&account->failures, 1, memory_order_relaxed);
+    return -1;
+}
+
+void diram_account_release(diram_space_account_t* account, size_t bytes) {
+    if (!account || bytes == 0) return;
+
+    if (bytes > account->chunk) {
+        atomic_fetch_sub_explicit(&account->reserved, bytes, memory_order_relaxed);
+        return;
+    }
+
+    diram_account_slot_t* slot = &account->slots[current_slot(account)];
+    size_t avail = atomic_fetch_add_explicit(&slot->avail, bytes, memory_order_relaxed) + bytes;
+
+    // Keep at most two chunks of spare per slot; hand the rest back
+    while (avail > 2 * account->chunk) {
+        if (atomic_compare_exchange_weak_explicit(&slot->avail, &avail, account->chunk,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+            atomic_fetch_sub_explicit(&account->reserved, avail - account->chunk,
+                                      memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+size_t diram_account_used(const diram_space_account_t* account) {
+    if (!account) return 0;
+
+    diram_space_account_t* a = (diram_space_account_t*)account;
+    size_t spare = 0;
+    for (uint32_t i = 0; i <= a->slot_mask; i++) {
+        spare += atomic_load_explicit(&a->slots[i].avail, memory_order_relaxed);
+    }
+    size_t reserved = atomic_load_explicit(&a->reserved, memory_order_relaxed);
+    return reserved > spare ? reserved - spare : 0;
+}
+
+// Each slot may hold up to two chunks of spare the fold can misattribute
+size_t diram_account_error_bound(const diram_space_account_t* account) {
+    if (!account) return 0;
+    return (size_t)(account->slot_mask + 1) * 2 * account->chunk;
+}
+
+void diram_account_get_stats(const diram_space_account_t* account, diram_account_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!account) return;
+
+    diram_space_account_t* a = (diram_space_account_t*)account;
+    out->limit = a->limit;
+    out->reserved = atomic_load_explicit(&a->reserved, memory_order_relaxed);
+    out->used = diram_account_used(account);
+    out->chunk = a->chunk;
+    out->refills = atomic_load_explicit(&a->refills, memory_order_relaxed);
+    out->reclaims = atomic_load_explicit(&a->reclaims, memory_order_relaxed);
+    out->failures = atomic_load_explicit(&a->failures, memory_order_relaxed);
+    out->slots = a->slot_mask + 1;
+}
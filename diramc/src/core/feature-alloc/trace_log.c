@@ -0,0 +1,501 @@
+// src/core/feature-alloc/trace_log.c
+// OBINexus DIRAM Binary Trace Log
+// Producers copy fixed-size records into a per-thread SPSC ring; a single
+// background writer gathers every ring into one writev per batch.
+#include "diram/core/feature-alloc/trace_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/uio.h>
+#include <time.h>
+
+#define TRACE_RING_MASK    (DIRAM_TRACE_RING_RECORDS - 1)
+#define TRACE_MAX_IOV      64
+
+_Static_assert(sizeof(diram_trace_record_t) == 128, "trace record must stay 128 bytes");
+_Static_assert((DIRAM_TRACE_RING_RECORDS & TRACE_RING_MASK) == 0,
+               "trace ring size must be a power of two");
+
+typedef struct diram_trace_ring {
+    _Alignas(64) atomic_uint_fast64_t head;    // written by the producer
+    _Alignas(64) atomic_uint_fast64_t tail;    // written by the writer
+    _Alignas(64) uint64_t cached_tail;         // producer-private view of tail
+    uint64_t full_waits;
+    uint64_t records;
+    uint64_t refused;                          // arrived after the log closed
+    atomic_int active;                         // producer is between check and publish
+    atomic_int orphaned;
+    struct diram_trace_ring* next;
+    diram_trace_record_t records_buf[DIRAM_TRACE_RING_RECORDS];
+} diram_trace_ring_t;
+
+static struct {
+    int fd;
+    atomic_int running;
+    pthread_t writer;
+    pthread_mutex_t lock;           // ring registration and open/close only
+    _Atomic(diram_trace_ring_t*) rings;
+    uint64_t offset;                // end of the last complete batch
+    uint64_t written;
+    uint64_t batches;
+    uint64_t write_errors;
+    uint64_t dropped_bytes;
+} g_trace = {
+    .fd = -1,
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+static pthread_key_t g_ring_key;
+static pthread_once_t g_ring_once = PTHREAD_ONCE_INIT;
+static __thread diram_trace_ring_t* tls_ring = NULL;
+
+static void ring_release(void* arg) {
+    diram_trace_ring_t* ring = (diram_trace_ring_t*)arg;
+    atomic_store_explicit(&ring->orphaned, 1, memory_order_release);
+}
+
+static void ring_key_init(void) {
+    pthread_key_create(&g_ring_key, ring_release);
+}
+
+// Rings are never freed; a ring left by an exited thread is adopted
+static diram_trace_ring_t* ring_acquire(void) {
+    if (tls_ring) return tls_ring;
+
+    pthread_once(&g_ring_once, ring_key_init);
+
+    diram_trace_ring_t* ring = NULL;
+    pthread_mutex_lock(&g_trace.lock);
+
+    for (diram_trace_ring_t* r = atomic_load(&g_trace.rings); r && !ring; r = r->next) {
+        int expected = 1;
+        if (atomic_compare_exchange_strong(&r->orphaned, &expected, 0)) {
+            ring = r;
+        }
+    }
+
+    if (!ring) {
+        void* mem = NULL;
+        if (posix_memalign(&mem, 64, sizeof(diram_trace_ring_t)) == 0) {
+            ring = (diram_trace_ring_t*)mem;
+            memset(ring, 0, sizeof(*ring));
+            ring->next = atomic_load(&g_trace.rings);
+            atomic_store_explicit(&g_trace.rings, ring, memory_order_release);
+        }
+    }
+
+    pthread_mutex_unlock(&g_trace.lock);
+
+    if (ring) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        tls_ring = ring;
+        pthread_setspecific(g_ring_key, ring);
+    }
+    return ring;
+}
+
+static int hex_nibble(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static void receipt_from_hex(const char* hex, uint8_t out[32]) {
+    memset(out, 0, 32);
+    if (!hex) return;
+    for (int i = 0; i < 32; i++) {
+        int hi = hex_nibble(hex[i * 2]);
+        if (hi < 0) return;
+        int lo = hex_nibble(hex[i * 2 + 1]);
+        if (lo < 0) return;
+        out[i] = (uint8_t)((hi << 4) | lo);
+    }
+}
+
+int diram_trace_record(diram_trace_event_t event,
+                       uint64_t timestamp,
+                       int32_t pid,
+                       const void* addr,
+                       size_t size,
+                       const char* receipt_hex,
+                       const char* tag) {
+    diram_trace_ring_t* ring = tls_ring;
+    if (!atomic_load_explicit(&g_trace.running, memory_order_relaxed)) {
+        // Threads that never traced have no ring and nothing to lose
+        if (ring) ring->refused++;
+        return -1;
+    }
+
+    if (!ring) ring = ring_acquire();
+    if (!ring) return -1;
+
+    // Announce the record before the final check; the writer waits for it
+    // after close, so a record is either written or refused, never stranded
+    atomic_store(&ring->active, 1);
+    if (!atomic_load(&g_trace.running)) {
+        atomic_store_explicit(&ring->active, 0, memory_order_release);
+        ring->refused++;
+        return -1;
+    }
+
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - ring->cached_tail >= DIRAM_TRACE_RING_RECORDS) {
+        ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        while (head - ring->cached_tail >= DIRAM_TRACE_RING_RECORDS) {
+            // Audit records are never dropped; give the writer the CPU
+            ring->full_waits++;
+            if (!atomic_load_explicit(&g_trace.running, memory_order_relaxed)) {
+                atomic_store_explicit(&ring->active, 0, memory_order_release);
+                ring->refused++;
+                return -1;
+            }
+            sched_yield();
+            ring->cached_tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        }
+    }
+
+    diram_trace_record_t* rec = &ring->records_buf[head & TRACE_RING_MASK];
+    rec->timestamp = timestamp;
+    rec->addr = (uint64_t)(uintptr_t)addr;
+    rec->size = size;
+    rec->pid = pid;
+    rec->event = (uint16_t)event;
+    rec->flags = 0;
+    receipt_from_hex(receipt_hex, rec->receipt);
+
+    const char* t = tag ? tag : "untagged";
+    size_t tag_len = strnlen(t, DIRAM_TRACE_TAG_LEN - 1);
+    memcpy(rec->tag, t, tag_len);
+    memset(rec->tag + tag_len, 0, DIRAM_TRACE_TAG_LEN - tag_len);
+
+    ring->records++;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    atomic_store_explicit(&ring->active, 0, memory_order_release);
+    return 0;
+}
+
+// Write every iovec fully at `offset`, advancing through partial writes
+static int writev_all(int fd, struct iovec* iov, int count, off_t offset) {
+    while (count > 0) {
+        ssize_t n = pwritev(fd, iov, count, offset);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        offset += n;
+        while (count > 0 && (size_t)n >= iov->iov_len) {
+            n -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char*)iov->iov_base + n;
+            iov->iov_len -= (size_t)n;
+        }
+    }
+    return 0;
+}
+
+// One gather pass over all rings; returns the number of records persisted
+static uint64_t trace_drain_once(void) {
+    struct iovec iov[TRACE_MAX_IOV];
+    diram_trace_ring_t* pending[TRACE_MAX_IOV / 2];
+    uint64_t new_tail[TRACE_MAX_IOV / 2];
+    uint64_t persisted = 0;
+
+    diram_trace_ring_t* ring = atomic_load_explicit(&g_trace.rings, memory_order_acquire);
+    while (ring) {
+        int iov_count = 0;
+        int ring_count = 0;
+        uint64_t batch = 0;
+
+        // Each ring contributes at most two spans (ring wrap-around)
+        for (; ring && iov_count + 2 <= TRACE_MAX_IOV; ring = ring->next) {
+            uint64_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+            uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+            if (head == tail) continue;
+
+            uint64_t first = tail & TRACE_RING_MASK;
+            uint64_t n = head - tail;
+            uint64_t span = DIRAM_TRACE_RING_RECORDS - first;
+            if (span > n) span = n;
+
+            iov[iov_count].iov_base = &ring->records_buf[first];
+            iov[iov_count].iov_len = span * sizeof(diram_trace_record_t);
+            iov_count++;
+            if (n > span) {
+                iov[iov_count].iov_base = &ring->records_buf[0];
+                iov[iov_count].iov_len = (n - span) * sizeof(diram_trace_record_t);
+                iov_count++;
+            }
+
+            pending[ring_count] = ring;
+            new_tail[ring_count] = head;
+            ring_count++;
+            batch += n;
+        }
+
+        if (iov_count == 0) break;
+        if (writev_all(g_trace.fd, iov, iov_count, (off_t)g_trace.offset) != 0) {
+            // Leave the records queued; the retry rewrites from the same
+            // offset, over whatever part of this batch did land
+            __atomic_store_n(&g_trace.write_errors, g_trace.write_errors + 1, __ATOMIC_RELAXED);
+            break;
+        }
+        __atomic_store_n(&g_trace.batches, g_trace.batches + 1, __ATOMIC_RELAXED);
+        g_trace.offset += batch * sizeof(diram_trace_record_t);
+
+        // Release the slots only after the kernel has the bytes
+        for (int i = 0; i < ring_count; i++) {
+            atomic_store_explicit(&pending[i]->tail, new_tail[i], memory_order_release);
+        }
+        persisted += batch;
+    }
+
+    __atomic_store_n(&g_trace.written, g_trace.written + persisted, __ATOMIC_RELAXED);
+    return persisted;
+}
+
+// Records still queued when the writer stops could not be written
+static void trace_discard_pending(void) {
+    uint64_t bytes = 0;
+    for (diram_trace_ring_t* r = atomic_load_explicit(&g_trace.rings, memory_order_acquire);
+         r; r = r->next) {
+        uint64_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+        uint64_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+        bytes += (head - tail) * sizeof(diram_trace_record_t);
+        atomic_store_explicit(&r->tail, head, memory_order_release);
+    }
+    __atomic_store_n(&g_trace.dropped_bytes, g_trace.dropped_bytes + bytes, __ATOMIC_RELAXED);
+}
+
+static void* trace_writer_thread(void* arg) {
+    (void)arg;
+    struct timespec idle = {0, DIRAM_TRACE_DRAIN_INTERVAL_US * 1000L};
+
+    while (atomic_load(&g_trace.running)) {
+        if (trace_drain_once() == 0) {
+            nanosleep(&idle, NULL);
+        }
+    }
+
+    // Producers that passed the running check before close finish first
+    for (diram_trace_ring_t* r = atomic_load_explicit(&g_trace.rings, memory_order_acquire);
+         r; r = r->next) {
+        while (atomic_load(&r->active)) sched_yield();
+    }
+
+    // Final drain after producers have been stopped; a failing write
+    // leaves nothing more to try
+    while (trace_drain_once() > 0) {
+    }
+    trace_discard_pending();
+    return NULL;
+}
+
+int diram_trace_open(const char* path) {
+    if (!path) return -1;
+
+    pthread_mutex_lock(&g_trace.lock);
+    if (g_trace.fd >= 0) {
+        pthread_mutex_unlock(&g_trace.lock);
+        return 0;
+    }
+
+    // Batches are written at an explicit offset so a failed one can be
+    // retried in place; appends continue from the end found here
+    int fd = open(path, O_WRONLY | O_CREAT | O_CLOEXEC, 0640);
+    if (fd < 0) {
+        pthread_mutex_unlock(&g_trace.lock);
+        return -1;
+    }
+
+    // A fresh file gets the header; an existing log is continued
+    off_t end = lseek(fd, 0, SEEK_END);
+    if (end == 0) {
+        diram_trace_file_header_t header = {0};
+        struct timespec ts = {0};
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        memcpy(header.magic, DIRAM_TRACE_BIN_MAGIC, 8);
+        header.version = DIRAM_TRACE_BIN_VERSION;
+        header.record_size = sizeof(diram_trace_record_t);
+        header.created = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+        if (write(fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+            close(fd);
+            pthread_mutex_unlock(&g_trace.lock);
+            return -1;
+        }
+        end = sizeof(header);
+    }
+
+    g_trace.fd = fd;
+    g_trace.offset = (uint64_t)end;
+    atomic_store_explicit(&g_trace.running, 1, memory_order_release);
+    if (pthread_create(&g_trace.writer, NULL, trace_writer_thread, NULL) != 0) {
+        atomic_store(&g_trace.running, 0);
+        close(fd);
+        g_trace.fd = -1;
+        pthread_mutex_unlock(&g_trace.lock);
+        return -1;
+    }
+
+    pthread_mutex_unlock(&g_trace.lock);
+    return 0;
+}
+
+void diram_trace_close(void) {
+    pthread_mutex_lock(&g_trace.lock);
+    if (g_trace.fd < 0) {
+        pthread_mutex_unlock(&g_trace.lock);
+        return;
+    }
+
+    atomic_store(&g_trace.running, 0);
+    pthread_mutex_unlock(&g_trace.lock);
+
+    pthread_join(g_trace.writer, NULL);
+
+    pthread_mutex_lock(&g_trace.lock);
+    // A failed batch may have left part of a record past the last good one
+    if (g_trace.write_errors && ftruncate(g_trace.fd, (off_t)g_trace.offset) != 0) {
+        g_trace.write_errors++;
+    }
+    close(g_trace.fd);
+    g_trace.fd = -1;
+    pthread_mutex_unlock(&g_trace.lock);
+}
+
+int diram_trace_is_open(void) {
+    return atomic_load_explicit(&g_trace.running, memory_order_relaxed);
+}
+
+void diram_trace_flush(void) {
+    if (!diram_trace_is_open()) return;
+
+    struct timespec pause = {0, DIRAM_TRACE_DRAIN_INTERVAL_US * 100L};
+    uint64_t errors = __atomic_load_n(&g_trace.write_errors, __ATOMIC_RELAXED);
+    for (diram_trace_ring_t* r = atomic_load_explicit(&g_trace.rings, memory_order_acquire);
+         r; r = r->next) {
+        uint64_t target = atomic_load_explicit(&r->head, memory_order_acquire);
+        while (atomic_load_explicit(&r->tail, memory_order_acquire) < target &&
+               diram_trace_is_open() &&
+               __atomic_load_n(&g_trace.write_errors, __ATOMIC_RELAXED) == errors) {
+            nanosleep(&pause, NULL);
+        }
+    }
+}
+
+void diram_trace_get_stats(diram_trace_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    for (diram_trace_ring_t* r = atomic_load_explicit(&g_trace.rings, memory_order_acquire);
+         r; r = r->next) {
+        out->records += __atomic_load_n(&r->records, __ATOMIC_RELAXED);
+        out->full_waits += __atomic_load_n(&r->full_waits, __ATOMIC_RELAXED);
+        out->refused += __atomic_load_n(&r->refused, __ATOMIC_RELAXED);
+        out->rings++;
+    }
+    out->written = __atomic_load_n(&g_trace.written, __ATOMIC_RELAXED);
+    out->batches = __atomic_load_n(&g_trace.batches, __ATOMIC_RELAXED);
+    out->write_errors = __atomic_load_n(&g_trace.write_errors, __ATOMIC_RELAXED);
+    out->dropped_bytes = __atomic_load_n(&g_trace.dropped_bytes, __ATOMIC_RELAXED);
+}
+
+// Reproduces the legacy fprintf layout, including glibc's %p rendering
+int diram_trace_format_record(const diram_trace_record_t* record, char* buffer, size_t length) {
+    if (!record || !buffer || length == 0) return -1;
+
+    char receipt[65];
+    for (int i = 0; i < 32; i++) {
+        static const char digits[] = "0123456789abcdef";
+        receipt[i * 2] = digits[record->receipt[i] >> 4];
+        receipt[i * 2 + 1] = digits[record->receipt[i] & 0x0F];
+    }
+    receipt[64] = '\0';
+
+    char addr[24];
+    if (record->addr == 0) {
+        strcpy(addr, "(nil)");
+    } else {
+        snprintf(addr, sizeof(addr), "0x%lx", (unsigned long)record->addr);
+    }
+
+    char tag[DIRAM_TRACE_TAG_LEN];
+    memcpy(tag, record->tag, DIRAM_TRACE_TAG_LEN);
+    tag[DIRAM_TRACE_TAG_LEN - 1] = '\0';
+
+    const char* event = record->event == DIRAM_TRACE_EVENT_FREE ? "FREE" : "ALLOC";
+    const char* suffix = record->event == DIRAM_TRACE_EVENT_FREE ? "traced" : tag;
+
+    return snprintf(buffer, length, "%lu|%d|%s|%s|%lu|%s|%s",
+                    (unsigned long)record->timestamp, record->pid, event, addr,
+                    (unsigned long)record->size, receipt, suffix);
+}
+
+static int compare_timestamp(const void* a, const void* b) {
+    const diram_trace_record_t* ra = (const diram_trace_record_t*)a;
+    const diram_trace_record_t* rb = (const diram_trace_record_t*)b;
+    return (ra->timestamp > rb->timestamp) - (ra->timestamp < rb->timestamp);
+}
+
+// Writer batches interleave threads; sort_by_time restores a global order
+int diram_trace_decode_file(const char* path, FILE* out, int sort_by_time) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return -1;
+
+    diram_trace_file_header_t header;
+    if (fread(&header, sizeof(header), 1, fp) != 1 ||
+        memcmp(header.magic, DIRAM_TRACE_BIN_MAGIC, 8) != 0 ||
+        header.version != DIRAM_TRACE_BIN_VERSION ||
+        header.record_size != sizeof(diram_trace_record_t)) {
+        fclose(fp);
+        return -1;
+    }
+
+    fprintf(out, "# DIRAM Trace Log\n");
+
+    char line[512];
+    diram_trace_record_t record;
+
+    if (!sort_by_time) {
+        while (fread(&record, sizeof(record), 1, fp) == 1) {
+            diram_trace_format_record(&record, line, sizeof(line));
+            fprintf(out, "%s\n", line);
+        }
+        fclose(fp);
+        return 0;
+    }
+
+    size_t count = 0, capacity = 4096;
+    diram_trace_record_t* records = malloc(capacity * sizeof(*records));
+    while (records && fread(&records[count], sizeof(record), 1, fp) == 1) {
+        if (++count == capacity) {
+            capacity *= 2;
+            diram_trace_record_t* grown = realloc(records, capacity * sizeof(*records));
+            if (!grown) {
+                free(records);
+                records = NULL;
+                break;
+            }
+            records = grown;
+        }
+    }
+    fclose(fp);
+    if (!records) return -1;
+
+    qsort(records, count, sizeof(*records), compare_timestamp);
+    for (size_t i = 0; i < count; i++) {
+        diram_trace_format_record(&records[i], line, sizeof(line));
+        fprintf(out, "%s\n", line);
+    }
+
+    free(records);
+    return 0;
+}
@@ -0,0 +1,334 @@
+// src/core/governor/governor.c
+// OBINexus DIRAM Heap Event Governor
+// A bucket is admitted while its theoretical arrival time stays within
+// capacity of now; every admitted event pushes it one interval further.
+// That refills continuously and needs a single CAS on shared buckets.
+#include "diram/core/governor/governor.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DIRAM_GOV_TSC 1
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+
+#define GOV_CALIBRATE_NS   2000000ULL     // TSC calibration window
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+static struct {
+    int use_tsc;
+    uint64_t tsc_base;
+    uint64_t ns_base;
+    uint64_t mult;            // ns per tick, 32.32 fixed point
+} g_clock;
+
+static pthread_once_t g_clock_once = PTHREAD_ONCE_INIT;
+
+static inline uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#ifdef DIRAM_GOV_TSC
+// Only an invariant TSC ticks at a constant rate across P/C-states
+static int tsc_is_invariant(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) return 0;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx >> 8) & 1;
+}
+#endif
+
+static void clock_calibrate(void) {
+#ifdef DIRAM_GOV_TSC
+    if (tsc_is_invariant()) {
+        uint64_t ns0 = monotonic_ns();
+        uint64_t tsc0 = __rdtsc();
+        uint64_t ns1, tsc1;
+        do {
+            ns1 = monotonic_ns();
+            tsc1 = __rdtsc();
+        } while (ns1 - ns0 < GOV_CALIBRATE_NS);
+
+        if (tsc1 > tsc0) {
+            g_clock.mult = (uint64_t)(((__uint128_t)(ns1 - ns0) << 32) / (tsc1 - tsc0));
+            g_clock.tsc_base = tsc1;
+            g_clock.ns_base = ns1;
+            g_clock.use_tsc = 1;
+            return;
+        }
+    }
+#endif
+    g_clock.use_tsc = 0;
+}
+
+uint64_t diram_gov_now_ns(void) {
+    pthread_once(&g_clock_once, clock_calibrate);
+#ifdef DIRAM_GOV_TSC
+    if (g_clock.use_tsc) {
+        uint64_t ticks = __rdtsc() - g_clock.tsc_base;
+        return g_clock.ns_base + (uint64_t)(((__uint128_t)ticks * g_clock.mult) >> 32);
+    }
+#endif
+    return monotonic_ns();
+}
+
+const char* diram_gov_clock_source(void) {
+    pthread_once(&g_clock_once, clock_calibrate);
+    return g_clock.use_tsc ? "tsc" : "vdso";
+}
+
+// ============================================================================
+// Buckets
+// ============================================================================
+
+// Stats readers may look at a live bucket, so limits are stored atomically
+static void bucket_set_rate(diram_gov_bucket_t* bucket, uint32_t rate, uint32_t burst) {
+    uint64_t interval = 0;
+    uint64_t capacity = 0;
+
+    if (rate != DIRAM_GOV_UNLIMITED) {
+        if (burst == 0) burst = 1;
+        interval = 1000000000ULL / rate;
+        if (interval == 0) interval = 1;
+        capacity = interval * burst;
+    }
+
+    __atomic_store_n(&bucket->interval_ns, interval, __ATOMIC_RELAXED);
+    __atomic_store_n(&bucket->capacity_ns, capacity, __ATOMIC_RELAXED);
+    __atomic_store_n(&bucket->tat_ns, 0, __ATOMIC_RELAXED);
+}
+
+void diram_gov_bucket_init(diram_gov_bucket_t* bucket, uint32_t rate, uint32_t burst) {
+    if (!bucket) return;
+    bucket_set_rate(bucket, rate, burst);
+    __atomic_store_n(&bucket->admitted, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&bucket->throttled, 0, __ATOMIC_RELAXED);
+}
+
+int diram_gov_bucket_admit(diram_gov_bucket_t* bucket, uint64_t now_ns, uint32_t cost) {
+    if (!bucket) return 0;
+
+    uint64_t interval = __atomic_load_n(&bucket->interval_ns, __ATOMIC_RELAXED);
+    if (interval == 0) {
+        __atomic_fetch_add(&bucket->admitted, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    uint64_t capacity = __atomic_load_n(&bucket->capacity_ns, __ATOMIC_RELAXED);
+    uint64_t charge = interval * (cost ? cost : 1);
+    uint64_t tat = __atomic_load_n(&bucket->tat_ns, __ATOMIC_RELAXED);
+
+    for (;;) {
+        uint64_t next = (tat > now_ns ? tat : now_ns) + charge;
+        if (next - now_ns > capacity) {
+            __atomic_fetch_add(&bucket->throttled, 1, __ATOMIC_RELAXED);
+            return -1;
+        }
+        if (__atomic_compare_exchange_n(&bucket->tat_ns, &tat, next, 1,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            __atomic_fetch_add(&bucket->admitted, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    }
+}
+
+double diram_gov_bucket_epsilon(const diram_gov_bucket_t* bucket, uint64_t now_ns) {
+    if (!bucket) return 0.0;
+
+    uint64_t capacity = __atomic_load_n(&bucket->capacity_ns, __ATOMIC_RELAXED);
+    uint64_t tat = __atomic_load_n(&bucket->tat_ns, __ATOMIC_RELAXED);
+    if (capacity == 0 || tat <= now_ns) return 0.0;
+
+    double epsilon = (double)(tat - now_ns) / (double)capacity;
+    return epsilon > 1.0 ? 1.0 : epsilon;
+}
+
+// ============================================================================
+// Per-thread governor state
+// ============================================================================
+
+typedef struct diram_gov_thread {
+    diram_gov_bucket_t bucket;        // owner-only writes
+    uint32_t generation;              // defaults this bucket was built from
+    int overridden;
+    atomic_int orphaned;
+    struct diram_gov_thread* next;
+} diram_gov_thread_t;
+
+static struct {
+    pthread_mutex_t lock;             // registration, reconfiguration and stats only
+    _Atomic(diram_gov_thread_t*) threads;
+    atomic_uint generation;
+    uint32_t thread_rate;
+    uint32_t thread_burst;
+    uint32_t space_rate;
+    uint32_t space_burst;
+    uint64_t retired_admitted;        // counts of exited threads' states
+    uint64_t retired_throttled;
+} g_gov = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .generation = 1,
+    .thread_rate = DIRAM_GOV_DEFAULT_THREAD_RATE,
+    .thread_burst = DIRAM_GOV_DEFAULT_THREAD_BURST,
+    .space_rate = DIRAM_GOV_UNLIMITED,
+    .space_burst = 0,
+};
+
+static pthread_key_t g_gov_key;
+static pthread_once_t g_gov_once = PTHREAD_ONCE_INIT;
+static __thread diram_gov_thread_t* tls_gov = NULL;
+
+static void gov_thread_release(void* arg) {
+    diram_gov_thread_t* state = (diram_gov_thread_t*)arg;
+    atomic_store_explicit(&state->orphaned, 1, memory_order_release);
+}
+
+static void gov_key_init(void) {
+    pthread_key_create(&g_gov_key, gov_thread_release);
+}
+
+static void gov_thread_reset(diram_gov_thread_t* state, uint32_t generation) {
+    pthread_mutex_lock(&g_gov.lock);
+    uint32_t rate = g_gov.thread_rate;
+    uint32_t burst = g_gov.thread_burst;
+    pthread_mutex_unlock(&g_gov.lock);
+
+    bucket_set_rate(&state->bucket, rate, burst);
+    state->generation = generation;
+}
+
+// Thread states are never freed; one left by an exited thread is adopted
+static diram_gov_thread_t* gov_thread_acquire(void) {
+    if (tls_gov) return tls_gov;
+
+    pthread_once(&g_gov_once, gov_key_init);
+
+    diram_gov_thread_t* state = NULL;
+    pthread_mutex_lock(&g_gov.lock);
+
+    for (diram_gov_thread_t* s = atomic_load(&g_gov.threads); s && !state; s = s->next) {
+        int expected = 1;
+        if (atomic_compare_exchange_strong(&s->orphaned, &expected, 0)) {
+            state = s;
+        }
+    }
+
+    if (state) {
+        // The adopter starts from zero; totals keep the previous owner's
+        g_gov.retired_admitted += state->bucket.admitted;
+        g_gov.retired_throttled += state->bucket.throttled;
+        __atomic_store_n(&state->bucket.admitted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&state->bucket.throttled, 0, __ATOMIC_RELAXED);
+    } else {
+        state = calloc(1, sizeof(diram_gov_thread_t));
+        if (state) {
+            state->next = atomic_load(&g_gov.threads);
+            atomic_store_explicit(&g_gov.threads, state, memory_order_release);
+        }
+    }
+
+    pthread_mutex_unlock(&g_gov.lock);
+
+    if (state) {
+        state->overridden = 0;
+        gov_thread_reset(state, atomic_load(&g_gov.generation));
+        tls_gov = state;
+        pthread_setspecific(g_gov_key, state);
+    }
+    return state;
+}
+
+void diram_gov_configure_thread(uint32_t rate, uint32_t burst) {
+    pthread_mutex_lock(&g_gov.lock);
+    g_gov.thread_rate = rate;
+    g_gov.thread_burst = burst;
+    pthread_mutex_unlock(&g_gov.lock);
+
+    // Threads rebuild their bucket on their next admit
+    atomic_fetch_add(&g_gov.generation, 1);
+}
+
+void diram_gov_configure_space(uint32_t rate, uint32_t burst) {
+    pthread_mutex_lock(&g_gov.lock);
+    g_gov.space_rate = rate;
+    g_gov.space_burst = burst;
+    pthread_mutex_unlock(&g_gov.lock);
+}
+
+void diram_gov_space_defaults(uint32_t* rate, uint32_t* burst) {
+    pthread_mutex_lock(&g_gov.lock);
+    if (rate) *rate = g_gov.space_rate;
+    if (burst) *burst = g_gov.space_burst;
+    pthread_mutex_unlock(&g_gov.lock);
+}
+
+int diram_gov_set_thread_limit(uint32_t rate, uint32_t burst) {
+    diram_gov_thread_t* state = gov_thread_acquire();
+    if (!state) return -1;
+
+    bucket_set_rate(&state->bucket, rate, burst);
+    state->overridden = 1;
+    return 0;
+}
+
+int diram_gov_admit_thread(uint64_t now_ns) {
+    diram_gov_thread_t* state = gov_thread_acquire();
+    if (!state) return -1;
+
+    uint32_t generation = atomic_load_explicit(&g_gov.generation, memory_order_relaxed);
+    if (state->generation != generation && !state->overridden) {
+        gov_thread_reset(state, generation);
+    }
+
+    // Owner-only bucket: the same arithmetic as the shared admit, minus the CAS
+    diram_gov_bucket_t* b = &state->bucket;
+    if (b->interval_ns == 0) {
+        __atomic_store_n(&b->admitted, b->admitted + 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+
+    uint64_t next = (b->tat_ns > now_ns ? b->tat_ns : now_ns) + b->interval_ns;
+    if (next - now_ns > b->capacity_ns) {
+        __atomic_store_n(&b->throttled, b->throttled + 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+    __atomic_store_n(&b->tat_ns, next, __ATOMIC_RELAXED);
+    __atomic_store_n(&b->admitted, b->admitted + 1, __ATOMIC_RELAXED);
+    return 0;
+}
+
+uint64_t diram_gov_thread_events(void) {
+    diram_gov_thread_t* state = gov_thread_acquire();
+    return state ? state->bucket.admitted : 0;
+}
+
+void diram_gov_get_stats(diram_gov_stats_t* out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+
+    uint64_t now = diram_gov_now_ns();
+    // Under the lock so an adoption cannot move counts mid-walk
+    pthread_mutex_lock(&g_gov.lock);
+    out->admitted = g_gov.retired_admitted;
+    out->throttled = g_gov.retired_throttled;
+    for (diram_gov_thread_t* s = atomic_load_explicit(&g_gov.threads, memory_order_acquire);
+         s; s = s->next) {
+        out->admitted += __atomic_load_n(&s->bucket.admitted, __ATOMIC_RELAXED);
+        out->throttled += __atomic_load_n(&s->bucket.throttled, __ATOMIC_RELAXED);
+        out->threads++;
+
+        double epsilon = diram_gov_bucket_epsilon(&s->bucket, now);
+        if (epsilon > out->max_epsilon) out->max_epsilon = epsilon;
+        if (epsilon > DIRAM_GOV_EPSILON_LIMIT) out->over_limit++;
+    }
+    pthread_mutex_unlock(&g_gov.lock);
+}
@@ -0,0 +1,369 @@
+// src/core/observe/observation_ring.c
+// OBINexus DIRAM Observation Ring
+// Each slot carries the low 32 bits of (position + 1) beside the phenotype,
+// written as one 64-bit store, so the folder can tell a finished slot from
+// one still being written or already lapped without any per-slot lock.
+// Folding walks every shard in position order under a try-lock and stops
+// within a shard at the first slot its producer has not yet published.
+// A recorder that loses that try-lock folds its own shard into a spill
+// beside it (histograms plus an EWMA run from zero), which the next ring
+// fold merges: the run's EWMA adds to the ring's decayed by (1 - a)^n,
+// exactly as if its n observations had been folded one by one.
+#include "diram/core/observe/observation_ring.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define EWMA_ONE  (1 << 16)
+
+// Bit offsets and widths of the phenotype_t fields, LSB first; every
+// phenotype byte holds three whole fields
+static const uint8_t field_shift[DIRAM_OBS_FIELDS] = { 0, 3, 6, 8, 11, 14, 16, 19, 22, 24, 27, 30 };
+static const uint8_t field_mask[DIRAM_OBS_FIELDS]  = { 7, 7, 3, 7, 7, 3, 7, 7, 3, 7, 7, 3 };
+
+static uint64_t g_ring_ids;
+
+static __thread struct {
+    diram_obs_ring_t* ring;
+    uint64_t id;
+    diram_obs_shard_t* shard;
+} tls_shard;
+
+uint32_t diram_obs_field(phenotype_t p, diram_obs_field_t field) {
+    return (p.raw >> field_shift[field]) & field_mask[field];
+}
+
+diram_obs_ring_t* diram_obs_ring_create(uint32_t capacity) {
+    uint64_t slots = 2;
+    while (slots < (capacity ? capacity : DIRAM_OBS_RING_DEFAULT)) slots <<= 1;
+
+    void* mem = NULL;
+    if (posix_memalign(&mem, 64, sizeof(diram_obs_ring_t)) != 0) return NULL;
+    diram_obs_ring_t* ring = mem;
+    memset(ring, 0, sizeof(*ring));
+
+    ring->id = __atomic_add_fetch(&g_ring_ids, 1, __ATOMIC_RELAXED);
+    ring->mask = slots - 1;
+    ring->fold_every = slots / 2;
+    pthread_mutex_init(&ring->shard_lock, NULL);
+    return ring;
+}
+
+void diram_obs_ring_destroy(diram_obs_ring_t* ring) {
+    if (!ring) return;
+    while (ring->shards) {
+        diram_obs_shard_t* shard = ring->shards;
+        ring->shards = shard->next;
+        free(shard);
+    }
+    pthread_mutex_destroy(&ring->shard_lock);
+    free(ring);
+}
+
+// Slow path: find this thread's shard or make one
+static diram_obs_shard_t* shard_acquire(diram_obs_ring_t* ring) {
+    pthread_t self = pthread_self();
+    size_t bytes = sizeof(diram_obs_shard_t) + (ring->mask + 1) * sizeof(uint64_t);
+    diram_obs_shard_t* shard = NULL;
+
+    pthread_mutex_lock(&ring->shard_lock);
+    diram_obs_shard_t* shared = NULL;
+    for (diram_obs_shard_t* s = ring->shards; s && !shard; s = s->next) {
+        if (s->shared) shared = s;
+        else if (pthread_equal(s->owner, self)) shard = s;
+    }
+    if (!shard) shard = shared;
+    if (!shard) {
+        void* mem = NULL;
+        if (posix_memalign(&mem, 64, bytes) == 0) {
+            // Zeroed slots carry sequence 0, which no position ever expects
+            shard = mem;
+            memset(shard, 0, bytes);
+            shard->owner = self;
+            shard->shared = ring->shard_count + 1 == DIRAM_OBS_MAX_SHARDS;
+            shard->next = ring->shards;
+            __atomic_store_n(&ring->shards, shard, __ATOMIC_RELEASE);
+            ring->shard_count++;
+        }
+    }
+    pthread_mutex_unlock(&ring->shard_lock);
+
+    if (shard) {
+        tls_shard.ring = ring;
+        tls_shard.id = ring->id;
+        tls_shard.shard = shard;
+    }
+    return shard;
+}
+
+// EWMA stays in registers across a run of slots. With SSE2, lane k of
+// e[j] is field 3k + j, so one byte unpack and one shift per vector
+// extract all twelve fields
+#ifdef __SSE2__
+typedef struct { __m128i e[3]; } ewma_run_t;
+
+static inline void ewma_load(ewma_run_t* run, const int32_t* ewma) {
+    for (int j = 0; j < 3; j++) {
+        run->e[j] = _mm_setr_epi32(ewma[j], ewma[3 + j], ewma[6 + j], ewma[9 + j]);
+    }
+}
+
+static inline void ewma_store(const ewma_run_t* run, int32_t* ewma) {
+    for (int j = 0; j < 3; j++) {
+        int32_t lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, run->e[j]);
+        for (int k = 0; k < 4; k++) ewma[3 * k + j] = lanes[k];
+    }
+}
+
+static inline void ewma_step(ewma_run_t* run, uint32_t raw) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i three_bits = _mm_set1_epi32(7);
+    __m128i bytes = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)raw), zero), zero);
+    __m128i v[3] = {
+        _mm_and_si128(bytes, three_bits),
+        _mm_and_si128(_mm_srli_epi32(bytes, 3), three_bits),
+        _mm_srli_epi32(bytes, 6),
+    };
+    for (int j = 0; j < 3; j++) {
+        __m128i delta = _mm_sub_epi32(_mm_slli_epi32(v[j], 16), run->e[j]);
+        run->e[j] = _mm_add_epi32(run->e[j], _mm_srai_epi32(delta, DIRAM_OBS_EWMA_SHIFT));
+    }
+}
+#else
+typedef struct { int32_t e[DIRAM_OBS_FIELDS]; } ewma_run_t;
+
+static inline void ewma_load(ewma_run_t* run, const int32_t* ewma) {
+    memcpy(run->e, ewma, sizeof(run->e));
+}
+
+static inline void ewma_store(const ewma_run_t* run, int32_t* ewma) {
+    memcpy(ewma, run->e, sizeof(run->e));
+}
+
+static inline void ewma_step(ewma_run_t* run, uint32_t raw) {
+#pragma GCC unroll 12
+    for (uint32_t f = 0; f < DIRAM_OBS_FIELDS; f++) {
+        int32_t v = (int32_t)((raw >> field_shift[f]) & field_mask[f]);
+        run->e[f] += (v * EWMA_ONE - run->e[f]) >> DIRAM_OBS_EWMA_SHIFT;
+    }
+}
+#endif
+
+static inline void fold_one(uint64_t (*histogram)[256], ewma_run_t* run, uint32_t raw) {
+    histogram[0][raw & 0xFF]++;
+    histogram[1][(raw >> 8) & 0xFF]++;
+    histogram[2][(raw >> 16) & 0xFF]++;
+    histogram[3][raw >> 24]++;
+    ewma_step(run, raw);
+}
+
+// Fold the shard's published slots from fold_next on; caller holds
+// shard->fold_busy. Returns how many were folded
+static uint64_t fold_run(diram_obs_ring_t* ring, diram_obs_shard_t* shard,
+                         uint64_t (*histogram)[256], int32_t* ewma,
+                         uint32_t* last, uint64_t* dropped) {
+    uint64_t head = __atomic_load_n(&shard->head, __ATOMIC_ACQUIRE);
+    uint64_t next = shard->fold_next;
+    uint64_t capacity = ring->mask + 1;
+
+    if (head - next > capacity) {
+        *dropped += head - capacity - next;
+        next = head - capacity;
+    }
+
+    uint64_t folded = 0;
+    uint64_t lapped = 0;
+    uint32_t raw = *last;
+    ewma_run_t run;
+    ewma_load(&run, ewma);
+    while (next < head) {
+        uint64_t slot = __atomic_load_n(&shard->slots[next & ring->mask], __ATOMIC_ACQUIRE);
+        int32_t lag = (int32_t)((uint32_t)(slot >> 32) - (uint32_t)(next + 1));
+        if (lag < 0) break;             // claimed, not yet written
+        if (lag == 0) {
+            raw = (uint32_t)slot;
+            fold_one(histogram, &run, raw);
+            folded++;
+        } else {
+            lapped++;                   // a later lap got there first
+        }
+        next++;
+    }
+    ewma_store(&run, ewma);
+    shard->fold_next = next;
+    *dropped += lapped;
+    *last = raw;
+    return folded;
+}
+
+// (1 - a)^n in 16.16 fixed point, by squaring
+static int64_t ewma_decay(uint64_t n) {
+    int64_t result = EWMA_ONE;
+    int64_t base = EWMA_ONE - (EWMA_ONE >> DIRAM_OBS_EWMA_SHIFT);
+    while (n && result) {
+        if (n & 1) result = (result * base) >> 16;
+        base = (base * base) >> 16;
+        n >>= 1;
+    }
+    return result;
+}
+
+// Recorder side, on losing fold_lock: fold its own shard into the spill.
+// Waits only while a ring fold is inside this very shard, since the next
+// half shard would lap it if that folder has been preempted
+static void spill_shard(diram_obs_ring_t* ring, diram_obs_shard_t* shard) {
+    while (__atomic_exchange_n(&shard->fold_busy, 1, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    shard->spilled += fold_run(ring, shard, shard->spill_histogram, shard->spill_ewma,
+                               &shard->spill_last, &shard->spill_dropped);
+    __atomic_store_n(&shard->fold_busy, 0, __ATOMIC_RELEASE);
+}
+
+// Merge the spill, which is older than anything left in the slots, then
+// fold those; caller holds fold_lock and shard->fold_busy
+static void fold_shard(diram_obs_ring_t* ring, diram_obs_shard_t* shard, int32_t* ewma) {
+    if (shard->spilled) {
+        int64_t decay = ewma_decay(shard->spilled);
+        for (uint32_t f = 0; f < DIRAM_OBS_FIELDS; f++) {
+            if (ring->folded == 0) {
+                // No history to decay: normalise the run from zero instead
+                ewma[f] = (int32_t)(((int64_t)shard->spill_ewma[f] << 16) / (EWMA_ONE - decay));
+            } else {
+                ewma[f] = (int32_t)(((int64_t)ewma[f] * decay) >> 16) + shard->spill_ewma[f];
+            }
+        }
+        for (uint32_t k = 0; k < 4; k++) {
+            for (uint32_t b = 0; b < 256; b++) {
+                ring->byte_histogram[k][b] += shard->spill_histogram[k][b];
+            }
+        }
+        ring->folded += shard->spilled;
+        ring->last = shard->spill_last;
+        memset(shard->spill_histogram, 0, sizeof(shard->spill_histogram));
+        memset(shard->spill_ewma, 0, sizeof(shard->spill_ewma));
+        shard->spilled = 0;
+    }
+    ring->dropped += shard->spill_dropped;
+    shard->spill_dropped = 0;
+
+    uint64_t head = __atomic_load_n(&shard->head, __ATOMIC_ACQUIRE);
+    uint64_t next = shard->fold_next;
+    if (head - next > ring->mask + 1) next = head - (ring->mask + 1);
+    if (next < head && ring->folded == 0) {
+        // Seed the averages with the first observation rather than zero
+        uint32_t raw = (uint32_t)__atomic_load_n(&shard->slots[next & ring->mask], __ATOMIC_ACQUIRE);
+        for (uint32_t f = 0; f < DIRAM_OBS_FIELDS; f++) {
+            ewma[f] = (int32_t)(((raw >> field_shift[f]) & field_mask[f]) * EWMA_ONE);
+        }
+    }
+    ring->folded += fold_run(ring, shard, ring->byte_histogram, ewma, &ring->last, &ring->dropped);
+}
+
+// Caller holds fold_lock. A shard whose owner is spilling is skipped
+// unless `wait` is set; its spill is merged on a later fold
+static void fold_locked(diram_obs_ring_t* ring, bool wait) {
+    int32_t ewma[DIRAM_OBS_FIELDS];
+    memcpy(ewma, ring->ewma_fixed, sizeof(ewma));
+    for (diram_obs_shard_t* s = __atomic_load_n(&ring->shards, __ATOMIC_ACQUIRE); s; s = s->next) {
+        bool busy;
+        while ((busy = __atomic_exchange_n(&s->fold_busy, 1, __ATOMIC_ACQUIRE)) && wait) {
+            sched_yield();
+        }
+        if (busy) continue;
+        fold_shard(ring, s, ewma);
+        __atomic_store_n(&s->fold_busy, 0, __ATOMIC_RELEASE);
+    }
+    memcpy(ring->ewma_fixed, ewma, sizeof(ewma));
+}
+
+void diram_obs_ring_record(diram_obs_ring_t* ring, phenotype_t observed) {
+    diram_obs_shard_t* shard = tls_shard.shard;
+    if (tls_shard.ring != ring || tls_shard.id != ring->id) {
+        shard = shard_acquire(ring);
+        if (!shard) return;
+    }
+
+    uint64_t pos;
+    if (!shard->shared) {
+        pos = shard->head;
+        __atomic_store_n(&shard->slots[pos & ring->mask], ((pos + 1) << 32) | observed.raw,
+                         __ATOMIC_RELAXED);
+        __atomic_store_n(&shard->head, pos + 1, __ATOMIC_RELEASE);
+    } else {
+        pos = __atomic_fetch_add(&shard->head, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&shard->slots[pos & ring->mask], ((pos + 1) << 32) | observed.raw,
+                         __ATOMIC_RELEASE);
+    }
+
+    // Every half shard, one recorder folds before the unfolded half is
+    // lapped; the others spill their own shard rather than wait
+    if (((pos + 1) & (ring->fold_every - 1)) == 0) {
+        if (!__atomic_exchange_n(&ring->fold_lock, 1, __ATOMIC_ACQUIRE)) {
+            fold_locked(ring, false);
+            __atomic_store_n(&ring->fold_lock, 0, __ATOMIC_RELEASE);
+        } else {
+            spill_shard(ring, shard);
+        }
+    }
+}
+
+uint32_t diram_obs_ring_recent(diram_obs_ring_t* ring, phenotype_t* out, uint32_t max) {
+    if (!ring || !out) return 0;
+
+    uint32_t copied = 0;
+    for (diram_obs_shard_t* s = __atomic_load_n(&ring->shards, __ATOMIC_ACQUIRE);
+         s && copied < max; s = s->next) {
+        uint64_t head = __atomic_load_n(&s->head, __ATOMIC_ACQUIRE);
+        uint64_t n = max - copied;
+        if (n > ring->mask + 1) n = ring->mask + 1;
+        if (n > head) n = head;
+
+        for (uint64_t pos = head - n; pos < head; pos++) {
+            uint64_t slot = __atomic_load_n(&s->slots[pos & ring->mask], __ATOMIC_ACQUIRE);
+            if ((uint32_t)(slot >> 32) == (uint32_t)(pos + 1)) {
+                out[copied++].raw = (uint32_t)slot;
+            }
+        }
+    }
+    return copied;
+}
+
+int diram_obs_ring_summary(diram_obs_ring_t* ring, diram_obs_summary_t* out) {
+    if (!ring || !out) return -1;
+    memset(out, 0, sizeof(*out));
+
+    while (__atomic_exchange_n(&ring->fold_lock, 1, __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    fold_locked(ring, true);
+
+    out->folded = ring->folded;
+    out->dropped = ring->dropped;
+    out->last.raw = ring->last;
+    for (uint32_t f = 0; f < DIRAM_OBS_FIELDS; f++) {
+        out->ewma[f] = (float)ring->ewma_fixed[f] / (float)EWMA_ONE;
+    }
+    // Byte k holds fields 3k..3k+2 at bits 0, 3 and 6
+    for (uint32_t k = 0; k < 4; k++) {
+        uint64_t (*h)[DIRAM_OBS_BUCKETS] = &out->histogram[3 * k];
+        for (uint32_t b = 0; b < 256; b++) {
+            uint64_t n = ring->byte_histogram[k][b];
+            h[0][b & 7] += n;
+            h[1][(b >> 3) & 7] += n;
+            h[2][b >> 6] += n;
+        }
+    }
+    __atomic_store_n(&ring->fold_lock, 0, __ATOMIC_RELEASE);
+
+    for (diram_obs_shard_t* s = __atomic_load_n(&ring->shards, __ATOMIC_ACQUIRE); s; s = s->next) {
+        out->recorded += __atomic_load_n(&s->head, __ATOMIC_RELAXED);
+        out->shards++;
+    }
+    return 0;
+}
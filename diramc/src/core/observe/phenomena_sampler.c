@@ -0,0 +1,489 @@
+// src/core/observe/phenomena_sampler.c
+// OBINexus DIRAM Phenomena Sampler
+// A pass snapshots the region table, walks each region's pages in chunks
+// against mincore and /proc/self/pagemap, and publishes the derived sample
+// under the region's sequence counter. The table lock is only taken to
+// snapshot and to publish, so tracking never waits for a whole pass.
+#include "diram/core/observe/phenomena_sampler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+
+#define CHUNK_PAGES         512
+#define EWMA_ONE            (1u << 16)
+#define EWMA_SHIFT          2           // alpha = 1/4 per pass
+
+#define PM_PRESENT          (1ULL << 63)
+#define PM_SOFT_DIRTY       (1ULL << 55)
+#define PM_PFN_MASK         ((1ULL << 55) - 1)
+
+typedef struct {
+    // Published: written under the table lock inside an odd seq,
+    // read lock-free
+    uint32_t seq;
+    uintptr_t base;                 // 0 when the slot is free
+    uintptr_t end;
+    uint64_t key;                   // new on every track
+    diram_region_sample_t sample;
+
+    // History, touched only by the pass in progress
+    uint64_t history_key;
+    uint64_t last_access_pass;
+    int32_t access_ewma;            // fraction of pages, << 16
+    int32_t dirty_ewma;
+    uint32_t bitmap_pages;
+    uint64_t* seen;                 // resident at the previous pass
+    uint64_t* marked;               // set idle at the previous pass
+} sampler_region_t;
+
+typedef struct {
+    uint32_t slot;
+    uint64_t key;
+    uintptr_t base;
+    uintptr_t end;
+} region_ref_t;
+
+struct diram_sampler {
+    diram_sampler_config_t config;
+    uint32_t sources;
+    size_t page_size;
+    int pagemap_fd;
+    int clear_refs_fd;
+    int idle_fd;
+    bool soft_dirty_owner;          // holds g_soft_dirty_claimed
+
+    pthread_mutex_t lock;           // region table
+    uint32_t high_water;            // slots ever used
+    uint64_t next_key;
+
+    pthread_mutex_t pass_lock;      // one pass at a time
+    uint64_t pass;
+
+    pthread_mutex_t thread_lock;
+    pthread_cond_t wake;
+    pthread_t thread;
+    bool running;
+    bool stop;
+
+    sampler_region_t regions[DIRAM_SAMPLER_MAX_REGIONS];
+};
+
+static const diram_sampler_config_t default_config = {
+    .interval_ms = DIRAM_SAMPLER_INTERVAL_MS,
+    .sources = DIRAM_SAMPLE_DEFAULT,
+};
+
+// Set while some sampler clears soft-dirty bits for the process
+static bool g_soft_dirty_claimed;
+
+static inline bool bit_get(const uint64_t* map, uint32_t i) {
+    return (map[i / 64] >> (i % 64)) & 1;
+}
+
+static inline void bit_put(uint64_t* map, uint32_t i, bool on) {
+    if (on) map[i / 64] |= 1ULL << (i % 64);
+    else map[i / 64] &= ~(1ULL << (i % 64));
+}
+
+static volatile uint64_t probe_word = 1;
+
+static uint64_t probe_entry(diram_sampler_t* sampler) {
+    uint64_t entry = 0;
+    off_t offset = (off_t)((uintptr_t)&probe_word / sampler->page_size * sizeof(entry));
+    if (pread(sampler->pagemap_fd, &entry, sizeof(entry), offset) != sizeof(entry)) return 0;
+    return entry;
+}
+
+// Kernels without CONFIG_MEM_SOFT_DIRTY accept the clear but never set the bit
+static bool soft_dirty_works(diram_sampler_t* sampler) {
+    if (pwrite(sampler->clear_refs_fd, "4", 1, 0) != 1) return false;
+    probe_word++;
+    return probe_entry(sampler) & PM_SOFT_DIRTY;
+}
+
+static void probe_sources(diram_sampler_t* sampler) {
+    uint32_t want = sampler->config.sources;
+    sampler->sources = want & DIRAM_SAMPLE_MINCORE;
+
+    if (want & (DIRAM_SAMPLE_PAGEMAP | DIRAM_SAMPLE_SOFT_DIRTY | DIRAM_SAMPLE_IDLE_PAGE)) {
+        sampler->pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    }
+    if (sampler->pagemap_fd < 0) return;
+    sampler->sources |= want & DIRAM_SAMPLE_PAGEMAP;
+
+    if ((want & DIRAM_SAMPLE_SOFT_DIRTY) &&
+        !__atomic_exchange_n(&g_soft_dirty_claimed, true, __ATOMIC_ACQ_REL)) {
+        sampler->clear_refs_fd = open("/proc/self/clear_refs", O_WRONLY | O_CLOEXEC);
+        if (sampler->clear_refs_fd >= 0 && soft_dirty_works(sampler)) {
+            sampler->sources |= DIRAM_SAMPLE_SOFT_DIRTY;
+            sampler->soft_dirty_owner = true;
+        } else {
+            __atomic_store_n(&g_soft_dirty_claimed, false, __ATOMIC_RELEASE);
+        }
+    }
+    // Idle tracking is only usable when pagemap hands us real PFNs
+    if ((want & DIRAM_SAMPLE_IDLE_PAGE) && (probe_entry(sampler) & PM_PFN_MASK)) {
+        sampler->idle_fd = open("/sys/kernel/mm/page_idle/bitmap", O_RDWR | O_CLOEXEC);
+        if (sampler->idle_fd >= 0) sampler->sources |= DIRAM_SAMPLE_IDLE_PAGE;
+    }
+}
+
+diram_sampler_t* diram_sampler_create(const diram_sampler_config_t* config) {
+    diram_sampler_t* sampler = calloc(1, sizeof(diram_sampler_t));
+    if (!sampler) return NULL;
+
+    sampler->config = config ? *config : default_config;
+    sampler->page_size = (size_t)sysconf(_SC_PAGESIZE);
+    sampler->pagemap_fd = -1;
+    sampler->clear_refs_fd = -1;
+    sampler->idle_fd = -1;
+    probe_sources(sampler);
+
+    pthread_mutex_init(&sampler->lock, NULL);
+    pthread_mutex_init(&sampler->pass_lock, NULL);
+    pthread_mutex_init(&sampler->thread_lock, NULL);
+    pthread_cond_init(&sampler->wake, NULL);
+    return sampler;
+}
+
+void diram_sampler_destroy(diram_sampler_t* sampler) {
+    if (!sampler) return;
+    diram_sampler_stop(sampler);
+
+    for (uint32_t i = 0; i < DIRAM_SAMPLER_MAX_REGIONS; i++) {
+        free(sampler->regions[i].seen);
+        free(sampler->regions[i].marked);
+    }
+    if (sampler->pagemap_fd >= 0) close(sampler->pagemap_fd);
+    if (sampler->clear_refs_fd >= 0) close(sampler->clear_refs_fd);
+    if (sampler->soft_dirty_owner) __atomic_store_n(&g_soft_dirty_claimed, false, __ATOMIC_RELEASE);
+    if (sampler->idle_fd >= 0) close(sampler->idle_fd);
+    pthread_cond_destroy(&sampler->wake);
+    pthread_mutex_destroy(&sampler->thread_lock);
+    pthread_mutex_destroy(&sampler->pass_lock);
+    pthread_mutex_destroy(&sampler->lock);
+    free(sampler);
+}
+
+uint32_t diram_sampler_sources(diram_sampler_t* sampler) {
+    return sampler ? sampler->sources : 0;
+}
+
+// Caller holds the table lock; the sequence brackets every published write
+static void region_publish(sampler_region_t* r, uintptr_t base, uintptr_t end, uint64_t key,
+                           const diram_region_sample_t* sample) {
+    uint32_t seq = r->seq;
+    __atomic_store_n(&r->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    __atomic_store_n(&r->base, base, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->end, end, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->key, key, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.phenomena.raw, sample->phenomena.raw, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.pages, sample->pages, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.resident, sample->resident, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.accessed, sample->accessed, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.dirtied, sample->dirtied, __ATOMIC_RELAXED);
+    __atomic_store_n(&r->sample.pass, sample->pass, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&r->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+int diram_sampler_track(diram_sampler_t* sampler, const void* base, size_t size) {
+    if (!sampler || !base || size == 0) return -1;
+
+    uintptr_t start = (uintptr_t)base & ~(uintptr_t)(sampler->page_size - 1);
+    uintptr_t end = ((uintptr_t)base + size + sampler->page_size - 1) & ~(uintptr_t)(sampler->page_size - 1);
+    diram_region_sample_t empty = {0};
+    int rc = -1;
+
+    pthread_mutex_lock(&sampler->lock);
+    for (uint32_t i = 0; i < DIRAM_SAMPLER_MAX_REGIONS; i++) {
+        sampler_region_t* r = &sampler->regions[i];
+        if (r->base) continue;
+        region_publish(r, start, end, ++sampler->next_key, &empty);
+        if (i >= sampler->high_water) __atomic_store_n(&sampler->high_water, i + 1, __ATOMIC_RELEASE);
+        rc = 0;
+        break;
+    }
+    pthread_mutex_unlock(&sampler->lock);
+    return rc;
+}
+
+void diram_sampler_untrack(diram_sampler_t* sampler, const void* base) {
+    if (!sampler || !base) return;
+
+    uintptr_t start = (uintptr_t)base & ~(uintptr_t)(sampler->page_size - 1);
+    diram_region_sample_t empty = {0};
+
+    pthread_mutex_lock(&sampler->lock);
+    for (uint32_t i = 0; i < sampler->high_water; i++) {
+        sampler_region_t* r = &sampler->regions[i];
+        if (r->base == start) {
+            region_publish(r, 0, 0, 0, &empty);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&sampler->lock);
+}
+
+int diram_sampler_lookup(diram_sampler_t* sampler, const void* addr, diram_region_sample_t* out) {
+    if (!sampler || !addr || !out) return -1;
+
+    uintptr_t a = (uintptr_t)addr;
+    uint32_t high = __atomic_load_n(&sampler->high_water, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < high; i++) {
+        sampler_region_t* r = &sampler->regions[i];
+        for (;;) {
+            uint32_t seq = __atomic_load_n(&r->seq, __ATOMIC_ACQUIRE);
+            if (seq & 1) continue;
+
+            uintptr_t base = __atomic_load_n(&r->base, __ATOMIC_RELAXED);
+            uintptr_t end = __atomic_load_n(&r->end, __ATOMIC_RELAXED);
+            bool hit = base && a >= base && a < end;
+            if (hit) {
+                out->phenomena.raw = __atomic_load_n(&r->sample.phenomena.raw, __ATOMIC_RELAXED);
+                out->pages = __atomic_load_n(&r->sample.pages, __ATOMIC_RELAXED);
+                out->resident = __atomic_load_n(&r->sample.resident, __ATOMIC_RELAXED);
+                out->accessed = __atomic_load_n(&r->sample.accessed, __ATOMIC_RELAXED);
+                out->dirtied = __atomic_load_n(&r->sample.dirtied, __ATOMIC_RELAXED);
+                out->pass = __atomic_load_n(&r->sample.pass, __ATOMIC_RELAXED);
+            }
+
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&r->seq, __ATOMIC_RELAXED) != seq) continue;
+            if (!hit) break;
+            return out->pass ? 0 : -1;
+        }
+    }
+    return -1;
+}
+
+static int history_reset(sampler_region_t* r, uint64_t key, uint32_t pages, uint64_t pass) {
+    size_t words = (pages + 63) / 64;
+    if (pages > r->bitmap_pages) {
+        uint64_t* seen = realloc(r->seen, words * sizeof(uint64_t));
+        if (seen) r->seen = seen;
+        uint64_t* marked = realloc(r->marked, words * sizeof(uint64_t));
+        if (marked) r->marked = marked;
+        if (!seen || !marked) return -1;
+        r->bitmap_pages = pages;
+    }
+    memset(r->seen, 0, words * sizeof(uint64_t));
+    memset(r->marked, 0, words * sizeof(uint64_t));
+    r->history_key = key;
+    r->last_access_pass = pass;     // being tracked counts as a touch
+    r->access_ewma = 0;
+    r->dirty_ewma = 0;
+    return 0;
+}
+
+// Bit set: accessed; clear: idle since we set it. The bitmap is read and
+// written in 64-page words
+static bool page_was_accessed(diram_sampler_t* sampler, uint64_t pfn) {
+    uint64_t word = 0;
+    off_t offset = (off_t)(pfn / 64 * sizeof(word));
+    if (pread(sampler->idle_fd, &word, sizeof(word), offset) != sizeof(word)) return true;
+    return !((word >> (pfn % 64)) & 1);
+}
+
+static void page_set_idle(diram_sampler_t* sampler, uint64_t pfn) {
+    uint64_t word = 1ULL << (pfn % 64);
+    off_t offset = (off_t)(pfn / 64 * sizeof(word));
+    if (pwrite(sampler->idle_fd, &word, sizeof(word), offset) != sizeof(word)) {
+        // Page not on the LRU; it will read as accessed next pass
+    }
+}
+
+static inline uint8_t scale(uint64_t part, uint64_t whole, uint32_t top) {
+    if (whole == 0) return 0;
+    return (uint8_t)((part * top * 2 + whole) / (whole * 2));
+}
+
+// 0 touched this pass, then one bucket per doubling of the quiet stretch
+static uint8_t age_bucket(uint64_t quiet_passes) {
+    uint8_t bucket = 0;
+    while (quiet_passes && bucket < 7) {
+        bucket++;
+        quiet_passes >>= 1;
+    }
+    return bucket;
+}
+
+// -1 when the range is no longer mapped
+static int sample_region(diram_sampler_t* sampler, sampler_region_t* r, const region_ref_t* ref,
+                         diram_region_sample_t* out) {
+    uint32_t pages = (uint32_t)((ref->end - ref->base) / sampler->page_size);
+    uint64_t pass = sampler->pass;
+    if (r->history_key != ref->key && history_reset(r, ref->key, pages, pass) != 0) return -1;
+
+    unsigned char vec[CHUNK_PAGES];
+    uint64_t entries[CHUNK_PAGES];
+    uint32_t resident = 0, accessed = 0, dirtied = 0;
+    uint32_t runs_resident = 0, runs_accessed = 0;
+    bool prev_resident = false, prev_accessed = false;
+
+    for (uint32_t first = 0; first < pages; first += CHUNK_PAGES) {
+        uint32_t n = pages - first < CHUNK_PAGES ? pages - first : CHUNK_PAGES;
+        uintptr_t addr = ref->base + (uintptr_t)first * sampler->page_size;
+
+        if ((sampler->sources & DIRAM_SAMPLE_MINCORE) &&
+            mincore((void*)addr, (size_t)n * sampler->page_size, vec) != 0) {
+            return -1;
+        }
+        if (sampler->pagemap_fd >= 0) {
+            ssize_t want = (ssize_t)(n * sizeof(uint64_t));
+            off_t offset = (off_t)(addr / sampler->page_size * sizeof(uint64_t));
+            if (pread(sampler->pagemap_fd, entries, (size_t)want, offset) != want) return -1;
+        } else {
+            memset(entries, 0, n * sizeof(uint64_t));
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t page = first + i;
+            uint64_t pm = entries[i];
+            bool present = (sampler->sources & DIRAM_SAMPLE_MINCORE) ? (vec[i] & 1) : (pm & PM_PRESENT);
+            bool dirty = (sampler->sources & DIRAM_SAMPLE_SOFT_DIRTY) && (pm & PM_PRESENT) &&
+                         (pm & PM_SOFT_DIRTY);
+            uint64_t pfn = pm & PM_PFN_MASK;
+
+            // Without idle tracking, faulting in and writing are the
+            // accesses we can see
+            bool touched;
+            if ((sampler->sources & DIRAM_SAMPLE_IDLE_PAGE) && (pm & PM_PRESENT) && pfn) {
+                touched = bit_get(r->marked, page) ? page_was_accessed(sampler, pfn) : true;
+                page_set_idle(sampler, pfn);
+                bit_put(r->marked, page, true);
+            } else {
+                touched = (present && !bit_get(r->seen, page)) || dirty;
+                bit_put(r->marked, page, false);
+            }
+            bit_put(r->seen, page, present);
+
+            resident += present;
+            dirtied += dirty;
+            accessed += touched;
+            runs_resident += present && !prev_resident;
+            runs_accessed += touched && !prev_accessed;
+            prev_resident = present;
+            prev_accessed = touched;
+        }
+    }
+
+    // Locality and spread describe the pages in use this pass: the ones
+    // touched if any were, else the resident set
+    uint32_t active = accessed ? accessed : resident;
+    uint32_t runs = accessed ? runs_accessed : runs_resident;
+
+    int32_t access_share = (int32_t)((uint64_t)accessed * EWMA_ONE / pages);
+    int32_t dirty_share = (int32_t)((uint64_t)dirtied * EWMA_ONE / pages);
+    r->access_ewma += (access_share - r->access_ewma) >> EWMA_SHIFT;
+    r->dirty_ewma += (dirty_share - r->dirty_ewma) >> EWMA_SHIFT;
+    if (accessed) r->last_access_pass = pass;
+
+    phenotype_t p = { .raw = 0 };
+    p.fields.age = age_bucket(pass - r->last_access_pass);
+    p.fields.frequency = scale((uint64_t)r->access_ewma, EWMA_ONE, 7);
+    p.fields.volatility = scale((uint64_t)r->dirty_ewma, EWMA_ONE, 3);
+    p.fields.locality = active > 1 ? scale(active - runs, active - 1, 7) : (active ? 7 : 0);
+    p.fields.clustering = scale(resident, pages, 7);
+    p.fields.spread = runs == 0 ? 0 : runs == 1 ? 1 : runs <= 8 ? 2 : 3;
+
+    out->phenomena = p;
+    out->pages = pages;
+    out->resident = resident;
+    out->accessed = accessed;
+    out->dirtied = dirtied;
+    out->pass = pass;
+    return 0;
+}
+
+void diram_sampler_sample(diram_sampler_t* sampler) {
+    if (!sampler) return;
+
+    pthread_mutex_lock(&sampler->pass_lock);
+    sampler->pass++;
+
+    region_ref_t refs[DIRAM_SAMPLER_MAX_REGIONS];
+    uint32_t count = 0;
+    pthread_mutex_lock(&sampler->lock);
+    for (uint32_t i = 0; i < sampler->high_water; i++) {
+        sampler_region_t* r = &sampler->regions[i];
+        if (r->base) refs[count++] = (region_ref_t){ i, r->key, r->base, r->end };
+    }
+    pthread_mutex_unlock(&sampler->lock);
+
+    for (uint32_t k = 0; k < count; k++) {
+        sampler_region_t* r = &sampler->regions[refs[k].slot];
+        diram_region_sample_t sample;
+        if (sample_region(sampler, r, &refs[k], &sample) != 0) continue;
+
+        // Untracked or re-tracked meanwhile: the sample belongs to nobody
+        pthread_mutex_lock(&sampler->lock);
+        if (r->key == refs[k].key) region_publish(r, r->base, r->end, r->key, &sample);
+        pthread_mutex_unlock(&sampler->lock);
+    }
+
+    // Next pass sees only writes made after this one
+    if (sampler->sources & DIRAM_SAMPLE_SOFT_DIRTY) {
+        if (pwrite(sampler->clear_refs_fd, "4", 1, 0) != 1) {
+            sampler->sources &= ~DIRAM_SAMPLE_SOFT_DIRTY;
+        }
+    }
+    pthread_mutex_unlock(&sampler->pass_lock);
+}
+
+static void* sampler_thread(void* arg) {
+    diram_sampler_t* sampler = arg;
+
+    pthread_mutex_lock(&sampler->thread_lock);
+    while (!sampler->stop) {
+        pthread_mutex_unlock(&sampler->thread_lock);
+        diram_sampler_sample(sampler);
+        pthread_mutex_lock(&sampler->thread_lock);
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t ns = (uint64_t)deadline.tv_nsec + (uint64_t)sampler->config.interval_ms * 1000000ULL;
+        deadline.tv_sec += (time_t)(ns / 1000000000ULL);
+        deadline.tv_nsec = (long)(ns % 1000000000ULL);
+        while (!sampler->stop &&
+               pthread_cond_timedwait(&sampler->wake, &sampler->thread_lock, &deadline) != ETIMEDOUT) {}
+    }
+    pthread_mutex_unlock(&sampler->thread_lock);
+    return NULL;
+}
+
+int diram_sampler_start(diram_sampler_t* sampler) {
+    if (!sampler) return -1;
+
+    int rc = -1;
+    pthread_mutex_lock(&sampler->thread_lock);
+    if (!sampler->running) {
+        sampler->stop = false;
+        if (pthread_create(&sampler->thread, NULL, sampler_thread, sampler) == 0) {
+            sampler->running = true;
+            rc = 0;
+        }
+    }
+    pthread_mutex_unlock(&sampler->thread_lock);
+    return rc;
+}
+
+void diram_sampler_stop(diram_sampler_t* sampler) {
+    if (!sampler) return;
+
+    pthread_mutex_lock(&sampler->thread_lock);
+    bool running = sampler->running;
+    sampler->stop = true;
+    sampler->running = false;
+    pthread_cond_signal(&sampler->wake);
+    pthread_mutex_unlock(&sampler->thread_lock);
+
+    if (running) pthread_join(sampler->thread, NULL);
+}
@@ -1,3 +1,585 @@
-/* Stub for src/core/parser/ast.c */
+// src/core/parser/ast.c
+// DIRAM Abstract Syntax Tree
+// OBINexus Aegis Project
+// Two encodings of the same tree. diram_ast_node_t is the classic layout:
+// one allocation per node, strings copied per node, a child pointer array.
+// diram_ast_arena_t packs a whole parse into a few growable arrays that are
+// released together, and hands out diram_ast_node_t views on demand so the
+// existing visitors work over either.
+#include "diram/core/parser/ast.h"
 #include <stdio.h>
-// TODO: Implement
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// Per-node layout
+// ============================================================================
+
+static char* copy_string(const char* text) {
+    return text ? strdup(text) : NULL;
+}
+
+diram_ast_node_t* diram_ast_create_node(diram_ast_node_type_t type) {
+    diram_ast_node_t* node = calloc(1, sizeof(diram_ast_node_t));
+    if (!node) return NULL;
+    node->type = type;
+    node->accept = diram_ast_accept;
+    return node;
+}
+
+static void free_strings(diram_ast_node_t* node) {
+    switch (node->type) {
+        case AST_NODE_ALLOCATION:
+            free((char*)node->data.allocation.tag);
+            break;
+        case AST_NODE_OPCODE:
+            free((char*)node->data.opcode.name);
+            free(node->data.opcode.operands);
+            break;
+        case AST_NODE_CONSTRAINT:
+            free((char*)node->data.constraint.name);
+            break;
+        case AST_NODE_POLICY:
+            free((char*)node->data.policy.name);
+            free((char*)node->data.policy.type);
+            for (size_t i = 0; i < node->data.policy.rule_count; i++) {
+                free(node->data.policy.rules[i]);
+            }
+            free(node->data.policy.rules);
+            break;
+        case AST_NODE_FEATURE_TOGGLE:
+            free((char*)node->data.feature.name);
+            free((char*)node->data.feature.description);
+            free((char*)node->data.feature.policy);
+            break;
+        case AST_NODE_MEMORY_REGION:
+            free((char*)node->data.memory_region.name);
+            break;
+        case AST_NODE_OPERAND:
+            free((char*)node->data.operand.name);
+            free((char*)node->data.operand.type);
+            break;
+        case AST_NODE_BUILD_TARGET:
+            free((char*)node->data.build_target.name);
+            free((char*)node->data.build_target.platform);
+            free((char*)node->data.build_target.compiler);
+            free((char*)node->data.build_target.flags);
+            break;
+        default:
+            break;
+    }
+}
+
+void diram_ast_destroy_node(diram_ast_node_t* node) {
+    if (!node) return;
+    for (size_t i = 0; i < node->child_count; i++) {
+        diram_ast_destroy_node(node->children[i]);
+    }
+    free(node->children);
+    free_strings(node);
+    free(node);
+}
+
+bool diram_ast_add_child(diram_ast_node_t* parent, diram_ast_node_t* child) {
+    if (!parent || !child) return false;
+
+    if (parent->child_count == parent->child_capacity) {
+        size_t capacity = parent->child_capacity ? parent->child_capacity * 2 : 4;
+        diram_ast_node_t** grown = realloc(parent->children, capacity * sizeof(*grown));
+        if (!grown) return false;
+        parent->children = grown;
+        parent->child_capacity = capacity;
+    }
+    parent->children[parent->child_count++] = child;
+    child->parent = parent;
+    return true;
+}
+
+bool diram_ast_remove_child(diram_ast_node_t* parent, diram_ast_node_t* child) {
+    if (!parent || !child) return false;
+
+    for (size_t i = 0; i < parent->child_count; i++) {
+        if (parent->children[i] != child) continue;
+        memmove(&parent->children[i], &parent->children[i + 1],
+                (parent->child_count - i - 1) * sizeof(diram_ast_node_t*));
+        parent->child_count--;
+        child->parent = NULL;
+        return true;
+    }
+    return false;
+}
+
+static const char* node_name(const diram_ast_node_t* node) {
+    switch (node->type) {
+        case AST_NODE_ALLOCATION:     return node->data.allocation.tag;
+        case AST_NODE_OPCODE:         return node->data.opcode.name;
+        case AST_NODE_CONSTRAINT:     return node->data.constraint.name;
+        case AST_NODE_POLICY:         return node->data.policy.name;
+        case AST_NODE_FEATURE_TOGGLE: return node->data.feature.name;
+        case AST_NODE_MEMORY_REGION:  return node->data.memory_region.name;
+        case AST_NODE_OPERAND:        return node->data.operand.name;
+        case AST_NODE_BUILD_TARGET:   return node->data.build_target.name;
+        default:                      return NULL;
+    }
+}
+
+diram_ast_node_t* diram_ast_find_child(diram_ast_node_t* parent,
+                                        diram_ast_node_type_t type,
+                                        const char* name) {
+    if (!parent) return NULL;
+
+    for (size_t i = 0; i < parent->child_count; i++) {
+        diram_ast_node_t* child = parent->children[i];
+        if (child->type != type) continue;
+        const char* child_name = node_name(child);
+        if (!name || (child_name && strcmp(child_name, name) == 0)) return child;
+    }
+    return NULL;
+}
+
+diram_ast_node_t* diram_ast_create_allocation(size_t size, const char* tag) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_ALLOCATION);
+    if (!node) return NULL;
+    node->data.allocation.size = size;
+    node->data.allocation.tag = copy_string(tag);
+    return node;
+}
+
+diram_ast_node_t* diram_ast_create_opcode(const char* name, uint8_t code) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_OPCODE);
+    if (!node) return NULL;
+    node->data.opcode.name = copy_string(name);
+    node->data.opcode.code = code;
+    return node;
+}
+
+diram_ast_node_t* diram_ast_create_constraint(const char* name, double epsilon) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_CONSTRAINT);
+    if (!node) return NULL;
+    node->data.constraint.name = copy_string(name);
+    node->data.constraint.epsilon_value = epsilon;
+    return node;
+}
+
+diram_ast_node_t* diram_ast_create_policy(const char* name, const char* type) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_POLICY);
+    if (!node) return NULL;
+    node->data.policy.name = copy_string(name);
+    node->data.policy.type = copy_string(type);
+    return node;
+}
+
+diram_ast_node_t* diram_ast_create_feature_toggle(const char* name, bool enabled) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_FEATURE_TOGGLE);
+    if (!node) return NULL;
+    node->data.feature.name = copy_string(name);
+    node->data.feature.enabled = enabled;
+    return node;
+}
+
+diram_ast_node_t* diram_ast_create_memory_region(const char* name, uint64_t base, size_t size) {
+    diram_ast_node_t* node = diram_ast_create_node(AST_NODE_MEMORY_REGION);
+    if (!node) return NULL;
+    node->data.memory_region.name = copy_string(name);
+    node->data.memory_region.base_address = base;
+    node->data.memory_region.size = size;
+    return node;
+}
+
+static void* dispatch(diram_ast_visitor_t* visitor, diram_ast_node_t* node) {
+    void* (*visit)(diram_ast_visitor_t*, diram_ast_node_t*) = NULL;
+    switch (node->type) {
+        case AST_NODE_ROOT:           visit = visitor->visit_root; break;
+        case AST_NODE_ALLOCATION:     visit = visitor->visit_allocation; break;
+        case AST_NODE_OPCODE:         visit = visitor->visit_opcode; break;
+        case AST_NODE_CONSTRAINT:     visit = visitor->visit_constraint; break;
+        case AST_NODE_POLICY:         visit = visitor->visit_policy; break;
+        case AST_NODE_FEATURE_TOGGLE: visit = visitor->visit_feature_toggle; break;
+        case AST_NODE_MEMORY_REGION:  visit = visitor->visit_memory_region; break;
+        case AST_NODE_OPERAND:        visit = visitor->visit_operand; break;
+        case AST_NODE_BUILD_TARGET:   visit = visitor->visit_build_target; break;
+    }
+    return visit ? visit(visitor, node) : NULL;
+}
+
+// Visits the node, then its subtree in pre-order
+void* diram_ast_accept(diram_ast_node_t* node, diram_ast_visitor_t* visitor) {
+    if (!node || !visitor) return NULL;
+
+    void* result = dispatch(visitor, node);
+    for (size_t i = 0; i < node->child_count; i++) {
+        diram_ast_accept(node->children[i], visitor);
+    }
+    return result;
+}
+
+static const char* const type_names[] = {
+    "root", "allocation", "opcode", "constraint", "policy",
+    "feature", "memory_region", "operand", "build_target"
+};
+
+void diram_ast_print(diram_ast_node_t* node, int depth) {
+    if (!node) return;
+    const char* name = node_name(node);
+    printf("%*s%s%s%s\n", depth * 2, "", type_names[node->type],
+           name ? " " : "", name ? name : "");
+    for (size_t i = 0; i < node->child_count; i++) {
+        diram_ast_print(node->children[i], depth + 1);
+    }
+}
+
+bool diram_ast_validate(diram_ast_node_t* node) {
+    if (!node) return false;
+    if ((unsigned)node->type > AST_NODE_BUILD_TARGET) return false;
+    if (node->type != AST_NODE_ROOT && node->type != AST_NODE_ALLOCATION && !node_name(node)) {
+        return false;
+    }
+    for (size_t i = 0; i < node->child_count; i++) {
+        if (node->children[i]->parent != node) return false;
+        if (!diram_ast_validate(node->children[i])) return false;
+    }
+    return true;
+}
+
+size_t diram_ast_count_nodes(diram_ast_node_t* root) {
+    if (!root) return 0;
+    size_t count = 1;
+    for (size_t i = 0; i < root->child_count; i++) {
+        count += diram_ast_count_nodes(root->children[i]);
+    }
+    return count;
+}
+
+// ============================================================================
+// Arena layout
+// ============================================================================
+
+#define ARENA_MIN_NODES     64
+
+// Grow *array to hold `need` elements of `size` bytes
+static bool reserve(void* array, uint32_t* capacity, uint32_t need, size_t size) {
+    if (need <= *capacity) return true;
+    uint32_t grown_capacity = *capacity ? *capacity : 16;
+    while (grown_capacity < need) grown_capacity *= 2;
+    void* grown = realloc(*(void**)array, (size_t)grown_capacity * size);
+    if (!grown) return false;
+    *(void**)array = grown;
+    *capacity = grown_capacity;
+    return true;
+}
+
+diram_ast_arena_t* diram_ast_arena_create(size_t node_hint) {
+    diram_ast_arena_t* arena = calloc(1, sizeof(diram_ast_arena_t));
+    if (!arena) return NULL;
+
+    uint32_t nodes = node_hint > ARENA_MIN_NODES ? (uint32_t)node_hint : ARENA_MIN_NODES;
+    if (!reserve(&arena->nodes, &arena->node_capacity, nodes, sizeof(diram_ast_compact_t)) ||
+        !reserve(&arena->strings, &arena->string_capacity, 1024, 1)) {
+        diram_ast_arena_destroy(arena);
+        return NULL;
+    }
+    arena->strings[0] = '\0';
+    arena->string_length = 1;
+    return arena;
+}
+
+void diram_ast_arena_destroy(diram_ast_arena_t* arena) {
+    if (!arena) return;
+    free(arena->nodes);
+    free(arena->children);
+    free(arena->lists);
+    free(arena->strings);
+    free(arena->intern);
+    free(arena->open);
+    free(arena->pending);
+    free((void*)arena->scratch);
+    free(arena);
+}
+
+void diram_ast_arena_reset(diram_ast_arena_t* arena) {
+    if (!arena) return;
+    arena->node_count = 0;
+    arena->child_count = 0;
+    arena->list_count = 0;
+    arena->string_length = 1;
+    arena->open_depth = 0;
+    arena->pending_count = 0;
+    if (arena->intern_count) {
+        memset(arena->intern, 0, (size_t)arena->intern_capacity * sizeof(uint64_t));
+        arena->intern_count = 0;
+    }
+}
+
+static uint32_t hash_string(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool intern_grow(diram_ast_arena_t* arena) {
+    uint32_t capacity = arena->intern_capacity ? arena->intern_capacity * 2 : 256;
+    uint64_t* table = calloc(capacity, sizeof(uint64_t));
+    if (!table) return false;
+
+    for (uint32_t i = 0; i < arena->intern_capacity; i++) {
+        uint64_t entry = arena->intern[i];
+        if (!entry) continue;
+        uint32_t slot = (uint32_t)(entry >> 32) & (capacity - 1);
+        while (table[slot]) slot = (slot + 1) & (capacity - 1);
+        table[slot] = entry;
+    }
+    free(arena->intern);
+    arena->intern = table;
+    arena->intern_capacity = capacity;
+    return true;
+}
+
+diram_ast_str_t diram_ast_arena_intern(diram_ast_arena_t* arena, const char* text, size_t length) {
+    if (!arena || !text || length == 0) return 0;
+
+    if ((arena->intern_count + 1) * 4 > arena->intern_capacity * 3 && !intern_grow(arena)) {
+        return 0;
+    }
+
+    uint32_t hash = hash_string(text, length);
+    uint32_t mask = arena->intern_capacity - 1;
+    uint32_t slot = hash & mask;
+    for (uint64_t entry; (entry = arena->intern[slot]) != 0; slot = (slot + 1) & mask) {
+        if ((uint32_t)(entry >> 32) != hash) continue;
+        const char* existing = arena->strings + (uint32_t)entry;
+        if (memcmp(existing, text, length) == 0 && existing[length] == '\0') {
+            return (uint32_t)entry;
+        }
+    }
+
+    uint32_t offset = arena->string_length;
+    if (length >= UINT32_MAX - offset ||
+        !reserve(&arena->strings, &arena->string_capacity, offset + (uint32_t)length + 1, 1)) {
+        return 0;
+    }
+    memcpy(arena->strings + offset, text, length);
+    arena->strings[offset + length] = '\0';
+    arena->string_length = offset + (uint32_t)length + 1;
+    arena->intern[slot] = (uint64_t)hash << 32 | offset;
+    arena->intern_count++;
+    return offset;
+}
+
+const char* diram_ast_arena_string(const diram_ast_arena_t* arena, diram_ast_str_t str) {
+    if (!arena || str >= arena->string_length) return "";
+    return arena->strings + str;
+}
+
+diram_ast_mark_t diram_ast_arena_mark(const diram_ast_arena_t* arena) {
+    if (!arena) return (diram_ast_mark_t){ 0, 0, 0, 1, 0 };
+    return (diram_ast_mark_t){
+        arena->node_count, arena->child_count, arena->list_count,
+        arena->string_length, arena->pending_count
+    };
+}
+
+void diram_ast_arena_rewind(diram_ast_arena_t* arena, diram_ast_mark_t mark) {
+    if (!arena || mark.nodes > arena->node_count) return;
+
+    arena->node_count = mark.nodes;
+    arena->child_count = mark.children;
+    arena->list_count = mark.lists;
+    arena->pending_count = mark.pending;
+    if (mark.strings >= arena->string_length) return;
+
+    // Re-intern the strings that survive; they are packed back to back
+    uint32_t kept = mark.strings;
+    arena->string_length = 1;
+    if (arena->intern_count) {
+        memset(arena->intern, 0, (size_t)arena->intern_capacity * sizeof(uint64_t));
+        arena->intern_count = 0;
+    }
+    while (arena->string_length < kept) {
+        const char* text = arena->strings + arena->string_length;
+        size_t length = strlen(text);
+        uint32_t hash = hash_string(text, length);
+        uint32_t slot = hash & (arena->intern_capacity - 1);
+        while (arena->intern[slot]) slot = (slot + 1) & (arena->intern_capacity - 1);
+        arena->intern[slot] = (uint64_t)hash << 32 | arena->string_length;
+        arena->intern_count++;
+        arena->string_length += (uint32_t)length + 1;
+    }
+}
+
+diram_ast_ref_t diram_ast_arena_open(diram_ast_arena_t* arena, diram_ast_node_type_t type) {
+    if (!arena) return DIRAM_AST_NONE;
+    // Only one root: everything else is opened inside it
+    if (arena->open_depth == 0 && arena->node_count > 0) return DIRAM_AST_NONE;
+
+    uint32_t ref = arena->node_count;
+    if (!reserve(&arena->nodes, &arena->node_capacity, ref + 1, sizeof(diram_ast_compact_t)) ||
+        !reserve(&arena->open, &arena->open_capacity, arena->open_depth + 1, sizeof(diram_ast_open_t)) ||
+        !reserve(&arena->pending, &arena->pending_capacity, arena->pending_count + 1, sizeof(diram_ast_ref_t))) {
+        return DIRAM_AST_NONE;
+    }
+
+    diram_ast_compact_t* node = &arena->nodes[ref];
+    memset(node, 0, sizeof(*node));
+    node->type = (uint8_t)type;
+    node->parent = DIRAM_AST_NONE;
+    if (arena->open_depth > 0) {
+        node->parent = arena->open[arena->open_depth - 1].node;
+        arena->pending[arena->pending_count++] = ref;
+    }
+    arena->open[arena->open_depth++] = (diram_ast_open_t){ ref, arena->pending_count };
+    arena->node_count++;
+    return ref;
+}
+
+bool diram_ast_arena_close(diram_ast_arena_t* arena) {
+    if (!arena || arena->open_depth == 0) return false;
+
+    diram_ast_open_t open = arena->open[arena->open_depth - 1];
+    uint32_t count = arena->pending_count - open.pending_base;
+    if (!reserve(&arena->children, &arena->child_capacity, arena->child_count + count,
+                 sizeof(diram_ast_ref_t))) {
+        return false;
+    }
+
+    diram_ast_compact_t* node = &arena->nodes[open.node];
+    node->first_child = arena->child_count;
+    node->child_count = count;
+    if (count) {
+        memcpy(arena->children + arena->child_count, arena->pending + open.pending_base,
+               count * sizeof(diram_ast_ref_t));
+    }
+    arena->child_count += count;
+    arena->pending_count = open.pending_base;
+    arena->open_depth--;
+    return true;
+}
+
+// A policy's rules must be added together, before the next policy's
+bool diram_ast_arena_add_rule(diram_ast_arena_t* arena, diram_ast_ref_t policy, diram_ast_str_t rule) {
+    diram_ast_compact_t* node = diram_ast_arena_node(arena, policy);
+    if (!node || node->type != AST_NODE_POLICY) return false;
+    if (node->extent == 0) node->value = arena->list_count;
+    if (node->value + node->extent != arena->list_count) return false;
+    if (!reserve(&arena->lists, &arena->list_capacity, arena->list_count + 1, sizeof(diram_ast_str_t))) {
+        return false;
+    }
+    arena->lists[arena->list_count++] = rule;
+    node->extent++;
+    return true;
+}
+
+diram_ast_compact_t* diram_ast_arena_node(const diram_ast_arena_t* arena, diram_ast_ref_t ref) {
+    if (!arena || ref >= arena->node_count) return NULL;
+    return &arena->nodes[ref];
+}
+
+const diram_ast_ref_t* diram_ast_arena_children(const diram_ast_arena_t* arena,
+                                                diram_ast_ref_t ref, uint32_t* count) {
+    const diram_ast_compact_t* node = diram_ast_arena_node(arena, ref);
+    if (count) *count = node ? node->child_count : 0;
+    return node ? arena->children + node->first_child : NULL;
+}
+
+// Expand a compact node into the classic layout for a visitor
+static bool arena_view(diram_ast_arena_t* arena, const diram_ast_compact_t* node,
+                       diram_ast_node_t* view) {
+    memset(view, 0, sizeof(*view));
+    view->type = (diram_ast_node_type_t)node->type;
+    view->child_count = node->child_count;
+    view->accept = diram_ast_accept;
+
+    const char* name = diram_ast_arena_string(arena, node->name);
+    const char* text = diram_ast_arena_string(arena, node->text);
+    const char* extra = diram_ast_arena_string(arena, node->extra);
+    const char* aux = diram_ast_arena_string(arena, node->aux);
+    switch (view->type) {
+        case AST_NODE_ALLOCATION:
+            view->data.allocation.size = (size_t)node->value;
+            view->data.allocation.tag = text;
+            view->data.allocation.address = node->extent;
+            snprintf(view->data.allocation.sha256_receipt,
+                     sizeof(view->data.allocation.sha256_receipt), "%s", aux);
+            break;
+        case AST_NODE_OPCODE:
+            view->data.opcode.name = name;
+            view->data.opcode.code = (uint8_t)node->code;
+            break;
+        case AST_NODE_CONSTRAINT:
+            view->data.constraint.name = name;
+            memcpy(&view->data.constraint.epsilon_value, &node->value, sizeof(double));
+            view->data.constraint.max_heap_events = (uint32_t)node->extent;
+            break;
+        case AST_NODE_POLICY:
+            if (!reserve(&arena->scratch, &arena->scratch_capacity, (uint32_t)node->extent,
+                         sizeof(const char*))) {
+                return false;
+            }
+            for (uint64_t i = 0; i < node->extent; i++) {
+                arena->scratch[i] = diram_ast_arena_string(arena, arena->lists[node->value + i]);
+            }
+            view->data.policy.name = name;
+            view->data.policy.type = text;
+            view->data.policy.enforced = node->flags & DIRAM_AST_ENABLED;
+            view->data.policy.rules = (char**)arena->scratch;
+            view->data.policy.rule_count = (size_t)node->extent;
+            break;
+        case AST_NODE_FEATURE_TOGGLE:
+            view->data.feature.name = name;
+            view->data.feature.enabled = node->flags & DIRAM_AST_ENABLED;
+            view->data.feature.description = text;
+            view->data.feature.policy = extra;
+            break;
+        case AST_NODE_MEMORY_REGION:
+            view->data.memory_region.name = name;
+            view->data.memory_region.base_address = node->value;
+            view->data.memory_region.size = (size_t)node->extent;
+            view->data.memory_region.protection_flags = node->flags & DIRAM_AST_PROTECTION;
+            break;
+        case AST_NODE_OPERAND:
+            view->data.operand.name = name;
+            view->data.operand.type = text;
+            view->data.operand.position = node->code;
+            view->data.operand.value.integer_value = node->value;
+            break;
+        case AST_NODE_BUILD_TARGET:
+            view->data.build_target.name = name;
+            view->data.build_target.platform = text;
+            view->data.build_target.compiler = extra;
+            view->data.build_target.flags = aux;
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+void* diram_ast_arena_accept(diram_ast_arena_t* arena, diram_ast_ref_t ref,
+                             diram_ast_visitor_t* visitor) {
+    const diram_ast_compact_t* node = diram_ast_arena_node(arena, ref);
+    if (!node || !visitor) return NULL;
+
+    diram_ast_node_t view;
+    if (!arena_view(arena, node, &view)) return NULL;
+    void* result = dispatch(visitor, &view);
+
+    uint32_t first = node->first_child, count = node->child_count;
+    for (uint32_t i = 0; i < count; i++) {
+        diram_ast_arena_accept(arena, arena->children[first + i], visitor);
+    }
+    return result;
+}
+
+size_t diram_ast_arena_bytes(const diram_ast_arena_t* arena) {
+    if (!arena) return 0;
+    return sizeof(*arena) +
+           (size_t)arena->node_capacity * sizeof(diram_ast_compact_t) +
+           (size_t)arena->child_capacity * sizeof(diram_ast_ref_t) +
+           (size_t)arena->list_capacity * sizeof(diram_ast_str_t) +
+           arena->string_capacity +
+           (size_t)arena->intern_capacity * sizeof(uint64_t) +
+           (size_t)arena->open_capacity * sizeof(diram_ast_open_t) +
+           (size_t)arena->pending_capacity * sizeof(diram_ast_ref_t) +
+           (size_t)arena->scratch_capacity * sizeof(const char*);
+}
@@ -1,3 +1,665 @@
-/* Stub for src/core/parser/parser.c */
+// src/core/parser/parser.c
+// DIRAM Single-Pass Parser State Machine
+// OBINexus Aegis Project
+// Each token is consumed once, in order: a start tag opens an arena node
+// (or a section / field / container frame), attributes and text fill the
+// innermost node, and an end tag closes it. Nothing is ever re-read, so
+// parsing is O(n) in the input. With emit_ast_immediately and a visitor,
+// every finished section item is visited and the arena rewound to just
+// the root, so memory stays bounded by the largest single item.
+#include "diram/core/parser/parser.h"
 #include <stdio.h>
-// TODO: Implement
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <ctype.h>
+
+// Manifest vocabulary (diram.drc.in.xml)
+enum {
+    EL_UNKNOWN = 0,
+    EL_CONFIG, EL_METADATA, EL_FEATURES, EL_OPCODES, EL_POLICIES,
+    EL_MEMORY_REGIONS, EL_BUILD,
+    EL_TOGGLE, EL_OPCODE, EL_POLICY, EL_REGION, EL_TARGETS, EL_TARGET,
+    EL_DESCRIPTION, EL_CONSTRAINT, EL_OPERANDS, EL_OPERAND, EL_CONSTRAINTS,
+    EL_HEAP_EVENTS, EL_RULE, EL_COMPILER, EL_FLAGS,
+    EL_TEXT                                     // known, text is not kept
+};
+
+static const struct {
+    const char* name;
+    uint16_t id;
+} elements[] = {
+    { "diram-config", EL_CONFIG }, { "metadata", EL_METADATA },
+    { "features", EL_FEATURES }, { "opcodes", EL_OPCODES },
+    { "policies", EL_POLICIES }, { "memory_regions", EL_MEMORY_REGIONS },
+    { "build", EL_BUILD }, { "toggle", EL_TOGGLE }, { "opcode", EL_OPCODE },
+    { "policy", EL_POLICY }, { "region", EL_REGION }, { "targets", EL_TARGETS },
+    { "target", EL_TARGET }, { "description", EL_DESCRIPTION },
+    { "constraint", EL_CONSTRAINT }, { "operands", EL_OPERANDS },
+    { "operand", EL_OPERAND }, { "constraints", EL_CONSTRAINTS },
+    { "heap_events", EL_HEAP_EVENTS }, { "rule", EL_RULE },
+    { "compiler", EL_COMPILER }, { "flags", EL_FLAGS },
+    { "project", EL_TEXT }, { "author", EL_TEXT }, { "created", EL_TEXT },
+    { "governance", EL_TEXT }, { "algorithm", EL_TEXT }, { "log_path", EL_TEXT },
+    { "default_space", EL_TEXT }, { "alignment", EL_TEXT }, { "output", EL_TEXT },
+    { "output_dir", EL_TEXT },
+};
+
+enum {
+    AT_UNKNOWN = 0,
+    AT_NAME, AT_ENABLED, AT_CODE, AT_TYPE, AT_POSITION, AT_MAX, AT_BASE,
+    AT_SIZE, AT_PROTECTION, AT_PLATFORM, AT_IGNORED
+};
+
+static const struct {
+    const char* name;
+    uint32_t id;
+} attributes[] = {
+    { "name", AT_NAME }, { "enabled", AT_ENABLED }, { "code", AT_CODE },
+    { "type", AT_TYPE }, { "position", AT_POSITION }, { "max", AT_MAX },
+    { "base", AT_BASE }, { "size", AT_SIZE }, { "protection", AT_PROTECTION },
+    { "platform", AT_PLATFORM }, { "version", AT_IGNORED }, { "xmlns", AT_IGNORED },
+};
+
+#define LOOKUP(table, text, length)                                             \
+    do {                                                                        \
+        for (size_t i_ = 0; i_ < sizeof(table) / sizeof(table[0]); i_++) {     \
+            if (table[i_].name[0] == text[0] &&                                 \
+                strncmp(table[i_].name, text, length) == 0 &&                   \
+                table[i_].name[length] == '\0') {                               \
+                return table[i_].id;                                            \
+            }                                                                   \
+        }                                                                       \
+    } while (0)
+
+static uint16_t element_id(const char* text, size_t length) {
+    LOOKUP(elements, text, length);
+    return EL_UNKNOWN;
+}
+
+static uint32_t attribute_id(const char* text, size_t length) {
+    LOOKUP(attributes, text, length);
+    return AT_UNKNOWN;
+}
+
+static uint32_t name_hash(const char* text, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static const char* const state_names[] = {
+    "init", "document", "metadata", "features", "opcodes", "policies",
+    "memory_regions", "build", "error", "complete"
+};
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+diram_parser_t* diram_parser_create_from_tokenizer(diram_tokenizer_t* tokenizer) {
+    if (!tokenizer) return NULL;
+
+    diram_parser_t* parser = calloc(1, sizeof(diram_parser_t));
+    if (!parser) {
+        diram_tokenizer_destroy(tokenizer);
+        return NULL;
+    }
+    parser->arena = diram_ast_arena_create(0);
+    if (!parser->arena) {
+        diram_tokenizer_destroy(tokenizer);
+        free(parser);
+        return NULL;
+    }
+    parser->tokenizer = tokenizer;
+    parser->state = PARSER_STATE_INIT;
+    parser->root = DIRAM_AST_NONE;
+    parser->current_node = DIRAM_AST_NONE;
+    parser->validate_policies = true;
+    return parser;
+}
+
+diram_parser_t* diram_parser_create(const char* xml_input, size_t length) {
+    return diram_parser_create_from_tokenizer(diram_tokenizer_create(xml_input, length));
+}
+
+diram_parser_t* diram_parser_open(const char* path) {
+    return diram_parser_create_from_tokenizer(diram_tokenizer_open(path));
+}
+
+void diram_parser_destroy(diram_parser_t* parser) {
+    if (!parser) return;
+    diram_tokenizer_destroy(parser->tokenizer);
+    diram_ast_arena_destroy(parser->arena);
+    free(parser);
+}
+
+void diram_parser_set_visitor(diram_parser_t* parser, diram_ast_visitor_t* visitor) {
+    if (parser) parser->visitor = visitor;
+}
+
+// ============================================================================
+// Errors and policy
+// ============================================================================
+
+static bool fail(diram_parser_t* parser, const diram_token_t* token, const char* format, ...) {
+    if (parser->has_error) return false;
+
+    // Without a token the message is expected to carry its own position
+    int n = 0;
+    if (token) {
+        parser->error_line = token->line;
+        parser->error_column = token->column;
+        n = snprintf(parser->error_message, sizeof(parser->error_message), "%u:%u: ",
+                     token->line, token->column);
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(parser->error_message + n, sizeof(parser->error_message) - (size_t)n, format, args);
+    va_end(args);
+    parser->has_error = true;
+    parser->state = PARSER_STATE_ERROR;
+    return false;
+}
+
+void diram_parser_set_policy_handler(diram_parser_t* parser,
+                                     void (*handler)(const char*)) {
+    if (parser) parser->policy_violation_handler = handler;
+}
+
+// Reported to the handler; fatal only in strict mode
+void diram_parser_policy_violation(diram_parser_t* parser, const char* violation) {
+    if (!parser || !violation) return;
+    if (parser->policy_violation_handler) parser->policy_violation_handler(violation);
+    if (parser->strict_mode) fail(parser, NULL, "policy violation: %s", violation);
+}
+
+static void violation(diram_parser_t* parser, const diram_token_t* token, const char* format, ...) {
+    char message[256];
+    int n = snprintf(message, sizeof(message), "%u:%u: ", token->line, token->column);
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message + n, sizeof(message) - (size_t)n, format, args);
+    va_end(args);
+    diram_parser_policy_violation(parser, message);
+}
+
+bool diram_parser_has_error(const diram_parser_t* parser) {
+    return parser ? parser->has_error : true;
+}
+
+const char* diram_parser_get_error(const diram_parser_t* parser) {
+    if (!parser) return "no parser";
+    return parser->has_error ? parser->error_message : NULL;
+}
+
+bool diram_parser_validate_constraint(const char* constraint) {
+    if (!constraint) return false;
+    const char* eq = strchr(constraint, '=');
+    if (!eq || eq == constraint) return false;
+    for (const char* c = constraint; c < eq; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '_') return false;
+    }
+    char* end;
+    strtod(eq + 1, &end);
+    return end != eq + 1 && *end == '\0';
+}
+
+// 0x00 and 0xFF are reserved
+bool diram_parser_validate_opcode(uint8_t code) {
+    return code != 0x00 && code != 0xFF;
+}
+
+bool diram_parser_validate_memory_protection(const char* protection) {
+    if (!protection || !*protection) return false;
+    unsigned seen = 0;
+    for (const char* c = protection; *c; c++) {
+        unsigned bit = *c == 'r' ? 4 : *c == 'w' ? 2 : *c == 'x' ? 1 : 0;
+        if (!bit || (seen & bit)) return false;
+        seen |= bit;
+    }
+    return true;
+}
+
+// ============================================================================
+// State machine
+// ============================================================================
+
+static bool is_section(diram_parser_state_t state) {
+    return state >= PARSER_STATE_METADATA && state <= PARSER_STATE_BUILD;
+}
+
+bool diram_parser_transition(diram_parser_t* parser, diram_parser_state_t new_state) {
+    if (!parser) return false;
+
+    diram_parser_state_t from = parser->state;
+    bool allowed = new_state == PARSER_STATE_ERROR ||
+        (from == PARSER_STATE_INIT && new_state == PARSER_STATE_DOCUMENT) ||
+        (from == PARSER_STATE_DOCUMENT && (is_section(new_state) || new_state == PARSER_STATE_COMPLETE)) ||
+        (is_section(from) && new_state == PARSER_STATE_DOCUMENT);
+    if (!allowed) {
+        return fail(parser, NULL, "invalid transition %s -> %s", state_names[from], state_names[new_state]);
+    }
+    parser->state = new_state;
+    return true;
+}
+
+static diram_parser_state_t section_state(uint16_t element) {
+    switch (element) {
+        case EL_METADATA:       return PARSER_STATE_METADATA;
+        case EL_FEATURES:       return PARSER_STATE_FEATURES;
+        case EL_OPCODES:        return PARSER_STATE_OPCODES;
+        case EL_POLICIES:       return PARSER_STATE_POLICIES;
+        case EL_MEMORY_REGIONS: return PARSER_STATE_MEMORY_REGIONS;
+        case EL_BUILD:          return PARSER_STATE_BUILD;
+        default:                return PARSER_STATE_ERROR;
+    }
+}
+
+static diram_ast_compact_t* current(diram_parser_t* parser) {
+    return diram_ast_arena_node(parser->arena, parser->current_node);
+}
+
+static diram_ast_str_t intern(diram_parser_t* parser, const char* text, size_t length) {
+    return diram_ast_arena_intern(parser->arena, text, length);
+}
+
+static bool streaming(const diram_parser_t* parser) {
+    return parser->emit_ast_immediately && parser->visitor;
+}
+
+// Hand a finished item to the visitor and drop it, keeping only the root
+static void emit_item(diram_parser_t* parser, diram_ast_ref_t item) {
+    if (!parser->root_emitted) {
+        diram_ast_arena_accept(parser->arena, parser->root, parser->visitor);
+        parser->root_emitted = true;
+        parser->nodes_emitted++;
+    }
+    diram_ast_arena_accept(parser->arena, item, parser->visitor);
+    parser->nodes_emitted += parser->arena->node_count - item;
+    diram_ast_arena_rewind(parser->arena, parser->stream_mark);
+}
+
+static diram_ast_ref_t open_node(diram_parser_t* parser, diram_ast_node_type_t type,
+                                 const diram_token_t* token) {
+    diram_ast_ref_t ref = diram_ast_arena_open(parser->arena, type);
+    if (ref == DIRAM_AST_NONE) {
+        fail(parser, token, "out of memory");
+        return DIRAM_AST_NONE;
+    }
+    parser->current_node = ref;
+    return ref;
+}
+
+static bool close_node(diram_parser_t* parser, diram_ast_ref_t ref) {
+    if (!diram_ast_arena_close(parser->arena)) return fail(parser, NULL, "out of memory");
+    diram_ast_compact_t* node = diram_ast_arena_node(parser->arena, ref);
+    parser->current_node = node->parent;
+    if (streaming(parser) && node->parent == parser->root) emit_item(parser, ref);
+    return true;
+}
+
+// Number with an optional 0x prefix and K/M/G[B] suffix
+static bool parse_number(const char* text, size_t length, uint64_t* out) {
+    char buffer[64];
+    if (length == 0 || length >= sizeof(buffer)) return false;
+    memcpy(buffer, text, length);
+    buffer[length] = '\0';
+
+    char* end;
+    uint64_t value = strtoull(buffer, &end, 0);
+    if (end == buffer) return false;
+    unsigned shift = 0;
+    switch (*end) {
+        case 'K': case 'k': shift = 10; end++; break;
+        case 'M': case 'm': shift = 20; end++; break;
+        case 'G': case 'g': shift = 30; end++; break;
+    }
+    if (shift && (*end == 'B' || *end == 'b')) end++;
+    if (*end != '\0') return false;
+    *out = value << shift;
+    return true;
+}
+
+static uint8_t parse_protection(const char* text, size_t length) {
+    uint8_t flags = 0;
+    for (size_t i = 0; i < length; i++) {
+        flags |= text[i] == 'r' ? 4 : text[i] == 'w' ? 2 : text[i] == 'x' ? 1 : 0;
+    }
+    return flags;
+}
+
+static bool start_element(diram_parser_t* parser, const diram_token_t* token,
+                          const char* text, size_t length) {
+    if (parser->state == PARSER_STATE_COMPLETE) {
+        return fail(parser, token, "content after the root element");
+    }
+    if (parser->depth == DIRAM_PARSER_MAX_DEPTH) {
+        return fail(parser, token, "elements nested deeper than %d", DIRAM_PARSER_MAX_DEPTH);
+    }
+
+    uint16_t element = element_id(text, length);
+    diram_parser_frame_t* parent = parser->depth ? &parser->frames[parser->depth - 1] : NULL;
+    diram_parser_frame_t frame = {
+        .name_hash = name_hash(text, length),
+        .name_length = (uint16_t)(length > UINT16_MAX ? UINT16_MAX : length),
+        .element = element,
+        .node = DIRAM_AST_NONE,
+        .field = PARSER_FIELD_NONE,
+        .resume = parser->state,
+    };
+
+    if (!parent) {
+        if (element != EL_CONFIG) return fail(parser, token, "expected <diram-config>");
+        if (!diram_parser_transition(parser, PARSER_STATE_DOCUMENT)) return false;
+        frame.node = parser->root = open_node(parser, AST_NODE_ROOT, token);
+        parser->stream_mark = diram_ast_arena_mark(parser->arena);
+    } else if (parent->field == PARSER_FIELD_SKIP) {
+        frame.field = PARSER_FIELD_SKIP;
+    } else if (parser->state == PARSER_STATE_DOCUMENT) {
+        diram_parser_state_t section = section_state(element);
+        if (section != PARSER_STATE_ERROR) {
+            if (!diram_parser_transition(parser, section)) return false;
+        } else {
+            frame.field = PARSER_FIELD_SKIP;
+        }
+    } else {
+        diram_ast_compact_t* node = diram_ast_arena_node(parser->arena, parent->node);
+        uint8_t owner = node ? node->type : AST_NODE_ROOT;
+        uint16_t container = parent->element;
+        diram_ast_node_type_t opens = AST_NODE_ROOT;        // none
+
+        switch (parser->state) {
+        case PARSER_STATE_FEATURES:
+            if (!node && element == EL_TOGGLE) opens = AST_NODE_FEATURE_TOGGLE;
+            else if (owner == AST_NODE_FEATURE_TOGGLE && element == EL_DESCRIPTION) frame.field = PARSER_FIELD_DESCRIPTION;
+            else if (owner == AST_NODE_FEATURE_TOGGLE && element == EL_POLICY) frame.field = PARSER_FIELD_POLICY;
+            else if (owner == AST_NODE_FEATURE_TOGGLE && element == EL_CONSTRAINT) frame.field = PARSER_FIELD_CONSTRAINT;
+            else if (owner == AST_NODE_FEATURE_TOGGLE && element == EL_TEXT) break;
+            else frame.field = PARSER_FIELD_SKIP;
+            break;
+        case PARSER_STATE_OPCODES:
+            if (!node && container == EL_OPCODES && element == EL_OPCODE) opens = AST_NODE_OPCODE;
+            else if (container == EL_OPERANDS && element == EL_OPERAND) opens = AST_NODE_OPERAND;
+            else if (container == EL_CONSTRAINTS && element == EL_HEAP_EVENTS) opens = AST_NODE_CONSTRAINT;
+            else if (owner == AST_NODE_OPCODE && container == EL_OPCODE &&
+                     (element == EL_OPERANDS || element == EL_CONSTRAINTS || element == EL_POLICY)) break;
+            else if (element == EL_TEXT) break;
+            else frame.field = PARSER_FIELD_SKIP;
+            break;
+        case PARSER_STATE_POLICIES:
+            if (!node && element == EL_POLICY) opens = AST_NODE_POLICY;
+            else if (owner == AST_NODE_POLICY && element == EL_RULE) frame.field = PARSER_FIELD_RULE;
+            else frame.field = PARSER_FIELD_SKIP;
+            break;
+        case PARSER_STATE_MEMORY_REGIONS:
+            if (!node && element == EL_REGION) opens = AST_NODE_MEMORY_REGION;
+            else frame.field = PARSER_FIELD_SKIP;
+            break;
+        case PARSER_STATE_BUILD:
+            if (container == EL_TARGETS && element == EL_TARGET) opens = AST_NODE_BUILD_TARGET;
+            else if (!node && (element == EL_TARGETS || element == EL_TEXT)) break;
+            else if (owner == AST_NODE_BUILD_TARGET && element == EL_COMPILER) frame.field = PARSER_FIELD_COMPILER;
+            else if (owner == AST_NODE_BUILD_TARGET && element == EL_FLAGS) frame.field = PARSER_FIELD_FLAGS;
+            else frame.field = PARSER_FIELD_SKIP;
+            break;
+        case PARSER_STATE_METADATA:
+            if (!node && element == EL_TEXT) break;
+            frame.field = PARSER_FIELD_SKIP;
+            break;
+        default:
+            frame.field = PARSER_FIELD_SKIP;
+            break;
+        }
+
+        if (opens != AST_NODE_ROOT) {
+            frame.node = open_node(parser, opens, token);
+            if (opens == AST_NODE_CONSTRAINT) current(parser)->name = intern(parser, text, length);
+        }
+    }
+
+    if (frame.field == PARSER_FIELD_SKIP && (!parent || parent->field != PARSER_FIELD_SKIP)) {
+        if (parser->strict_mode) {
+            return fail(parser, token, "unexpected <%.*s> in %s", (int)length, text,
+                        state_names[parser->state]);
+        }
+    }
+    if (parser->has_error) return false;
+    parser->frames[parser->depth++] = frame;
+    return true;
+}
+
+static bool end_element(diram_parser_t* parser, const diram_token_t* token,
+                        const char* text, size_t length) {
+    if (parser->depth == 0) return fail(parser, token, "unmatched </%.*s>", (int)length, text);
+
+    // A self-closing tag ends with an empty name
+    diram_parser_frame_t* frame = &parser->frames[parser->depth - 1];
+    if (length != 0 && (frame->name_length != (length > UINT16_MAX ? UINT16_MAX : length) ||
+                        frame->name_hash != name_hash(text, length))) {
+        return fail(parser, token, "</%.*s> does not close the open element", (int)length, text);
+    }
+    parser->depth--;
+
+    if (frame->node != DIRAM_AST_NONE && !close_node(parser, frame->node)) return false;
+    if (parser->depth == 0) {
+        if (streaming(parser) && !parser->root_emitted) {
+            diram_ast_arena_accept(parser->arena, parser->root, parser->visitor);
+            parser->root_emitted = true;
+            parser->nodes_emitted++;
+        }
+        return diram_parser_transition(parser, PARSER_STATE_COMPLETE);
+    }
+    if (parser->depth == 1 && is_section(parser->state)) {
+        return diram_parser_transition(parser, PARSER_STATE_DOCUMENT);
+    }
+    return true;
+}
+
+static bool attribute_value(diram_parser_t* parser, const diram_token_t* token,
+                            const char* text, size_t length) {
+    diram_parser_frame_t* frame = &parser->frames[parser->depth - 1];
+    if (frame->node == DIRAM_AST_NONE) return true;
+
+    diram_ast_compact_t* node = current(parser);
+    uint64_t number = 0;
+    bool numeric = parser->attribute == AT_CODE || parser->attribute == AT_POSITION ||
+                   parser->attribute == AT_MAX || parser->attribute == AT_BASE ||
+                   parser->attribute == AT_SIZE;
+    if (numeric && !parse_number(text, length, &number)) {
+        return fail(parser, token, "expected a number, got '%.*s'", (int)length, text);
+    }
+
+    switch (parser->attribute) {
+    case AT_NAME:
+        node->name = intern(parser, text, length);
+        break;
+    case AT_ENABLED:
+        if (length == 4 && memcmp(text, "true", 4) == 0) node->flags |= DIRAM_AST_ENABLED;
+        else if (!(length == 5 && memcmp(text, "false", 5) == 0)) {
+            return fail(parser, token, "expected true or false, got '%.*s'", (int)length, text);
+        }
+        break;
+    case AT_CODE:
+        if (number > UINT8_MAX) return fail(parser, token, "opcode 0x%llx out of range", (unsigned long long)number);
+        node->code = (uint16_t)number;
+        if (parser->validate_policies && !diram_parser_validate_opcode((uint8_t)number)) {
+            violation(parser, token, "reserved opcode 0x%02x", (unsigned)number);
+        }
+        break;
+    case AT_TYPE:
+    case AT_PLATFORM:
+        node->text = intern(parser, text, length);
+        break;
+    case AT_POSITION:
+        node->code = (uint16_t)number;
+        break;
+    case AT_MAX:
+    case AT_SIZE:
+        node->extent = number;
+        break;
+    case AT_BASE:
+        node->value = number;
+        break;
+    case AT_PROTECTION: {
+        uint8_t flags = parse_protection(text, length);
+        node->flags = (uint8_t)((node->flags & ~DIRAM_AST_PROTECTION) | flags);
+        if (parser->validate_policies) {
+            char buffer[8];
+            bool valid = length < sizeof(buffer);
+            if (valid) {
+                memcpy(buffer, text, length);
+                buffer[length] = '\0';
+                valid = diram_parser_validate_memory_protection(buffer);
+            }
+            if (!valid) violation(parser, token, "invalid protection '%.*s'", (int)length, text);
+        }
+        break;
+    }
+    case AT_UNKNOWN:
+        if (parser->strict_mode) return fail(parser, token, "unknown attribute");
+        break;
+    default:
+        break;
+    }
+    return !parser->has_error;
+}
+
+static bool text_content(diram_parser_t* parser, const diram_token_t* token,
+                         const char* text, size_t length) {
+    if (parser->depth == 0) return fail(parser, token, "text outside the root element");
+
+    diram_parser_frame_t* frame = &parser->frames[parser->depth - 1];
+    diram_ast_compact_t* node = current(parser);
+    switch (frame->field) {
+    case PARSER_FIELD_DESCRIPTION:
+        node->text = intern(parser, text, length);
+        break;
+    case PARSER_FIELD_POLICY:
+    case PARSER_FIELD_COMPILER:
+        node->extra = intern(parser, text, length);
+        break;
+    case PARSER_FIELD_FLAGS:
+        node->aux = intern(parser, text, length);
+        break;
+    case PARSER_FIELD_RULE:
+        if (!diram_ast_arena_add_rule(parser->arena, parser->current_node, intern(parser, text, length))) {
+            return fail(parser, token, "out of memory");
+        }
+        break;
+    case PARSER_FIELD_CONSTRAINT: {
+        // epsilon_limit=0.6 becomes a constraint node under the toggle
+        char buffer[128];
+        if (length >= sizeof(buffer)) return fail(parser, token, "constraint too long");
+        memcpy(buffer, text, length);
+        buffer[length] = '\0';
+        if (parser->validate_policies && !diram_parser_validate_constraint(buffer)) {
+            violation(parser, token, "malformed constraint '%s'", buffer);
+            break;
+        }
+        const char* eq = memchr(text, '=', length);
+        if (!eq) break;
+        diram_ast_ref_t ref = open_node(parser, AST_NODE_CONSTRAINT, token);
+        if (ref == DIRAM_AST_NONE) return false;
+        double epsilon = strtod(buffer + (eq - text) + 1, NULL);
+        diram_ast_compact_t* constraint = current(parser);
+        constraint->name = intern(parser, text, (size_t)(eq - text));
+        memcpy(&constraint->value, &epsilon, sizeof(double));
+        return close_node(parser, ref);
+    }
+    default:
+        break;
+    }
+    return !parser->has_error;
+}
+
+bool diram_parser_consume_token(diram_parser_t* parser, diram_token_t* token) {
+    if (!parser || !token || parser->has_error) return false;
+
+    const char* text = diram_tokenizer_text(parser->tokenizer, token);
+    size_t length = token->value.text.length;
+    switch (token->type) {
+    case TOKEN_XML_START:
+        if (parser->state != PARSER_STATE_INIT) return fail(parser, token, "misplaced XML declaration");
+        return true;
+    case TOKEN_ELEMENT_START:
+        return start_element(parser, token, text, length);
+    case TOKEN_ELEMENT_END:
+        return end_element(parser, token, text, length);
+    case TOKEN_ATTRIBUTE_NAME:
+        parser->attribute = attribute_id(text, length);
+        return true;
+    case TOKEN_ATTRIBUTE_VALUE:
+        return attribute_value(parser, token, text, length);
+    case TOKEN_TEXT:
+        return text_content(parser, token, text, length);
+    case TOKEN_EOF:
+        if (parser->state != PARSER_STATE_COMPLETE) return fail(parser, token, "unexpected end of input");
+        return true;
+    case TOKEN_ERROR:
+        parser->error_line = token->line;
+        parser->error_column = token->column;
+        return fail(parser, NULL, "%s", diram_tokenizer_get_error(parser->tokenizer));
+    default:
+        return true;
+    }
+}
+
+diram_ast_arena_t* diram_parser_parse(diram_parser_t* parser) {
+    if (!parser || parser->state != PARSER_STATE_INIT) return NULL;
+
+    for (;;) {
+        diram_token_t token = diram_tokenizer_next(parser->tokenizer);
+        if (!diram_parser_consume_token(parser, &token)) return NULL;
+        if (token.type == TOKEN_EOF) return parser->arena;
+    }
+}
+
+// ============================================================================
+// Direct emission
+// ============================================================================
+
+static diram_ast_compact_t* emit_open(diram_parser_t* parser, diram_ast_node_type_t type,
+                                      const char* name, diram_ast_ref_t* ref) {
+    if (!parser || parser->has_error || parser->current_node == DIRAM_AST_NONE) return NULL;
+    *ref = open_node(parser, type, NULL);
+    if (*ref == DIRAM_AST_NONE) return NULL;
+    diram_ast_compact_t* node = current(parser);
+    node->name = name ? intern(parser, name, strlen(name)) : 0;
+    return node;
+}
+
+bool diram_parser_emit_feature_toggle(diram_parser_t* parser, const char* name, bool enabled) {
+    diram_ast_ref_t ref;
+    diram_ast_compact_t* node = emit_open(parser, AST_NODE_FEATURE_TOGGLE, name, &ref);
+    if (!node) return false;
+    if (enabled) node->flags |= DIRAM_AST_ENABLED;
+    return close_node(parser, ref);
+}
+
+bool diram_parser_emit_opcode(diram_parser_t* parser, const char* name, uint8_t code) {
+    diram_ast_ref_t ref;
+    diram_ast_compact_t* node = emit_open(parser, AST_NODE_OPCODE, name, &ref);
+    if (!node) return false;
+    node->code = code;
+    return close_node(parser, ref);
+}
+
+bool diram_parser_emit_policy(diram_parser_t* parser, const char* name, const char* type) {
+    diram_ast_ref_t ref;
+    diram_ast_compact_t* node = emit_open(parser, AST_NODE_POLICY, name, &ref);
+    if (!node) return false;
+    node->text = type ? intern(parser, type, strlen(type)) : 0;
+    return close_node(parser, ref);
+}
+
+bool diram_parser_emit_memory_region(diram_parser_t* parser, const char* name, uint64_t base, size_t size) {
+    diram_ast_ref_t ref;
+    diram_ast_compact_t* node = emit_open(parser, AST_NODE_MEMORY_REGION, name, &ref);
+    if (!node) return false;
+    node->value = base;
+    node->extent = size;
+    return close_node(parser, ref);
+}
@@ -0,0 +1,212 @@
+// src/core/parser/structural_index.c
+// DIRAM XML Structural Scanner
+// OBINexus Aegis Project
+// Every back-end produces identical masks; the vector paths compare each
+// lane against the handful of bytes XML structure hangs on and pack the
+// results with movemask.
+//   scalar - class table, one byte at a time
+//   SSE4.2 - 16-byte compares, four per block
+//   AVX2   - 32-byte compares, two per block
+#include "diram/core/parser/structural_index.h"
+#include <stdatomic.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DIRAM_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+enum { C_LT = 1, C_QUOTE = 2, C_DELIM = 4, C_SPACE = 8, C_NEWLINE = 16 };
+
+static const uint8_t scan_class[256] = {
+    ['<'] = C_LT | C_DELIM,
+    ['>'] = C_DELIM,
+    ['='] = C_DELIM,
+    ['/'] = C_DELIM,
+    ['"'] = C_QUOTE | C_DELIM,
+    ['\''] = C_QUOTE | C_DELIM,
+    [' '] = C_SPACE | C_DELIM,
+    ['\t'] = C_SPACE | C_DELIM,
+    ['\r'] = C_SPACE | C_DELIM,
+    ['\n'] = C_SPACE | C_DELIM | C_NEWLINE,
+};
+
+static void scan_block_scalar(const uint8_t* in, size_t length, diram_scan_block_t* out) {
+    memset(out, 0, sizeof(*out));
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = scan_class[in[i]];
+        if (!c) continue;
+        uint64_t bit = 1ULL << i;
+        if (c & C_LT) out->lt |= bit;
+        if (c & C_QUOTE) out->quote |= bit;
+        if (c & C_DELIM) out->delim |= bit;
+        if (c & C_SPACE) out->space |= bit;
+        if (c & C_NEWLINE) out->newline |= bit;
+    }
+}
+
+static void scan_scalar(const char* input, size_t blocks, diram_scan_block_t* out) {
+    for (size_t b = 0; b < blocks; b++) {
+        scan_block_scalar((const uint8_t*)input + b * DIRAM_SCAN_BLOCK, DIRAM_SCAN_BLOCK, &out[b]);
+    }
+}
+
+#ifdef DIRAM_SCAN_X86
+__attribute__((target("sse4.2")))
+static void scan_sse42(const char* input, size_t blocks, diram_scan_block_t* out) {
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i eq = _mm_set1_epi8('=');
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i dquote = _mm_set1_epi8('"');
+    const __m128i squote = _mm_set1_epi8('\'');
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i nl = _mm_set1_epi8('\n');
+
+    for (size_t b = 0; b < blocks; b++) {
+        const char* block = input + b * DIRAM_SCAN_BLOCK;
+        uint64_t m_lt = 0, m_quote = 0, m_delim = 0, m_space = 0, m_newline = 0;
+        for (int k = 0; k < 4; k++) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(block + 16 * k));
+            __m128i is_lt = _mm_cmpeq_epi8(v, lt);
+            __m128i is_nl = _mm_cmpeq_epi8(v, nl);
+            __m128i is_quote = _mm_or_si128(_mm_cmpeq_epi8(v, dquote), _mm_cmpeq_epi8(v, squote));
+            __m128i is_space = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab)),
+                                            _mm_or_si128(_mm_cmpeq_epi8(v, cr), is_nl));
+            __m128i is_punct = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, gt), _mm_cmpeq_epi8(v, eq)),
+                                            _mm_cmpeq_epi8(v, slash));
+            __m128i is_delim = _mm_or_si128(_mm_or_si128(is_lt, is_quote), _mm_or_si128(is_space, is_punct));
+            int shift = 16 * k;
+            m_lt |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_lt) << shift;
+            m_quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_quote) << shift;
+            m_delim |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_delim) << shift;
+            m_space |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_space) << shift;
+            m_newline |= (uint64_t)(uint16_t)_mm_movemask_epi8(is_nl) << shift;
+        }
+        out[b] = (diram_scan_block_t){ m_lt, m_quote, m_delim, m_space, m_newline };
+    }
+}
+
+__attribute__((target("avx2")))
+static void scan_avx2(const char* input, size_t blocks, diram_scan_block_t* out) {
+    const __m256i lt = _mm256_set1_epi8('<');
+    const __m256i gt = _mm256_set1_epi8('>');
+    const __m256i eq = _mm256_set1_epi8('=');
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i dquote = _mm256_set1_epi8('"');
+    const __m256i squote = _mm256_set1_epi8('\'');
+    const __m256i sp = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i nl = _mm256_set1_epi8('\n');
+
+    for (size_t b = 0; b < blocks; b++) {
+        const char* block = input + b * DIRAM_SCAN_BLOCK;
+        uint64_t m_lt = 0, m_quote = 0, m_delim = 0, m_space = 0, m_newline = 0;
+        for (int k = 0; k < 2; k++) {
+            __m256i v = _mm256_loadu_si256((const __m256i*)(block + 32 * k));
+            __m256i is_lt = _mm256_cmpeq_epi8(v, lt);
+            __m256i is_nl = _mm256_cmpeq_epi8(v, nl);
+            __m256i is_quote = _mm256_or_si256(_mm256_cmpeq_epi8(v, dquote), _mm256_cmpeq_epi8(v, squote));
+            __m256i is_space = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, sp), _mm256_cmpeq_epi8(v, tab)),
+                                               _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), is_nl));
+            __m256i is_punct = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, gt), _mm256_cmpeq_epi8(v, eq)),
+                                               _mm256_cmpeq_epi8(v, slash));
+            __m256i is_delim = _mm256_or_si256(_mm256_or_si256(is_lt, is_quote),
+                                               _mm256_or_si256(is_space, is_punct));
+            int shift = 32 * k;
+            m_lt |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_lt) << shift;
+            m_quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_quote) << shift;
+            m_delim |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_delim) << shift;
+            m_space |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_space) << shift;
+            m_newline |= (uint64_t)(uint32_t)_mm256_movemask_epi8(is_nl) << shift;
+        }
+        out[b] = (diram_scan_block_t){ m_lt, m_quote, m_delim, m_space, m_newline };
+    }
+}
+#endif
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static atomic_int g_impl = DIRAM_SCAN_IMPL_AUTO;
+
+int diram_scan_supported(diram_scan_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SCAN_IMPL_AUTO:
+        case DIRAM_SCAN_IMPL_SCALAR:
+            return 1;
+#ifdef DIRAM_SCAN_X86
+        case DIRAM_SCAN_IMPL_SSE42:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2");
+        case DIRAM_SCAN_IMPL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return 0;
+    }
+}
+
+static diram_scan_impl_t scan_resolve(void) {
+    int impl = atomic_load_explicit(&g_impl, memory_order_relaxed);
+    if (impl != DIRAM_SCAN_IMPL_AUTO) return (diram_scan_impl_t)impl;
+
+    int best = diram_scan_supported(DIRAM_SCAN_IMPL_AVX2) ? DIRAM_SCAN_IMPL_AVX2
+             : diram_scan_supported(DIRAM_SCAN_IMPL_SSE42) ? DIRAM_SCAN_IMPL_SSE42
+             : DIRAM_SCAN_IMPL_SCALAR;
+
+    int expected = DIRAM_SCAN_IMPL_AUTO;
+    atomic_compare_exchange_strong(&g_impl, &expected, best);
+    return (diram_scan_impl_t)atomic_load_explicit(&g_impl, memory_order_relaxed);
+}
+
+int diram_scan_force_impl(diram_scan_impl_t impl) {
+    if (!diram_scan_supported(impl)) return -1;
+
+    atomic_store(&g_impl, DIRAM_SCAN_IMPL_AUTO);
+    if (impl != DIRAM_SCAN_IMPL_AUTO) atomic_store(&g_impl, impl);
+    scan_resolve();
+    return 0;
+}
+
+diram_scan_impl_t diram_scan_active_impl(void) {
+    return scan_resolve();
+}
+
+const char* diram_scan_impl_name(diram_scan_impl_t impl) {
+    switch (impl) {
+        case DIRAM_SCAN_IMPL_AUTO:   return "auto";
+        case DIRAM_SCAN_IMPL_SCALAR: return "scalar";
+        case DIRAM_SCAN_IMPL_SSE42:  return "sse4.2-x16";
+        case DIRAM_SCAN_IMPL_AVX2:   return "avx2-x32";
+        default:                     return "unknown";
+    }
+}
+
+void diram_scan_blocks(const char* input, size_t blocks, diram_scan_block_t* out) {
+    if (!input || !out) return;
+
+    switch (scan_resolve()) {
+#ifdef DIRAM_SCAN_X86
+        case DIRAM_SCAN_IMPL_AVX2:
+            scan_avx2(input, blocks, out);
+            return;
+        case DIRAM_SCAN_IMPL_SSE42:
+            scan_sse42(input, blocks, out);
+            return;
+#endif
+        default:
+            scan_scalar(input, blocks, out);
+            return;
+    }
+}
+
+void diram_scan_tail(const char* input, size_t length, diram_scan_block_t* out) {
+    if (!input || !out) return;
+    scan_block_scalar((const uint8_t*)input, length < DIRAM_SCAN_BLOCK ? length : DIRAM_SCAN_BLOCK, out);
+}
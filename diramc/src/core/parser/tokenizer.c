@@ -1,3 +1,601 @@
-/* Stub for src/core/parser/tokenizer.c */
+// src/core/parser/tokenizer.c
+// DIRAM XML Tokenizer
+// OBINexus Aegis Project
+// Tokens are views into the input: a mapped file, a caller buffer or, for
+// pipes, a window that is refilled in chunks. Scanning a token changes no
+// tokenizer state until the token is known to be complete, so when a
+// stream window runs dry mid-token the window is refilled (keeping the
+// token's bytes) and the token is simply scanned again.
+// Delimiters are found by bit scans over a structural index classified a
+// batch of 64-byte blocks ahead (structural_index.h); line numbers are
+// counted from its newline masks only when a token needs them.
+#include "diram/core/parser/tokenizer.h"
 #include <stdio.h>
-// TODO: Implement
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+typedef enum {
+    LEX_TOKEN,      // *tok is complete
+    LEX_SKIP,       // consumed markup that yields no token
+    LEX_MORE,       // ran out of window mid-token
+    LEX_ERROR
+} lex_result_t;
+
+// XML name characters; bytes >= 0x80 are accepted as UTF-8 name bytes
+enum { NAME_START = 1, NAME_CHAR = 2, SPACE = 4 };
+static const uint8_t char_class[256] = {
+    ['a' ... 'z'] = NAME_START | NAME_CHAR,
+    ['A' ... 'Z'] = NAME_START | NAME_CHAR,
+    ['_'] = NAME_START | NAME_CHAR,
+    [':'] = NAME_START | NAME_CHAR,
+    [0x80 ... 0xFF] = NAME_START | NAME_CHAR,
+    ['0' ... '9'] = NAME_CHAR,
+    ['-'] = NAME_CHAR,
+    ['.'] = NAME_CHAR,
+    [' '] = SPACE, ['\t'] = SPACE, ['\r'] = SPACE, ['\n'] = SPACE,
+};
+
+static inline bool is_space(char c) { return char_class[(uint8_t)c] & SPACE; }
+static inline bool is_name_start(char c) { return char_class[(uint8_t)c] & NAME_START; }
+
+static diram_tokenizer_t* tokenizer_alloc(void) {
+    diram_tokenizer_t* tokenizer = calloc(1, sizeof(diram_tokenizer_t));
+    if (!tokenizer) return NULL;
+    tokenizer->fd = -1;
+    tokenizer->line = 1;
+    return tokenizer;
+}
+
+diram_tokenizer_t* diram_tokenizer_create(const char* input, size_t length) {
+    if (!input && length) return NULL;
+
+    diram_tokenizer_t* tokenizer = tokenizer_alloc();
+    if (!tokenizer) return NULL;
+    tokenizer->input = input;
+    tokenizer->length = length;
+    tokenizer->at_eof = true;
+    return tokenizer;
+}
+
+diram_tokenizer_t* diram_tokenizer_create_stream(int fd, size_t chunk_size) {
+    if (fd < 0) return NULL;
+
+    diram_tokenizer_t* tokenizer = tokenizer_alloc();
+    if (!tokenizer) return NULL;
+    tokenizer->fd = fd;
+    tokenizer->chunk_size = chunk_size ? chunk_size : DIRAM_TOKENIZER_CHUNK;
+    tokenizer->window_capacity = tokenizer->chunk_size * 2;
+    tokenizer->window = malloc(tokenizer->window_capacity);
+    if (!tokenizer->window) {
+        free(tokenizer);
+        return NULL;
+    }
+    tokenizer->input = tokenizer->window;
+    return tokenizer;
+}
+
+diram_tokenizer_t* diram_tokenizer_open(const char* path) {
+    if (!path) return NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            close(fd);
+            madvise(mapping, (size_t)st.st_size, MADV_SEQUENTIAL);
+            diram_tokenizer_t* tokenizer = diram_tokenizer_create(mapping, (size_t)st.st_size);
+            if (!tokenizer) {
+                munmap(mapping, (size_t)st.st_size);
+                return NULL;
+            }
+            tokenizer->mapping = mapping;
+            tokenizer->mapping_length = (size_t)st.st_size;
+            return tokenizer;
+        }
+    }
+
+    // Not mappable: stream it, and own the descriptor
+    diram_tokenizer_t* tokenizer = diram_tokenizer_create_stream(fd, 0);
+    if (!tokenizer) {
+        close(fd);
+        return NULL;
+    }
+    tokenizer->owns_fd = true;
+    return tokenizer;
+}
+
+void diram_tokenizer_destroy(diram_tokenizer_t* tokenizer) {
+    if (!tokenizer) return;
+    if (tokenizer->mapping) munmap(tokenizer->mapping, tokenizer->mapping_length);
+    if (tokenizer->owns_fd) close(tokenizer->fd);
+    free(tokenizer->window);
+    free(tokenizer->index);
+    free(tokenizer);
+}
+
+typedef enum {
+    SCAN_LT = offsetof(diram_scan_block_t, lt),
+    SCAN_QUOTE = offsetof(diram_scan_block_t, quote),
+    SCAN_DELIM = offsetof(diram_scan_block_t, delim),
+    SCAN_SPACE = offsetof(diram_scan_block_t, space),
+} scan_mask_t;
+
+// Lowest stream offset the scan can still come back to
+static uint64_t index_keep(const diram_tokenizer_t* t) {
+    uint64_t keep = t->input_offset + t->position;
+    if (t->lines_to < keep) keep = t->lines_to;
+    if (t->in_element && t->element.offset < keep) keep = t->element.offset;
+    return keep & ~(uint64_t)(DIRAM_SCAN_BLOCK - 1);
+}
+
+// Classify the next batch of blocks whose bytes are all present (or the
+// final partial block at end of input); false when there is nothing to add
+static bool index_extend(diram_tokenizer_t* t) {
+    uint64_t next = t->index_offset + (uint64_t)t->index_count * DIRAM_SCAN_BLOCK;
+    uint64_t end = t->input_offset + t->length;
+    if (next >= end) return false;
+    size_t blocks = (size_t)((end - next) / DIRAM_SCAN_BLOCK);
+    if (blocks == 0 && !t->at_eof) return false;
+    if (blocks > DIRAM_TOKENIZER_BATCH) blocks = DIRAM_TOKENIZER_BATCH;
+    size_t adding = blocks ? blocks : 1;
+
+    if (t->index_count + adding > t->index_capacity && t->index_count) {
+        size_t drop = (size_t)((index_keep(t) - t->index_offset) / DIRAM_SCAN_BLOCK);
+        memmove(t->index, t->index + drop, (t->index_count - drop) * sizeof(diram_scan_block_t));
+        t->index_count -= drop;
+        t->index_offset += (uint64_t)drop * DIRAM_SCAN_BLOCK;
+    }
+    if (t->index_count + adding > t->index_capacity) {
+        size_t capacity = t->index_capacity ? t->index_capacity * 2 : 2 * DIRAM_TOKENIZER_BATCH;
+        diram_scan_block_t* grown = realloc(t->index, capacity * sizeof(diram_scan_block_t));
+        if (!grown) return false;
+        t->index = grown;
+        t->index_capacity = capacity;
+    }
+
+    const char* from = t->input + (next - t->input_offset);
+    if (blocks) diram_scan_blocks(from, blocks, t->index + t->index_count);
+    else diram_scan_tail(from, (size_t)(end - next), t->index + t->index_count);
+    t->index_count += adding;
+    return true;
+}
+
+// First position >= from whose bit is set in `mask` (clear, if `invert`),
+// or t->length when the input seen so far has none
+static inline size_t scan_for(diram_tokenizer_t* t, size_t from, scan_mask_t mask, bool invert) {
+    uint64_t at = t->input_offset + from;
+    uint64_t end = t->input_offset + t->length;
+    while (at < end) {
+        size_t b = (size_t)((at - t->index_offset) / DIRAM_SCAN_BLOCK);
+        if (b >= t->index_count) {
+            if (!index_extend(t)) break;
+            continue;               // extending may have slid the index
+        }
+        uint64_t bits = *(const uint64_t*)((const char*)&t->index[b] + mask);
+        if (invert) bits = ~bits;
+        bits &= ~0ULL << (at % DIRAM_SCAN_BLOCK);
+        if (bits) {
+            at = (at & ~(uint64_t)(DIRAM_SCAN_BLOCK - 1)) + (uint64_t)__builtin_ctzll(bits);
+            return at < end ? (size_t)(at - t->input_offset) : t->length;
+        }
+        at = (at | (DIRAM_SCAN_BLOCK - 1)) + 1;
+    }
+    return t->length;
+}
+
+// Bring line and line_start up to stream offset `to` from the newline masks
+static inline void count_lines(diram_tokenizer_t* t, uint64_t to) {
+    uint64_t at = t->lines_to;
+    while (at < to) {
+        uint64_t block = at & ~(uint64_t)(DIRAM_SCAN_BLOCK - 1);
+        size_t b = (size_t)((block - t->index_offset) / DIRAM_SCAN_BLOCK);
+        if (b >= t->index_count) {
+            if (!index_extend(t)) break;
+            continue;               // extending may have slid the index
+        }
+        uint64_t bits = t->index[b].newline;
+        bits &= ~0ULL << (at - block);
+        if (to < block + DIRAM_SCAN_BLOCK) bits &= (1ULL << (to - block)) - 1;
+        if (bits) {
+            t->line_start = block + 64 - (uint64_t)__builtin_clzll(bits);
+            // Few newlines per block; cheaper than a libgcc popcount without -mpopcnt
+            do {
+                t->line++;
+                bits &= bits - 1;
+            } while (bits);
+        }
+        at = block + DIRAM_SCAN_BLOCK;
+    }
+    // A trailing partial block is not indexed until it fills; count it here
+    for (; at < to; at++) {
+        if (t->input[at - t->input_offset] == '\n') {
+            t->line++;
+            t->line_start = at + 1;
+        }
+    }
+    if (to > t->lines_to) t->lines_to = to;
+}
+
+static lex_result_t fail(diram_tokenizer_t* t, const char* what) {
+    if (!t->has_error) {
+        uint64_t at = t->input_offset + t->position;
+        count_lines(t, at);
+        snprintf(t->error_buffer, sizeof(t->error_buffer), "%u:%u: %s",
+                 t->line, (uint32_t)(at - t->line_start) + 1, what);
+        t->has_error = true;
+    }
+    return LEX_ERROR;
+}
+
+// Unterminated constructs are reported where their token starts
+static inline lex_result_t need_more(diram_tokenizer_t* t, const char* what) {
+    return t->at_eof ? fail(t, what) : LEX_MORE;
+}
+
+// Anything else at the offending byte; nothing is scanned after an error
+static lex_result_t fail_at(diram_tokenizer_t* t, size_t pos, const char* what) {
+    t->position = pos;
+    return fail(t, what);
+}
+
+static const char* find(const diram_tokenizer_t* t, size_t from, const char* needle, size_t n) {
+    if (from >= t->length) return NULL;
+    return memmem(t->input + from, t->length - from, needle, n);
+}
+
+static void token_at(diram_tokenizer_t* t, diram_token_t* tok, diram_token_type_t type,
+                     size_t start, size_t end) {
+    uint64_t at = t->input_offset + start;
+    count_lines(t, at);
+    tok->type = type;
+    tok->memory = MEMORY_NONE;
+    tok->value.text.offset = at;
+    tok->value.text.length = (uint32_t)(end - start);
+    tok->line = t->line;
+    tok->column = (uint32_t)(at - t->line_start) + 1;
+    t->column = tok->column;
+}
+
+static lex_result_t lex_text(diram_tokenizer_t* t, diram_token_t* tok) {
+    // Indentation between tags is the common case: one scan skips it
+    size_t first = scan_for(t, t->position, SCAN_SPACE, true);
+    if (first >= t->length && !t->at_eof) return LEX_MORE;
+    if (first >= t->length || t->input[first] == '<') {
+        t->position = first;
+        return LEX_SKIP;
+    }
+    size_t end = scan_for(t, first + 1, SCAN_LT, false);
+    if (end == t->length && !t->at_eof) return LEX_MORE;
+
+    size_t last = end;
+    while (is_space(t->input[last - 1])) last--;
+    token_at(t, tok, TOKEN_TEXT, first, last);
+    tok->memory = MEMORY_CONSTANT;
+    t->position = end;
+    return LEX_TOKEN;
+}
+
+// <? ... ?>, <!-- ... -->, <![CDATA[ ... ]]> and <!DOCTYPE ...>
+static lex_result_t lex_special(diram_tokenizer_t* t, diram_token_t* tok) {
+    size_t pos = t->position;
+    const char* in = t->input;
+    size_t avail = t->length - pos;
+
+    if (in[pos + 1] == '?') {
+        const char* close = find(t, pos + 2, "?>", 2);
+        if (!close) return need_more(t, "unterminated processing instruction");
+        size_t end = (size_t)(close - in);
+        if (end - pos >= 5 && memcmp(in + pos + 2, "xml", 3) == 0 &&
+            (end - pos == 5 || is_space(in[pos + 5]))) {
+            token_at(t, tok, TOKEN_XML_START, pos + 2, end);
+            t->position = end + 2;
+            return LEX_TOKEN;
+        }
+        t->position = end + 2;
+        return LEX_SKIP;
+    }
+
+    if (avail < 9 && !t->at_eof) return LEX_MORE;
+    if (avail >= 4 && memcmp(in + pos, "<!--", 4) == 0) {
+        const char* close = find(t, pos + 4, "-->", 3);
+        if (!close) return need_more(t, "unterminated comment");
+        t->position = (size_t)(close - in) + 3;
+        return LEX_SKIP;
+    }
+    if (avail >= 9 && memcmp(in + pos, "<![CDATA[", 9) == 0) {
+        const char* close = find(t, pos + 9, "]]>", 3);
+        if (!close) return need_more(t, "unterminated CDATA section");
+        size_t end = (size_t)(close - in);
+        if (end == pos + 9) {
+            t->position = end + 3;
+            return LEX_SKIP;
+        }
+        token_at(t, tok, TOKEN_TEXT, pos + 9, end);
+        tok->memory = MEMORY_CONSTANT;
+        t->position = end + 3;
+        return LEX_TOKEN;
+    }
+    const char* close = memchr(in + pos, '>', avail);
+    if (!close) return need_more(t, "unterminated declaration");
+    t->position = (size_t)(close - in) + 1;
+    return LEX_SKIP;
+}
+
+static lex_result_t lex_markup(diram_tokenizer_t* t, diram_token_t* tok) {
+    size_t pos = t->position;
+    const char* in = t->input;
+    if (pos + 1 >= t->length) return need_more(t, "unexpected end of input after '<'");
+
+    char c = in[pos + 1];
+    if (c == '?' || c == '!') return lex_special(t, tok);
+
+    if (c == '/') {
+        if (pos + 2 >= t->length) return need_more(t, "unterminated end tag");
+        if (!is_name_start(in[pos + 2])) return fail_at(t, pos + 2, "expected a name after '</'");
+        size_t name_end = scan_for(t, pos + 3, SCAN_DELIM, false);
+        size_t gt = scan_for(t, name_end, SCAN_SPACE, true);
+        if (gt >= t->length) return need_more(t, "unterminated end tag");
+        if (in[gt] != '>') return fail_at(t, gt, "expected '>' to close the end tag");
+        token_at(t, tok, TOKEN_ELEMENT_END, pos + 2, name_end);
+        t->position = gt + 1;
+        return LEX_TOKEN;
+    }
+
+    if (!is_name_start(c)) return fail_at(t, pos + 1, "expected a name after '<'");
+    size_t name_end = scan_for(t, pos + 2, SCAN_DELIM, false);
+    if (name_end >= t->length) return need_more(t, "unterminated start tag");
+    token_at(t, tok, TOKEN_ELEMENT_START, pos + 1, name_end);
+    t->position = name_end;
+    t->element = tok->value.text;
+    t->in_element = true;
+    return LEX_TOKEN;
+}
+
+static lex_result_t lex_in_tag(diram_tokenizer_t* t, diram_token_t* tok) {
+    size_t pos = scan_for(t, t->position, SCAN_SPACE, true);
+    if (pos >= t->length) return need_more(t, "unterminated start tag");
+
+    const char* in = t->input;
+    char c = in[pos];
+    if (c == '>') {
+        t->position = pos + 1;
+        t->in_element = false;
+        return LEX_SKIP;
+    }
+    if (c == '/') {
+        if (pos + 1 >= t->length) return need_more(t, "unterminated start tag");
+        if (in[pos + 1] != '>') return fail_at(t, pos + 1, "expected '>' after '/'");
+        token_at(t, tok, TOKEN_ELEMENT_END, pos, pos);
+        tok->value.text = t->element;
+        t->position = pos + 2;
+        t->in_element = false;
+        return LEX_TOKEN;
+    }
+    if (!is_name_start(c)) return fail_at(t, pos, "expected an attribute name");
+
+    size_t name_end = scan_for(t, pos + 1, SCAN_DELIM, false);
+    if (name_end >= t->length) return need_more(t, "unterminated start tag");
+    token_at(t, tok, TOKEN_ATTRIBUTE_NAME, pos, name_end);
+    t->position = name_end;
+    t->in_attribute = true;
+    return LEX_TOKEN;
+}
+
+static lex_result_t lex_attribute_value(diram_tokenizer_t* t, diram_token_t* tok) {
+    const char* in = t->input;
+    size_t pos = scan_for(t, t->position, SCAN_SPACE, true);
+    if (pos >= t->length) return need_more(t, "unterminated attribute");
+    if (in[pos] != '=') return fail_at(t, pos, "expected '=' after the attribute name");
+
+    pos = scan_for(t, pos + 1, SCAN_SPACE, true);
+    if (pos >= t->length) return need_more(t, "unterminated attribute");
+    char quote = in[pos];
+    if (quote != '"' && quote != '\'') return fail_at(t, pos, "expected a quoted attribute value");
+
+    size_t close = pos;
+    do {
+        close = scan_for(t, close + 1, SCAN_QUOTE, false);
+    } while (close < t->length && in[close] != quote);
+    if (close >= t->length) return need_more(t, "unterminated attribute value");
+    token_at(t, tok, TOKEN_ATTRIBUTE_VALUE, pos + 1, close);
+    tok->memory = MEMORY_CONSTANT;
+    t->position = close + 1;
+    t->in_attribute = false;
+    return LEX_TOKEN;
+}
+
+static lex_result_t lex_one(diram_tokenizer_t* t, diram_token_t* tok) {
+    if (t->in_attribute) return lex_attribute_value(t, tok);
+    if (t->in_element) return lex_in_tag(t, tok);
+
+    if (t->position >= t->length) {
+        if (!t->at_eof) return LEX_MORE;
+        token_at(t, tok, TOKEN_EOF, t->position, t->position);
+        return LEX_TOKEN;
+    }
+    if (t->input[t->position] != '<') return lex_text(t, tok);
+    return lex_markup(t, tok);
+}
+
+// Slide the window past what is no longer needed and read another chunk.
+// An open start tag stays in the window so '/>' can still name it, and the
+// window always starts on a block boundary so the index stays aligned
+static int refill(diram_tokenizer_t* t) {
+    count_lines(t, t->input_offset + t->position);
+    size_t keep = t->position;
+    if (t->in_element) keep = (size_t)(t->element.offset - t->input_offset);
+    keep = (size_t)(((t->input_offset + keep) & ~(uint64_t)(DIRAM_SCAN_BLOCK - 1)) - t->input_offset);
+
+    memmove(t->window, t->window + keep, t->length - keep);
+    t->input_offset += keep;
+    t->position -= keep;
+    t->length -= keep;
+
+    if (t->length == t->window_capacity) {
+        char* grown = realloc(t->window, t->window_capacity * 2);
+        if (!grown) return -1;
+        t->window = grown;
+        t->window_capacity *= 2;
+    }
+    t->input = t->window;
+
+    size_t want = t->window_capacity - t->length;
+    if (want > t->chunk_size) want = t->chunk_size;
+    ssize_t got;
+    do {
+        got = read(t->fd, t->window + t->length, want);
+    } while (got < 0 && errno == EINTR);
+    if (got < 0) return -1;
+    if (got == 0) t->at_eof = true;
+    t->length += (size_t)got;
+    return 0;
+}
+
+diram_token_t diram_tokenizer_next(diram_tokenizer_t* tokenizer) {
+    diram_token_t tok = { .type = TOKEN_ERROR };
+    if (!tokenizer || tokenizer->has_error) return tok;
+
+    for (;;) {
+        switch (lex_one(tokenizer, &tok)) {
+        case LEX_TOKEN:
+            return tok;
+        case LEX_SKIP:
+            continue;
+        case LEX_MORE:
+            // Nothing was consumed; scan the same token again with more input
+            if (refill(tokenizer) != 0) {
+                fail(tokenizer, strerror(errno ? errno : ENOMEM));
+                tok.type = TOKEN_ERROR;
+                return tok;
+            }
+            continue;
+        case LEX_ERROR:
+            tok.type = TOKEN_ERROR;
+            return tok;
+        }
+    }
+}
+
+bool diram_tokenizer_has_error(const diram_tokenizer_t* tokenizer) {
+    return tokenizer && tokenizer->has_error;
+}
+
+const char* diram_tokenizer_get_error(const diram_tokenizer_t* tokenizer) {
+    if (!tokenizer || !tokenizer->has_error) return NULL;
+    return tokenizer->error_buffer;
+}
+
+const char* diram_tokenizer_text(const diram_tokenizer_t* tokenizer, const diram_token_t* token) {
+    if (!tokenizer || !token) return NULL;
+    return tokenizer->input + (token->value.text.offset - tokenizer->input_offset);
+}
+
+const char* diram_token_type_to_string(diram_token_type_t type) {
+    switch (type) {
+    case TOKEN_NONE: return "NONE";
+    case TOKEN_XML_START: return "XML_START";
+    case TOKEN_XML_END: return "XML_END";
+    case TOKEN_ELEMENT_START: return "ELEMENT_START";
+    case TOKEN_ELEMENT_END: return "ELEMENT_END";
+    case TOKEN_ATTRIBUTE_NAME: return "ATTRIBUTE_NAME";
+    case TOKEN_ATTRIBUTE_VALUE: return "ATTRIBUTE_VALUE";
+    case TOKEN_TEXT: return "TEXT";
+    case TOKEN_MEMORY_REGION: return "MEMORY_REGION";
+    case TOKEN_OPCODE: return "OPCODE";
+    case TOKEN_OPERAND: return "OPERAND";
+    case TOKEN_POLICY_FLAG: return "POLICY_FLAG";
+    case TOKEN_FEATURE_TOGGLE: return "FEATURE_TOGGLE";
+    case TOKEN_CONSTRAINT: return "CONSTRAINT";
+    case TOKEN_NIL_TYPE: return "NIL_TYPE";
+    case TOKEN_INTEGER: return "INTEGER";
+    case TOKEN_HEX_VALUE: return "HEX_VALUE";
+    case TOKEN_BOOLEAN: return "BOOLEAN";
+    case TOKEN_STRING: return "STRING";
+    case TOKEN_IDENTIFIER: return "IDENTIFIER";
+    case TOKEN_EOF: return "EOF";
+    case TOKEN_ERROR: return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+const char* diram_token_memory_to_string(diram_token_memory_t memory) {
+    switch (memory) {
+    case MEMORY_NONE: return "NONE";
+    case MEMORY_SYSTEM: return "SYSTEM";
+    case MEMORY_USERSPACE: return "USERSPACE";
+    case MEMORY_TRACE_BUFFER: return "TRACE_BUFFER";
+    case MEMORY_HEAP: return "HEAP";
+    case MEMORY_STACK: return "STACK";
+    case MEMORY_REGISTER: return "REGISTER";
+    case MEMORY_CONSTANT: return "CONSTANT";
+    case MEMORY_VIRTUAL: return "VIRTUAL";
+    }
+    return "UNKNOWN";
+}
+
+void diram_token_free(diram_token_t* token) {
+    (void)token;
+}
+
+static bool name_in(const char* name, size_t length, const char* const* names) {
+    if (!name) return false;
+    for (; *names; names++) {
+        if (strlen(*names) == length && memcmp(*names, name, length) == 0) return true;
+    }
+    return false;
+}
+
+// Elements and attributes of the diram.drc.in.xml manifest schema
+static const char* const element_names[] = {
+    "diram-config", "metadata", "project", "author", "created", "governance",
+    "features", "toggle", "description", "policy", "constraint", "algorithm",
+    "log_path", "default_space", "opcodes", "opcode", "operands", "operand",
+    "constraints", "heap_events", "alignment", "output", "policies", "rule",
+    "memory_regions", "region", "build", "output_dir", "targets", "target",
+    "compiler", "flags", NULL
+};
+
+static const char* const attribute_names[] = {
+    "version", "xmlns", "name", "enabled", "code", "type", "position", "max",
+    "base", "size", "protection", "platform", NULL
+};
+
+bool diram_tokenizer_is_element_name(const char* name, size_t length) {
+    return name_in(name, length, element_names);
+}
+
+bool diram_tokenizer_is_attribute_name(const char* name, size_t length) {
+    return name_in(name, length, attribute_names);
+}
+
+diram_token_memory_t diram_tokenizer_classify_memory(const char* region_name, size_t length) {
+    static const struct {
+        const char* name;
+        diram_token_memory_t memory;
+    } regions[] = {
+        { "system", MEMORY_SYSTEM },
+        { "userspace", MEMORY_USERSPACE },
+        { "trace_buffer", MEMORY_TRACE_BUFFER },
+        { "heap", MEMORY_HEAP },
+        { "stack", MEMORY_STACK },
+        { "register", MEMORY_REGISTER },
+        { "constant", MEMORY_CONSTANT },
+        { "virtual", MEMORY_VIRTUAL },
+    };
+    if (!region_name) return MEMORY_NONE;
+    for (size_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        if (strlen(regions[i].name) == length && memcmp(regions[i].name, region_name, length) == 0) {
+            return regions[i].memory;
+        }
+    }
+    return MEMORY_NONE;
+}
@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "diram/core/feature-alloc/space_account.h"
+
+// Charge/release throughput, 1 to 64 threads sharing one space:
+// the previous mutex + used_bytes path against per-CPU reservations
+
+#define BENCH_OPS_PER_THREAD  200000
+#define BENCH_CHARGE          256
+#define BENCH_LIMIT           ((size_t)1 << 34)
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t limit_bytes;
+    size_t used_bytes;
+} mutex_space_t;
+
+static mutex_space_t mutex_space;
+static diram_space_account_t* account;
+static pthread_barrier_t start_line;
+
+static int mutex_charge(size_t bytes) {
+    pthread_mutex_lock(&mutex_space.lock);
+    int ok = (mutex_space.used_bytes + bytes <= mutex_space.limit_bytes) ? 0 : -1;
+    if (ok == 0) mutex_space.used_bytes += bytes;
+    pthread_mutex_unlock(&mutex_space.lock);
+    return ok;
+}
+
+static void mutex_release(size_t bytes) {
+    pthread_mutex_lock(&mutex_space.lock);
+    mutex_space.used_bytes -= bytes;
+    pthread_mutex_unlock(&mutex_space.lock);
+}
+
+static void* run_mutex(void* arg) {
+    (void)arg;
+    pthread_barrier_wait(&start_line);
+    for (int i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        if (mutex_charge(BENCH_CHARGE) == 0) mutex_release(BENCH_CHARGE);
+    }
+    return NULL;
+}
+
+static void* run_account(void* arg) {
+    (void)arg;
+    pthread_barrier_wait(&start_line);
+    for (int i = 0; i < BENCH_OPS_PER_THREAD; i++) {
+        if (diram_account_charge(account, BENCH_CHARGE) == 0) {
+            diram_account_release(account, BENCH_CHARGE);
+        }
+    }
+    return NULL;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double run(void* (*fn)(void*), int threads) {
+    pthread_t tids[64];
+    pthread_barrier_init(&start_line, NULL, (unsigned)threads + 1);
+    for (int i = 0; i < threads; i++) pthread_create(&tids[i], NULL, fn, NULL);
+
+    double start = now_sec();
+    pthread_barrier_wait(&start_line);
+    for (int i = 0; i < threads; i++) pthread_join(tids[i], NULL);
+    double elapsed = now_sec() - start;
+
+    pthread_barrier_destroy(&start_line);
+    return (double)threads * BENCH_OPS_PER_THREAD / elapsed;
+}
+
+int main() {
+    pthread_mutex_init(&mutex_space.lock, NULL);
+    mutex_space.limit_bytes = BENCH_LIMIT;
+    account = diram_account_create(BENCH_LIMIT);
+    if (!account) return 1;
+
+    printf("DIRAMC space accounting contention (%d charge+release pairs per thread)\n\n",
+           BENCH_OPS_PER_THREAD);
+    printf("%8s  %16s  %16s  %8s\n", "threads", "mutex ops/s", "per-cpu ops/s", "speedup");
+
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        double m = run(run_mutex, threads);
+        double a = run(run_account, threads);
+        printf("%8d  %16.0f  %16.0f  %7.2fx\n", threads, m, a, a / m);
+    }
+
+    diram_account_stats_t stats;
+    diram_account_get_stats(account, &stats);
+    printf("\nslots=%u chunk=%zu refills=%lu used=%zu (bound %zu)\n",
+           stats.slots, stats.chunk, (unsigned long)stats.refills, stats.used,
+           diram_account_error_bound(account));
+
+    diram_account_destroy(account);
+    return 0;
+}
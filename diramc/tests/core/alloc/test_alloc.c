@@ -1,14 +1,37 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <assert.h>
-#include "diram/core/bootstrap.h"
+#include <unistd.h>
+#include <string.h>
+#include "diram/core/diram.h"
+#include "diram/core/config/config.h"
+#include "diram/core/config/config_cache.h"
+#include "diram/core/feature-alloc/receipt_queue.h"
+
+#define CONFIG_BURST  4
 
 int main() {
     printf("Running DIRAMC allocation tests...\n");
     
+    // A local .dramrc in a scratch directory, nothing from the real home
+    char root[] = "/tmp/diram_alloc_XXXXXX";
+    assert(mkdtemp(root) && chdir(root) == 0);
+    setenv("HOME", root, 1);
+    setenv(DIRAM_CONFIG_CACHE_ENV, "", 1);
+    unsetenv(DIRAM_CONFIG_ENV);
+    FILE* f = fopen(".dramrc", "w");
+    assert(f);
+    fprintf(f, "receipt_mode=deferred\n[governor]\nthread_rate=1\nthread_burst=%d\n", CONFIG_BURST);
+    fclose(f);
+    
     // Initialize bootstrap
     assert(diram_bootstrap_init() == 0);
     printf("✓ Bootstrap initialized\n");
     
+    // The loaded config is in effect
+    assert(diram_receipt_get_mode() == DIRAM_RECEIPT_MODE_DEFERRED);
+    printf("✓ receipt_mode from .dramrc applied\n");
+    
     // Test allocation
     diram_allocation_t* alloc = diram_alloc_traced(1024, "test");
     assert(alloc != NULL);
@@ -22,6 +45,20 @@ int main() {
     diram_free_traced(alloc);
     printf("✓ Deallocation successful\n");
     
+    // [governor] thread_burst caps this thread's allocations
+    diram_allocation_t* held[CONFIG_BURST];
+    for (int i = 1; i < CONFIG_BURST; i++) {
+        held[i] = diram_alloc_traced(64, "burst");
+        assert(held[i] != NULL);
+    }
+    assert(diram_alloc_traced(64, "burst") == NULL);
+    for (int i = 1; i < CONFIG_BURST; i++) diram_free_traced(held[i]);
+    printf("✓ Governor burst of %d from .dramrc enforced\n", CONFIG_BURST);
+    
+    diram_close_trace_log();
+    unlink(".dramrc");
+    rmdir(root);
+    
     printf("\nAll tests passed!\n");
     return 0;
 }
@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "diram/core/diram.h"
+#include "diram/core/diram_dag.h"
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+#include "diram/core/feature-alloc/prefetch_pool.h"
+#include "diram/core/observe/observation_ring.h"
+
+static phenotype_t pheno(uint32_t intent, uint32_t locality) {
+    phenotype_t p = {.raw = 0};
+    p.fields.intent = intent;
+    p.fields.locality = locality;
+    return p;
+}
+
+int main() {
+    printf("Running DIRAMC context integration tests...\n");
+
+    diram_context_t* ctx = diram_init();
+    assert(ctx && ctx->dag && ctx->observations && ctx->sampler);
+    assert(ctx->prefetch_pool && ctx->predictor && ctx->streams);
+    assert(ctx->dag_root == ctx->dag->root && ctx->current_state == ctx->dag_root);
+    printf("✓ Context wires the DAG, observation ring, sampler and prefetch pool\n");
+
+    // Observations land in the ring
+    for (int i = 0; i < 10; i++) diram_observe(ctx, NULL, 0);
+    diram_obs_summary_t summary;
+    assert(diram_obs_ring_summary(ctx->observations, &summary) == 0);
+    assert(summary.recorded == 10 && summary.folded + summary.dropped == 10);
+    printf("✓ diram_observe recorded %llu observations\n", (unsigned long long)summary.recorded);
+
+    // Navigation appends a state, and finds it again once the new edge's
+    // probability clears the context's threshold
+    uint32_t nodes = ctx->dag->node_count;
+    dag_node_t* a = diram_navigate_dag(ctx, pheno(5, 3));
+    assert(a && a != ctx->dag_root);
+    assert(ctx->dag->node_count == nodes + 1);
+    diram_dag_release(ctx->dag, a);
+    ctx->phenomenon_threshold = 0.4f;
+    dag_node_t* b = diram_navigate_dag(ctx, pheno(5, 3));
+    assert(b == a && ctx->dag->node_count == nodes + 1);
+    diram_dag_release(ctx->dag, b);
+    ctx->phenomenon_threshold = 0.6f;
+    printf("✓ diram_navigate_dag reuses the transition it created\n");
+
+    // Allocation observes, navigates and either moves to the target state
+    // or leaves the held state as it was
+    uint64_t before = summary.recorded;
+    void* p = diram_alloc(ctx, 256, pheno(2, 1));
+    assert(diram_obs_ring_summary(ctx->observations, &summary) == 0);
+    assert(summary.recorded == before + 1);
+    if (p) {
+        assert(ctx->current_state != ctx->dag_root);
+        diram_free(ctx, p);
+    } else {
+        assert(ctx->current_state == ctx->dag_root);
+    }
+    printf("✓ diram_alloc %s\n", p ? "moved to the target state" : "was refused by the triple stream");
+
+    // A prediction parks a speculative block in the context's pool
+    // (diram_alloc may already have parked one for its own next request)
+    diram_prefetch_stats_t stats;
+    diram_prefetch_pool_get_stats(ctx->prefetch_pool, &stats);
+    uint32_t blocks = stats.blocks;
+    size_t bytes = stats.bytes;
+    phenomenon_prediction_t prediction = { .phenotype = pheno(5, 3), .size = 4096, .confidence = 1.0f };
+    assert(prefetch_by_phenomenon(ctx, &prediction) == 0);
+    diram_prefetch_pool_get_stats(ctx->prefetch_pool, &stats);
+    assert(stats.blocks == blocks + 1 && stats.bytes == bytes + 4096);
+    printf("✓ prefetch_by_phenomenon parked %zu bytes\n", stats.bytes - bytes);
+
+    // Destroy releases the parked block, the ring and the DAG
+    diram_destroy(ctx);
+
+    // A repeated request teaches the predictor, which parks the next block
+    // before it is asked for; the request then claims it from the pool
+    ctx = diram_init();
+    assert(ctx);
+    const size_t request = 3000;
+    const phenotype_t want = pheno(3, 2);
+    for (int i = 0; i < 4; i++) diram_free(ctx, diram_alloc(ctx, request, want));
+    diram_prefetch_pool_get_stats(ctx->prefetch_pool, &stats);
+    assert(stats.parked >= 1 && stats.hits >= 1);
+    assert(stats.blocks == 1 && stats.bytes >= request);
+
+    // Line the triple stream up with the parked block so the claim sticks
+    diram_prefetch_pool_t* pool = ctx->prefetch_pool;
+    void* parked = pool->blocks[pool->age_head].ptr;
+    uint8_t locality = compute_spatial_locality(parked);
+    ctx->streams->current.stream_a = encode_primary_intent(want.fields.intent);
+    ctx->streams->current.stream_b = encode_verification((uint16_t)((locality << 8) | want.fields.locality));
+    ctx->streams->current.stream_c = encode_governance((uint16_t)(check_permission_level(parked) << 8));
+
+    uint64_t hits = stats.hits;
+    p = diram_alloc(ctx, request, want);
+    assert(p == parked && ctx->current_state != ctx->dag_root);
+    diram_prefetch_pool_get_stats(ctx->prefetch_pool, &stats);
+    assert(stats.hits == hits + 1);
+    diram_free(ctx, p);
+    printf("✓ diram_alloc served from the pool after %llu predicted requests\n",
+           (unsigned long long)stats.hits);
+    diram_destroy(ctx);
+    diram_free(NULL, NULL);
+    diram_destroy(NULL);
+    printf("✓ Context destroyed\n");
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "diram/core/feature-alloc/phenomenon_predictor.h"
+
+static phenotype_t pheno(uint32_t intent, uint32_t locality) {
+    phenotype_t p = {.raw = 0};
+    p.fields.intent = intent;
+    p.fields.locality = locality;
+    return p;
+}
+
+// Fraction of the last `rounds` observations predicted exactly beforehand
+static double replay(phenomenon_predictor_t* pred, const phenotype_t* seq,
+                     const size_t* sizes, int len, int rounds) {
+    int hits = 0, total = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < len; i++) {
+            phenomenon_prediction_t out;
+            if (r >= rounds / 2) {
+                total++;
+                hits += diram_predictor_predict(pred, &out) == 0 &&
+                        out.phenotype.raw == (seq[i].raw & pred->field_mask) &&
+                        out.size == sizes[i];
+            }
+            diram_predictor_observe(pred, seq[i], sizes[i]);
+        }
+    }
+    return (double)hits / total;
+}
+
+int main() {
+    printf("Running DIRAMC phenomenon predictor tests...\n");
+
+    phenomenon_predictor_t pred;
+    assert(diram_predictor_init(&pred, DIRAM_PREDICTOR_MAX_ORDER + 1, 0) == -1);
+    assert(diram_predictor_init(&pred, 0, 0) == 0);
+    assert(pred.order == DIRAM_PREDICTOR_DEFAULT_ORDER);
+    phenomenon_prediction_t out;
+    assert(diram_predictor_predict(&pred, &out) == -1);
+    printf("✓ Empty predictor makes no prediction\n");
+
+    // A repeating cycle is learned exactly, sizes included
+    phenotype_t cycle[3] = { pheno(1, 2), pheno(2, 4), pheno(3, 6) };
+    size_t cycle_sizes[3] = { 64, 4096, 256 };
+    assert(replay(&pred, cycle, cycle_sizes, 3, 20) == 1.0);
+    diram_predictor_predict(&pred, &out);
+    assert(out.phenotype.raw == cycle[0].raw && out.size == 64);
+    assert(out.confidence > 0.9f && out.order == pred.order);
+    printf("✓ Cycle predicted exactly (confidence %.2f)\n", out.confidence);
+
+    // A-B-A-C needs two symbols of context: after A comes B or C
+    phenotype_t abac[4] = { pheno(1, 0), pheno(2, 0), pheno(1, 0), pheno(4, 0) };
+    size_t abac_sizes[4] = { 128, 128, 128, 128 };
+    phenomenon_predictor_t first;
+    assert(diram_predictor_init(&first, 1, 0) == 0);
+    double order1 = replay(&first, abac, abac_sizes, 4, 20);
+    diram_predictor_destroy(&first);
+    diram_predictor_destroy(&pred);
+    assert(diram_predictor_init(&pred, 2, 0) == 0);
+    double order2 = replay(&pred, abac, abac_sizes, 4, 20);
+    assert(order1 < 0.8 && order2 == 1.0);
+    printf("✓ Order 2 resolves A-B-A-C (%.0f%% vs %.0f%% at order 1)\n",
+           order2 * 100, order1 * 100);
+
+    // Age drifts between observations but is masked out by default
+    phenotype_t aged = pheno(5, 1);
+    for (uint32_t age = 0; age < 8; age++) {
+        aged.fields.age = age;
+        diram_predictor_observe(&pred, aged, 512);
+    }
+    assert(diram_predictor_predict(&pred, &out) == 0);
+    assert(out.phenotype.fields.intent == 5 && out.phenotype.fields.age == 0);
+    assert(pred.confidence_scores[(pred.sequence_length - 1) % DIRAM_PREDICTOR_HISTORY] > 0.5f);
+    printf("✓ Age ignored; confidence recorded per observation\n");
+
+    // Sizes in one power-of-two class share a candidate sized for the largest
+    for (int i = 0; i < 4; i++) diram_predictor_observe(&pred, aged, 900 + (size_t)i * 20);
+    diram_predictor_predict(&pred, &out);
+    assert(out.size == 960);
+    printf("✓ Predicted size covers its class (%zu bytes)\n", out.size);
+
+    // The model adapts when the pattern changes
+    for (int i = 0; i < 40; i++) diram_predictor_observe(&pred, pheno(6, 3), 2048);
+    diram_predictor_predict(&pred, &out);
+    assert(out.phenotype.fields.intent == 6 && out.size == 2048);
+    diram_predictor_destroy(&pred);
+    printf("✓ Predictor follows a changed pattern\n");
+
+    // DAG edges decide when the model has nothing, and reinforce agreement
+    dag_node_t* node = create_dag_node(pheno(0, 0), (axial_state_t){0});
+    dag_node_t* to = create_dag_node(pheno(0, 0), (axial_state_t){0});
+    add_dag_edge(node, to, pheno(2, 1), 0.2f);
+    add_dag_edge(node, to, pheno(3, 3), 0.6f);
+    assert(diram_predictor_init(&pred, 2, 0) == 0);
+    phenotype_t next = predict_next_phenomenon(&pred, node, &out);
+    assert(next.raw == pheno(3, 3).raw && out.size == 0);
+    assert(out.confidence > 0.74f && out.confidence < 0.76f);
+    for (int i = 0; i < 3; i++) diram_predictor_observe(&pred, pheno(2, 1), 32);
+    phenomenon_prediction_t model;
+    diram_predictor_predict(&pred, &model);
+    next = predict_next_phenomenon(&pred, node, &out);
+    assert(next.raw == pheno(2, 1).raw && out.size == 32);
+    assert(out.confidence > model.confidence);
+    diram_predictor_destroy(&pred);
+    for (uint32_t i = 0; i < node->edge_count; i++) free(node->edges[i]);
+    free(node->edges);
+    free(node);
+    free(to->edges);
+    free(to);
+    printf("✓ DAG edges blended (%.2f -> %.2f)\n", model.confidence, out.confidence);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "diram/core/diram.h"
+#include "diram/core/feature-alloc/receipt_queue.h"
+
+#define DEFERRED_ALLOCS 400     // two rounds stay under DIRAM_GOV_DEFAULT_THREAD_BURST
+
+int main() {
+    printf("Running DIRAMC deferred receipt tests...\n");
+
+    diram_allocation_t* allocs[DEFERRED_ALLOCS];
+    char expected[DEFERRED_ALLOCS][DIRAM_SHA256_HEX_LEN];
+
+    diram_receipt_mode_t mode;
+    assert(diram_receipt_parse_mode("deferred", &mode) == 0);
+    assert(mode == DIRAM_RECEIPT_MODE_DEFERRED);
+    assert(diram_receipt_parse_mode("bogus", &mode) != 0);
+    printf("✓ receipt_mode values parsed\n");
+
+    // Deferred receipts must match what sync mode would have computed
+    assert(diram_receipt_set_mode(DIRAM_RECEIPT_MODE_DEFERRED) == 0);
+    for (int i = 0; i < DEFERRED_ALLOCS; i++) {
+        allocs[i] = diram_alloc_traced(64 + i, "deferred");
+        assert(allocs[i] != NULL);
+    }
+
+    diram_receipt_flush();
+    for (int i = 0; i < DEFERRED_ALLOCS; i++) {
+        assert(allocs[i]->receipt_ticket == 0);
+        assert(strlen(allocs[i]->sha256_receipt) == 64);
+        memcpy(expected[i], allocs[i]->sha256_receipt, DIRAM_SHA256_HEX_LEN);
+
+        diram_receipt_set_mode(DIRAM_RECEIPT_MODE_SYNC);
+        diram_compute_receipt(allocs[i], "deferred");
+        assert(strcmp(expected[i], allocs[i]->sha256_receipt) == 0);
+        diram_receipt_set_mode(DIRAM_RECEIPT_MODE_DEFERRED);
+    }
+    printf("✓ Flush back-fills receipts identical to sync mode\n");
+
+    // Freeing before the worker runs settles the receipt inline
+    for (int i = 0; i < DEFERRED_ALLOCS; i++) {
+        diram_free_traced(allocs[i]);
+    }
+    for (int i = 0; i < DEFERRED_ALLOCS; i++) {
+        allocs[i] = diram_alloc_traced(32, "settle");
+        assert(allocs[i] != NULL);
+        diram_free_traced(allocs[i]);
+    }
+    diram_receipt_flush();
+    printf("✓ Free settles pending receipts\n");
+
+    diram_receipt_stats_t stats;
+    diram_receipt_get_stats(&stats);
+    assert(stats.deferred >= DEFERRED_ALLOCS);
+    printf("✓ Stats: deferred=%lu batches=%lu settled=%lu full=%lu\n",
+           (unsigned long)stats.deferred, (unsigned long)stats.batches,
+           (unsigned long)stats.settled, (unsigned long)stats.queue_full);
+
+    assert(diram_receipt_set_mode(DIRAM_RECEIPT_MODE_SYNC) == 0);
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/feature-alloc/slab_arena.h"
+
+#define HANDOFF_BLOCKS   3          // one refill of the 16 KiB class
+#define STRESS_THREADS   4
+#define STRESS_BLOCKS    1000
+
+static void* g_handoff[HANDOFF_BLOCKS];
+static void* g_stress[STRESS_THREADS][STRESS_BLOCKS];
+static pthread_barrier_t g_barrier;
+static uint64_t g_stress_misses[STRESS_THREADS];
+
+static diram_slab_stats_t stats(void) {
+    diram_slab_stats_t s;
+    diram_slab_get_stats(&s);
+    return s;
+}
+
+static void* alloc_checked(size_t size) {
+    void* payload = NULL;
+    void* header = diram_slab_alloc(size, &payload);
+    assert(header && payload);
+    assert((uintptr_t)header % 8 == 0);
+    assert((uintptr_t)payload % DIRAM_SLAB_CACHE_LINE == 0);
+    assert((char*)payload - (char*)header == DIRAM_SLAB_USER_HEADER);
+    memset(header, 0xA5, DIRAM_SLAB_USER_HEADER);
+    memset(payload, 0x5A, size);
+    return header;
+}
+
+// Allocates into the handoff slots and exits, orphaning its arena
+static void* handoff_owner(void* arg) {
+    (void)arg;
+    for (int i = 0; i < HANDOFF_BLOCKS; i++) {
+        g_handoff[i] = alloc_checked(DIRAM_SLAB_MAX_PAYLOAD);
+    }
+    return NULL;
+}
+
+// Adopts the orphaned arena and must get the remotely freed blocks back
+static void* handoff_adopter(void* arg) {
+    (void)arg;
+    diram_slab_stats_t before = stats();
+    for (int i = 0; i < HANDOFF_BLOCKS; i++) {
+        void* header = alloc_checked(DIRAM_SLAB_MAX_PAYLOAD);
+        int found = 0;
+        for (int j = 0; j < HANDOFF_BLOCKS; j++) {
+            if (g_handoff[j] == header) found = 1;
+        }
+        assert(found);
+    }
+    diram_slab_stats_t after = stats();
+    assert(after.misses == before.misses && after.hits == before.hits + HANDOFF_BLOCKS);
+    assert(after.arena_count == before.arena_count);
+    for (int i = 0; i < HANDOFF_BLOCKS; i++) diram_slab_free(g_handoff[i]);
+    return NULL;
+}
+
+// Each thread frees its neighbour's blocks, then reallocates its own
+static void* stress_worker(void* arg) {
+    int id = (int)(intptr_t)arg;
+    for (int i = 0; i < STRESS_BLOCKS; i++) {
+        g_stress[id][i] = alloc_checked(200);
+    }
+    pthread_barrier_wait(&g_barrier);
+
+    int neighbour = (id + 1) % STRESS_THREADS;
+    for (int i = 0; i < STRESS_BLOCKS; i++) {
+        diram_slab_free(g_stress[neighbour][i]);
+    }
+    pthread_barrier_wait(&g_barrier);
+
+    // Every block of this arena is back, on its free or remote list
+    diram_slab_stats_t before = stats();
+    for (int i = 0; i < STRESS_BLOCKS; i++) {
+        g_stress[id][i] = alloc_checked(200);
+    }
+    g_stress_misses[id] = stats().misses - before.misses;
+    pthread_barrier_wait(&g_barrier);
+
+    for (int i = 0; i < STRESS_BLOCKS; i++) {
+        diram_slab_free(g_stress[id][i]);
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC slab arena tests...\n");
+
+    // Size classes: 64 B doubling to 16 KiB, header in front
+    static const struct { size_t request, block; } classes[] = {
+        {     1, DIRAM_SLAB_BLOCK_HEADER + 64 },
+        {    64, DIRAM_SLAB_BLOCK_HEADER + 64 },
+        {    65, DIRAM_SLAB_BLOCK_HEADER + 128 },
+        {   100, DIRAM_SLAB_BLOCK_HEADER + 128 },
+        {  1024, DIRAM_SLAB_BLOCK_HEADER + 1024 },
+        {  1025, DIRAM_SLAB_BLOCK_HEADER + 2048 },
+        {  8193, DIRAM_SLAB_BLOCK_HEADER + 16384 },
+        { 16384, DIRAM_SLAB_BLOCK_HEADER + 16384 },
+    };
+    diram_slab_stats_t before = stats();
+    for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+        void* header = alloc_checked(classes[i].request);
+        assert(diram_slab_block_size(header) == classes[i].block);
+        diram_slab_free(header);
+    }
+    diram_slab_stats_t after = stats();
+    assert(after.large_allocs == before.large_allocs);
+    assert(after.allocs - before.allocs == sizeof(classes) / sizeof(classes[0]));
+    assert(after.live_blocks == before.live_blocks);
+    printf("✓ Requests rounded to %d size classes\n", DIRAM_SLAB_CLASS_COUNT);
+
+    // Freed blocks are reused by the same class
+    void* a = alloc_checked(300);
+    diram_slab_free(a);
+    before = stats();
+    assert(alloc_checked(300) == a);
+    after = stats();
+    assert(after.hits == before.hits + 1 && after.misses == before.misses);
+    diram_slab_free(a);
+
+    // Above 16 KiB: one aligned heap block, sized exactly
+    before = stats();
+    void* large = alloc_checked(DIRAM_SLAB_MAX_PAYLOAD + 1);
+    assert(diram_slab_block_size(large) == DIRAM_SLAB_BLOCK_HEADER + DIRAM_SLAB_MAX_PAYLOAD + 1);
+    void* huge = alloc_checked(1 << 20);
+    assert(diram_slab_block_size(huge) == DIRAM_SLAB_BLOCK_HEADER + (1 << 20));
+    after = stats();
+    assert(after.large_allocs == before.large_allocs + 2);
+    assert(after.hits == before.hits && after.misses == before.misses);
+    assert(after.live_blocks == before.live_blocks + 2);
+    diram_slab_free(large);
+    diram_slab_free(huge);
+    after = stats();
+    assert(after.live_blocks == before.live_blocks && after.live_reserved == before.live_reserved);
+
+    // Past what the prefix can record: refused without touching the heap
+    void* payload = NULL;
+    assert(diram_slab_alloc((size_t)UINT32_MAX + 1, &payload) == NULL);
+    after = stats();
+    assert(after.large_allocs == before.large_allocs + 2 && after.live_blocks == before.live_blocks);
+    printf("✓ Large blocks bypass the classes\n");
+
+    // Hit rate and fragmentation from the counters
+    diram_slab_stats_t s = {0};
+    assert(diram_slab_hit_rate(&s) == 0.0 && diram_slab_fragmentation(&s) == 0.0);
+    assert(diram_slab_hit_rate(NULL) == 0.0 && diram_slab_fragmentation(NULL) == 0.0);
+    s.hits = 3;
+    s.misses = 1;
+    s.live_requested = 64;
+    s.live_reserved = 256;
+    assert(diram_slab_hit_rate(&s) == 0.75 && diram_slab_fragmentation(&s) == 0.75);
+
+    before = stats();
+    void* blocks[4];
+    for (int i = 0; i < 4; i++) blocks[i] = alloc_checked(100);
+    after = stats();
+    assert(after.live_requested - before.live_requested == 400);
+    assert(after.live_reserved - before.live_reserved == 4 * (DIRAM_SLAB_BLOCK_HEADER + 128));
+    assert(diram_slab_fragmentation(&after) > 0.0 && diram_slab_fragmentation(&after) < 1.0);
+    assert(diram_slab_hit_rate(&after) > 0.0 && diram_slab_hit_rate(&after) < 1.0);
+    for (int i = 0; i < 4; i++) diram_slab_free(blocks[i]);
+    printf("✓ Hit rate %.2f, fragmentation accounted per block\n", diram_slab_hit_rate(&after));
+
+    // Blocks freed by another thread go back to the owner's arena; the
+    // owner exits and a new thread adopts the arena with them in it
+    pthread_t thread;
+    pthread_create(&thread, NULL, handoff_owner, NULL);
+    pthread_join(thread, NULL);
+    before = stats();
+    for (int i = 0; i < HANDOFF_BLOCKS; i++) diram_slab_free(g_handoff[i]);
+    after = stats();
+    assert(after.remote_frees == before.remote_frees + HANDOFF_BLOCKS);
+    pthread_create(&thread, NULL, handoff_adopter, NULL);
+    pthread_join(thread, NULL);
+    printf("✓ Remote frees returned to an adopted arena (%u arenas)\n", stats().arena_count);
+
+    // Concurrent remote frees: nothing lost from the Treiber lists
+    before = stats();
+    pthread_t workers[STRESS_THREADS];
+    pthread_barrier_init(&g_barrier, NULL, STRESS_THREADS);
+    for (int i = 0; i < STRESS_THREADS; i++) {
+        pthread_create(&workers[i], NULL, stress_worker, (void*)(intptr_t)i);
+    }
+    for (int i = 0; i < STRESS_THREADS; i++) {
+        pthread_join(workers[i], NULL);
+        assert(g_stress_misses[i] == 0);
+    }
+    pthread_barrier_destroy(&g_barrier);
+    after = stats();
+    assert(after.remote_frees - before.remote_frees >= STRESS_THREADS * STRESS_BLOCKS);
+    assert(after.live_blocks == before.live_blocks);
+    assert(after.live_reserved == before.live_reserved);
+    printf("✓ %d threads freed %d blocks each across arenas\n", STRESS_THREADS, STRESS_BLOCKS);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/feature-alloc/space_account.h"
+
+#define ACCOUNT_LIMIT   (1u << 20)
+#define ACCOUNT_THREADS 8
+#define ACCOUNT_CHARGE  100
+
+static diram_space_account_t* account;
+static int charged[ACCOUNT_THREADS];
+
+static void* charge_until_full(void* arg) {
+    int id = *(int*)arg;
+    while (diram_account_charge(account, ACCOUNT_CHARGE) == 0) {
+        charged[id]++;
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC space accounting tests...\n");
+
+    account = diram_account_create(ACCOUNT_LIMIT);
+    assert(account != NULL);
+
+    // Single thread: exact limit, nothing charged on refusal
+    size_t total = 0;
+    while (diram_account_charge(account, ACCOUNT_CHARGE) == 0) total += ACCOUNT_CHARGE;
+    assert(total == (ACCOUNT_LIMIT / ACCOUNT_CHARGE) * ACCOUNT_CHARGE);
+    assert(diram_account_used(account) == total);
+    printf("✓ Limit reached exactly: %zu of %u bytes\n", total, ACCOUNT_LIMIT);
+
+    for (size_t released = 0; released < total; released += ACCOUNT_CHARGE) {
+        diram_account_release(account, ACCOUNT_CHARGE);
+    }
+    assert(diram_account_used(account) == 0);
+    printf("✓ Release returns quota\n");
+
+    // Large charges bypass the per-CPU slots
+    assert(diram_account_charge(account, ACCOUNT_LIMIT) == 0);
+    assert(diram_account_charge(account, 1) == -1);
+    diram_account_release(account, ACCOUNT_LIMIT);
+    assert(diram_account_used(account) == 0);
+    printf("✓ Whole-limit charge\n");
+
+    // Concurrent: the sum of successful charges never exceeds the limit
+    pthread_t threads[ACCOUNT_THREADS];
+    int ids[ACCOUNT_THREADS];
+    for (int i = 0; i < ACCOUNT_THREADS; i++) {
+        ids[i] = i;
+        pthread_create(&threads[i], NULL, charge_until_full, &ids[i]);
+    }
+    total = 0;
+    for (int i = 0; i < ACCOUNT_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+        total += (size_t)charged[i] * ACCOUNT_CHARGE;
+    }
+    assert(total <= ACCOUNT_LIMIT);
+    assert(total == (ACCOUNT_LIMIT / ACCOUNT_CHARGE) * ACCOUNT_CHARGE);
+    printf("✓ %d threads filled the quota exactly, never over\n", ACCOUNT_THREADS);
+
+    diram_account_stats_t stats;
+    diram_account_get_stats(account, &stats);
+    assert(stats.used <= stats.limit);
+    printf("✓ Stats: slots=%u chunk=%zu refills=%lu reclaims=%lu bound=%zu\n",
+           stats.slots, stats.chunk, (unsigned long)stats.refills,
+           (unsigned long)stats.reclaims, diram_account_error_bound(account));
+
+    diram_account_destroy(account);
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/resource.h>
+#include "diram/core/feature-alloc/trace_log.h"
+
+#define THREADS          4
+#define PER_THREAD       3000       // ALLOC + FREE pairs, wraps each ring
+#define TOTAL            (THREADS * PER_THREAD * 2)
+
+static uint64_t g_clock;
+
+// Timestamps are unique across threads so the sorted order is exact
+static uint64_t tick(void) {
+    return __atomic_add_fetch(&g_clock, 1, __ATOMIC_RELAXED);
+}
+
+static void receipt_for(uint64_t n, char hex[65]) {
+    for (int i = 0; i < 4; i++) {
+        snprintf(hex + i * 16, 17, "%016llX", (unsigned long long)(n * 0x9E3779B97F4A7C15ULL + i));
+    }
+}
+
+static void* producer(void* arg) {
+    int id = (int)(intptr_t)arg;
+    char hex[65];
+    char tag[32];
+    for (int i = 0; i < PER_THREAD; i++) {
+        uint64_t n = (uint64_t)id * PER_THREAD + i;
+        void* addr = (void*)(uintptr_t)(0x100000 + n * 64);
+        receipt_for(n, hex);
+        snprintf(tag, sizeof(tag), "t%d-%d", id, i);
+        assert(diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, tick(), 1000 + id, addr,
+                                  (size_t)(n % 4096) + 1, hex, tag) == 0);
+        assert(diram_trace_record(DIRAM_TRACE_EVENT_FREE, tick(), 1000 + id, addr,
+                                  (size_t)(n % 4096) + 1, hex, tag) == 0);
+    }
+    return NULL;
+}
+
+// Records until the log turns it away
+static void* until_refused(void* arg) {
+    uint64_t* accepted = arg;
+    while (diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, tick(), 9, NULL, 8, NULL, "late") == 0) {
+        (*accepted)++;
+    }
+    return NULL;
+}
+
+// The ts|pid|EVENT|addr|size|receipt|tag line the log must produce
+static void expected_line(uint64_t n, int free_event, uint64_t ts, char* out, size_t length) {
+    char hex[65];
+    receipt_for(n, hex);
+    for (char* c = hex; *c; c++) {
+        if (*c >= 'A' && *c <= 'F') *c = (char)(*c - 'A' + 'a');
+    }
+    int id = (int)(n / PER_THREAD);
+    char tag[32];
+    snprintf(tag, sizeof(tag), "t%d-%d", id, (int)(n % PER_THREAD));
+    snprintf(out, length, "%lu|%d|%s|%p|%zu|%s|%s", (unsigned long)ts, 1000 + id,
+             free_event ? "FREE" : "ALLOC", (void*)(uintptr_t)(0x100000 + n * 64),
+             (size_t)(n % 4096) + 1, hex, free_event ? "traced" : tag);
+}
+
+// Decode to memory and split into lines after the header
+static char** decode(const char* path, int sorted, size_t* count) {
+    char* text = NULL;
+    size_t size = 0;
+    FILE* out = open_memstream(&text, &size);
+    assert(out);
+    assert(diram_trace_decode_file(path, out, sorted) == 0);
+    fclose(out);
+
+    assert(strncmp(text, "# DIRAM Trace Log\n", 18) == 0);
+    char** lines = malloc(sizeof(char*) * (TOTAL + 1));
+    *count = 0;
+    for (char* line = strtok(text + 18, "\n"); line; line = strtok(NULL, "\n")) {
+        assert(*count < TOTAL);
+        lines[(*count)++] = strdup(line);
+    }
+    free(text);
+    return lines;
+}
+
+static void free_lines(char** lines, size_t count) {
+    for (size_t i = 0; i < count; i++) free(lines[i]);
+    free(lines);
+}
+
+int main() {
+    printf("Running DIRAMC trace log tests...\n");
+
+    char path[] = "/tmp/diram_trace_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    unlink(path);
+
+    // Nothing is accepted while the log is closed
+    assert(diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, 1, 1, NULL, 1, NULL, NULL) == -1);
+
+    // Several producers, each wrapping its ring, then close drains
+    assert(diram_trace_open(path) == 0);
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        pthread_create(&threads[i], NULL, producer, (void*)(intptr_t)i);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    diram_trace_close();
+
+    diram_trace_stats_t stats;
+    diram_trace_get_stats(&stats);
+    assert(stats.records == TOTAL && stats.written == TOTAL);
+    assert(stats.write_errors == 0 && stats.dropped_bytes == 0);
+    assert(stats.rings >= THREADS);
+    printf("✓ %llu records from %d threads in %llu batches (%llu full waits)\n",
+           (unsigned long long)stats.written, THREADS, (unsigned long long)stats.batches,
+           (unsigned long long)stats.full_waits);
+
+    // Time order: exactly the records written, ts 1..TOTAL
+    uint64_t* ts_of = calloc(THREADS * PER_THREAD * 2, sizeof(uint64_t));
+    size_t count;
+    char** lines = decode(path, 1, &count);
+    assert(count == TOTAL);
+    char expected[512];
+    for (size_t i = 0; i < count; i++) {
+        unsigned long ts;
+        int pid;
+        char event[8];
+        unsigned int slot;
+        assert(sscanf(lines[i], "%lu|%d|%7[A-Z]|0x%x", &ts, &pid, event, &slot) == 4);
+        assert(ts == i + 1);
+        uint64_t n = (slot - 0x100000) / 64;
+        int free_event = strcmp(event, "FREE") == 0;
+        assert(n < THREADS * PER_THREAD && !ts_of[n * 2 + free_event]);
+        ts_of[n * 2 + free_event] = ts;
+        expected_line(n, free_event, ts, expected, sizeof(expected));
+        assert(strcmp(lines[i], expected) == 0);
+    }
+    free_lines(lines, count);
+    printf("✓ Sorted decode matches every record written\n");
+
+    // Batch order: same lines, each thread's records in its own order
+    lines = decode(path, 0, &count);
+    assert(count == TOTAL);
+    uint64_t last_ts[THREADS] = {0};
+    for (size_t i = 0; i < count; i++) {
+        unsigned long ts;
+        int pid;
+        assert(sscanf(lines[i], "%lu|%d|", &ts, &pid) == 2);
+        assert(pid >= 1000 && pid < 1000 + THREADS && ts > last_ts[pid - 1000]);
+        last_ts[pid - 1000] = ts;
+        char* event = strchr(strchr(lines[i], '|') + 1, '|') + 1;
+        unsigned int slot;
+        assert(sscanf(strchr(event, '|'), "|0x%x", &slot) == 1);
+        uint64_t n = (slot - 0x100000) / 64;
+        int free_event = strncmp(event, "FREE", 4) == 0;
+        assert(ts_of[n * 2 + free_event] == ts);
+        expected_line(n, free_event, ts, expected, sizeof(expected));
+        assert(strcmp(lines[i], expected) == 0);
+    }
+    free_lines(lines, count);
+    free(ts_of);
+    printf("✓ Unsorted decode keeps per-thread order\n");
+
+    // A failing write keeps the records queued; they land once it succeeds
+    signal(SIGXFSZ, SIG_IGN);
+    struct rlimit saved, limit;
+    assert(getrlimit(RLIMIT_FSIZE, &saved) == 0);
+    char fresh[] = "/tmp/diram_trace_XXXXXX";
+    fd = mkstemp(fresh);
+    assert(fd >= 0);
+    close(fd);
+    unlink(fresh);
+    assert(diram_trace_open(fresh) == 0);
+    limit = saved;
+    limit.rlim_cur = sizeof(diram_trace_file_header_t) + 10 * sizeof(diram_trace_record_t) + 50;
+    assert(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+    for (int i = 0; i < 100; i++) {
+        assert(diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, 1000 + i, 7,
+                                  (void*)(uintptr_t)(0x1000 + i), 16, NULL, "retry") == 0);
+    }
+    diram_trace_flush();
+    diram_trace_stats_t failing;
+    diram_trace_get_stats(&failing);
+    assert(failing.write_errors > stats.write_errors);
+    assert(failing.written == stats.written);
+    assert(setrlimit(RLIMIT_FSIZE, &saved) == 0);
+    diram_trace_flush();
+    diram_trace_close();
+    diram_trace_get_stats(&stats);
+    assert(stats.written == failing.written + 100 && stats.dropped_bytes == 0);
+
+    lines = decode(fresh, 0, &count);
+    assert(count == 100);
+    for (size_t i = 0; i < count; i++) {
+        unsigned long ts;
+        assert(sscanf(lines[i], "%lu|7|ALLOC|", &ts) == 1 && ts == 1000 + i);
+    }
+    free_lines(lines, count);
+    printf("✓ Failed batch retried in place (%llu write errors, nothing dropped)\n",
+           (unsigned long long)(stats.write_errors));
+
+    // After close a record is refused and counted, not queued
+    diram_trace_stats_t before;
+    diram_trace_get_stats(&before);
+    assert(diram_trace_record(DIRAM_TRACE_EVENT_ALLOC, 1, 7, NULL, 16, NULL, "late") == -1);
+    diram_trace_get_stats(&stats);
+    assert(stats.refused == before.refused + 1 && stats.records == before.records);
+
+    // Closing under a running producer: every accepted record is written
+    // or counted as dropped, and the producer is told when it is refused
+    char racing[] = "/tmp/diram_trace_XXXXXX";
+    fd = mkstemp(racing);
+    assert(fd >= 0);
+    close(fd);
+    unlink(racing);
+    diram_trace_get_stats(&before);
+    assert(diram_trace_open(racing) == 0);
+    pthread_t late;
+    uint64_t accepted = 0;
+    pthread_create(&late, NULL, until_refused, &accepted);
+    usleep(2000);
+    diram_trace_close();
+    pthread_join(late, NULL);
+    diram_trace_get_stats(&stats);
+    assert(stats.records - before.records == accepted);
+    assert((stats.written - before.written) +
+           (stats.dropped_bytes - before.dropped_bytes) / sizeof(diram_trace_record_t) == accepted);
+    assert(stats.refused == before.refused + 1);
+    printf("✓ Close under load: %llu accepted, none stranded, late record refused\n",
+           (unsigned long long)accepted);
+
+    unlink(path);
+    unlink(fresh);
+    unlink(racing);
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <stdint.h>
+#include "diram/core/feature-alloc/async_promise.h"
+#include "diram/core/feature-alloc/async_executor.h"
+#include "diram/core/crypto/sha256.h"
+
+#define BATCH_COUNT 100
+
+// Same bytes a single async allocation hashes
+typedef struct {
+    void* addr;
+    size_t size;
+    time_t timestamp;
+    char tag[64];
+} receipt_input_t;
+
+static void expected_receipt(const diram_allocation_t* base, char hex[65]) {
+    receipt_input_t input;
+    memset(&input, 0, sizeof(input));
+    input.addr = base->ptr;
+    input.size = base->size;
+    input.timestamp = (time_t)base->timestamp;
+    strncpy(input.tag, base->tag ? base->tag : "untagged", sizeof(input.tag) - 1);
+    diram_sha256_hex(&input, sizeof(input), hex);
+}
+
+int main() {
+    printf("Running DIRAMC batch allocation tests...\n");
+
+    size_t sizes[BATCH_COUNT];
+    const char* tags[BATCH_COUNT];
+    char names[BATCH_COUNT][16];
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        sizes[i] = 1 + (size_t)(i * 37) % 4000;
+        snprintf(names[i], sizeof(names[i]), "buf_%d", i);
+        tags[i] = (i % 10 == 0) ? NULL : names[i];
+    }
+
+    diram_promise_all_t* batch = diram_alloc_async_batch(sizes, tags, BATCH_COUNT, NULL);
+    assert(batch && batch->count == BATCH_COUNT);
+    assert(diram_promise_await(batch->aggregate_promise, 5000) == 0);
+    assert(batch->aggregate_promise->result.resolved_allocation == batch->allocations);
+    printf("✓ One aggregate promise for %d buffers\n", BATCH_COUNT);
+
+    // Buffers are aligned, disjoint and laid out in one reservation
+    char* prev_end = NULL;
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        diram_enhanced_allocation_t* alloc = batch->results[i];
+        assert(alloc->base.size == sizes[i]);
+        assert(alloc->base.flags & DIRAM_ALLOC_FLAG_BATCH);
+        assert(((uintptr_t)alloc->base.ptr % DIRAM_ALLOC_BATCH_ALIGN) == 0);
+        if (i == 0) assert(alloc->base.ptr == batch->reservation);
+        else assert((char*)alloc->base.ptr >= prev_end);
+        prev_end = (char*)alloc->base.ptr + alloc->base.size;
+        memset(alloc->base.ptr, 0xA5, alloc->base.size);
+    }
+    printf("✓ Buffers aligned and contiguous\n");
+
+    // Tags survive the caller's array and batch receipts match single hashing
+    for (int i = 0; i < BATCH_COUNT; i++) {
+        diram_enhanced_allocation_t* alloc = batch->results[i];
+        if (tags[i]) assert(strcmp(alloc->base.tag, tags[i]) == 0);
+        else assert(alloc->base.tag == NULL);
+
+        char hex[65];
+        expected_receipt(&alloc->base, hex);
+        assert(strcmp(hex, alloc->base.sha256_receipt) == 0);
+    }
+    printf("✓ Tags and receipts match per-allocation hashing\n");
+
+    diram_alloc_batch_release(batch);
+
+    // Untagged batch of one, released without an explicit await
+    size_t one = 128;
+    batch = diram_alloc_async_batch(&one, NULL, 1, NULL);
+    assert(batch);
+    diram_alloc_batch_release(batch);
+    assert(diram_alloc_async_batch(NULL, NULL, 4, NULL) == NULL);
+    assert(diram_alloc_async_batch(&one, NULL, 0, NULL) == NULL);
+    printf("✓ Edge cases handled\n");
+
+    // The batch total is charged to the space and returned on release
+    diram_memory_space_t* space = diram_space_create("batch", 10000);
+    assert(space);
+    size_t pair[2] = { 4000, 4000 };
+    diram_promise_all_t* held = diram_alloc_async_batch(pair, NULL, 2, space);
+    assert(held && diram_promise_await(held->aggregate_promise, 5000) == 0);
+    batch = diram_alloc_async_batch(pair, NULL, 2, space);
+    assert(batch && diram_promise_await(batch->aggregate_promise, 5000) == -1);
+    assert(batch->aggregate_promise->receipt.reject_reason == REJECT_REASON_GOVERNANCE_VIOLATION);
+    assert(batch->results == NULL);
+    diram_alloc_batch_release(batch);
+    diram_alloc_batch_release(held);
+    batch = diram_alloc_async_batch(pair, NULL, 2, space);
+    assert(batch && diram_promise_await(batch->aggregate_promise, 5000) == 0);
+    diram_alloc_batch_release(batch);
+    diram_space_destroy(space);
+    printf("✓ Batch charged against the space limit\n");
+
+    diram_executor_shutdown();
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "diram/core/feature-alloc/async_executor.h"
+#include "diram/core/feature-alloc/async_promise.h"
+
+#define FLAT_TASKS     20000
+#define SUBMITTERS     4
+#define FANOUT_ROOTS   16
+#define FANOUT_CHILDREN 256
+#define ASYNC_ALLOCS   2000
+
+typedef struct {
+    diram_task_t task;
+    int spawn;
+} counted_task_t;
+
+static atomic_int executed;
+
+static void count_run(diram_task_t* task) {
+    counted_task_t* t = (counted_task_t*)task;
+    // Children pushed from a worker land on its own deque for peers to steal
+    for (int i = 0; i < t->spawn; i++) {
+        counted_task_t* child = calloc(1, sizeof(counted_task_t));
+        child->task.run = count_run;
+        diram_executor_submit(&child->task);
+    }
+    atomic_fetch_add(&executed, 1);
+    free(t);
+}
+
+static void submit_counted(int spawn) {
+    counted_task_t* t = calloc(1, sizeof(counted_task_t));
+    assert(t);
+    t->task.run = count_run;
+    t->spawn = spawn;
+    diram_executor_submit(&t->task);
+}
+
+static void* submitter(void* arg) {
+    (void)arg;
+    for (int i = 0; i < FLAT_TASKS / SUBMITTERS; i++) submit_counted(0);
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC async executor tests...\n");
+
+    diram_executor_configure(4, 0);
+
+    // Tasks from many external threads all run exactly once
+    pthread_t threads[SUBMITTERS];
+    for (int i = 0; i < SUBMITTERS; i++) pthread_create(&threads[i], NULL, submitter, NULL);
+    for (int i = 0; i < SUBMITTERS; i++) pthread_join(threads[i], NULL);
+    diram_executor_shutdown();
+    assert(atomic_load(&executed) == FLAT_TASKS);
+
+    diram_executor_stats_t stats;
+    diram_executor_get_stats(&stats);
+    assert(stats.submitted + stats.inlined == FLAT_TASKS);
+    assert(stats.executed == stats.submitted);
+    assert(stats.queue_depth == 0);
+    assert(stats.peak_depth > 0);
+    printf("✓ %d tasks from %d threads (peak depth %llu)\n", FLAT_TASKS, SUBMITTERS,
+           (unsigned long long)stats.peak_depth);
+
+    // Work spawned by workers is shared out by stealing
+    atomic_store(&executed, 0);
+    for (int i = 0; i < FANOUT_ROOTS; i++) submit_counted(FANOUT_CHILDREN);
+    diram_executor_shutdown();
+    assert(atomic_load(&executed) == FANOUT_ROOTS * (FANOUT_CHILDREN + 1));
+    diram_executor_get_stats(&stats);
+    assert(stats.queue_depth == 0);
+    printf("✓ Fan-out drained (%llu steals, %llu injected)\n",
+           (unsigned long long)stats.steals, (unsigned long long)stats.injected);
+
+    // Past max_pending the submitter runs the task itself
+    diram_executor_configure(1, 1);
+    uint64_t inlined_before = stats.inlined;
+    for (int i = 0; i < 1000; i++) submit_counted(0);
+    diram_executor_shutdown();
+    diram_executor_get_stats(&stats);
+    assert(stats.inlined > inlined_before);
+    printf("✓ Back-pressure runs %llu tasks inline\n",
+           (unsigned long long)(stats.inlined - inlined_before));
+
+    // Async allocations resolve through the pool and await as before
+    diram_executor_configure(2, 0);
+    diram_async_promise_t** promises = calloc(ASYNC_ALLOCS, sizeof(*promises));
+    for (int i = 0; i < ASYNC_ALLOCS; i++) {
+        promises[i] = diram_alloc_async(64 + (size_t)i, "exec_test", NULL, 0);
+        assert(promises[i]);
+    }
+    for (int i = 0; i < ASYNC_ALLOCS; i++) {
+        assert(diram_promise_await(promises[i], 5000) == 0);
+        diram_enhanced_allocation_t* alloc = promises[i]->result.resolved_allocation;
+        assert(alloc && alloc->base.size == 64 + (size_t)i);
+        free(alloc->base.ptr);
+        free(alloc->base.tag);
+        free(alloc);
+        diram_promise_destroy(promises[i]);
+    }
+    free(promises);
+    printf("✓ %d async allocations resolved via the executor\n", ASYNC_ALLOCS);
+
+    // Async allocations are charged to their space and refused past its limit
+    diram_memory_space_t* space = diram_space_create("async", 4096);
+    assert(space);
+    diram_async_promise_t* first = diram_alloc_async(3000, "quota", space, 0);
+    assert(diram_promise_await(first, 5000) == 0);
+    diram_async_promise_t* over = diram_alloc_async(3000, "quota", space, 0);
+    assert(diram_promise_await(over, 5000) == -1);
+    assert(over->receipt.reject_reason == REJECT_REASON_GOVERNANCE_VIOLATION);
+    diram_async_promise_t* looked = diram_alloc_with_lookahead(3000, "quota", space, 0);
+    assert(diram_promise_await(looked, 5000) == -1);
+    diram_fpromise_t* compact = diram_alloc_async_compact(3000, "quota", space);
+    assert(diram_fpromise_await(compact, 5000) != 0);
+    diram_fpromise_release(compact);
+
+    // Releasing returns the quota
+    diram_alloc_async_release(first->result.resolved_allocation, space);
+    diram_async_promise_t* again = diram_alloc_async(3000, "quota", space, 0);
+    assert(diram_promise_await(again, 5000) == 0);
+    diram_alloc_async_release(again->result.resolved_allocation, space);
+    diram_promise_destroy(first);
+    diram_promise_destroy(over);
+    diram_promise_destroy(looked);
+    diram_promise_destroy(again);
+    diram_space_destroy(space);
+    diram_executor_shutdown();
+    printf("✓ Async allocations charged against the space limit\n");
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/feature-alloc/lookahead_cache.h"
+#include "diram/core/feature-alloc/async_promise.h"
+#include "diram/core/feature-alloc/async_executor.h"
+
+#define CAPACITY       256
+#define READERS        3
+#define WRITER_ROUNDS  20000
+
+static int stop_readers;
+
+static void* reader(void* arg) {
+    (void)arg;
+    diram_lookahead_prediction_t pred;
+    while (!__atomic_load_n(&stop_readers, __ATOMIC_ACQUIRE)) {
+        for (uint32_t pattern = 0; pattern < 64; pattern++) {
+            if (diram_lookahead_cache_lookup("hot", pattern, &pred) == 0) {
+                // Writers only ever store (pattern + 1) * 16 for this key
+                assert(pred.predicted_size == (pattern + 1) * 16);
+                assert(pred.confidence >= 0.3 && pred.confidence <= 1.0);
+            }
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC lookahead cache tests...\n");
+
+    // Capacity is fixed once the cache is built
+    assert(diram_lookahead_cache_configure(CAPACITY) == 0);
+    diram_lookahead_prediction_t pred;
+    assert(diram_lookahead_cache_lookup("tensor", 7, &pred) == -1);
+    assert(diram_lookahead_cache_configure(CAPACITY * 2) == -1);
+    diram_lookahead_stats_t stats;
+    diram_lookahead_cache_get_stats(&stats);
+    assert(stats.capacity == CAPACITY && stats.misses == 1);
+    printf("✓ Configured capacity %zu\n", stats.capacity);
+
+    // Keys are (tag, pattern): same pattern under another tag is a miss
+    diram_lookahead_cache_record("tensor", 7, 4096);
+    assert(diram_lookahead_cache_lookup("tensor", 7, &pred) == 0);
+    assert(pred.predicted_size == 4096 && pred.confidence == 0.5);
+    assert(diram_lookahead_cache_lookup("tensor", 8, &pred) == -1);
+    assert(diram_lookahead_cache_lookup("vector", 7, &pred) == -1);
+    printf("✓ Keyed by tag and access pattern\n");
+
+    // Confidence grows while the size recurs; a new size takes over slowly
+    for (int i = 0; i < 4; i++) diram_lookahead_cache_record("tensor", 7, 4096);
+    assert(diram_lookahead_cache_lookup("tensor", 7, &pred) == 0);
+    assert(pred.confidence > 0.7);
+    diram_lookahead_cache_record("tensor", 7, 512);
+    diram_lookahead_cache_lookup("tensor", 7, &pred);
+    assert(pred.predicted_size == 4096);
+    diram_lookahead_cache_record("tensor", 7, 512);
+    diram_lookahead_cache_lookup("tensor", 7, &pred);
+    assert(pred.predicted_size == 512 && pred.confidence == 0.5);
+    printf("✓ Confidence tracks recurring sizes\n");
+
+    // Filling far past capacity evicts but never grows the table
+    diram_lookahead_cache_clear();
+    for (uint32_t pattern = 0; pattern < CAPACITY * 4; pattern++) {
+        diram_lookahead_cache_record("fill", pattern, 64);
+    }
+    diram_lookahead_cache_get_stats(&stats);
+    assert(stats.entries <= CAPACITY);
+    assert(stats.inserts == CAPACITY * 4);
+    assert(stats.evictions == stats.inserts - stats.entries);
+    printf("✓ %zu entries after %llu inserts (%llu evictions)\n", stats.entries,
+           (unsigned long long)stats.inserts, (unsigned long long)stats.evictions);
+
+    // Referenced entries survive a CLOCK sweep better than unreferenced ones
+    int kept[2];
+    for (int referenced = 0; referenced < 2; referenced++) {
+        diram_lookahead_cache_clear();
+        for (uint32_t pattern = 0; pattern < CAPACITY / 2; pattern++) {
+            diram_lookahead_cache_record("keep", pattern, 64);
+            if (referenced) diram_lookahead_cache_lookup("keep", pattern, NULL);
+        }
+        for (uint32_t pattern = 0; pattern < CAPACITY / 2; pattern++) {
+            diram_lookahead_cache_record("cold", pattern, 64);
+        }
+        kept[referenced] = 0;
+        for (uint32_t pattern = 0; pattern < CAPACITY / 2; pattern++) {
+            kept[referenced] += diram_lookahead_cache_lookup("keep", pattern, NULL) == 0;
+        }
+    }
+    assert(kept[1] > kept[0]);
+    diram_lookahead_cache_get_stats(&stats);
+    assert(stats.hit_ratio > 0.5 && stats.hit_ratio < 1.0);
+    printf("✓ CLOCK kept %d referenced vs %d unreferenced, hit ratio %.2f\n",
+           kept[1], kept[0], stats.hit_ratio);
+
+    // Seqlock readers never see a torn entry
+    diram_lookahead_cache_clear();
+    pthread_t threads[READERS];
+    for (int i = 0; i < READERS; i++) pthread_create(&threads[i], NULL, reader, NULL);
+    for (int round = 0; round < WRITER_ROUNDS; round++) {
+        uint32_t pattern = (uint32_t)round % 64;
+        diram_lookahead_cache_record("hot", pattern, (pattern + 1) * 16);
+        diram_lookahead_cache_record("noise", (uint32_t)round, 1);
+    }
+    __atomic_store_n(&stop_readers, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < READERS; i++) pthread_join(threads[i], NULL);
+    diram_lookahead_cache_get_stats(&stats);
+    printf("✓ %d concurrent readers, %llu read retries\n", READERS,
+           (unsigned long long)stats.read_retries);
+
+    // Lookahead allocations learn the requested size for their pattern
+    diram_lookahead_cache_clear();
+    for (int i = 0; i < 6; i++) {
+        diram_async_promise_t* p = diram_alloc_with_lookahead(1000, "learned", NULL, 42);
+        assert(diram_promise_await(p, 5000) == 0);
+        diram_enhanced_allocation_t* alloc = p->result.resolved_allocation;
+        free(alloc->base.ptr);
+        free(alloc->base.tag);
+        free(alloc);
+        diram_promise_destroy(p);
+    }
+    diram_executor_shutdown();
+    assert(diram_lookahead_cache_lookup("learned", 42, &pred) == 0);
+    assert(pred.predicted_size == 1000 && pred.confidence > 0.7);
+    printf("✓ Async lookahead allocations recorded (confidence %.2f)\n", pred.confidence);
+
+    printf("All tests passed!\n");
+    return 0;
+}
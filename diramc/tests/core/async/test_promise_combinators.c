@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "diram/core/feature-alloc/async_promise.h"
+#include "diram/core/feature-alloc/async_executor.h"
+
+#define CHILDREN   10000
+#define SETTLERS   4
+
+static diram_async_promise_t* children[CHILDREN];
+static diram_enhanced_allocation_t values[CHILDREN];
+static int fulfilled_calls;
+static int rejected_calls;
+static diram_reject_reason_t last_reason;
+
+static void on_fulfilled(diram_enhanced_allocation_t* alloc) {
+    (void)alloc;
+    __atomic_fetch_add(&fulfilled_calls, 1, __ATOMIC_RELAXED);
+}
+
+static void on_rejected(diram_reject_reason_t reason, const char* msg) {
+    (void)msg;
+    last_reason = reason;
+    __atomic_fetch_add(&rejected_calls, 1, __ATOMIC_RELAXED);
+}
+
+static void make_children(void) {
+    for (int i = 0; i < CHILDREN; i++) {
+        children[i] = diram_promise_create(NULL);
+        assert(children[i]);
+    }
+}
+
+static void destroy_children(void) {
+    for (int i = 0; i < CHILDREN; i++) diram_promise_destroy(children[i]);
+}
+
+static diram_async_promise_t* watch(diram_async_promise_t* aggregate) {
+    fulfilled_calls = 0;
+    rejected_calls = 0;
+    return aggregate->thenable.then(aggregate, on_fulfilled, on_rejected);
+}
+
+static void await_settled(diram_async_promise_t* promise) {
+    // diram_promise_await returns early on a spurious wakeup
+    while (diram_promise_get_status(promise).err == DIRAM_ERR_PENDING) {
+        diram_promise_await(promise, 5000);
+    }
+}
+
+// Holds the single executor worker until the race is built
+static int gate_open;
+
+static void gate_run(diram_task_t* task) {
+    (void)task;
+    while (!__atomic_load_n(&gate_open, __ATOMIC_ACQUIRE)) sched_yield();
+}
+
+static void* settle_stripe(void* arg) {
+    int id = (int)(intptr_t)arg;
+    for (int i = id; i < CHILDREN; i += SETTLERS) {
+        diram_promise_resolve_internal(children[i], &values[i]);
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC promise combinator tests...\n");
+
+    // all: children settled from several threads, aggregate fires once
+    make_children();
+    diram_promise_all_t* all = diram_promise_all(children, CHILDREN);
+    assert(all);
+    diram_async_promise_t* next = watch(all->aggregate_promise);
+    assert(diram_promise_get_status(all->aggregate_promise).err == DIRAM_ERR_PENDING);
+
+    pthread_t threads[SETTLERS];
+    for (int i = 0; i < SETTLERS; i++) {
+        pthread_create(&threads[i], NULL, settle_stripe, (void*)(intptr_t)i);
+    }
+    await_settled(all->aggregate_promise);
+    for (int i = 0; i < SETTLERS; i++) pthread_join(threads[i], NULL);
+
+    assert(diram_promise_get_status(all->aggregate_promise).ok);
+    assert(fulfilled_calls == 1 && rejected_calls == 0);
+    for (int i = 0; i < CHILDREN; i++) assert(all->results[i] == &values[i]);
+    diram_promise_all_destroy(all);
+    diram_promise_destroy(next);
+    destroy_children();
+    printf("✓ all over %d children woke once with ordered results\n", CHILDREN);
+
+    // all: first rejection settles the aggregate, later children are ignored
+    make_children();
+    all = diram_promise_all(children, CHILDREN);
+    next = watch(all->aggregate_promise);
+    diram_promise_reject_internal(children[777], REJECT_REASON_GOVERNANCE_VIOLATION, "denied");
+    for (int i = 0; i < CHILDREN; i++) diram_promise_resolve_internal(children[i], &values[i]);
+    assert(rejected_calls == 1 && fulfilled_calls == 0);
+    assert(last_reason == REJECT_REASON_GOVERNANCE_VIOLATION);
+    diram_promise_all_destroy(all);
+    diram_promise_destroy(next);
+    destroy_children();
+    printf("✓ all rejects once on the first failed child\n");
+
+    // race: first child wins, every loser is cancelled immediately
+    make_children();
+    diram_promise_race_t* race = diram_promise_race(children, CHILDREN);
+    assert(race);
+    next = watch(race->winner_promise);
+    diram_promise_resolve_internal(children[4242], &values[4242]);
+    assert(fulfilled_calls == 1 && rejected_calls == 0);
+    assert(race->winner_index == 4242);
+    assert(race->winner_promise->result.resolved_allocation == &values[4242]);
+    for (int i = 0; i < CHILDREN; i++) {
+        if (i == 4242) continue;
+        assert(children[i]->receipt.state == PROMISE_STATE_REJECTED);
+        assert(children[i]->receipt.reject_reason == REJECT_REASON_CANCELLED);
+    }
+    diram_promise_race_destroy(race);
+    diram_promise_destroy(next);
+    destroy_children();
+    printf("✓ race over %d children cancelled %d losers\n", CHILDREN, CHILDREN - 1);
+
+    // race over real async allocations: queued losers never allocate
+    diram_executor_configure(1, 0);
+    diram_task_t gate = { .run = gate_run };
+    diram_executor_submit(&gate);
+    for (int i = 0; i < CHILDREN; i++) {
+        children[i] = diram_alloc_async(128, "race", NULL, 0);
+        assert(children[i]);
+    }
+    race = diram_promise_race(children, CHILDREN);
+    __atomic_store_n(&gate_open, 1, __ATOMIC_RELEASE);
+    await_settled(race->winner_promise);
+    assert(diram_promise_get_status(race->winner_promise).ok);
+    diram_promise_race_destroy(race);
+    diram_executor_shutdown();
+
+    int allocated = 0;
+    for (int i = 0; i < CHILDREN; i++) {
+        if (children[i]->receipt.state == PROMISE_STATE_RESOLVED) {
+            diram_enhanced_allocation_t* alloc = children[i]->result.resolved_allocation;
+            free(alloc->base.ptr);
+            free(alloc->base.tag);
+            free(alloc);
+            allocated++;
+        }
+    }
+    destroy_children();
+    assert(allocated == 1);
+    printf("✓ Async race allocated %d of %d buffers\n", allocated, CHILDREN);
+
+    // Destroying a pending combinator cancels its children
+    make_children();
+    all = diram_promise_all(children, CHILDREN);
+    diram_promise_all_destroy(all);
+    for (int i = 0; i < CHILDREN; i++) {
+        assert(children[i]->receipt.reject_reason == REJECT_REASON_CANCELLED);
+    }
+    destroy_children();
+
+    // Already-settled children settle the aggregate during construction
+    diram_async_promise_t* settled[2] = {
+        diram_promise_resolve(&values[0]),
+        diram_promise_reject(REJECT_REASON_TIMEOUT, "slow"),
+    };
+    race = diram_promise_race(settled, 2);
+    assert(race->winner_index == 0 && diram_promise_get_status(race->winner_promise).ok);
+    diram_promise_race_destroy(race);
+    all = diram_promise_all(settled, 2);
+    assert(diram_promise_get_status(all->aggregate_promise).err == DIRAM_ERR_MEMORY_EXHAUSTED);
+    diram_promise_all_destroy(all);
+    diram_promise_destroy(settled[0]);
+    diram_promise_destroy(settled[1]);
+    printf("✓ Destroy cancels pending children; settled children handled\n");
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "diram/core/feature-alloc/promise_futex.h"
+#include "diram/core/feature-alloc/async_promise.h"
+#include "diram/core/feature-alloc/async_executor.h"
+
+#define WAITERS        4
+#define RACE_ROUNDS    10000
+#define COMPACT_ALLOCS 1000
+
+static int order[4];
+static int order_len;
+
+static void record(diram_fpromise_t* promise, void* context) {
+    (void)promise;
+    order[order_len++] = (int)(intptr_t)context;
+}
+
+static diram_fpromise_t* shared;
+
+static void* waiter(void* arg) {
+    (void)arg;
+    assert(diram_fpromise_await(shared, 5000) == 0);
+    assert(diram_fpromise_state(shared) == DIRAM_FPROMISE_RESOLVED);
+    return NULL;
+}
+
+static diram_fpromise_t* race_promise;
+static pthread_barrier_t race_start;
+static int race_calls;
+
+static void count_call(diram_fpromise_t* promise, void* context) {
+    (void)promise;
+    __atomic_fetch_add((int*)context, 1, __ATOMIC_RELAXED);
+}
+
+static void* race_settler(void* arg) {
+    (void)arg;
+    for (int i = 0; i < RACE_ROUNDS; i++) {
+        pthread_barrier_wait(&race_start);
+        diram_fpromise_resolve(race_promise, NULL);
+        pthread_barrier_wait(&race_start);
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC compact promise tests...\n");
+
+    // Settled promises are recycled through the thread's freelist
+    diram_fpromise_t* p = diram_fpromise_create();
+    assert(p && diram_fpromise_state(p) == DIRAM_FPROMISE_PENDING);
+    int value = 42;
+    assert(diram_fpromise_resolve(p, &value) == 0);
+    assert(diram_fpromise_resolve(p, NULL) == -1);
+    assert(diram_fpromise_reject(p, 1, "late") == -1);
+    assert(diram_fpromise_await(p, 0) == 0 && p->value == &value);
+    diram_fpromise_release(p);
+    assert(diram_fpromise_create() == p);
+    diram_fpromise_release(p);
+    printf("✓ Settle once, await, recycle (%zu bytes)\n", sizeof(diram_fpromise_t));
+
+    // Continuations run in attachment order; late ones run inline
+    p = diram_fpromise_create();
+    for (int i = 0; i < 3; i++) assert(diram_fpromise_then(p, record, (void*)(intptr_t)i) == 0);
+    assert(order_len == 0);
+    assert(diram_fpromise_reject(p, REJECT_REASON_CANCELLED, "cancelled") == 0);
+    assert(order_len == 3 && order[0] == 0 && order[1] == 1 && order[2] == 2);
+    assert(diram_fpromise_then(p, record, (void*)(intptr_t)3) == 0);
+    assert(order_len == 4 && order[3] == 3);
+    assert(diram_fpromise_await(p, 0) == -1);
+    assert(p->reason == REJECT_REASON_CANCELLED);
+    diram_fpromise_release(p);
+    printf("✓ Continuations ordered, rejection propagated\n");
+
+    // A pending await times out
+    p = diram_fpromise_create();
+    assert(diram_fpromise_await(p, 20) == DIRAM_ERR_TIMEOUT);
+    diram_fpromise_resolve(p, NULL);
+    diram_fpromise_release(p);
+    printf("✓ Await times out while pending\n");
+
+    // Every blocked waiter is woken by one settle
+    shared = diram_fpromise_create();
+    pthread_t threads[WAITERS];
+    for (int i = 0; i < WAITERS; i++) pthread_create(&threads[i], NULL, waiter, NULL);
+    usleep(20000);
+    assert(diram_fpromise_resolve(shared, NULL) == 0);
+    for (int i = 0; i < WAITERS; i++) pthread_join(threads[i], NULL);
+    diram_fpromise_release(shared);
+    printf("✓ %d futex waiters woken\n", WAITERS);
+
+    // then() racing settle runs exactly once either way
+    pthread_barrier_init(&race_start, NULL, 2);
+    pthread_t settler;
+    pthread_create(&settler, NULL, race_settler, NULL);
+    for (int i = 0; i < RACE_ROUNDS; i++) {
+        race_promise = diram_fpromise_create();
+        pthread_barrier_wait(&race_start);
+        diram_fpromise_then(race_promise, count_call, &race_calls);
+        pthread_barrier_wait(&race_start);
+        assert(diram_fpromise_await(race_promise, 5000) == 0);
+        diram_fpromise_release(race_promise);
+    }
+    pthread_join(settler, NULL);
+    assert(race_calls == RACE_ROUNDS);
+    printf("✓ %d then/settle races, each continuation ran once\n", RACE_ROUNDS);
+
+    // Async allocations through the executor
+    diram_fpromise_t* promises[COMPACT_ALLOCS];
+    for (int i = 0; i < COMPACT_ALLOCS; i++) {
+        promises[i] = diram_alloc_async_compact(32 + (size_t)i, "compact", NULL);
+        assert(promises[i]);
+    }
+    for (int i = 0; i < COMPACT_ALLOCS; i++) {
+        assert(diram_fpromise_await(promises[i], 5000) == 0);
+        diram_enhanced_allocation_t* alloc = promises[i]->value;
+        assert(alloc->base.size == 32 + (size_t)i);
+        free(alloc->base.ptr);
+        free(alloc->base.tag);
+        free(alloc);
+        diram_fpromise_release(promises[i]);
+    }
+    diram_executor_shutdown();
+    printf("✓ %d compact async allocations\n", COMPACT_ALLOCS);
+
+    printf("All tests passed!\n");
+    return 0;
+}
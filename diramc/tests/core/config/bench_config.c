@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "diram/core/config/config.h"
+#include "diram/core/config/config_cache.h"
+
+// Cold start to a validated config: each run execs a fresh copy of this
+// binary that does init + load_hierarchy + validate, once from the text
+// files and once from the compiled .drcb cache. Reports the time from
+// init to a validated config and the whole process lifetime.
+
+#define BENCH_RUNS  201
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Child side: load, validate and report the elapsed time on stdout
+static int run_child(void) {
+    double start = now_sec();
+    diram_config_init();
+    diram_config_load_hierarchy();
+    bool valid = diram_config_validate();
+    double elapsed = now_sec() - start;
+    if (!valid) return 1;
+    return write(STDOUT_FILENO, &elapsed, sizeof(elapsed)) == sizeof(elapsed) ? 0 : 1;
+}
+
+typedef struct {
+    const char* label;
+    char cache[128];                // $DIRAM_CONFIG_CACHE, empty for text
+    double load[BENCH_RUNS];
+    double process[BENCH_RUNS];
+} mode_t_;
+
+static void run_once(const char* self, mode_t_* mode, int run) {
+    setenv(DIRAM_CONFIG_CACHE_ENV, mode->cache, 1);
+    int fds[2];
+    if (pipe(fds) != 0) exit(1);
+    double start = now_sec();
+    pid_t pid = fork();
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        execl(self, self, "child", (char*)NULL);
+        _exit(1);
+    }
+    close(fds[1]);
+    int status;
+    if (read(fds[0], &mode->load[run], sizeof(double)) != sizeof(double) ||
+        waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        fprintf(stderr, "%s: run %d failed\n", mode->label, run);
+        exit(1);
+    }
+    mode->process[run] = now_sec() - start;
+    close(fds[0]);
+}
+
+static void report(mode_t_* mode) {
+    qsort(mode->load, BENCH_RUNS, sizeof(double), compare_double);
+    qsort(mode->process, BENCH_RUNS, sizeof(double), compare_double);
+    printf("  %-26s load median %6.1f us  p90 %6.1f us   process median %6.1f us\n", mode->label,
+           mode->load[BENCH_RUNS / 2] * 1e6, mode->load[BENCH_RUNS * 9 / 10] * 1e6,
+           mode->process[BENCH_RUNS / 2] * 1e6);
+}
+
+static void compile(const char* cache) {
+    setenv(DIRAM_CONFIG_CACHE_ENV, cache, 1);
+    diram_config_init();
+    diram_config_load_hierarchy();
+    diram_config_cleanup();
+}
+
+static void backdate(const char* path) {
+    struct timespec times[2] = { { time(NULL) - 60, 0 }, { time(NULL) - 60, 0 } };
+    utimensat(AT_FDCWD, path, times, 0);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "child") == 0) return run_child();
+
+    char self[PATH_MAX];
+    if (!realpath(argv[0], self)) return 1;
+    printf("DIRAMC config cold start (%d runs each, interleaved)\n", BENCH_RUNS);
+
+    char root[64] = "/tmp/diram_bench_config_XXXXXX";
+    char work[96];
+    if (!mkdtemp(root)) return 1;
+    snprintf(work, sizeof(work), "%s/work", root);
+    if (mkdir(work, 0700) != 0 || chdir(work) != 0) return 1;
+    setenv("HOME", root, 1);
+    unsetenv(DIRAM_CONFIG_ENV);
+
+    // A full config as the local file, a few overrides in the user's
+    diram_config_init();
+    diram_config_save(".dramrc");
+    char user[128];
+    snprintf(user, sizeof(user), "%s/.dramrc", root);
+    FILE* f = fopen(user, "w");
+    if (!f) return 1;
+    fputs("# user overrides\nmemory_limit=2048\nreceipt_mode=deferred\n[async]\nexecutor_threads=2\n", f);
+    fclose(f);
+    struct stat st;
+    stat(".dramrc", &st);
+    printf("  sources: %s, ~/.dramrc, ./.dramrc (%lld bytes)\n", DIRAM_SYSTEM_CONFIG_FILE,
+           (long long)st.st_size);
+
+    static mode_t_ modes[3] = {
+        { .label = "text (no cache)" },
+        { .label = ".drcb, sources hashed" },
+        { .label = ".drcb, sources stat only" },
+    };
+
+    // Compiled from just-written sources, whose stamps are always
+    // re-hashed; then from backdated ones, which a stat settles
+    snprintf(modes[1].cache, sizeof(modes[1].cache), "%s/hashed.drcb", root);
+    compile(modes[1].cache);
+    backdate(".dramrc");
+    backdate(user);
+    snprintf(modes[2].cache, sizeof(modes[2].cache), "%s/stat.drcb", root);
+    compile(modes[2].cache);
+    stat(modes[2].cache, &st);
+    printf("  cache: %lld bytes\n", (long long)st.st_size);
+
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        for (int m = 0; m < 3; m++) {
+            run_once(self, &modes[m], run);
+        }
+    }
+    for (int m = 0; m < 3; m++) {
+        report(&modes[m]);
+    }
+
+    unlink(modes[1].cache);
+    unlink(modes[2].cache);
+    unlink(user);
+    unlink(".dramrc");
+    rmdir(work);
+    rmdir(root);
+    return 0;
+}
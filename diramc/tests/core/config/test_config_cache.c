@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include "diram/core/config/config.h"
+#include "diram/core/config/config_cache.h"
+#include "diram/core/feature-alloc/receipt_queue.h"
+
+static char root[64];
+static char cache_path[128];
+static char user_path[128];
+
+// Shipped configs, relative to the directory make test runs in
+static const char* const shipped[] = { "diram.drc", "config/diram.drc" };
+static char shipped_path[2][PATH_MAX];
+
+static void write_file(const char* path, const char* text) {
+    FILE* f = fopen(path, "w");
+    assert(f);
+    fputs(text, f);
+    fclose(f);
+}
+
+// Backdate a file so its mtime alone is trusted
+static void set_mtime(const char* path, time_t when) {
+    struct timespec times[2] = { { when, 0 }, { when, 0 } };
+    assert(utimensat(AT_FDCWD, path, times, 0) == 0);
+}
+
+static bool cache_hits(void) {
+    const char* sources[DIRAM_CONFIG_MAX_SOURCES] = {
+        DIRAM_SYSTEM_CONFIG_FILE, user_path, ".dramrc"
+    };
+    int errors;
+    bool hit = diram_config_cache_load(cache_path, sources, 3, &errors) == 0;
+    diram_config_cache_release();
+    return hit;
+}
+
+static int load(diram_config_t* out) {
+    diram_config_cleanup();
+    diram_config_init();
+    int errors = diram_config_load_hierarchy();
+    *out = g_diram_config;
+    return errors;
+}
+
+int main() {
+    printf("Running DIRAMC config cache tests...\n");
+
+    for (int i = 0; i < 2; i++) {
+        assert(realpath(shipped[i], shipped_path[i]));
+    }
+    snprintf(root, sizeof(root), "/tmp/diram_config_XXXXXX");
+    assert(mkdtemp(root));
+    snprintf(user_path, sizeof(user_path), "%s/.dramrc", root);
+    snprintf(cache_path, sizeof(cache_path), "%s/cache/nested/config.drcb", root);
+    char work[96];
+    snprintf(work, sizeof(work), "%s/work", root);
+    assert(mkdir(work, 0700) == 0 && chdir(work) == 0);
+    setenv("HOME", root, 1);
+    unsetenv(DIRAM_CONFIG_ENV);
+
+    write_file(user_path, "memory_limit=2048\nmemory_space=userspace\nreceipt_mode=deferred\n");
+    write_file(".dramrc", "trace=true\nlog_dir=/var/log/diram\n[async]\nexecutor_threads=4\n"
+                          "[governor]\nthread_rate=500\n");
+    set_mtime(user_path, time(NULL) - 100);
+    set_mtime(".dramrc", time(NULL) - 100);
+    bool system_present = access(DIRAM_SYSTEM_CONFIG_FILE, F_OK) == 0;
+
+    // Key table: every key reachable through the perfect hash
+    for (size_t i = 0; i < diram_config_key_count(); i++) {
+        assert(diram_config_key_index(diram_config_key(i)->name) == (int)i);
+    }
+    assert(diram_config_key_index("memory_limits") == -1 && diram_config_key_index("") == -1);
+    diram_config_init();
+    assert(diram_config_set_value(CFG_GOV_SPACE_BURST, "7") == 0);
+    assert(strcmp(diram_config_get_value(CFG_GOV_SPACE_BURST), "7") == 0);
+    assert(strcmp(diram_config_get_value(CFG_ASYNC_ENABLE_PROMISES), "true") == 0);
+    assert(diram_config_set_value(CFG_RECEIPT_MODE, "sometimes") == -1);
+    assert(diram_config_set_value("no_such_key", "1") == -1);
+    uint8_t broken[256];
+    const config_index_t* index = diram_config_get_index();
+    memcpy(broken, index->slots, index->mask + 1);
+    for (size_t i = 0; i <= index->mask; i++) {
+        if (broken[i]) { broken[i] = 0; break; }
+    }
+    config_index_t bad = { index->seed, index->mask, broken };
+    assert(!diram_config_set_index(&bad));
+    printf("✓ %zu keys, perfect hash seed %u over %u slots\n",
+           diram_config_key_count(), index->seed, index->mask + 1);
+
+    // Text load with the cache disabled is the reference
+    setenv(DIRAM_CONFIG_CACHE_ENV, "", 1);
+    diram_config_t text;
+    int text_errors = load(&text);
+    assert(text.memory_limit == 2048 && text.trace_enabled && text.executor_threads == 4);
+    assert(text.gov_thread_rate == 500 && strcmp(text.log_dir, "/var/log/diram") == 0);
+    assert(access(cache_path, F_OK) != 0);
+
+    // First cached load compiles, the second maps
+    setenv(DIRAM_CONFIG_CACHE_ENV, cache_path, 1);
+    diram_config_t compiled, mapped;
+    assert(load(&compiled) == text_errors);
+    assert(access(cache_path, F_OK) == 0);
+    assert(memcmp(&compiled, &text, sizeof(text)) == 0);
+    assert(cache_hits());
+    assert(load(&mapped) == text_errors);
+    assert(memcmp(&mapped, &text, sizeof(text)) == 0);
+    assert(strcmp(diram_config_get_value(CFG_MEMORY_SPACE), "userspace") == 0);
+    assert(strcmp(diram_config_get_value(CFG_RECEIPT_MODE), "deferred") == 0);
+    printf("✓ Compiled and mapped configs match the text load\n");
+
+    // Touching a source without changing it keeps the cache
+    set_mtime(".dramrc", time(NULL) - 50);
+    assert(cache_hits());
+
+    // Same size, new contents: stale, rebuilt on the next load
+    write_file(".dramrc", "trace=true\nlog_dir=/var/log/diraM\n[async]\nexecutor_threads=4\n"
+                          "[governor]\nthread_rate=500\n");
+    assert(!cache_hits());
+    diram_config_t edited;
+    load(&edited);
+    assert(strcmp(edited.log_dir, "/var/log/diraM") == 0);
+    assert(cache_hits());
+    printf("✓ Touched source still valid, edited source rebuilt\n");
+
+    // A source appearing or disappearing invalidates
+    assert(unlink(".dramrc") == 0);
+    assert(!cache_hits());
+    assert(load(&edited) == text_errors + 1);
+    assert(!edited.trace_enabled && edited.memory_limit == 2048);
+    assert(cache_hits());
+    printf("✓ Removed source invalidates (system config %s)\n", system_present ? "present" : "absent");
+
+    // Corruption is caught by the checksum
+    int fd = open(cache_path, O_RDWR);
+    assert(fd >= 0);
+    struct stat st;
+    assert(fstat(fd, &st) == 0);
+    char byte;
+    assert(pread(fd, &byte, 1, st.st_size - 2) == 1);
+    byte ^= 0x20;
+    assert(pwrite(fd, &byte, 1, st.st_size - 2) == 1);
+    close(fd);
+    assert(!cache_hits());
+    load(&edited);
+    assert(cache_hits());
+    printf("✓ Corrupt cache rejected and rebuilt (%lld bytes)\n", (long long)st.st_size);
+
+    // A source with parse errors is never cached
+    write_file(".dramrc", "trace=true\nnot a setting\n");
+    assert(load(&edited) > text_errors);
+    assert(!cache_hits());
+    printf("✓ Sources with errors stay uncached\n");
+
+    // Comments may follow a value; a '#' inside one is kept
+    write_file(".dramrc", "log_dir=/var/log/a#b   # where logs go\nreceipt_mode=deferred\t# batched\n");
+    diram_config_init();
+    assert(diram_config_load_file(".dramrc", CONFIG_SOURCE_LOCAL) == 0);
+    assert(strcmp(g_diram_config.log_dir, "/var/log/a#b") == 0);
+    assert(g_diram_config.receipt_mode == DIRAM_RECEIPT_MODE_DEFERRED);
+
+    // The shipped configs load without errors, and so get cached
+    for (int i = 0; i < 2; i++) {
+        diram_config_cleanup();
+        diram_config_init();
+        assert(diram_config_load_file(shipped_path[i], CONFIG_SOURCE_CMDLINE) == 0);
+        assert(g_diram_config.memory_limit == 6144 && g_diram_config.trace_enabled);
+        assert(g_diram_config.receipt_mode == DIRAM_RECEIPT_MODE_SYNC);
+        assert(strcmp(g_diram_config.memory_space, "userspace") == 0);
+        assert(strcmp(g_diram_config.log_dir, "logs") == 0);
+    }
+    write_file(".dramrc", "trace=true\n");
+    setenv(DIRAM_CONFIG_ENV, shipped_path[0], 1);
+    unlink(cache_path);
+    assert(load(&edited) == text_errors);
+    assert(access(cache_path, F_OK) == 0);
+    assert(edited.memory_limit == 6144 && edited.receipt_mode == DIRAM_RECEIPT_MODE_SYNC);
+    unsetenv(DIRAM_CONFIG_ENV);
+    printf("✓ Trailing comments stripped; shipped diram.drc loads and caches\n");
+
+    diram_config_cleanup();
+    unlink(".dramrc");
+    unlink(user_path);
+    unlink(cache_path);
+    char dir[160];
+    snprintf(dir, sizeof(dir), "%s/cache/nested", root);
+    rmdir(dir);
+    snprintf(dir, sizeof(dir), "%s/cache", root);
+    rmdir(dir);
+    rmdir(work);
+    rmdir(root);
+
+    printf("All tests passed!\n");
+    return 0;
+}
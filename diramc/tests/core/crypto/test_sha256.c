@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "diram/core/crypto/sha256.h"
+
+// FIPS 180-4 / NIST CAVP short and long message vectors
+static const char* MSG_448 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+static const char* EXPECT_EMPTY = "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+static const char* EXPECT_ABC   = "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+static const char* EXPECT_448   = "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1";
+static const char* EXPECT_MILL  = "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0";
+
+static void check_vectors(diram_sha256_impl_t impl, const char* million) {
+    char hex[65];
+
+    assert(diram_sha256_force_impl(impl) == 0);
+
+    diram_sha256_hex("", 0, hex);
+    assert(strcmp(hex, EXPECT_EMPTY) == 0);
+    diram_sha256_hex("abc", 3, hex);
+    assert(strcmp(hex, EXPECT_ABC) == 0);
+    diram_sha256_hex(MSG_448, strlen(MSG_448), hex);
+    assert(strcmp(hex, EXPECT_448) == 0);
+    diram_sha256_hex(million, 1000000, hex);
+    assert(strcmp(hex, EXPECT_MILL) == 0);
+
+    printf("✓ NIST vectors (%s)\n", diram_sha256_impl_name(impl));
+}
+
+// Batch must agree with the scalar reference for every length and lane count
+static void check_batch(diram_sha256_impl_t impl) {
+    enum { COUNT = 37 };
+    static uint8_t buffers[COUNT][300];
+    const void* data[COUNT];
+    size_t lens[COUNT];
+    uint8_t batch[COUNT][DIRAM_SHA256_DIGEST_LEN];
+    uint8_t single[DIRAM_SHA256_DIGEST_LEN];
+
+    for (int i = 0; i < COUNT; i++) {
+        lens[i] = (size_t)(i * 8 + (i % 3)) % 300;   // crosses 55/56/64 boundaries
+        for (size_t b = 0; b < lens[i]; b++) buffers[i][b] = (uint8_t)(i * 31 + b);
+        data[i] = buffers[i];
+    }
+
+    for (size_t count = 0; count <= COUNT; count++) {
+        assert(diram_sha256_force_impl(impl) == 0);
+        diram_sha256_batch(data, lens, count, batch);
+
+        assert(diram_sha256_force_impl(DIRAM_SHA256_IMPL_SCALAR) == 0);
+        for (size_t i = 0; i < count; i++) {
+            diram_sha256(data[i], lens[i], single);
+            assert(memcmp(single, batch[i], DIRAM_SHA256_DIGEST_LEN) == 0);
+        }
+    }
+
+    printf("✓ Batch matches scalar (%s)\n", diram_sha256_impl_name(impl));
+}
+
+int main() {
+    printf("Running DIRAMC SHA-256 tests...\n");
+
+    char* million = malloc(1000000);
+    assert(million != NULL);
+    memset(million, 'a', 1000000);
+
+    const diram_sha256_impl_t impls[] = {
+        DIRAM_SHA256_IMPL_SCALAR, DIRAM_SHA256_IMPL_SHANI, DIRAM_SHA256_IMPL_AVX2
+    };
+
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (!diram_sha256_supported(impls[i])) {
+            printf("- %s not supported on this CPU, skipped\n", diram_sha256_impl_name(impls[i]));
+            continue;
+        }
+        check_vectors(impls[i], million);
+        check_batch(impls[i]);
+    }
+
+    assert(diram_sha256_force_impl(DIRAM_SHA256_IMPL_AUTO) == 0);
+    printf("✓ Auto dispatch: single=%s batch=%s\n",
+           diram_sha256_impl_name(diram_sha256_active_impl()),
+           diram_sha256_impl_name(diram_sha256_active_batch_impl()));
+
+    free(million);
+    printf("\nAll tests passed!\n");
+    return 0;
+}
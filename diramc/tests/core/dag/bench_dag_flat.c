@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "diram/core/dag/dag_flat.h"
+
+// Navigation over a 1M-node DAG: pointer-linked dag_node_t/dag_edge_t
+// (built with add_dag_edge) against the CSR flat store. Both graphs get
+// the same edges, appended in the same shuffled order as a DAG that grew
+// incrementally would see them.
+
+#define BENCH_NODES        1000000
+#define BENCH_MAX_DEGREE   8
+#define BENCH_SPAN         1000      // edges point at most this far ahead
+#define BENCH_WALKS        200000
+#define BENCH_DEPTH        32
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (uint32_t)rng;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// The diram_navigate_dag loop; every walk stays clear of the sink, so
+// the state-creation branch never runs in either store
+static dag_node_t* navigate_pointer(dag_node_t* current, phenotype_t target,
+                                    float threshold, uint32_t max_depth, uint64_t* steps) {
+    for (uint32_t depth = 0; depth < max_depth; depth++) {
+        dag_edge_t* best_edge = NULL;
+        float best_score = 0.0f;
+        for (uint32_t i = 0; i < current->edge_count; i++) {
+            dag_edge_t* edge = current->edges[i];
+            float similarity = compute_phenotype_similarity(edge->trigger, target);
+            float score = similarity * edge->probability;
+            if (score > best_score && score > threshold) {
+                best_score = score;
+                best_edge = edge;
+            }
+        }
+        if (!best_edge) return current;
+
+        current = best_edge->to;
+        best_edge->traversal_count++;
+        (*steps)++;
+        if (compute_phenotype_similarity(current->phenotype, target) > 0.95f) return current;
+    }
+    return current;
+}
+
+int main() {
+    printf("Flat DAG benchmark: %d nodes, up to %d edges each\n", BENCH_NODES, BENCH_MAX_DEGREE);
+
+    uint32_t* pheno = malloc(BENCH_NODES * sizeof(uint32_t));
+    uint32_t* order = malloc(BENCH_NODES * sizeof(uint32_t));
+    for (uint32_t i = 0; i < BENCH_NODES; i++) {
+        pheno[i] = next_rand();
+        order[i] = i;
+    }
+    for (uint32_t i = BENCH_NODES - 1; i > 0; i--) {
+        uint32_t j = next_rand() % (i + 1);
+        uint32_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+
+    dag_node_t** nodes = malloc(BENCH_NODES * sizeof(dag_node_t*));
+    diram_flat_dag_t* flat = diram_flat_dag_create(BENCH_NODES, 0);
+    for (uint32_t i = 0; i < BENCH_NODES; i++) {
+        nodes[i] = create_dag_node((phenotype_t){ .raw = pheno[i] }, (axial_state_t){0});
+        diram_flat_dag_add_node(flat, (phenotype_t){ .raw = pheno[i] }, (axial_state_t){0});
+    }
+
+    double t0 = now_sec();
+    uint64_t edges = 0;
+    for (uint32_t k = 0; k < BENCH_NODES; k++) {
+        uint32_t from = order[k];
+        if (from == BENCH_NODES - 1) continue;   // the sink
+        uint32_t degree = 1 + next_rand() % BENCH_MAX_DEGREE;
+        for (uint32_t e = 0; e < degree; e++) {
+            uint32_t span = BENCH_NODES - 1 - from < BENCH_SPAN ? BENCH_NODES - 1 - from : BENCH_SPAN;
+            uint32_t to = from + 1 + next_rand() % span;
+            float probability = (float)(1 + next_rand() % 100) / 100.0f;
+            phenotype_t trigger = { .raw = pheno[to] };
+            add_dag_edge(nodes[from], nodes[to], trigger, probability);
+            diram_flat_dag_add_edge(flat, from, to, trigger, probability);
+            edges++;
+        }
+    }
+    printf("  built %llu edges in %.2f s (%u flat slots, %u abandoned)\n",
+           (unsigned long long)edges, now_sec() - t0, flat->edge_used, flat->edge_dead);
+    diram_flat_dag_compact(flat);
+
+    uint32_t* starts = malloc(BENCH_WALKS * sizeof(uint32_t));
+    uint32_t* targets = malloc(BENCH_WALKS * sizeof(uint32_t));
+    for (uint32_t w = 0; w < BENCH_WALKS; w++) {
+        starts[w] = next_rand() % (BENCH_NODES / 2);
+        targets[w] = next_rand();
+    }
+
+    uint64_t steps = 0, check_pointer = 0, check_flat = 0;
+    t0 = now_sec();
+    for (uint32_t w = 0; w < BENCH_WALKS; w++) {
+        dag_node_t* end = navigate_pointer(nodes[starts[w]], (phenotype_t){ .raw = targets[w] },
+                                           0.0f, BENCH_DEPTH, &steps);
+        check_pointer += end->phenotype.raw;
+    }
+    double pointer_ns = (now_sec() - t0) * 1e9 / (double)steps;
+
+    t0 = now_sec();
+    for (uint32_t w = 0; w < BENCH_WALKS; w++) {
+        uint32_t end = diram_flat_dag_navigate(flat, starts[w], (phenotype_t){ .raw = targets[w] },
+                                               0.0f, BENCH_DEPTH);
+        check_flat += flat->rows[end].pheno;
+    }
+    double flat_ns = (now_sec() - t0) * 1e9 / (double)steps;
+
+    printf("  %llu navigation steps, results %s\n", (unsigned long long)steps,
+           check_pointer == check_flat ? "identical" : "DIFFER");
+    printf("  pointer DAG: %6.1f ns/step\n", pointer_ns);
+    printf("  flat DAG:    %6.1f ns/step  (%.1fx)\n", flat_ns, pointer_ns / flat_ns);
+    printf("  edge storage: pointer %zu B/edge, flat %zu B/edge\n",
+           sizeof(dag_edge_t) + sizeof(dag_edge_t*),
+           sizeof(uint32_t) * 3 + sizeof(float));
+    return check_pointer == check_flat ? 0 : 1;
+}
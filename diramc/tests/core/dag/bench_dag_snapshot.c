@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "diram/core/dag/dag_snapshot.h"
+
+// Startup cost of a 10M-edge DAG: writing the snapshot, mapping it with
+// and without payload verification, the first navigations straight off
+// the mapping, and the full upgrade to a mutable diram_dag_t.
+
+#define BENCH_NODES      2000000
+#define BENCH_EDGES      10000000
+#define BENCH_WALKS      100000
+#define BENCH_PATH       "/tmp/diram_bench_dag.snap"
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return (uint32_t)rng;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main() {
+    printf("DAG snapshot benchmark: %d nodes, %d edges\n", BENCH_NODES, BENCH_EDGES);
+
+    double t0 = now_sec();
+    diram_dag_t* dag = diram_dag_create();
+    for (uint32_t i = 1; i < BENCH_NODES; i++) {
+        diram_dag_add_node(dag, (phenotype_t){ .raw = next_rand() });
+    }
+    for (uint32_t e = 0; e < BENCH_EDGES; e++) {
+        uint32_t from = e % BENCH_NODES;
+        uint32_t to = from + 1 + next_rand() % 1000;
+        if (to >= BENCH_NODES) to = BENCH_NODES - 1;
+        if (from == to) from = 0;
+        diram_dag_connect_nodes(dag, dag->nodes[from], dag->nodes[to],
+                                dag->nodes[to]->phenotype, (float)(next_rand() % 1000) / 1000.0f);
+    }
+    double built = now_sec() - t0;
+
+    t0 = now_sec();
+    if (diram_dag_serialize(dag, BENCH_PATH) != 0) {
+        printf("serialize failed\n");
+        return 1;
+    }
+    double written = now_sec() - t0;
+    diram_dag_destroy(dag);
+
+    t0 = now_sec();
+    diram_dag_map_t* map = diram_dag_map_open(BENCH_PATH, 0);
+    double mapped = now_sec() - t0;
+    if (!map) {
+        printf("map failed\n");
+        return 1;
+    }
+
+    t0 = now_sec();
+    uint64_t check = 0;
+    for (uint32_t w = 0; w < BENCH_WALKS; w++) {
+        check += diram_dag_map_navigate(map, next_rand() % BENCH_NODES,
+                                        (phenotype_t){ .raw = next_rand() }, 0.3f, 16);
+    }
+    double walked = now_sec() - t0;
+    diram_dag_map_close(map);
+
+    t0 = now_sec();
+    map = diram_dag_map_open(BENCH_PATH, DIRAM_DAG_MAP_VERIFY);
+    double verified = now_sec() - t0;
+
+    t0 = now_sec();
+    diram_dag_t* upgraded = diram_dag_map_upgrade(map);
+    double upgrade = now_sec() - t0;
+
+    printf("  image size:            %.1f MB\n", (double)map->size / 1e6);
+    printf("  rebuild via API:       %8.1f ms\n", built * 1e3);
+    printf("  serialize:             %8.1f ms\n", written * 1e3);
+    printf("  map, header only:      %8.3f ms\n", mapped * 1e3);
+    printf("  map + verify:          %8.1f ms\n", verified * 1e3);
+    printf("  %d cold walks:     %8.1f ms  (check %llu)\n", BENCH_WALKS, walked * 1e3,
+           (unsigned long long)check);
+    printf("  upgrade to mutable:    %8.1f ms  (%u nodes, %u edges)\n", upgrade * 1e3,
+           upgraded->node_count, upgraded->edge_count);
+
+    diram_dag_destroy(upgraded);
+    diram_dag_map_close(map);
+    remove(BENCH_PATH);
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "diram/core/dag/dag_flat.h"
+
+static phenotype_t raw(uint32_t bits) {
+    return (phenotype_t){ .raw = bits };
+}
+
+int main() {
+    printf("Running DIRAMC flat DAG tests...\n");
+
+    diram_flat_dag_t* dag = diram_flat_dag_create(2, 4);
+    assert(dag);
+    axial_state_t axial = {0};
+
+    // Rows move and grow while edges keep their order and counters
+    uint32_t root = diram_flat_dag_add_node(dag, raw(0), axial);
+    for (uint32_t i = 1; i <= 100; i++) {
+        uint32_t node = diram_flat_dag_add_node(dag, raw(i), axial);
+        assert(node == i);
+        assert(diram_flat_dag_add_edge(dag, root, node, raw(i), 0.5f) == 0);
+        if (i > 1) assert(diram_flat_dag_add_edge(dag, i - 1, node, raw(i), 0.25f) == 0);
+    }
+    assert(dag->node_count == 101 && dag->edge_count == 199);
+    assert(dag->rows[root].count == 100 && dag->rows[root].capacity == 128);
+    for (uint32_t i = 0; i < 100; i++) {
+        assert(dag->edge_target[dag->rows[root].begin + i] == i + 1);
+    }
+    assert(diram_flat_dag_add_edge(dag, root, 500, raw(1), 0.5f) == -1);
+    printf("✓ Incremental append (%u dead slots of %u used)\n", dag->edge_dead, dag->edge_used);
+
+    // Compaction drops abandoned slots and keeps every row intact
+    uint32_t live_capacity = 0;
+    for (uint32_t n = 0; n < dag->node_count; n++) live_capacity += dag->rows[n].capacity;
+    assert(diram_flat_dag_compact(dag) == 0);
+    assert(dag->edge_dead == 0 && dag->edge_used == live_capacity);
+    for (uint32_t i = 0; i < 100; i++) {
+        uint32_t slot = dag->rows[root].begin + i;
+        assert(dag->edge_target[slot] == i + 1 && dag->edge_trigger[slot] == i + 1);
+    }
+    for (uint32_t n = 1; n < 100; n++) {
+        assert(dag->rows[n].count == 1 && dag->edge_target[dag->rows[n].begin] == n + 1);
+    }
+    printf("✓ Compaction keeps %u edges in %u slots\n", dag->edge_count, dag->edge_used);
+
+    // Navigation follows the best similarity * probability edge
+    uint32_t found = diram_flat_dag_navigate(dag, root, raw(64), 0.3f, 8);
+    assert(found == 64);
+    assert(dag->edge_traversals[dag->rows[root].begin + 63] == 1);
+
+    // Nothing above threshold: a new state is appended under the current node
+    uint32_t nodes = dag->node_count;
+    uint32_t fresh = diram_flat_dag_navigate(dag, 100, raw(0xFFFF0000u), 0.3f, 8);
+    assert(fresh == nodes && dag->node_count == nodes + 1);
+    assert(dag->rows[fresh].pheno == 0xFFFF0000u);
+    assert(dag->rows[100].count == 1 && dag->edge_target[dag->rows[100].begin] == fresh);
+    assert(diram_flat_dag_navigate(dag, 100, raw(0xFFFF0000u), 0.3f, 8) == fresh);
+    printf("✓ Navigation matches and appends new states\n");
+
+    diram_flat_dag_destroy(dag);
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include "diram/core/dag/dag_optimize.h"
+
+#define READERS   3
+#define WALKS     3000
+
+static diram_dag_t* g_dag;
+
+static phenotype_t raw(uint32_t bits) {
+    return (phenotype_t){ .raw = bits };
+}
+
+static uint32_t xorshift(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static dag_edge_t* edge_to(dag_node_t* from, dag_node_t* to) {
+    for (uint32_t i = 0; i < from->edge_count; i++) {
+        if (from->edges[i]->to == to) return from->edges[i];
+    }
+    return NULL;
+}
+
+static int in_graph(diram_dag_t* dag, dag_node_t* node) {
+    return node->id < dag->node_count && dag->nodes[node->id] == node;
+}
+
+// Navigates from wherever the last walk ended, holding only that state,
+// while the background optimizer prunes and reclaims around it
+static void* reader_thread(void* arg) {
+    uint32_t rng = (uint32_t)(uintptr_t)arg;
+    dag_node_t* current = NULL;
+    diram_dag_optimize_stats_t stats = {0};
+    for (uint32_t w = 0; w < WALKS || stats.passes < 3; w++) {
+        if (w % 256 == 0) diram_dag_optimize_get_stats(g_dag, &stats);
+        phenotype_t target = raw(xorshift(&rng) & 0x00FF00FFu);
+        if (w < WALKS) {
+            dag_node_t* next = diram_dag_navigate(g_dag, w % 16 ? current : NULL, target, 0.3f, 8);
+            assert(next);
+            diram_dag_release(g_dag, current);
+            current = next;
+        } else {
+            // Read-only until the optimizer has caught up with the appends
+            sched_yield();
+        }
+
+        dag_traversal_context_t* t = diram_dag_begin_traversal(g_dag);
+        while (diram_dag_traverse_next(t, target)) {}
+        diram_dag_end_traversal(t);
+    }
+    diram_dag_release(g_dag, current);
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC DAG optimizer tests...\n");
+
+    diram_dag_t* dag = diram_dag_create();
+    dag_node_t* keep = diram_dag_add_node(dag, raw(0xFFFF0000u));
+    dag_node_t* weak = diram_dag_add_node(dag, raw(0x0000FFFFu));
+    dag_node_t* below = diram_dag_add_node(dag, raw(0x00FF00FFu));
+    dag_node_t* twin_a = diram_dag_add_node(dag, raw(0x0F0F0F0Fu));
+    dag_node_t* twin_b = diram_dag_add_node(dag, raw(0x0F0F0F0Eu));
+    dag_node_t* fork = diram_dag_add_node(dag, raw(0xAAAAAAAAu));
+    dag_node_t* busy = diram_dag_add_node(dag, raw(0x55555555u));
+    dag_node_t* quiet = diram_dag_add_node(dag, raw(0x33333333u));
+    dag_node_t* held = diram_dag_add_node(dag, raw(0xCCCCCCCCu));
+
+    assert(diram_dag_connect_nodes(dag, dag->root, keep, keep->phenotype, 0.9f) == 0);
+    assert(diram_dag_connect_nodes(dag, dag->root, weak, weak->phenotype, 0.01f) == 0);
+    assert(diram_dag_connect_nodes(dag, weak, below, below->phenotype, 0.9f) == 0);
+    assert(diram_dag_connect_nodes(dag, dag->root, twin_a, twin_a->phenotype, 0.6f) == 0);
+    assert(diram_dag_connect_nodes(dag, dag->root, twin_b, twin_b->phenotype, 0.5f) == 0);
+    assert(diram_dag_connect_nodes(dag, keep, fork, fork->phenotype, 0.9f) == 0);
+    assert(diram_dag_connect_nodes(dag, fork, busy, busy->phenotype, 0.2f) == 0);
+    assert(diram_dag_connect_nodes(dag, fork, quiet, quiet->phenotype, 0.8f) == 0);
+    assert(diram_dag_connect_nodes(dag, dag->root, held, held->phenotype, 0.01f) == 0);
+    edge_to(dag->root, twin_a)->traversal_count = 3;
+    edge_to(dag->root, twin_b)->traversal_count = 1;
+    edge_to(fork, busy)->traversal_count = 16;
+    edge_to(fork, quiet)->traversal_count = 4;
+    assert(diram_dag_hold(dag, held) == 0);
+
+    diram_dag_optimize(dag);
+    diram_dag_optimize_stats_t stats;
+    diram_dag_optimize_get_stats(dag, &stats);
+
+    // Weak edges go; what only they led to is reclaimed
+    assert(stats.passes == 1 && stats.edges_pruned == 2);
+    assert(!edge_to(dag->root, weak) && !edge_to(dag->root, held));
+    assert(stats.nodes_condemned == 4 && stats.nodes_reclaimed == 3);
+    assert(stats.bytes_reclaimed >= 4 * sizeof(dag_edge_t) + 3 * sizeof(dag_node_t));
+    printf("✓ Pruned %llu edges, reclaimed %llu nodes / %llu bytes\n",
+           (unsigned long long)stats.edges_pruned, (unsigned long long)stats.nodes_reclaimed,
+           (unsigned long long)stats.bytes_reclaimed);
+
+    // Near-identical siblings fold into the better-travelled edge
+    dag_edge_t* merged = edge_to(dag->root, twin_a);
+    assert(stats.edges_merged == 1 && !edge_to(dag->root, twin_b));
+    assert(fabsf(merged->probability - 0.8f) < 1e-6f && merged->traversal_count == 4);
+    assert(in_graph(dag, twin_a));
+    printf("✓ Merged sibling edges (p=%.2f)\n", merged->probability);
+
+    // Re-weighted towards traffic share, counts aged
+    dag_edge_t* hot = edge_to(fork, busy);
+    dag_edge_t* cold = edge_to(fork, quiet);
+    assert(fabsf(hot->probability - 0.6f) < 1e-6f && hot->traversal_count == 8);
+    assert(fabsf(cold->probability - 0.525f) < 1e-6f && cold->traversal_count == 2);
+    printf("✓ Renormalized %llu edges\n", (unsigned long long)stats.edges_renormalized);
+
+    // Held through the pass, so it came back; released, it goes
+    assert(stats.nodes_rescued == 1 && in_graph(dag, held) && held->holds == 1);
+    assert(dag->node_count == 7);
+    diram_dag_release(dag, held);
+    diram_dag_optimize(dag);
+    diram_dag_optimize_get_stats(dag, &stats);
+    assert(stats.nodes_reclaimed == 4 && dag->node_count == 6);
+    for (uint32_t i = 0; i < dag->node_count; i++) assert(dag->nodes[i]->id == i);
+    printf("✓ Held nodes survive until released\n");
+
+    diram_dag_destroy(dag);
+
+    // Readers navigating and appending while the optimizer runs in the background
+    g_dag = diram_dag_create();
+    diram_dag_optimize_config_t config = {
+        .min_probability = 0.6f,   // fresh 0.5 edges go unless they get used
+        .min_traversals = 1,
+        .merge_similarity = DIRAM_DAG_OPT_MERGE_SIMILARITY,
+        .renormalize_weight = DIRAM_DAG_OPT_RENORM_WEIGHT,
+        .slice_budget = 256,
+        .interval_ms = 1,
+    };
+    assert(diram_dag_optimize_configure(g_dag, &config) == 0);
+    assert(diram_dag_optimizer_start(g_dag) == 0);
+    assert(diram_dag_optimizer_start(g_dag) == -1);
+
+    pthread_t readers[READERS];
+    for (uintptr_t r = 0; r < READERS; r++) {
+        pthread_create(&readers[r], NULL, reader_thread, (void*)(r * 7919 + 1));
+    }
+    for (int r = 0; r < READERS; r++) pthread_join(readers[r], NULL);
+    diram_dag_optimizer_stop(g_dag);
+
+    // Settle: nothing held any more, so a full pass leaves only what the root reaches
+    diram_dag_optimize(g_dag);
+    diram_dag_optimize(g_dag);
+    diram_dag_optimize_get_stats(g_dag, &stats);
+    assert(stats.passes >= 5 && stats.nodes_reclaimed > 0);
+    uint32_t edges = 0;
+    for (uint32_t i = 0; i < g_dag->node_count; i++) {
+        assert(g_dag->nodes[i]->id == i && g_dag->nodes[i]->holds == 0);
+        edges += g_dag->nodes[i]->edge_count;
+    }
+    assert(edges == g_dag->edge_count);
+    printf("✓ Concurrent run: %llu passes, %llu nodes reclaimed, %u live, max pause %.1f us\n",
+           (unsigned long long)stats.passes, (unsigned long long)stats.nodes_reclaimed,
+           g_dag->node_count, (double)stats.max_pause_ns / 1e3);
+    diram_dag_destroy(g_dag);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "diram/core/dag/dag_snapshot.h"
+
+#define SNAPSHOT_PATH   "/tmp/diram_test_dag.snap"
+#define ROUNDTRIP_PATH  "/tmp/diram_test_dag_roundtrip.snap"
+
+static phenotype_t raw(uint32_t bits) {
+    return (phenotype_t){ .raw = bits };
+}
+
+static size_t read_file(const char* path, uint8_t** out) {
+    FILE* f = fopen(path, "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    size_t size = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    *out = malloc(size);
+    assert(fread(*out, 1, size, f) == size);
+    fclose(f);
+    return size;
+}
+
+static void write_file(const char* path, const uint8_t* data, size_t size) {
+    FILE* f = fopen(path, "wb");
+    assert(f && fwrite(data, 1, size, f) == size);
+    fclose(f);
+}
+
+int main() {
+    printf("Running DIRAMC DAG snapshot tests...\n");
+
+    // root -> 1..20 (wide enough for batched scoring), chain 1 -> 21 -> 22
+    diram_dag_t* dag = diram_dag_create();
+    dag_node_t* nodes[23] = { dag->root };
+    for (uint32_t i = 1; i <= 22; i++) nodes[i] = diram_dag_add_node(dag, raw(i * 0x01010101u));
+    for (uint32_t i = 1; i <= 20; i++) {
+        assert(diram_dag_connect_nodes(dag, dag->root, nodes[i], raw(i * 0x01010101u), 0.9f) == 0);
+    }
+    assert(diram_dag_connect_nodes(dag, nodes[1], nodes[21], raw(21 * 0x01010101u), 0.8f) == 0);
+    assert(diram_dag_connect_nodes(dag, nodes[21], nodes[22], raw(22 * 0x01010101u), 0.8f) == 0);
+    nodes[5]->observation_count = 42;
+    dag->root->edges[4]->traversal_count = 7;
+
+    assert(diram_dag_serialize(dag, SNAPSHOT_PATH) == 0);
+
+    // Navigated in place, read-only
+    diram_dag_map_t* map = diram_dag_map_open(SNAPSHOT_PATH, DIRAM_DAG_MAP_VERIFY);
+    assert(map);
+    assert(map->header->node_count == 23 && map->header->edge_count == 22);
+    assert(map->header->generation == dag->generation);
+    assert((uintptr_t)map->edge_trigger % DIRAM_DAG_FILE_ALIGN == 0);
+    for (uint32_t i = 1; i <= 20; i++) {
+        phenotype_t target = raw(i * 0x01010101u);
+        uint32_t mapped = diram_dag_map_navigate(map, 0, target, 0.6f, 8);
+        assert(mapped == i && diram_dag_navigate(dag, NULL, target, 0.6f, 8)->id == i);
+    }
+    assert(diram_dag_map_navigate(map, 1, raw(21 * 0x01010101u), 0.6f, 8) == 21);
+    assert(diram_dag_navigate(dag, nodes[1], raw(21 * 0x01010101u), 0.6f, 8) == nodes[21]);
+    assert(diram_dag_map_navigate(map, 0, raw(0xDEADBEEF), 0.6f, 8) == 0);
+    assert(diram_dag_map_navigate(map, 99, raw(0), 0.6f, 8) == DIRAM_DAG_MAP_NONE);
+    printf("✓ Mapped snapshot navigates like the live DAG\n");
+
+    // Upgrade keeps structure, counters and generation, and writes back byte for byte
+    diram_dag_t* upgraded = diram_dag_map_upgrade(map);
+    assert(upgraded);
+    assert(upgraded->node_count == 23 && upgraded->edge_count == 22);
+    assert(upgraded->generation == dag->generation);
+    assert(upgraded->nodes[5]->observation_count == 42);
+    assert(upgraded->root->edges[4]->traversal_count == 7);
+    assert(upgraded->root->edges[4]->generation == 0);
+    diram_dag_map_close(map);
+
+    // The live DAG bumped traversal counters above; compare against a fresh write
+    assert(diram_dag_serialize(dag, SNAPSHOT_PATH) == 0);
+    diram_dag_t* reloaded = diram_dag_deserialize(SNAPSHOT_PATH);
+    assert(reloaded && diram_dag_serialize(reloaded, ROUNDTRIP_PATH) == 0);
+    uint8_t* original;
+    uint8_t* roundtrip;
+    size_t size = read_file(SNAPSHOT_PATH, &original);
+    assert(read_file(ROUNDTRIP_PATH, &roundtrip) == size);
+    assert(memcmp(original, roundtrip, size) == 0);
+
+    // A learned state appends after the restored generation
+    dag_node_t* fresh = diram_dag_navigate(reloaded, NULL, raw(0xABCD0000u), 0.6f, 8);
+    assert(fresh->id == 23 && reloaded->generation == dag->generation + 1);
+    printf("✓ Upgrade round-trips to an identical image (%zu bytes)\n", size);
+
+    // Corruption: payload caught by VERIFY, header always caught
+    original[size - 1] ^= 0x01;
+    write_file(SNAPSHOT_PATH, original, size);
+    assert(diram_dag_map_open(SNAPSHOT_PATH, DIRAM_DAG_MAP_VERIFY) == NULL);
+    map = diram_dag_map_open(SNAPSHOT_PATH, 0);
+    assert(map);
+    diram_dag_map_close(map);
+    assert(diram_dag_deserialize(SNAPSHOT_PATH) == NULL);
+
+    original[size - 1] ^= 0x01;
+    original[offsetof(diram_dag_file_header_t, generation)] ^= 0x01;
+    write_file(SNAPSHOT_PATH, original, size);
+    assert(diram_dag_map_open(SNAPSHOT_PATH, 0) == NULL);
+
+    write_file(SNAPSHOT_PATH, roundtrip, size - 4);
+    assert(diram_dag_map_open(SNAPSHOT_PATH, 0) == NULL);
+    printf("✓ Checksums reject corrupted and truncated images\n");
+
+    free(original);
+    free(roundtrip);
+    remove(SNAPSHOT_PATH);
+    remove(ROUNDTRIP_PATH);
+    diram_dag_destroy(reloaded);
+    diram_dag_destroy(upgraded);
+    diram_dag_destroy(dag);
+
+    printf("All tests passed!\n");
+    return 0;
+}
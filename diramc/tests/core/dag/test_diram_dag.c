@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/diram_dag.h"
+
+#define READERS        3
+#define WRITER_NODES   3000
+#define WALKS          4000
+
+static diram_dag_t* g_dag;
+static int g_writer_done;
+
+static phenotype_t raw(uint32_t bits) {
+    return (phenotype_t){ .raw = bits };
+}
+
+static uint32_t xorshift(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void* writer_thread(void* arg) {
+    (void)arg;
+    uint32_t rng = 7;
+    for (uint32_t i = 0; i < WRITER_NODES; i++) {
+        uint32_t pick = xorshift(&rng) % __atomic_load_n(&g_dag->node_count, __ATOMIC_RELAXED);
+        dag_node_t* from = i % 3 ? g_dag->nodes[pick] : g_dag->root;
+        dag_node_t* node = diram_dag_add_node(g_dag, raw(xorshift(&rng)));
+        assert(node);
+        assert(diram_dag_connect_nodes(g_dag, from, node, node->phenotype, 0.9f) == 0);
+    }
+    __atomic_store_n(&g_writer_done, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+// Read-only walks; returns how many edges they followed
+static void* reader_thread(void* arg) {
+    uint32_t rng = (uint32_t)(uintptr_t)arg;
+    uintptr_t steps = 0;
+    for (uint32_t w = 0; w < WALKS || !__atomic_load_n(&g_writer_done, __ATOMIC_ACQUIRE); w++) {
+        dag_traversal_context_t* t = diram_dag_begin_traversal(g_dag);
+        phenotype_t target = raw(xorshift(&rng));
+        while (diram_dag_traverse_next(t, target)) steps++;
+        diram_dag_predict_next(g_dag, t->current_node);
+        diram_dag_end_traversal(t);
+    }
+    return (void*)steps;
+}
+
+int main() {
+    printf("Running DIRAMC concurrent DAG tests...\n");
+
+    diram_dag_t* dag = diram_dag_create();
+    assert(dag && dag->root && dag->node_count == 1);
+    dag->threshold = 0.7f;
+
+    // A traversal sees the DAG as of its snapshot, not later appends
+    dag_node_t* a = diram_dag_add_node(dag, raw(0x0F));
+    assert(diram_dag_connect_nodes(dag, dag->root, a, raw(0x0F), 0.9f) == 0);
+    dag_traversal_context_t* t = diram_dag_begin_traversal(dag);
+    uint64_t snapshot = t->snapshot.generation;
+
+    dag_node_t* b = diram_dag_add_node(dag, raw(0xF0));
+    assert(diram_dag_connect_nodes(dag, dag->root, b, raw(0xF0), 0.9f) == 0);
+    assert(dag->generation == snapshot + 1);
+    assert(diram_dag_traverse_next(t, raw(0xF0)) == NULL);
+    assert(t->state == DAG_STATE_COMPLETE);
+    diram_dag_end_traversal(t);
+
+    t = diram_dag_begin_traversal(dag);
+    assert(diram_dag_traverse_next(t, raw(0xF0)) == b);
+    assert(t->cumulative_probability == 0.9f && t->depth == 1);
+    diram_dag_end_traversal(t);
+    printf("✓ Traversals are pinned to their generation\n");
+
+    // Growing a row under a pinned reader retires the old array instead of freeing it
+    diram_dag_snapshot_t snap;
+    diram_dag_snapshot_begin(dag, &snap);
+    dag_edge_t** pinned = dag->root->edges;
+    for (uint32_t i = 0; i < 40; i++) {
+        assert(diram_dag_connect_nodes(dag, dag->root, a, raw(i << 8), 0.1f) == 0);
+    }
+    assert(dag->root->edges != pinned && dag->retired_count > 0);
+    assert(pinned[0]->to == a && pinned[1]->to == b);
+    diram_dag_snapshot_end(&snap);
+    for (uint32_t i = 0; i < 200 && dag->retired_count > 0; i++) {
+        assert(diram_dag_connect_nodes(dag, a, b, raw(i), 0.1f) == 0);
+    }
+    assert(dag->retired_count <= 1);
+    printf("✓ Replaced edge arrays reclaimed once readers leave (%u pending)\n", dag->retired_count);
+
+    // Navigation follows the best edge, or appends a new state
+    assert(diram_dag_navigate(dag, NULL, raw(0x0F), 0.3f, 8) == a);
+    uint32_t nodes = dag->node_count;
+    dag_node_t* fresh = diram_dag_navigate(dag, b, raw(0xABCD0000u), 0.3f, 8);
+    assert(dag->node_count == nodes + 1 && fresh->phenotype.raw == 0xABCD0000u);
+    assert(diram_dag_get_transition_probability(dag, b, fresh) == 0.5f);
+    assert(diram_dag_get_transition_probability(NULL, b, fresh) == 0.0f);
+    assert(diram_dag_navigate(dag, b, raw(0xABCD0000u), 0.3f, 8) == fresh);
+    diram_dag_destroy(dag);
+    printf("✓ Navigation matches and appends new states\n");
+
+    // Readers walk while one writer keeps appending and growing rows
+    g_dag = diram_dag_create();
+    g_dag->threshold = 0.5f;
+    pthread_t writer, readers[READERS];
+    pthread_create(&writer, NULL, writer_thread, NULL);
+    for (uintptr_t i = 0; i < READERS; i++) {
+        pthread_create(&readers[i], NULL, reader_thread, (void*)(i * 7919 + 1));
+    }
+
+    uint64_t steps = 0;
+    pthread_join(writer, NULL);
+    for (int i = 0; i < READERS; i++) {
+        void* result;
+        pthread_join(readers[i], &result);
+        steps += (uintptr_t)result;
+    }
+
+    uint64_t counted = 0;
+    for (uint32_t n = 0; n < g_dag->node_count; n++) {
+        for (uint32_t e = 0; e < g_dag->nodes[n]->edge_count; e++) {
+            counted += g_dag->nodes[n]->edges[e]->traversal_count;
+        }
+    }
+    assert(g_dag->node_count == WRITER_NODES + 1 && g_dag->edge_count == WRITER_NODES);
+    assert(counted == steps);
+    printf("✓ %d readers, 1 writer: %llu traversals counted exactly, generation %llu\n",
+           READERS, (unsigned long long)steps, (unsigned long long)g_dag->generation);
+    diram_dag_destroy(g_dag);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/governor/governor.h"
+
+#define NS_PER_SEC 1000000000ULL
+
+static diram_gov_bucket_t shared;
+static int shared_admitted[8];
+
+static uint64_t g_thread_events;
+
+// Three events, then the thread exits and leaves its state to be adopted
+static void* retiring_thread(void* arg) {
+    (void)arg;
+    uint64_t now = diram_gov_now_ns();
+    for (int i = 0; i < 3; i++) assert(diram_gov_admit_thread(now) == 0);
+    g_thread_events = diram_gov_thread_events();
+    return NULL;
+}
+
+static void* adopting_thread(void* arg) {
+    (void)arg;
+    g_thread_events = diram_gov_thread_events();
+    assert(diram_gov_admit_thread(diram_gov_now_ns()) == 0);
+    assert(diram_gov_thread_events() == g_thread_events + 1);
+    return NULL;
+}
+
+// One event on a 1/s bucket of burst 1 fills it for the next second
+static void* saturate_thread(void* arg) {
+    (void)arg;
+    assert(diram_gov_set_thread_limit(1, 1) == 0);
+    assert(diram_gov_admit_thread(diram_gov_now_ns()) == 0);
+    return NULL;
+}
+
+static void* hammer_shared(void* arg) {
+    int id = *(int*)arg;
+    for (int i = 0; i < 10000; i++) {
+        if (diram_gov_bucket_admit(&shared, NS_PER_SEC, 1) == 0) {
+            shared_admitted[id]++;
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC governor tests...\n");
+
+    // Clock is monotonic and in nanoseconds
+    uint64_t t0 = diram_gov_now_ns();
+    uint64_t t1 = diram_gov_now_ns();
+    assert(t1 >= t0);
+    printf("✓ Clock source: %s\n", diram_gov_clock_source());
+
+    // Burst is admitted back-to-back, then the bucket throttles
+    diram_gov_bucket_t bucket;
+    diram_gov_bucket_init(&bucket, 1000, 10);
+    uint64_t now = 5 * NS_PER_SEC;
+    for (int i = 0; i < 10; i++) {
+        assert(diram_gov_bucket_admit(&bucket, now, 1) == 0);
+    }
+    assert(diram_gov_bucket_admit(&bucket, now, 1) == -1);
+    assert(diram_gov_bucket_epsilon(&bucket, now) > 0.99);
+    printf("✓ Burst admitted, excess throttled\n");
+
+    // Refill is continuous: 2.5 ms at 1000/s frees two whole slots, not a second's worth
+    now += 2500000;
+    assert(diram_gov_bucket_admit(&bucket, now, 1) == 0);
+    assert(diram_gov_bucket_admit(&bucket, now, 1) == 0);
+    assert(diram_gov_bucket_admit(&bucket, now, 1) == -1);
+    assert(bucket.admitted == 12 && bucket.throttled == 2);
+    printf("✓ Continuous refill\n");
+
+    // Unlimited buckets always admit
+    diram_gov_bucket_init(&bucket, DIRAM_GOV_UNLIMITED, 0);
+    for (int i = 0; i < 100000; i++) {
+        assert(diram_gov_bucket_admit(&bucket, now, 1) == 0);
+    }
+    printf("✓ Unlimited bucket\n");
+
+    // A shared bucket never over-admits under contention
+    diram_gov_bucket_init(&shared, 1000, 500);
+    pthread_t threads[8];
+    int ids[8];
+    for (int i = 0; i < 8; i++) {
+        ids[i] = i;
+        pthread_create(&threads[i], NULL, hammer_shared, &ids[i]);
+    }
+    int total = 0;
+    for (int i = 0; i < 8; i++) {
+        pthread_join(threads[i], NULL);
+        total += shared_admitted[i];
+    }
+    assert(total == 500);
+    printf("✓ Shared bucket admitted exactly its burst across 8 threads\n");
+
+    // Per-thread limits
+    assert(diram_gov_set_thread_limit(100, 5) == 0);
+    now = diram_gov_now_ns();
+    int admitted = 0;
+    for (int i = 0; i < 20; i++) {
+        if (diram_gov_admit_thread(now) == 0) admitted++;
+    }
+    assert(admitted == 5);
+
+    diram_gov_stats_t stats;
+    diram_gov_get_stats(&stats);
+    assert(stats.threads >= 1 && stats.throttled >= 15);
+    printf("✓ Thread limit: admitted=%lu throttled=%lu max_epsilon=%.2f\n",
+           (unsigned long)stats.admitted, (unsigned long)stats.throttled, stats.max_epsilon);
+
+    // An adopted thread state starts counting from zero; totals are kept
+    pthread_t worker;
+    pthread_create(&worker, NULL, retiring_thread, NULL);
+    pthread_join(worker, NULL);
+    assert(g_thread_events == 3);
+    diram_gov_stats_t before;
+    diram_gov_get_stats(&before);
+    pthread_create(&worker, NULL, adopting_thread, NULL);
+    pthread_join(worker, NULL);
+    assert(g_thread_events == 0);
+    diram_gov_get_stats(&stats);
+    assert(stats.threads == before.threads && stats.admitted == before.admitted + 1);
+    printf("✓ Adopted thread state starts at zero events\n");
+
+    // Buckets past the ε ceiling are flagged
+    pthread_t saturated;
+    pthread_create(&saturated, NULL, saturate_thread, NULL);
+    pthread_join(saturated, NULL);
+    diram_gov_get_stats(&stats);
+    assert(stats.over_limit >= 1 && stats.max_epsilon > DIRAM_GOV_EPSILON_LIMIT);
+    printf("✓ %u bucket(s) over the ε limit of %.1f\n", stats.over_limit, DIRAM_GOV_EPSILON_LIMIT);
+
+    printf("\nAll tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+#include "diram/core/observe/observation_ring.h"
+
+// Cost of recording one observation, folding amortized in, against the
+// previous bounded append that stopped recording at capacity
+
+#define BENCH_RECORDS    20000000
+#define BENCH_THREADS    4
+
+static diram_obs_ring_t* ring;
+static pthread_barrier_t start_line;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void* run_ring(void* arg) {
+    uint32_t n = (uint32_t)(uintptr_t)arg;
+    pthread_barrier_wait(&start_line);
+    for (uint32_t i = 0; i < n; i++) {
+        diram_obs_ring_record(ring, (phenotype_t){ .raw = i * 0x9E3779B9u });
+    }
+    return NULL;
+}
+
+static double threaded(uint32_t threads) {
+    pthread_t tids[BENCH_THREADS];
+    pthread_barrier_init(&start_line, NULL, threads + 1);
+    for (uint32_t t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, run_ring, (void*)(uintptr_t)(BENCH_RECORDS / threads));
+    }
+    pthread_barrier_wait(&start_line);
+    double t0 = now_sec();
+    for (uint32_t t = 0; t < threads; t++) pthread_join(tids[t], NULL);
+    double elapsed = now_sec() - t0;
+    pthread_barrier_destroy(&start_line);
+    return elapsed;
+}
+
+int main() {
+    printf("Observation ring benchmark: %d records\n", BENCH_RECORDS);
+
+    // Previous path: bounded append, silent after 1024
+    phenotype_t* buffer = calloc(1024, sizeof(phenotype_t));
+    volatile uint32_t count = 0;
+    double t0 = now_sec();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        if (count < 1024) buffer[count++] = (phenotype_t){ .raw = i * 0x9E3779B9u };
+    }
+    double old = now_sec() - t0;
+
+    ring = diram_obs_ring_create(0);
+    t0 = now_sec();
+    for (uint32_t i = 0; i < BENCH_RECORDS; i++) {
+        diram_obs_ring_record(ring, (phenotype_t){ .raw = i * 0x9E3779B9u });
+    }
+    double single = now_sec() - t0;
+    diram_obs_summary_t s;
+    diram_obs_ring_summary(ring, &s);
+    printf("  bounded append (kept 1024):  %6.2f ns/record\n", old * 1e9 / BENCH_RECORDS);
+    printf("  ring, 1 thread:              %6.2f ns/record  (%llu folded, %llu dropped)\n",
+           single * 1e9 / BENCH_RECORDS, (unsigned long long)s.folded, (unsigned long long)s.dropped);
+    diram_obs_ring_destroy(ring);
+
+    ring = diram_obs_ring_create(0);
+    double multi = threaded(BENCH_THREADS);
+    diram_obs_ring_summary(ring, &s);
+    printf("  ring, %d threads:             %6.2f ns/record  (%llu folded, %llu dropped)\n",
+           BENCH_THREADS, multi * 1e9 / BENCH_RECORDS,
+           (unsigned long long)s.folded, (unsigned long long)s.dropped);
+
+    t0 = now_sec();
+    for (int i = 0; i < 100000; i++) diram_obs_ring_summary(ring, &s);
+    printf("  summary read:                %6.2f ns\n", (now_sec() - t0) * 1e9 / 100000);
+    diram_obs_ring_destroy(ring);
+    free(buffer);
+    return 0;
+}
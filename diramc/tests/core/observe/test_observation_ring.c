@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+#include <pthread.h>
+#include "diram/core/observe/observation_ring.h"
+
+#define THREADS          4
+#define PER_THREAD       100000
+
+static diram_obs_ring_t* g_ring;
+
+static void* recorder(void* arg) {
+    uint32_t locality = (uint32_t)(uintptr_t)arg;
+    for (uint32_t i = 0; i < PER_THREAD; i++) {
+        phenotype_t p = { .raw = 0 };
+        p.fields.locality = locality;
+        p.fields.age = i & 7;
+        diram_obs_ring_record(g_ring, p);
+    }
+    return NULL;
+}
+
+static uint64_t histogram_total(const diram_obs_summary_t* s, diram_obs_field_t field) {
+    uint64_t total = 0;
+    for (uint32_t b = 0; b < DIRAM_OBS_BUCKETS; b++) total += s->histogram[field][b];
+    return total;
+}
+
+int main() {
+    printf("Running DIRAMC observation ring tests...\n");
+
+    // Field offsets agree with the phenotype_t bitfields
+    phenotype_t p = { .raw = 0 };
+    p.fields.age = 5; p.fields.volatility = 2; p.fields.spread = 3;
+    p.fields.dependency = 6; p.fields.compliance = 4; p.fields.audit = 1;
+    assert(diram_obs_field(p, DIRAM_OBS_AGE) == 5 && diram_obs_field(p, DIRAM_OBS_VOLATILITY) == 2);
+    assert(diram_obs_field(p, DIRAM_OBS_SPREAD) == 3 && diram_obs_field(p, DIRAM_OBS_DEPENDENCY) == 6);
+    assert(diram_obs_field(p, DIRAM_OBS_COMPLIANCE) == 4 && diram_obs_field(p, DIRAM_OBS_AUDIT) == 1);
+    assert(diram_obs_field(p, DIRAM_OBS_LOCALITY) == 0);
+    printf("✓ Field layout matches phenotype_t\n");
+
+    // Keeps recording past capacity; the newest survive in order
+    diram_obs_ring_t* ring = diram_obs_ring_create(50);
+    assert(ring && ring->mask == 63);
+    for (uint32_t i = 0; i < 1000; i++) diram_obs_ring_record(ring, (phenotype_t){ .raw = i });
+    phenotype_t recent[128];
+    assert(diram_obs_ring_recent(ring, recent, 128) == 64);
+    for (uint32_t i = 0; i < 64; i++) assert(recent[i].raw == 936 + i);
+    assert(diram_obs_ring_recent(ring, recent, 3) == 3 && recent[2].raw == 999);
+    printf("✓ Ring keeps the newest observations past capacity\n");
+
+    // Nothing lost to the aggregates while one recorder keeps up
+    diram_obs_summary_t s;
+    assert(diram_obs_ring_summary(ring, &s) == 0);
+    assert(s.recorded == 1000 && s.folded == 1000 && s.dropped == 0 && s.last.raw == 999);
+    assert(histogram_total(&s, DIRAM_OBS_AGE) == 1000);
+    assert(s.histogram[DIRAM_OBS_AGE][0] == 125);
+    diram_obs_ring_destroy(ring);
+
+    // EWMA follows a shift in behaviour
+    ring = diram_obs_ring_create(0);
+    phenotype_t steady = { .raw = 0 };
+    steady.fields.locality = 1;
+    for (uint32_t i = 0; i < 2000; i++) diram_obs_ring_record(ring, steady);
+    diram_obs_ring_summary(ring, &s);
+    assert(fabsf(s.ewma[DIRAM_OBS_LOCALITY] - 1.0f) < 0.01f);
+    steady.fields.locality = 6;
+    for (uint32_t i = 0; i < 2000; i++) diram_obs_ring_record(ring, steady);
+    diram_obs_ring_summary(ring, &s);
+    assert(fabsf(s.ewma[DIRAM_OBS_LOCALITY] - 6.0f) < 0.05f);
+    assert(s.histogram[DIRAM_OBS_LOCALITY][1] == 2000 && s.histogram[DIRAM_OBS_LOCALITY][6] == 2000);
+    printf("✓ EWMA %.2f and histograms track locality\n", s.ewma[DIRAM_OBS_LOCALITY]);
+    diram_obs_ring_destroy(ring);
+
+    // With fold_lock held elsewhere the recorder spills its own shard, and
+    // merging the spill gives the same averages as folding one by one
+    ring = diram_obs_ring_create(64);
+    steady.fields.locality = 1;
+    ring->fold_lock = 1;
+    for (uint32_t i = 0; i < 2000; i++) diram_obs_ring_record(ring, steady);
+    ring->fold_lock = 0;
+    diram_obs_ring_summary(ring, &s);
+    assert(s.folded == 2000 && s.dropped == 0);
+    assert(fabsf(s.ewma[DIRAM_OBS_LOCALITY] - 1.0f) < 0.01f);
+    steady.fields.locality = 6;
+    ring->fold_lock = 1;
+    for (uint32_t i = 0; i < 64; i++) diram_obs_ring_record(ring, steady);
+    ring->fold_lock = 0;
+    diram_obs_ring_summary(ring, &s);
+    float expected = 1.0f + 5.0f * (1.0f - powf(63.0f / 64.0f, 64.0f));
+    assert(s.folded == 2064 && s.dropped == 0);
+    assert(fabsf(s.ewma[DIRAM_OBS_LOCALITY] - expected) < 0.01f);
+    assert(s.histogram[DIRAM_OBS_LOCALITY][1] == 2000 && s.histogram[DIRAM_OBS_LOCALITY][6] == 64);
+    printf("✓ Contended folds spill and merge (EWMA %.3f, expected %.3f)\n",
+           s.ewma[DIRAM_OBS_LOCALITY], expected);
+    diram_obs_ring_destroy(ring);
+
+    // Concurrent recorders: a recorder that loses the fold spills its own
+    // shard, so none is lapped even when the folder is preempted
+    g_ring = diram_obs_ring_create(256);
+    pthread_t threads[THREADS];
+    for (uintptr_t t = 0; t < THREADS; t++) pthread_create(&threads[t], NULL, recorder, (void*)(t + 1));
+    for (int t = 0; t < THREADS; t++) pthread_join(threads[t], NULL);
+    diram_obs_ring_summary(g_ring, &s);
+    assert(s.recorded == THREADS * PER_THREAD);
+    assert(s.folded + s.dropped == s.recorded);
+    assert(s.dropped == 0);
+    assert(histogram_total(&s, DIRAM_OBS_LOCALITY) == s.folded);
+    assert(s.folded > 0 && s.histogram[DIRAM_OBS_LOCALITY][0] == 0);
+    printf("✓ %d threads: %llu folded, %llu dropped\n", THREADS,
+           (unsigned long long)s.folded, (unsigned long long)s.dropped);
+    diram_obs_ring_destroy(g_ring);
+
+    printf("All tests passed!\n");
+    return 0;
+}
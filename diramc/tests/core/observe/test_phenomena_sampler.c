@@ -0,0 +1,138 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "diram/core/observe/phenomena_sampler.h"
+
+#define PAGES       64
+#define LOOKUPS     200000
+
+static diram_sampler_t* g_sampler;
+static char* g_region;
+
+static void* reader_thread(void* arg) {
+    (void)arg;
+    diram_region_sample_t s;
+    for (uint32_t i = 0; i < LOOKUPS; i++) {
+        if (diram_sampler_lookup(g_sampler, g_region + (i % PAGES) * 4096, &s) == 0) {
+            assert(s.pages == PAGES && s.resident <= PAGES && s.pass > 0);
+            assert((s.phenomena.raw & ~DIRAM_SAMPLE_FIELD_MASK) == 0);
+        }
+    }
+    return NULL;
+}
+
+int main() {
+    printf("Running DIRAMC phenomena sampler tests...\n");
+
+    // Soft-dirty clears the whole process's bits: off by default, and
+    // only one sampler at a time gets it
+    diram_sampler_t* defaults = diram_sampler_create(NULL);
+    assert(defaults);
+    assert(!(diram_sampler_sources(defaults) & DIRAM_SAMPLE_SOFT_DIRTY));
+    diram_sampler_config_t all = { DIRAM_SAMPLER_INTERVAL_MS, DIRAM_SAMPLE_ALL };
+    diram_sampler_t* sampler = diram_sampler_create(&all);
+    assert(sampler);
+    uint32_t sources = diram_sampler_sources(sampler);
+    assert(sources & DIRAM_SAMPLE_MINCORE);
+    bool soft_dirty = sources & DIRAM_SAMPLE_SOFT_DIRTY;
+    diram_sampler_t* second = diram_sampler_create(&all);
+    assert(second && !(diram_sampler_sources(second) & DIRAM_SAMPLE_SOFT_DIRTY));
+    diram_sampler_destroy(second);
+    diram_sampler_destroy(defaults);
+    printf("✓ Sources: mincore%s%s%s\n", sources & DIRAM_SAMPLE_PAGEMAP ? " pagemap" : "",
+           soft_dirty ? " soft-dirty" : "", sources & DIRAM_SAMPLE_IDLE_PAGE ? " idle-page" : "");
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char* region = mmap(NULL, PAGES * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(region != MAP_FAILED);
+    diram_region_sample_t s;
+
+    // Nothing to report until a pass has run
+    assert(diram_sampler_track(sampler, region + 100, PAGES * page - 200) == 0);
+    assert(diram_sampler_lookup(sampler, region, &s) == -1);
+    diram_sampler_sample(sampler);
+    assert(diram_sampler_lookup(sampler, region + PAGES * page - 1, &s) == 0);
+    assert(s.pages == PAGES && s.resident == 0 && s.accessed == 0);
+    assert(s.phenomena.fields.clustering == 0 && s.phenomena.fields.spread == 0);
+    assert(diram_sampler_lookup(sampler, region + PAGES * page, &s) == -1);
+    printf("✓ Untouched region: %u pages, none resident\n", s.pages);
+
+    // One contiguous quarter written
+    memset(region, 1, 16 * page);
+    diram_sampler_sample(sampler);
+    assert(diram_sampler_lookup(sampler, region, &s) == 0);
+    assert(s.resident == 16 && s.accessed == 16);
+    assert(!soft_dirty || s.dirtied == 16);
+    assert(s.phenomena.fields.age == 0 && s.phenomena.fields.clustering == 2);
+    assert(s.phenomena.fields.locality == 7 && s.phenomena.fields.spread == 1);
+    printf("✓ Contiguous writes: locality %u, spread %u\n",
+           s.phenomena.fields.locality, s.phenomena.fields.spread);
+
+    // Left alone, it ages and cools
+    diram_sampler_sample(sampler);
+    diram_sampler_sample(sampler);
+    diram_sampler_sample(sampler);
+    assert(diram_sampler_lookup(sampler, region, &s) == 0);
+    assert(s.resident == 16 && s.accessed == 0 && s.dirtied == 0);
+    assert(s.phenomena.fields.age == 2 && s.phenomena.fields.volatility == 0);
+    printf("✓ Idle region ages to bucket %u\n", s.phenomena.fields.age);
+
+    // Scattered writes spread out and lose locality
+    for (uint32_t i = 32; i < PAGES; i += 2) region[i * page] = 1;
+    diram_sampler_sample(sampler);
+    assert(diram_sampler_lookup(sampler, region, &s) == 0);
+    assert(s.resident == 32 && s.accessed == 16);
+    assert(s.phenomena.fields.age == 0 && s.phenomena.fields.locality == 0);
+    assert(s.phenomena.fields.spread == 3);
+    printf("✓ Scattered writes: locality %u, spread %u\n",
+           s.phenomena.fields.locality, s.phenomena.fields.spread);
+
+    // Rewriting resident pages is only visible through soft-dirty bits
+    if (soft_dirty) {
+        for (uint32_t round = 0; round < 8; round++) {
+            memset(region, 2, 16 * page);
+            diram_sampler_sample(sampler);
+        }
+        assert(diram_sampler_lookup(sampler, region, &s) == 0);
+        assert(s.dirtied == 16 && s.accessed == 16);
+        assert(s.phenomena.fields.volatility == 1 && s.phenomena.fields.frequency == 2);
+        printf("✓ Rewrites: volatility %u, frequency %u\n",
+               s.phenomena.fields.volatility, s.phenomena.fields.frequency);
+    }
+
+    // Untracked regions stop answering; their slot is reused fresh
+    diram_sampler_untrack(sampler, region);
+    assert(diram_sampler_lookup(sampler, region, &s) == -1);
+    assert(diram_sampler_track(sampler, region, PAGES * page) == 0);
+    diram_sampler_sample(sampler);
+    assert(diram_sampler_lookup(sampler, region, &s) == 0 && s.resident == 32);
+    assert(s.phenomena.fields.age == 0 && s.phenomena.fields.frequency == 1);
+    printf("✓ Untrack and re-track\n");
+
+    // Background sampling while other threads look regions up
+    g_sampler = sampler;
+    g_region = region;
+    uint64_t before = s.pass;
+    assert(diram_sampler_start(sampler) == 0);
+    assert(diram_sampler_start(sampler) == -1);
+    pthread_t readers[2];
+    for (int r = 0; r < 2; r++) pthread_create(&readers[r], NULL, reader_thread, NULL);
+    for (int r = 0; r < 2; r++) pthread_join(readers[r], NULL);
+    do {
+        sched_yield();
+        assert(diram_sampler_lookup(sampler, region, &s) == 0);
+    } while (s.pass == before);
+    diram_sampler_stop(sampler);
+    printf("✓ Background thread reached pass %llu\n", (unsigned long long)s.pass);
+
+    diram_sampler_destroy(sampler);
+    munmap(region, PAGES * page);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,388 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <malloc.h>
+#include <unistd.h>
+#include "diram/core/parser/tokenizer.h"
+#include "diram/core/parser/ast.h"
+
+// Parse-plus-visit time and heap use for a ~100k-node manifest, built once
+// as separately allocated diram_ast_node_t trees and once into an arena.
+
+#define BENCH_NODES     100000
+#define BENCH_ROUNDS    5
+#define BENCH_PATH      "/tmp/diram_bench_ast.xml"
+#define NODES_PER_UNIT  7
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void write_manifest(const char* path, uint32_t units) {
+    FILE* f = fopen(path, "w");
+    if (!f) exit(1);
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<diram-config version=\"1.0.0\">\n", f);
+    for (uint32_t i = 0; i < units; i++) {
+        fprintf(f,
+            "    <features>\n"
+            "        <toggle name=\"feature_%u\" enabled=\"%s\">\n"
+            "            <description>Generated toggle %u</description>\n"
+            "            <policy>zero-trust</policy>\n"
+            "        </toggle>\n"
+            "    </features>\n"
+            "    <opcodes>\n"
+            "        <opcode name=\"OP_%u\" code=\"0x%02x\">\n"
+            "            <operands>\n"
+            "                <operand name=\"size\" type=\"size_t\" position=\"1\"/>\n"
+            "                <operand name=\"tag\" type=\"string\" position=\"2\"/>\n"
+            "            </operands>\n"
+            "            <constraints><heap_events max=\"3\"/></constraints>\n"
+            "        </opcode>\n"
+            "    </opcodes>\n"
+            "    <policies>\n"
+            "        <policy name=\"policy_%u\" type=\"security\">\n"
+            "            <rule>all_allocations_traced</rule>\n"
+            "            <rule>pid_binding_enforced</rule>\n"
+            "            <rule>cryptographic_verification</rule>\n"
+            "        </policy>\n"
+            "    </policies>\n"
+            "    <memory_regions>\n"
+            "        <region name=\"region_%u\" base=\"0x%08x\" size=\"16777216\" protection=\"rw\"/>\n"
+            "    </memory_regions>\n",
+            i, i & 1 ? "true" : "false", i, i, i & 0xFF, i, i, i << 12);
+    }
+    fputs("</diram-config>\n", f);
+    fclose(f);
+}
+
+// Element name -> node type; -1 for containers and text-only elements
+static int element_type(const char* name, size_t length, int parent_type) {
+#define IS(s) (length == sizeof(s) - 1 && memcmp(name, s, length) == 0)
+    if (IS("diram-config")) return AST_NODE_ROOT;
+    if (IS("toggle")) return AST_NODE_FEATURE_TOGGLE;
+    if (IS("opcode")) return AST_NODE_OPCODE;
+    if (IS("operand")) return AST_NODE_OPERAND;
+    if (IS("heap_events")) return AST_NODE_CONSTRAINT;
+    if (IS("policy") && parent_type != AST_NODE_FEATURE_TOGGLE) return AST_NODE_POLICY;
+    if (IS("region")) return AST_NODE_MEMORY_REGION;
+    if (IS("target")) return AST_NODE_BUILD_TARGET;
+    return -1;
+#undef IS
+}
+
+typedef struct {
+    int type;               // node type opened by this element, or -1
+    const char* name;       // element name, for text fields
+    size_t length;
+} frame_t;
+
+// ---------------------------------------------------------------------------
+// Per-node layout
+// ---------------------------------------------------------------------------
+
+static diram_ast_node_t* build_nodes(const char* path) {
+    diram_tokenizer_t* t = diram_tokenizer_open(path);
+    diram_ast_node_t* stack[64];
+    frame_t frames[64];
+    int depth = 0, nodes = 0;
+    diram_ast_node_t* root = NULL;
+    const char* attribute = NULL;
+    size_t attribute_length = 0;
+
+    for (;;) {
+        diram_token_t tok = diram_tokenizer_next(t);
+        if (tok.type == TOKEN_EOF || tok.type == TOKEN_ERROR) break;
+        const char* text = diram_tokenizer_text(t, &tok);
+        size_t length = tok.value.text.length;
+        diram_ast_node_t* current = nodes ? stack[nodes - 1] : NULL;
+
+        switch (tok.type) {
+        case TOKEN_ELEMENT_START: {
+            int type = element_type(text, length, current ? (int)current->type : -1);
+            frames[depth++] = (frame_t){ type, text, length };
+            if (type < 0) break;
+            diram_ast_node_t* node = diram_ast_create_node((diram_ast_node_type_t)type);
+            if (current) diram_ast_add_child(current, node);
+            else root = node;
+            stack[nodes++] = node;
+            if (type == AST_NODE_CONSTRAINT) node->data.constraint.name = strndup(text, length);
+            break;
+        }
+        case TOKEN_ATTRIBUTE_NAME:
+            attribute = text;
+            attribute_length = length;
+            break;
+        case TOKEN_ATTRIBUTE_VALUE: {
+            if (!current || frames[depth - 1].type < 0) break;
+            bool is_name = attribute_length == 4 && memcmp(attribute, "name", 4) == 0;
+            char c = attribute[0];
+            switch (current->type) {
+            case AST_NODE_FEATURE_TOGGLE:
+                if (is_name) current->data.feature.name = strndup(text, length);
+                else current->data.feature.enabled = length == 4 && memcmp(text, "true", 4) == 0;
+                break;
+            case AST_NODE_OPCODE:
+                if (is_name) current->data.opcode.name = strndup(text, length);
+                else current->data.opcode.code = (uint8_t)strtoul(text, NULL, 16);
+                break;
+            case AST_NODE_OPERAND:
+                if (is_name) current->data.operand.name = strndup(text, length);
+                else if (c == 't') current->data.operand.type = strndup(text, length);
+                else current->data.operand.position = (uint32_t)strtoul(text, NULL, 10);
+                break;
+            case AST_NODE_CONSTRAINT:
+                current->data.constraint.max_heap_events = (uint32_t)strtoul(text, NULL, 10);
+                break;
+            case AST_NODE_POLICY:
+                if (is_name) current->data.policy.name = strndup(text, length);
+                else current->data.policy.type = strndup(text, length);
+                break;
+            case AST_NODE_MEMORY_REGION:
+                if (is_name) current->data.memory_region.name = strndup(text, length);
+                else if (c == 'b') current->data.memory_region.base_address = strtoull(text, NULL, 16);
+                else if (c == 's') current->data.memory_region.size = strtoull(text, NULL, 10);
+                else current->data.memory_region.protection_flags = 6;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+        case TOKEN_TEXT: {
+            if (!current || depth == 0) break;
+            frame_t* f = &frames[depth - 1];
+            if (current->type == AST_NODE_FEATURE_TOGGLE) {
+                if (f->name[0] == 'd') current->data.feature.description = strndup(text, length);
+                else current->data.feature.policy = strndup(text, length);
+            } else if (current->type == AST_NODE_POLICY) {
+                size_t n = current->data.policy.rule_count;
+                current->data.policy.rules = realloc(current->data.policy.rules, (n + 1) * sizeof(char*));
+                current->data.policy.rules[n] = strndup(text, length);
+                current->data.policy.rule_count = n + 1;
+            }
+            break;
+        }
+        case TOKEN_ELEMENT_END:
+            if (frames[--depth].type >= 0) nodes--;
+            break;
+        default:
+            break;
+        }
+    }
+    diram_tokenizer_destroy(t);
+    return root;
+}
+
+// ---------------------------------------------------------------------------
+// Arena layout
+// ---------------------------------------------------------------------------
+
+static diram_ast_arena_t* build_arena(const char* path) {
+    diram_tokenizer_t* t = diram_tokenizer_open(path);
+    diram_ast_arena_t* arena = diram_ast_arena_create(0);
+    diram_ast_ref_t stack[64];
+    frame_t frames[64];
+    int depth = 0, nodes = 0;
+    const char* attribute = NULL;
+    size_t attribute_length = 0;
+
+    for (;;) {
+        diram_token_t tok = diram_tokenizer_next(t);
+        if (tok.type == TOKEN_EOF || tok.type == TOKEN_ERROR) break;
+        const char* text = diram_tokenizer_text(t, &tok);
+        size_t length = tok.value.text.length;
+        diram_ast_ref_t ref = nodes ? stack[nodes - 1] : DIRAM_AST_NONE;
+        diram_ast_compact_t* current = diram_ast_arena_node(arena, ref);
+
+        switch (tok.type) {
+        case TOKEN_ELEMENT_START: {
+            int type = element_type(text, length, current ? current->type : -1);
+            frames[depth++] = (frame_t){ type, text, length };
+            if (type < 0) break;
+            ref = diram_ast_arena_open(arena, (diram_ast_node_type_t)type);
+            stack[nodes++] = ref;
+            if (type == AST_NODE_CONSTRAINT) {
+                diram_ast_arena_node(arena, ref)->name = diram_ast_arena_intern(arena, text, length);
+            }
+            break;
+        }
+        case TOKEN_ATTRIBUTE_NAME:
+            attribute = text;
+            attribute_length = length;
+            break;
+        case TOKEN_ATTRIBUTE_VALUE: {
+            if (!current || frames[depth - 1].type < 0) break;
+            bool is_name = attribute_length == 4 && memcmp(attribute, "name", 4) == 0;
+            char c = attribute[0];
+            switch (current->type) {
+            case AST_NODE_FEATURE_TOGGLE:
+                if (is_name) current->name = diram_ast_arena_intern(arena, text, length);
+                else if (length == 4 && memcmp(text, "true", 4) == 0) current->flags |= DIRAM_AST_ENABLED;
+                break;
+            case AST_NODE_OPCODE:
+                if (is_name) current->name = diram_ast_arena_intern(arena, text, length);
+                else current->code = (uint16_t)strtoul(text, NULL, 16);
+                break;
+            case AST_NODE_OPERAND:
+                if (is_name) current->name = diram_ast_arena_intern(arena, text, length);
+                else if (c == 't') current->text = diram_ast_arena_intern(arena, text, length);
+                else current->code = (uint16_t)strtoul(text, NULL, 10);
+                break;
+            case AST_NODE_CONSTRAINT:
+                current->extent = strtoul(text, NULL, 10);
+                break;
+            case AST_NODE_POLICY:
+                if (is_name) current->name = diram_ast_arena_intern(arena, text, length);
+                else current->text = diram_ast_arena_intern(arena, text, length);
+                break;
+            case AST_NODE_MEMORY_REGION:
+                if (is_name) current->name = diram_ast_arena_intern(arena, text, length);
+                else if (c == 'b') current->value = strtoull(text, NULL, 16);
+                else if (c == 's') current->extent = strtoull(text, NULL, 10);
+                else current->flags |= 6;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+        case TOKEN_TEXT: {
+            if (!current || depth == 0) break;
+            frame_t* f = &frames[depth - 1];
+            diram_ast_str_t str = diram_ast_arena_intern(arena, text, length);
+            if (current->type == AST_NODE_FEATURE_TOGGLE) {
+                if (f->name[0] == 'd') current->text = str;
+                else current->extra = str;
+            } else if (current->type == AST_NODE_POLICY) {
+                diram_ast_arena_add_rule(arena, ref, str);
+            }
+            break;
+        }
+        case TOKEN_ELEMENT_END:
+            if (frames[--depth].type >= 0) {
+                diram_ast_arena_close(arena);
+                nodes--;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    diram_tokenizer_destroy(t);
+    return arena;
+}
+
+// ---------------------------------------------------------------------------
+// Visitor: count nodes and touch every name
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    diram_ast_visitor_t base;
+    size_t nodes;
+    size_t bytes;
+} count_visitor_t;
+
+static void* count_any(diram_ast_visitor_t* self, diram_ast_node_t* node) {
+    count_visitor_t* v = (count_visitor_t*)self;
+    v->nodes++;
+    const char* name = NULL;
+    switch (node->type) {
+        case AST_NODE_OPCODE:         name = node->data.opcode.name; break;
+        case AST_NODE_CONSTRAINT:     name = node->data.constraint.name; break;
+        case AST_NODE_POLICY:         name = node->data.policy.name;
+                                      v->bytes += node->data.policy.rule_count; break;
+        case AST_NODE_FEATURE_TOGGLE: name = node->data.feature.name; break;
+        case AST_NODE_MEMORY_REGION:  name = node->data.memory_region.name; break;
+        case AST_NODE_OPERAND:        name = node->data.operand.name; break;
+        default: break;
+    }
+    if (name) v->bytes += strlen(name);
+    return NULL;
+}
+
+static count_visitor_t count_visitor(void) {
+    count_visitor_t v = { 0 };
+    v.base.visit_root = v.base.visit_allocation = v.base.visit_opcode = count_any;
+    v.base.visit_constraint = v.base.visit_policy = v.base.visit_feature_toggle = count_any;
+    v.base.visit_memory_region = v.base.visit_operand = v.base.visit_build_target = count_any;
+    return v;
+}
+
+static size_t heap_in_use(void) {
+    return mallinfo2().uordblks;
+}
+
+int main() {
+    uint32_t units = BENCH_NODES / NODES_PER_UNIT;
+    write_manifest(BENCH_PATH, units);
+    printf("AST benchmark: %u nodes, best of %d\n", units * NODES_PER_UNIT + 1, BENCH_ROUNDS);
+    printf("  %-10s %10s %10s %10s %12s %8s\n", "layout", "parse ms", "visit ms", "free ms", "heap bytes", "B/node");
+
+    // Tokenizing alone, the floor under both parse times
+    double best_parse = 1e9, best_visit = 1e9, best_free = 1e9;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        double t0 = now_sec();
+        diram_tokenizer_t* t = diram_tokenizer_open(BENCH_PATH);
+        diram_token_t tok;
+        do {
+            tok = diram_tokenizer_next(t);
+        } while (tok.type != TOKEN_EOF && tok.type != TOKEN_ERROR);
+        diram_tokenizer_destroy(t);
+        if (now_sec() - t0 < best_parse) best_parse = now_sec() - t0;
+    }
+    printf("  %-10s %10.2f\n", "tokens", best_parse * 1e3);
+
+    best_parse = 1e9;
+    size_t heap = 0, nodes = 0, check = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        size_t before = heap_in_use();
+        double t0 = now_sec();
+        diram_ast_node_t* root = build_nodes(BENCH_PATH);
+        double t1 = now_sec();
+        heap = heap_in_use() - before;
+        count_visitor_t v = count_visitor();
+        diram_ast_accept(root, &v.base);
+        double t2 = now_sec();
+        diram_ast_destroy_node(root);
+        double t3 = now_sec();
+        nodes = v.nodes;
+        check = v.bytes;
+        if (t1 - t0 < best_parse) best_parse = t1 - t0;
+        if (t2 - t1 < best_visit) best_visit = t2 - t1;
+        if (t3 - t2 < best_free) best_free = t3 - t2;
+    }
+    printf("  %-10s %10.2f %10.2f %10.2f %12zu %8.1f\n", "per-node", best_parse * 1e3,
+           best_visit * 1e3, best_free * 1e3, heap, (double)heap / nodes);
+
+    best_parse = best_visit = best_free = 1e9;
+    size_t arena_nodes = 0, arena_check = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        size_t before = heap_in_use();
+        double t0 = now_sec();
+        diram_ast_arena_t* arena = build_arena(BENCH_PATH);
+        double t1 = now_sec();
+        heap = heap_in_use() - before;
+        count_visitor_t v = count_visitor();
+        diram_ast_arena_accept(arena, 0, &v.base);
+        double t2 = now_sec();
+        diram_ast_arena_destroy(arena);
+        double t3 = now_sec();
+        arena_nodes = v.nodes;
+        arena_check = v.bytes;
+        if (t1 - t0 < best_parse) best_parse = t1 - t0;
+        if (t2 - t1 < best_visit) best_visit = t2 - t1;
+        if (t3 - t2 < best_free) best_free = t3 - t2;
+    }
+    printf("  %-10s %10.2f %10.2f %10.2f %12zu %8.1f\n", "arena", best_parse * 1e3,
+           best_visit * 1e3, best_free * 1e3, heap, (double)heap / arena_nodes);
+
+    if (nodes != arena_nodes || check != arena_check) {
+        printf("layouts disagree: %zu/%zu nodes\n", nodes, arena_nodes);
+        return 1;
+    }
+    unlink(BENCH_PATH);
+    return 0;
+}
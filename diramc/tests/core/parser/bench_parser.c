@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "diram/core/parser/parser.h"
+
+// Throughput and peak RSS of a full parse of a large manifest, buffered
+// into the arena and streamed to a visitor. Each mode runs in its own
+// child so ru_maxrss is that mode's alone.
+
+#define BENCH_UNITS     40000
+#define BENCH_PATH      "/tmp/diram_bench_parser.xml"
+#define STREAM_CHUNK    (64 * 1024)
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static size_t write_manifest(const char* path, uint32_t units) {
+    FILE* f = fopen(path, "w");
+    if (!f) exit(1);
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<diram-config version=\"1.0.0\">\n", f);
+    for (uint32_t i = 0; i < units; i++) {
+        fprintf(f,
+            "    <features>\n"
+            "        <toggle name=\"feature_%u\" enabled=\"%s\">\n"
+            "            <description>Generated toggle %u</description>\n"
+            "            <policy>zero-trust</policy>\n"
+            "            <constraint>epsilon_limit=0.6</constraint>\n"
+            "        </toggle>\n"
+            "    </features>\n"
+            "    <opcodes>\n"
+            "        <opcode name=\"OP_%u\" code=\"0x%02x\">\n"
+            "            <operands>\n"
+            "                <operand name=\"size\" type=\"size_t\" position=\"1\"/>\n"
+            "                <operand name=\"tag\" type=\"string\" position=\"2\"/>\n"
+            "            </operands>\n"
+            "            <constraints><heap_events max=\"3\"/></constraints>\n"
+            "        </opcode>\n"
+            "    </opcodes>\n"
+            "    <policies>\n"
+            "        <policy name=\"policy_%u\" type=\"security\">\n"
+            "            <rule>all_allocations_traced</rule>\n"
+            "            <rule>pid_binding_enforced</rule>\n"
+            "        </policy>\n"
+            "    </policies>\n"
+            "    <memory_regions>\n"
+            "        <region name=\"region_%u\" base=\"0x%08x\" size=\"16MB\" protection=\"rw\"/>\n"
+            "    </memory_regions>\n",
+            i, i & 1 ? "true" : "false", i, i, i % 254 + 1, i, i, i << 12);
+    }
+    fputs("</diram-config>\n", f);
+    long size = ftell(f);
+    fclose(f);
+    return (size_t)size;
+}
+
+static void* count_node(diram_ast_visitor_t* self, diram_ast_node_t* node) {
+    (void)node;
+    (*(uint64_t*)self->context)++;
+    return NULL;
+}
+
+typedef enum { MODE_BUFFERED, MODE_STREAM_MAPPED, MODE_STREAM_FD } mode_t_;
+
+static const char* const mode_names[] = {
+    "buffered (mmap, whole arena)", "streaming (mmap)", "streaming (read, 64 KB chunks)"
+};
+
+// Runs in the child: parse, visit, report nodes and seconds through the pipe
+static int run_mode(mode_t_ mode, int out) {
+    uint64_t nodes = 0;
+    diram_ast_visitor_t visitor;
+    memset(&visitor, 0, sizeof(visitor));
+    visitor.visit_root = visitor.visit_feature_toggle = visitor.visit_constraint = count_node;
+    visitor.visit_opcode = visitor.visit_operand = visitor.visit_policy = count_node;
+    visitor.visit_memory_region = visitor.visit_build_target = count_node;
+    visitor.context = &nodes;
+
+    double start = now_sec();
+    diram_parser_t* parser;
+    if (mode == MODE_STREAM_FD) {
+        int fd = open(BENCH_PATH, O_RDONLY);
+        parser = diram_parser_create_from_tokenizer(diram_tokenizer_create_stream(fd, STREAM_CHUNK));
+    } else {
+        parser = diram_parser_open(BENCH_PATH);
+    }
+    if (!parser) return 1;
+    if (mode != MODE_BUFFERED) {
+        parser->emit_ast_immediately = true;
+        diram_parser_set_visitor(parser, &visitor);
+    }
+    diram_ast_arena_t* arena = diram_parser_parse(parser);
+    if (!arena) {
+        fprintf(stderr, "%s\n", diram_parser_get_error(parser));
+        return 1;
+    }
+    if (mode == MODE_BUFFERED) diram_ast_arena_accept(arena, parser->root, &visitor);
+    size_t arena_bytes = diram_ast_arena_bytes(arena);
+    diram_parser_destroy(parser);
+    double seconds = now_sec() - start;
+
+    dprintf(out, "%llu %f %zu\n", (unsigned long long)nodes, seconds, arena_bytes);
+    return 0;
+}
+
+int main() {
+    printf("DIRAMC parser benchmark\n");
+    size_t size = write_manifest(BENCH_PATH, BENCH_UNITS);
+    printf("  manifest: %u units, %.1f MB\n\n", BENCH_UNITS, size / 1e6);
+
+    for (int mode = MODE_BUFFERED; mode <= MODE_STREAM_FD; mode++) {
+        int fds[2];
+        if (pipe(fds) != 0) return 1;
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            _exit(run_mode((mode_t_)mode, fds[1]));
+        }
+        close(fds[1]);
+
+        int status;
+        struct rusage usage;
+        if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            printf("  %-32s failed\n", mode_names[mode]);
+            return 1;
+        }
+        char line[128] = {0};
+        if (read(fds[0], line, sizeof(line) - 1) <= 0) return 1;
+        close(fds[0]);
+
+        unsigned long long nodes;
+        double seconds;
+        size_t arena_bytes;
+        sscanf(line, "%llu %lf %zu", &nodes, &seconds, &arena_bytes);
+        printf("  %-32s %8.1f ms %7.1f MB/s  %llu nodes  arena %6.2f MB  peak RSS %6.1f MB\n",
+               mode_names[mode], seconds * 1e3, size / seconds / 1e6, nodes,
+               arena_bytes / 1e6, usage.ru_maxrss / 1024.0);
+    }
+
+    unlink(BENCH_PATH);
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include "diram/core/parser/tokenizer.h"
+#include "diram/core/parser/structural_index.h"
+
+// Tokenizer throughput over a synthetic manifest shaped like
+// diram.drc.in.xml: the structural scan alone and full tokenization
+// (mapped, read from a file in chunks, piped) under each scan path.
+
+#define BENCH_BYTES     (64u << 20)
+#define BENCH_ROUNDS    5
+#define BENCH_PATH      "/tmp/diram_bench_manifest.xml"
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static size_t write_manifest(const char* path, size_t target) {
+    FILE* f = fopen(path, "w");
+    if (!f) return 0;
+    fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+          "<diram-config version=\"1.0.0\" xmlns=\"http://obinexus.org/diram/config\">\n", f);
+    for (uint32_t i = 0; (size_t)ftell(f) < target; i++) {
+        fprintf(f,
+            "    <!-- Unit %u -->\n"
+            "    <features>\n"
+            "        <toggle name=\"feature_%u\" enabled=\"%s\">\n"
+            "            <description>Generated toggle %u for throughput runs</description>\n"
+            "            <policy>zero-trust</policy>\n"
+            "            <constraint>epsilon_limit=0.6</constraint>\n"
+            "        </toggle>\n"
+            "    </features>\n"
+            "    <opcodes>\n"
+            "        <opcode name=\"OP_%u\" code=\"0x%02x\">\n"
+            "            <operands>\n"
+            "                <operand name=\"size\" type=\"size_t\" position=\"1\"/>\n"
+            "                <operand name=\"tag\" type=\"string\" position=\"2\"/>\n"
+            "            </operands>\n"
+            "            <constraints><heap_events max=\"3\"/><alignment>8</alignment></constraints>\n"
+            "        </opcode>\n"
+            "    </opcodes>\n"
+            "    <memory_regions>\n"
+            "        <region name=\"region_%u\" base=\"0x%08x\" size=\"16MB\" protection=\"rw\"/>\n"
+            "    </memory_regions>\n",
+            i, i, i & 1 ? "true" : "false", i, i, i & 0xFF, i, i << 12);
+    }
+    fputs("</diram-config>\n", f);
+    size_t size = (size_t)ftell(f);
+    fclose(f);
+    return size;
+}
+
+static uint64_t drain(diram_tokenizer_t* t) {
+    uint64_t tokens = 0;
+    for (;;) {
+        diram_token_t tok = diram_tokenizer_next(t);
+        if (tok.type == TOKEN_EOF) return tokens;
+        if (tok.type == TOKEN_ERROR) {
+            printf("error: %s\n", diram_tokenizer_get_error(t));
+            exit(1);
+        }
+        tokens++;
+    }
+}
+
+static void* pipe_writer(void* arg) {
+    int* fds = arg;
+    FILE* f = fopen(BENCH_PATH, "r");
+    static char buf[1 << 16];
+    size_t n;
+    while (f && (n = fread(buf, 1, sizeof(buf), f)) > 0) {
+        if (write(fds[1], buf, n) != (ssize_t)n) break;
+    }
+    if (f) fclose(f);
+    close(fds[1]);
+    return NULL;
+}
+
+static void report(const char* label, size_t bytes, uint64_t tokens, double best) {
+    printf("  %-24s %7.3f GB/s  %6.1f Mtokens/s\n", label,
+           (double)bytes / best / 1e9, (double)tokens / best / 1e6);
+}
+
+// Stage one alone: classify the mapped manifest into a reused index
+static void bench_scan(size_t bytes) {
+    diram_tokenizer_t* t = diram_tokenizer_open(BENCH_PATH);
+    static diram_scan_block_t index[DIRAM_TOKENIZER_BATCH];
+    size_t blocks = bytes / DIRAM_SCAN_BLOCK;
+    uint64_t lt = 0;
+    double best = 1e9;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        double t0 = now_sec();
+        for (size_t b = 0; b < blocks; b += DIRAM_TOKENIZER_BATCH) {
+            size_t n = blocks - b < DIRAM_TOKENIZER_BATCH ? blocks - b : DIRAM_TOKENIZER_BATCH;
+            diram_scan_blocks(t->input + b * DIRAM_SCAN_BLOCK, n, index);
+            lt += index[0].lt;
+        }
+        double dt = now_sec() - t0;
+        if (dt < best) best = dt;
+    }
+    diram_tokenizer_destroy(t);
+    printf("  %-24s %7.3f GB/s  (%llx)\n", "structural scan", (double)bytes / best / 1e9,
+           (unsigned long long)(lt & 0xF));
+}
+
+int main() {
+    size_t bytes = write_manifest(BENCH_PATH, BENCH_BYTES);
+    if (!bytes) {
+        printf("cannot write %s\n", BENCH_PATH);
+        return 1;
+    }
+    printf("Tokenizer benchmark: %.1f MB manifest, best of %d\n", (double)bytes / 1e6, BENCH_ROUNDS);
+
+    diram_scan_impl_t impls[] = { DIRAM_SCAN_IMPL_SCALAR, DIRAM_SCAN_IMPL_SSE42, DIRAM_SCAN_IMPL_AVX2 };
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (diram_scan_force_impl(impls[i]) != 0) continue;
+        printf("%s\n", diram_scan_impl_name(impls[i]));
+        bench_scan(bytes);
+        uint64_t tokens = 0;
+        double best = 1e9;
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            double t0 = now_sec();
+            diram_tokenizer_t* t = diram_tokenizer_open(BENCH_PATH);
+            tokens = drain(t);
+            diram_tokenizer_destroy(t);
+            double dt = now_sec() - t0;
+            if (dt < best) best = dt;
+        }
+        report("mmap", bytes, tokens, best);
+
+        best = 1e9;
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            FILE* f = fopen(BENCH_PATH, "r");
+            double t0 = now_sec();
+            diram_tokenizer_t* t = diram_tokenizer_create_stream(fileno(f), 0);
+            drain(t);
+            diram_tokenizer_destroy(t);
+            double dt = now_sec() - t0;
+            fclose(f);
+            if (dt < best) best = dt;
+        }
+        report("file, 64 KiB chunks", bytes, tokens, best);
+
+        best = 1e9;
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            int fds[2];
+            if (pipe(fds) != 0) return 1;
+            pthread_t writer;
+            double t0 = now_sec();
+            pthread_create(&writer, NULL, pipe_writer, fds);
+            diram_tokenizer_t* t = diram_tokenizer_create_stream(fds[0], 0);
+            drain(t);
+            diram_tokenizer_destroy(t);
+            pthread_join(writer, NULL);
+            double dt = now_sec() - t0;
+            close(fds[0]);
+            if (dt < best) best = dt;
+        }
+        report("pipe, 64 KiB chunks", bytes, tokens, best);
+    }
+
+    unlink(BENCH_PATH);
+    return 0;
+}
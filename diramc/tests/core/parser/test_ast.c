@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "diram/core/parser/ast.h"
+
+// Records the pre-order sequence of names a visitor sees
+typedef struct {
+    diram_ast_visitor_t base;
+    char trace[512];
+} trace_visitor_t;
+
+static void* trace_node(diram_ast_visitor_t* self, diram_ast_node_t* node) {
+    trace_visitor_t* v = (trace_visitor_t*)self;
+    char entry[96];
+    switch (node->type) {
+        case AST_NODE_ROOT:
+            snprintf(entry, sizeof(entry), "root ");
+            break;
+        case AST_NODE_FEATURE_TOGGLE:
+            snprintf(entry, sizeof(entry), "feature:%s:%d:%s ", node->data.feature.name,
+                     node->data.feature.enabled, node->data.feature.description);
+            break;
+        case AST_NODE_OPCODE:
+            snprintf(entry, sizeof(entry), "opcode:%s:%u ", node->data.opcode.name, node->data.opcode.code);
+            break;
+        case AST_NODE_OPERAND:
+            snprintf(entry, sizeof(entry), "operand:%s:%u ", node->data.operand.name,
+                     node->data.operand.position);
+            break;
+        case AST_NODE_POLICY:
+            snprintf(entry, sizeof(entry), "policy:%s:%zu:%s ", node->data.policy.name,
+                     node->data.policy.rule_count, node->data.policy.rules[1]);
+            break;
+        case AST_NODE_MEMORY_REGION:
+            snprintf(entry, sizeof(entry), "region:%s:%lx:%zu:%u ", node->data.memory_region.name,
+                     (unsigned long)node->data.memory_region.base_address,
+                     node->data.memory_region.size, node->data.memory_region.protection_flags);
+            break;
+        default:
+            snprintf(entry, sizeof(entry), "? ");
+            break;
+    }
+    strncat(v->trace, entry, sizeof(v->trace) - strlen(v->trace) - 1);
+    return NULL;
+}
+
+static trace_visitor_t trace_visitor(void) {
+    trace_visitor_t v;
+    memset(&v, 0, sizeof(v));
+    v.base.visit_root = v.base.visit_feature_toggle = v.base.visit_opcode = trace_node;
+    v.base.visit_operand = v.base.visit_policy = v.base.visit_memory_region = trace_node;
+    return v;
+}
+
+static const char* const rules[] = { "all_allocations_traced", "pid_binding_enforced" };
+
+static diram_ast_node_t* build_nodes(void) {
+    diram_ast_node_t* root = diram_ast_create_node(AST_NODE_ROOT);
+    diram_ast_node_t* feature = diram_ast_create_feature_toggle("detached_mode", true);
+    feature->data.feature.description = strdup("Background daemon");
+    diram_ast_add_child(root, feature);
+
+    diram_ast_node_t* opcode = diram_ast_create_opcode("ALLOC", 1);
+    for (uint32_t i = 1; i <= 2; i++) {
+        diram_ast_node_t* operand = diram_ast_create_node(AST_NODE_OPERAND);
+        operand->data.operand.name = strdup(i == 1 ? "size" : "tag");
+        operand->data.operand.position = i;
+        diram_ast_add_child(opcode, operand);
+    }
+    diram_ast_add_child(root, opcode);
+
+    diram_ast_node_t* policy = diram_ast_create_policy("zero-trust", "security");
+    policy->data.policy.rules = malloc(2 * sizeof(char*));
+    policy->data.policy.rules[0] = strdup(rules[0]);
+    policy->data.policy.rules[1] = strdup(rules[1]);
+    policy->data.policy.rule_count = 2;
+    diram_ast_add_child(root, policy);
+
+    diram_ast_node_t* region = diram_ast_create_memory_region("system", 0xF0000000, 16 << 20);
+    region->data.memory_region.protection_flags = 5;
+    diram_ast_add_child(root, region);
+    return root;
+}
+
+static diram_ast_str_t intern(diram_ast_arena_t* arena, const char* text) {
+    return diram_ast_arena_intern(arena, text, strlen(text));
+}
+
+static void build_arena(diram_ast_arena_t* arena) {
+    assert(diram_ast_arena_open(arena, AST_NODE_ROOT) == 0);
+
+    diram_ast_ref_t feature = diram_ast_arena_open(arena, AST_NODE_FEATURE_TOGGLE);
+    diram_ast_compact_t* node = diram_ast_arena_node(arena, feature);
+    node->name = intern(arena, "detached_mode");
+    node->text = intern(arena, "Background daemon");
+    node->flags = DIRAM_AST_ENABLED;
+    assert(diram_ast_arena_close(arena));
+
+    diram_ast_ref_t opcode = diram_ast_arena_open(arena, AST_NODE_OPCODE);
+    diram_ast_arena_node(arena, opcode)->name = intern(arena, "ALLOC");
+    diram_ast_arena_node(arena, opcode)->code = 1;
+    for (uint16_t i = 1; i <= 2; i++) {
+        diram_ast_ref_t operand = diram_ast_arena_open(arena, AST_NODE_OPERAND);
+        diram_ast_arena_node(arena, operand)->name = intern(arena, i == 1 ? "size" : "tag");
+        diram_ast_arena_node(arena, operand)->code = i;
+        assert(diram_ast_arena_close(arena));
+    }
+    assert(diram_ast_arena_close(arena));
+
+    diram_ast_ref_t policy = diram_ast_arena_open(arena, AST_NODE_POLICY);
+    diram_ast_arena_node(arena, policy)->name = intern(arena, "zero-trust");
+    diram_ast_arena_node(arena, policy)->text = intern(arena, "security");
+    assert(diram_ast_arena_add_rule(arena, policy, intern(arena, rules[0])));
+    assert(diram_ast_arena_add_rule(arena, policy, intern(arena, rules[1])));
+    assert(diram_ast_arena_close(arena));
+
+    diram_ast_ref_t region = diram_ast_arena_open(arena, AST_NODE_MEMORY_REGION);
+    node = diram_ast_arena_node(arena, region);
+    node->name = intern(arena, "system");
+    node->value = 0xF0000000;
+    node->extent = 16 << 20;
+    node->flags = 5;
+    assert(diram_ast_arena_close(arena));
+
+    assert(diram_ast_arena_close(arena));
+}
+
+int main() {
+    printf("Running DIRAMC AST tests...\n");
+
+    // Per-node layout
+    diram_ast_node_t* root = build_nodes();
+    assert(diram_ast_count_nodes(root) == 7);
+    assert(diram_ast_validate(root));
+    diram_ast_node_t* opcode = diram_ast_find_child(root, AST_NODE_OPCODE, "ALLOC");
+    assert(opcode && opcode->child_count == 2);
+    assert(!diram_ast_find_child(root, AST_NODE_OPCODE, "FREE"));
+    diram_ast_node_t* operand = opcode->children[1];
+    assert(diram_ast_remove_child(opcode, operand));
+    assert(opcode->child_count == 1 && !operand->parent);
+    assert(diram_ast_add_child(opcode, operand));
+    assert(diram_ast_count_nodes(root) == 7);
+    printf("✓ Per-node tree: 7 nodes, find/remove/add\n");
+
+    // Arena layout: the same tree
+    diram_ast_arena_t* arena = diram_ast_arena_create(0);
+    assert(arena);
+    build_arena(arena);
+    assert(arena->node_count == 7 && arena->open_depth == 0 && arena->pending_count == 0);
+    assert(diram_ast_arena_open(arena, AST_NODE_ROOT) == DIRAM_AST_NONE);
+    assert(!diram_ast_arena_close(arena));
+
+    uint32_t count;
+    const diram_ast_ref_t* children = diram_ast_arena_children(arena, 0, &count);
+    assert(count == 4);
+    const diram_ast_compact_t* op = diram_ast_arena_node(arena, children[1]);
+    assert(op->type == AST_NODE_OPCODE && op->child_count == 2 && op->parent == 0);
+    const diram_ast_ref_t* operands = diram_ast_arena_children(arena, children[1], &count);
+    assert(count == 2 && operands == children - 2);  // closed first, stored first
+    assert(strcmp(diram_ast_arena_string(arena, diram_ast_arena_node(arena, operands[1])->name), "tag") == 0);
+    printf("✓ Arena tree: children as contiguous ranges\n");
+
+    // Interning
+    diram_ast_str_t a = intern(arena, "system");
+    assert(a == diram_ast_arena_node(arena, children[3])->name);
+    assert(diram_ast_arena_intern(arena, "systemd", 6) == a);
+    assert(diram_ast_arena_intern(arena, "", 0) == 0 && diram_ast_arena_string(arena, 0)[0] == '\0');
+    uint32_t length = arena->string_length;
+    for (int i = 0; i < 1000; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "name_%d", i % 100);
+        intern(arena, name);
+    }
+    assert(arena->intern_count == 10 + 100);
+    assert(strcmp(diram_ast_arena_string(arena, a), "system") == 0);
+    assert(arena->string_length > length);
+    printf("✓ Strings interned once\n");
+
+    // Both layouts visit identically
+    trace_visitor_t v1 = trace_visitor(), v2 = trace_visitor();
+    diram_ast_accept(root, &v1.base);
+    diram_ast_arena_accept(arena, 0, &v2.base);
+    assert(strcmp(v1.trace, v2.trace) == 0);
+    printf("✓ Visitors see the same tree: %s\n", v2.trace);
+
+    // Releasing
+    size_t bytes = diram_ast_arena_bytes(arena);
+    diram_ast_arena_reset(arena);
+    assert(arena->node_count == 0 && arena->intern_count == 0);
+    assert(diram_ast_arena_bytes(arena) == bytes);
+    build_arena(arena);
+    trace_visitor_t v3 = trace_visitor();
+    diram_ast_arena_accept(arena, 0, &v3.base);
+    assert(strcmp(v1.trace, v3.trace) == 0);
+    diram_ast_arena_destroy(arena);
+    diram_ast_destroy_node(root);
+    printf("✓ Reset and single release (%zu bytes reused)\n", bytes);
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "diram/core/parser/parser.h"
+
+static const char manifest[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!-- DIRAM XML Configuration Manifest -->\n"
+    "<diram-config version=\"1.0.0\" xmlns=\"http://obinexus.org/diram/config\">\n"
+    "    <metadata>\n"
+    "        <project>OBINexus DIRAM</project>\n"
+    "    </metadata>\n"
+    "    <features>\n"
+    "        <toggle name=\"predictive_allocation\" enabled=\"true\">\n"
+    "            <description>Lookahead strategies</description>\n"
+    "            <policy>zero-trust</policy>\n"
+    "            <constraint>epsilon_limit=0.6</constraint>\n"
+    "        </toggle>\n"
+    "        <toggle name=\"memory_isolation\" enabled=\"false\">\n"
+    "            <default_space>userspace</default_space>\n"
+    "        </toggle>\n"
+    "    </features>\n"
+    "    <opcodes>\n"
+    "        <opcode name=\"ALLOC\" code=\"0x01\">\n"
+    "            <operands>\n"
+    "                <operand name=\"size\" type=\"size_t\" position=\"1\"/>\n"
+    "                <operand name=\"tag\" type=\"string\" position=\"2\"/>\n"
+    "            </operands>\n"
+    "            <constraints>\n"
+    "                <heap_events max=\"3\"/>\n"
+    "                <alignment>8</alignment>\n"
+    "            </constraints>\n"
+    "        </opcode>\n"
+    "    </opcodes>\n"
+    "    <policies>\n"
+    "        <policy name=\"zero-trust\" type=\"security\">\n"
+    "            <rule>all_allocations_traced</rule>\n"
+    "            <rule>pid_binding_enforced</rule>\n"
+    "        </policy>\n"
+    "    </policies>\n"
+    "    <memory_regions>\n"
+    "        <region name=\"system\" base=\"0x00000000\" size=\"16MB\" protection=\"rx\"/>\n"
+    "        <region name=\"trace_buffer\" base=\"0xF0000000\" size=\"256MB\" protection=\"w\"/>\n"
+    "    </memory_regions>\n"
+    "    <build>\n"
+    "        <output_dir>build/</output_dir>\n"
+    "        <targets>\n"
+    "            <target name=\"native\" platform=\"x86_64\">\n"
+    "                <compiler>gcc</compiler>\n"
+    "                <flags>-O2 -fPIC</flags>\n"
+    "            </target>\n"
+    "        </targets>\n"
+    "    </build>\n"
+    "</diram-config>\n";
+
+static const char expected_trace[] =
+    "root "
+    "feature:predictive_allocation:1:Lookahead strategies:zero-trust "
+    "constraint:epsilon_limit:0.6:0 "
+    "feature:memory_isolation:0:: "
+    "opcode:ALLOC:1 operand:size:size_t:1 operand:tag:string:2 constraint:heap_events:0.0:3 "
+    "policy:zero-trust:security:2:pid_binding_enforced "
+    "region:system:0:16777216:5 region:trace_buffer:f0000000:268435456:2 "
+    "target:native:x86_64:gcc:-O2 -fPIC ";
+
+// Records the pre-order sequence of nodes a visitor sees
+typedef struct {
+    diram_ast_visitor_t base;
+    char trace[1024];
+    size_t nodes;
+} trace_visitor_t;
+
+static void* trace_node(diram_ast_visitor_t* self, diram_ast_node_t* node) {
+    trace_visitor_t* v = (trace_visitor_t*)self;
+    char entry[128];
+    switch (node->type) {
+        case AST_NODE_ROOT:
+            snprintf(entry, sizeof(entry), "root ");
+            break;
+        case AST_NODE_FEATURE_TOGGLE:
+            snprintf(entry, sizeof(entry), "feature:%s:%d:%s:%s ", node->data.feature.name,
+                     node->data.feature.enabled, node->data.feature.description,
+                     node->data.feature.policy);
+            break;
+        case AST_NODE_CONSTRAINT:
+            snprintf(entry, sizeof(entry), "constraint:%s:%.1f:%u ", node->data.constraint.name,
+                     node->data.constraint.epsilon_value, node->data.constraint.max_heap_events);
+            break;
+        case AST_NODE_OPCODE:
+            snprintf(entry, sizeof(entry), "opcode:%s:%u ", node->data.opcode.name, node->data.opcode.code);
+            break;
+        case AST_NODE_OPERAND:
+            snprintf(entry, sizeof(entry), "operand:%s:%s:%u ", node->data.operand.name,
+                     node->data.operand.type, node->data.operand.position);
+            break;
+        case AST_NODE_POLICY:
+            snprintf(entry, sizeof(entry), "policy:%s:%s:%zu:%s ", node->data.policy.name,
+                     node->data.policy.type, node->data.policy.rule_count, node->data.policy.rules[1]);
+            break;
+        case AST_NODE_MEMORY_REGION:
+            snprintf(entry, sizeof(entry), "region:%s:%lx:%zu:%u ", node->data.memory_region.name,
+                     (unsigned long)node->data.memory_region.base_address,
+                     node->data.memory_region.size, node->data.memory_region.protection_flags);
+            break;
+        case AST_NODE_BUILD_TARGET:
+            snprintf(entry, sizeof(entry), "target:%s:%s:%s:%s ", node->data.build_target.name,
+                     node->data.build_target.platform, node->data.build_target.compiler,
+                     node->data.build_target.flags);
+            break;
+        default:
+            snprintf(entry, sizeof(entry), "? ");
+            break;
+    }
+    strncat(v->trace, entry, sizeof(v->trace) - strlen(v->trace) - 1);
+    v->nodes++;
+    return NULL;
+}
+
+static trace_visitor_t trace_visitor(void) {
+    trace_visitor_t v;
+    memset(&v, 0, sizeof(v));
+    v.base.visit_root = v.base.visit_feature_toggle = v.base.visit_constraint = trace_node;
+    v.base.visit_opcode = v.base.visit_operand = v.base.visit_policy = trace_node;
+    v.base.visit_memory_region = v.base.visit_build_target = trace_node;
+    return v;
+}
+
+static char last_violation[256];
+static int violations;
+
+static void record_violation(const char* violation) {
+    snprintf(last_violation, sizeof(last_violation), "%s", violation);
+    violations++;
+}
+
+// Parses `xml` and returns the error message, or NULL on success
+static const char* parse_error(const char* xml, bool strict) {
+    static char message[512];
+    diram_parser_t* parser = diram_parser_create(xml, strlen(xml));
+    assert(parser);
+    parser->strict_mode = strict;
+    diram_parser_set_policy_handler(parser, record_violation);
+    diram_ast_arena_t* arena = diram_parser_parse(parser);
+    assert((arena == NULL) == diram_parser_has_error(parser));
+    const char* error = NULL;
+    if (!arena) {
+        snprintf(message, sizeof(message), "%s", diram_parser_get_error(parser));
+        error = message;
+    }
+    diram_parser_destroy(parser);
+    return error;
+}
+
+int main() {
+    printf("Running DIRAMC parser tests...\n");
+
+    // Buffered: the whole tree stays in the arena
+    diram_parser_t* parser = diram_parser_create(manifest, sizeof(manifest) - 1);
+    assert(parser);
+    diram_ast_arena_t* arena = diram_parser_parse(parser);
+    assert(arena && !diram_parser_has_error(parser));
+    assert(parser->state == PARSER_STATE_COMPLETE && parser->depth == 0);
+    assert(arena->node_count == 12 && arena->open_depth == 0);
+    uint32_t count;
+    diram_ast_arena_children(arena, parser->root, &count);
+    assert(count == 7);
+    trace_visitor_t buffered = trace_visitor();
+    diram_ast_arena_accept(arena, parser->root, &buffered.base);
+    assert(strcmp(buffered.trace, expected_trace) == 0);
+    assert(!diram_parser_parse(parser));            // single use
+    diram_parser_destroy(parser);
+    printf("✓ Buffered parse: %zu nodes\n", buffered.nodes);
+
+    // Streaming: items are visited as they close and dropped
+    parser = diram_parser_create(manifest, sizeof(manifest) - 1);
+    trace_visitor_t streamed = trace_visitor();
+    parser->emit_ast_immediately = true;
+    diram_parser_set_visitor(parser, &streamed.base);
+    arena = diram_parser_parse(parser);
+    assert(arena && arena->node_count == 1);
+    assert(strcmp(streamed.trace, expected_trace) == 0);
+    assert(parser->nodes_emitted == buffered.nodes);
+    diram_parser_destroy(parser);
+    printf("✓ Streaming parse: same visit order, %u node left\n", 1u);
+
+    // Streaming from a pipe, a few bytes at a time
+    for (size_t chunk = 1; chunk <= 64; chunk *= 4) {
+        int fds[2];
+        assert(pipe(fds) == 0);
+        assert(write(fds[1], manifest, sizeof(manifest) - 1) == (ssize_t)(sizeof(manifest) - 1));
+        close(fds[1]);
+        parser = diram_parser_create_from_tokenizer(diram_tokenizer_create_stream(fds[0], chunk));
+        trace_visitor_t piped = trace_visitor();
+        parser->emit_ast_immediately = true;
+        diram_parser_set_visitor(parser, &piped.base);
+        assert(diram_parser_parse(parser));
+        assert(strcmp(piped.trace, expected_trace) == 0);
+        diram_parser_destroy(parser);
+        close(fds[0]);
+    }
+    printf("✓ Streamed through a pipe in 1..64 byte chunks\n");
+
+    // Structural errors carry line:column
+    const char* error = parse_error("<diram-config>\n  <features></policies>\n</diram-config>", false);
+    assert(error && strncmp(error, "2:", 2) == 0 && strstr(error, "</policies>"));
+    error = parse_error("<diram-config><features>", false);
+    assert(error && strstr(error, "unexpected end of input"));
+    error = parse_error("<config/>", false);
+    assert(error && strstr(error, "expected <diram-config>"));
+    error = parse_error("<diram-config/><diram-config/>", false);
+    assert(error && strstr(error, "after the root"));
+    error = parse_error("<diram-config><opcodes><opcode code=\"lots\"/></opcodes></diram-config>", false);
+    assert(error && strstr(error, "expected a number"));
+    error = parse_error("<diram-config><features><toggle", false);
+    assert(error);
+    printf("✓ Malformed input rejected: %s\n", error);
+
+    // Unknown elements are skipped unless strict
+    const char* unknown = "<diram-config><features><toggle name=\"a\"><extra><x>1</x></extra>"
+                          "</toggle></features><future/></diram-config>";
+    assert(parse_error(unknown, false) == NULL);
+    error = parse_error(unknown, true);
+    assert(error && strstr(error, "unexpected <extra> in features"));
+    printf("✓ Unknown elements skipped, rejected in strict mode\n");
+
+    // Policy violations reach the handler; fatal only in strict mode
+    const char* reserved = "<diram-config><opcodes><opcode name=\"NOP\" code=\"0x00\"/></opcodes>"
+                           "<memory_regions><region name=\"r\" base=\"0\" size=\"1KB\" protection=\"rwr\"/>"
+                           "</memory_regions></diram-config>";
+    violations = 0;
+    assert(parse_error(reserved, false) == NULL);
+    assert(violations == 2 && strstr(last_violation, "invalid protection 'rwr'"));
+    violations = 0;
+    error = parse_error(reserved, true);
+    assert(violations == 1 && error && strstr(error, "reserved opcode 0x00"));
+    printf("✓ Policy violations reported (%s)\n", last_violation);
+
+    // Utilities
+    assert(diram_parser_validate_constraint("epsilon_limit=0.6"));
+    assert(!diram_parser_validate_constraint("=0.6") && !diram_parser_validate_constraint("limit=high"));
+    assert(diram_parser_validate_opcode(0x01) && !diram_parser_validate_opcode(0xFF));
+    assert(diram_parser_validate_memory_protection("rx") && !diram_parser_validate_memory_protection("rq"));
+    parser = diram_parser_create("", 0);
+    assert(!diram_parser_transition(parser, PARSER_STATE_POLICIES));
+    assert(diram_parser_has_error(parser));
+    diram_parser_destroy(parser);
+    printf("✓ Validation utilities and transitions\n");
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "diram/core/parser/structural_index.h"
+#include "diram/core/parser/tokenizer.h"
+
+#define BLOCKS 64
+
+static const char alphabet[] = "<>=/\"' \t\r\nab-_:0.?!";
+
+static void fill_random(char* buf, size_t n, unsigned* seed) {
+    for (size_t i = 0; i < n; i++) {
+        // Mostly structural bytes, with high-bit bytes mixed in
+        int r = rand_r(seed);
+        buf[i] = (r & 7) == 0 ? (char)(0x80 | (r >> 3)) : alphabet[(r >> 3) % (sizeof(alphabet) - 1)];
+    }
+}
+
+static int matches(char c, const char* set) {
+    return c != '\0' && strchr(set, c) != NULL;
+}
+
+static void check_block(const char* in, size_t length, const diram_scan_block_t* b) {
+    for (size_t i = 0; i < DIRAM_SCAN_BLOCK; i++) {
+        char c = i < length ? in[i] : '\0';
+        assert(((b->lt >> i) & 1) == (uint64_t)(i < length && c == '<'));
+        assert(((b->quote >> i) & 1) == (uint64_t)(i < length && matches(c, "\"'")));
+        assert(((b->delim >> i) & 1) == (uint64_t)(i < length && matches(c, " \t\r\n<>=\"'/")));
+        assert(((b->space >> i) & 1) == (uint64_t)(i < length && matches(c, " \t\r\n")));
+        assert(((b->newline >> i) & 1) == (uint64_t)(i < length && c == '\n'));
+    }
+}
+
+static const char manifest[] =
+    "<?xml version=\"1.0\"?>\n"
+    "<diram-config version=\"1.0.0\">\n"
+    "  <region name=\"system\" base=\"0x0\" size=\"16MB\"/>\n"
+    "  <description>  padded text\n spanning lines  </description>\n"
+    "</diram-config>\n";
+
+int main() {
+    printf("Running DIRAMC structural index tests...\n");
+
+    static char input[BLOCKS * DIRAM_SCAN_BLOCK];
+    static diram_scan_block_t reference[BLOCKS], got[BLOCKS];
+    unsigned seed = 7;
+    fill_random(input, sizeof(input), &seed);
+
+    // Scalar masks agree with the definition byte by byte
+    assert(diram_scan_force_impl(DIRAM_SCAN_IMPL_SCALAR) == 0);
+    diram_scan_blocks(input, BLOCKS, reference);
+    for (size_t b = 0; b < BLOCKS; b++) {
+        check_block(input + b * DIRAM_SCAN_BLOCK, DIRAM_SCAN_BLOCK, &reference[b]);
+    }
+    for (size_t n = 0; n < DIRAM_SCAN_BLOCK; n++) {
+        diram_scan_block_t tail;
+        diram_scan_tail(input, n, &tail);
+        check_block(input, n, &tail);
+    }
+    printf("✓ Scalar masks\n");
+
+    // Every vector path produces the scalar masks, at any alignment
+    diram_scan_impl_t impls[] = { DIRAM_SCAN_IMPL_SSE42, DIRAM_SCAN_IMPL_AVX2 };
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+        if (diram_scan_force_impl(impls[i]) != 0) {
+            printf("  %s not supported, skipped\n", diram_scan_impl_name(impls[i]));
+            continue;
+        }
+        assert(diram_scan_active_impl() == impls[i]);
+        diram_scan_blocks(input, BLOCKS, got);
+        assert(memcmp(got, reference, sizeof(got)) == 0);
+        for (size_t shift = 1; shift < 8; shift++) {
+            diram_scan_blocks(input + shift, BLOCKS - 1, got);
+            assert(diram_scan_force_impl(DIRAM_SCAN_IMPL_SCALAR) == 0);
+            diram_scan_block_t expect[BLOCKS];
+            diram_scan_blocks(input + shift, BLOCKS - 1, expect);
+            assert(memcmp(got, expect, (BLOCKS - 1) * sizeof(diram_scan_block_t)) == 0);
+            assert(diram_scan_force_impl(impls[i]) == 0);
+        }
+        printf("✓ %s matches scalar\n", diram_scan_impl_name(impls[i]));
+    }
+
+    // The tokenizer sees the same tokens whichever path built its index
+    diram_scan_impl_t all[] = { DIRAM_SCAN_IMPL_SCALAR, DIRAM_SCAN_IMPL_SSE42, DIRAM_SCAN_IMPL_AVX2 };
+    uint32_t lines = 0;
+    size_t count = 0;
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); i++) {
+        if (diram_scan_force_impl(all[i]) != 0) continue;
+        diram_tokenizer_t* t = diram_tokenizer_create(manifest, sizeof(manifest) - 1);
+        size_t tokens = 0;
+        diram_token_t tok;
+        do {
+            tok = diram_tokenizer_next(t);
+            assert(tok.type != TOKEN_ERROR);
+            if (tok.type == TOKEN_TEXT) {
+                assert(tok.line == 4 && tok.column == 18);
+                assert(memcmp(diram_tokenizer_text(t, &tok), "padded text\n spanning lines", tok.value.text.length) == 0);
+            }
+            tokens++;
+        } while (tok.type != TOKEN_EOF);
+        assert(count == 0 || (tokens == count && tok.line == lines));
+        count = tokens;
+        lines = tok.line;
+        diram_tokenizer_destroy(t);
+    }
+    assert(lines == 7);
+    printf("✓ Tokenizer agrees across paths: %zu tokens\n", count);
+
+    assert(diram_scan_force_impl(DIRAM_SCAN_IMPL_AUTO) == 0);
+    printf("  active: %s\n", diram_scan_impl_name(diram_scan_active_impl()));
+
+    printf("All tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <unistd.h>
+#include "diram/core/parser/tokenizer.h"
+
+static const char manifest[] =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!-- generated -->\n"
+    "<diram-config version=\"1.0.0\">\n"
+    "    <features>\n"
+    "        <toggle name=\"detached_mode\" enabled='true'>\n"
+    "            <description>Background daemon</description>\n"
+    "            <flags><![CDATA[-O2 <fast>]]></flags>\n"
+    "        </toggle>\n"
+    "        <region name=\"system\" base=\"0x00000000\" size=\"16MB\"/>\n"
+    "    </features >\n"
+    "</diram-config>\n";
+
+typedef struct {
+    diram_token_type_t type;
+    const char* text;
+    uint32_t line;
+    uint32_t column;
+} expected_t;
+
+static const expected_t expected[] = {
+    { TOKEN_XML_START, "xml version=\"1.0\" encoding=\"UTF-8\"", 1, 3 },
+    { TOKEN_ELEMENT_START, "diram-config", 3, 2 },
+    { TOKEN_ATTRIBUTE_NAME, "version", 3, 15 },
+    { TOKEN_ATTRIBUTE_VALUE, "1.0.0", 3, 24 },
+    { TOKEN_ELEMENT_START, "features", 4, 6 },
+    { TOKEN_ELEMENT_START, "toggle", 5, 10 },
+    { TOKEN_ATTRIBUTE_NAME, "name", 5, 17 },
+    { TOKEN_ATTRIBUTE_VALUE, "detached_mode", 5, 23 },
+    { TOKEN_ATTRIBUTE_NAME, "enabled", 5, 38 },
+    { TOKEN_ATTRIBUTE_VALUE, "true", 5, 47 },
+    { TOKEN_ELEMENT_START, "description", 6, 14 },
+    { TOKEN_TEXT, "Background daemon", 6, 26 },
+    { TOKEN_ELEMENT_END, "description", 6, 45 },
+    { TOKEN_ELEMENT_START, "flags", 7, 14 },
+    { TOKEN_TEXT, "-O2 <fast>", 7, 29 },
+    { TOKEN_ELEMENT_END, "flags", 7, 44 },
+    { TOKEN_ELEMENT_END, "toggle", 8, 11 },
+    { TOKEN_ELEMENT_START, "region", 9, 10 },
+    { TOKEN_ATTRIBUTE_NAME, "name", 9, 17 },
+    { TOKEN_ATTRIBUTE_VALUE, "system", 9, 23 },
+    { TOKEN_ATTRIBUTE_NAME, "base", 9, 31 },
+    { TOKEN_ATTRIBUTE_VALUE, "0x00000000", 9, 37 },
+    { TOKEN_ATTRIBUTE_NAME, "size", 9, 49 },
+    { TOKEN_ATTRIBUTE_VALUE, "16MB", 9, 55 },
+    { TOKEN_ELEMENT_END, "region", 9, 60 },
+    { TOKEN_ELEMENT_END, "features", 10, 7 },
+    { TOKEN_ELEMENT_END, "diram-config", 11, 3 },
+    { TOKEN_EOF, "", 12, 1 },
+};
+#define EXPECTED (sizeof(expected) / sizeof(expected[0]))
+
+static void check_stream(diram_tokenizer_t* t) {
+    for (size_t i = 0; i < EXPECTED; i++) {
+        diram_token_t tok = diram_tokenizer_next(t);
+        const char* text = diram_tokenizer_text(t, &tok);
+        if (tok.type != expected[i].type || tok.value.text.length != strlen(expected[i].text) ||
+            memcmp(text, expected[i].text, tok.value.text.length) != 0 ||
+            tok.line != expected[i].line || tok.column != expected[i].column) {
+            fprintf(stderr, "token %zu: %s '%.*s' at %u:%u\n", i, diram_token_type_to_string(tok.type),
+                    (int)tok.value.text.length, text, tok.line, tok.column);
+            assert(0);
+        }
+    }
+    assert(diram_tokenizer_next(t).type == TOKEN_EOF);
+    assert(!diram_tokenizer_has_error(t));
+}
+
+static const char* first_error(const char* input) {
+    static char message[256];
+    diram_tokenizer_t* t = diram_tokenizer_create(input, strlen(input));
+    diram_token_t tok;
+    do {
+        tok = diram_tokenizer_next(t);
+    } while (tok.type != TOKEN_EOF && tok.type != TOKEN_ERROR);
+    message[0] = '\0';
+    if (tok.type == TOKEN_ERROR) {
+        snprintf(message, sizeof(message), "%s", diram_tokenizer_get_error(t));
+        assert(diram_tokenizer_next(t).type == TOKEN_ERROR);
+    }
+    diram_tokenizer_destroy(t);
+    return message;
+}
+
+int main() {
+    printf("Running DIRAMC tokenizer tests...\n");
+
+    // Borrowed buffer: every token is a view into it
+    diram_tokenizer_t* t = diram_tokenizer_create(manifest, sizeof(manifest) - 1);
+    diram_token_t first = diram_tokenizer_next(t);
+    assert(diram_tokenizer_text(t, &first) == manifest + 2);
+    diram_tokenizer_destroy(t);
+    t = diram_tokenizer_create(manifest, sizeof(manifest) - 1);
+    check_stream(t);
+    diram_tokenizer_destroy(t);
+    printf("✓ In-memory buffer: %zu tokens\n", EXPECTED);
+
+    // Mapped file
+    char path[] = "/tmp/diram_tokenizer_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, manifest, sizeof(manifest) - 1) == (ssize_t)(sizeof(manifest) - 1));
+    close(fd);
+    t = diram_tokenizer_open(path);
+    assert(t && t->mapping && t->fd == -1);
+    check_stream(t);
+    diram_tokenizer_destroy(t);
+    unlink(path);
+    printf("✓ Mapped file\n");
+
+    // Pipe, in chunks far smaller than a tag
+    for (size_t chunk = 1; chunk <= 16; chunk *= 2) {
+        int fds[2];
+        assert(pipe(fds) == 0);
+        assert(write(fds[1], manifest, sizeof(manifest) - 1) == (ssize_t)(sizeof(manifest) - 1));
+        close(fds[1]);
+        t = diram_tokenizer_create_stream(fds[0], chunk);
+        check_stream(t);
+        assert(t->window_capacity <= 256);
+        diram_tokenizer_destroy(t);
+        close(fds[0]);
+    }
+    printf("✓ Streamed through a pipe in 1..16 byte chunks\n");
+
+    // Paths that cannot be mapped fall back to streaming
+    int fds[2];
+    assert(pipe(fds) == 0);
+    assert(write(fds[1], manifest, sizeof(manifest) - 1) == (ssize_t)(sizeof(manifest) - 1));
+    close(fds[1]);
+    char pipe_path[64];
+    snprintf(pipe_path, sizeof(pipe_path), "/proc/self/fd/%d", fds[0]);
+    t = diram_tokenizer_open(pipe_path);
+    assert(t && !t->mapping && t->owns_fd);
+    check_stream(t);
+    diram_tokenizer_destroy(t);
+    close(fds[0]);
+    printf("✓ Unmappable path streamed\n");
+
+    // Malformed input stops with a located error
+    assert(strcmp(first_error("<a b=c/>"), "1:6: expected a quoted attribute value") == 0);
+    assert(strcmp(first_error("<a>\n  </ b>"), "2:5: expected a name after '</'") == 0);
+    assert(strcmp(first_error("<a b=\"1\""), "1:9: unterminated start tag") == 0);
+    assert(strcmp(first_error("<!-- open"), "1:1: unterminated comment") == 0);
+    assert(strcmp(first_error("<a>text</a>"), "") == 0);
+    printf("✓ Errors: %s\n", first_error("<a\n  =\"x\">"));
+
+    // Manifest vocabulary
+    assert(diram_tokenizer_is_element_name("toggle", 6));
+    assert(!diram_tokenizer_is_element_name("toggles", 7));
+    assert(diram_tokenizer_is_attribute_name("protection", 10));
+    assert(diram_tokenizer_classify_memory("trace_buffer", 12) == MEMORY_TRACE_BUFFER);
+    assert(diram_tokenizer_classify_memory("system_", 7) == MEMORY_NONE);
+    printf("✓ Manifest vocabulary\n");
+
+    printf("All tests passed!\n");
+    return 0;
+}